@@ -6,6 +6,114 @@ dnl Function to detect if libfsapfs dependencies are available
 AC_DEFUN([AX_LIBFSAPFS_CHECK_LOCAL],
   [dnl Check for internationalization functions in libfsapfs/libfsapfs_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Check for hardware AES support in libfsapfs/libfsapfs_aes_ni.c
+  AX_LIBFSAPFS_CHECK_AES_NI
+])
+
+dnl Function to detect if the compiler supports the AES-NI and VAES intrinsics
+dnl The intrinsics are only used in functions with a target attribute, that are
+dnl called after the processor support was determined at run-time, hence -maes
+dnl and -mvaes are only used to check the compiler and not added to CFLAGS
+AC_DEFUN([AX_LIBFSAPFS_CHECK_AES_NI],
+  [AX_COMMON_ARG_DISABLE(
+    [aes-ni],
+    [aes_ni],
+    [hardware AES (AES-NI and VAES) support])
+
+  ac_cv_libfsapfs_aes_ni=no
+  ac_cv_libfsapfs_vaes=no
+
+  AS_IF(
+    [test "x$ac_cv_enable_aes_ni" != xno],
+    [AS_CASE(
+      [$host_cpu],
+      [i?86 | x86_64 | amd64],
+      [ac_cv_libfsapfs_aes_ni=check])
+    ])
+
+  AS_IF(
+    [test "x$ac_cv_libfsapfs_aes_ni" = xcheck],
+    [AC_LANG_PUSH(C)
+
+    SAVE_CFLAGS="$CFLAGS"
+    CFLAGS="$CFLAGS -msse2 -maes"
+
+    AC_MSG_CHECKING(
+      [whether the compiler supports the AES-NI intrinsics])
+
+    AC_LINK_IFELSE(
+      [AC_LANG_PROGRAM(
+        [[#include <cpuid.h>
+#include <wmmintrin.h>
+
+__attribute__((target("aes,sse2")))
+static __m128i test_decrypt( __m128i block, __m128i round_key )
+{
+	return( _mm_aesdeclast_si128( _mm_aesdec_si128( block, round_key ), round_key ) );
+}]],
+        [[unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+__m128i block = _mm_setzero_si128();
+__get_cpuid( 1, &eax, &ebx, &ecx, &edx );
+block = test_decrypt( block, _mm_aeskeygenassist_si128( block, 0x01 ) );
+return( _mm_cvtsi128_si32( block ) ); ]] )],
+      [ac_cv_libfsapfs_aes_ni=yes],
+      [ac_cv_libfsapfs_aes_ni=no])
+
+    AC_MSG_RESULT(
+      [$ac_cv_libfsapfs_aes_ni])
+
+    AS_IF(
+      [test "x$ac_cv_libfsapfs_aes_ni" = xyes],
+      [CFLAGS="$CFLAGS -mavx2 -mavx512f -mvaes"
+
+      AC_MSG_CHECKING(
+        [whether the compiler supports the VAES intrinsics])
+
+      AC_LINK_IFELSE(
+        [AC_LANG_PROGRAM(
+          [[#include <cpuid.h>
+#include <immintrin.h>
+
+__attribute__((target("aes,sse2,avx2,avx512f,vaes")))
+static __m512i test_decrypt( __m512i block, __m512i round_key )
+{
+	return( _mm512_aesdeclast_epi128( _mm512_aesdec_epi128( block, round_key ), round_key ) );
+}]],
+          [[unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+unsigned int xcr0_eax = 0, xcr0_edx = 0;
+__m512i block = _mm512_setzero_si512();
+__get_cpuid_count( 7, 0, &eax, &ebx, &ecx, &edx );
+__asm__ __volatile__ ( "xgetbv" : "=a" ( xcr0_eax ), "=d" ( xcr0_edx ) : "c" ( 0 ) );
+block = test_decrypt( block, block );
+return( (int) ( xcr0_eax + ecx ) ); ]] )],
+        [ac_cv_libfsapfs_vaes=yes],
+        [ac_cv_libfsapfs_vaes=no])
+
+      AC_MSG_RESULT(
+        [$ac_cv_libfsapfs_vaes])
+      ])
+
+    CFLAGS="$SAVE_CFLAGS"
+
+    AC_LANG_POP(C)
+    ])
+
+  AS_IF(
+    [test "x$ac_cv_libfsapfs_aes_ni" = xyes],
+    [AC_DEFINE(
+      [HAVE_AES_NI_INTRINSICS],
+      [1],
+      [Define to 1 if the compiler supports the AES-NI intrinsics.])
+    ])
+
+  AS_IF(
+    [test "x$ac_cv_libfsapfs_vaes" = xyes],
+    [AC_DEFINE(
+      [HAVE_VAES_INTRINSICS],
+      [1],
+      [Define to 1 if the compiler supports the VAES intrinsics.])
+    ])
 ])
 
 dnl Function to detect if fsapfstools dependencies are available
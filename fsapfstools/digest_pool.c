@@ -0,0 +1,829 @@
+/*
+ * Digest pool functions
+ *
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash.h"
+#include "digest_pool.h"
+#include "fsapfstools_libcerror.h"
+#include "fsapfstools_libcthreads.h"
+#include "fsapfstools_libfsapfs.h"
+#include "fsapfstools_libhmac.h"
+
+/* Calculates the digest hash of the data of the file entry of a job
+ * Returns 1 if successful or -1 on error
+ */
+int digest_job_calculate(
+     digest_job_t *digest_job,
+     libcerror_error_t **error )
+{
+	uint8_t digest_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	libfsapfs_file_entry_t *file_entry       = NULL;
+	libhmac_md5_context_t *md5_context       = NULL;
+	libhmac_sha1_context_t *sha1_context     = NULL;
+	libhmac_sha256_context_t *sha256_context = NULL;
+	uint8_t *buffer                          = NULL;
+	static char *function                    = "digest_job_calculate";
+	size_t digest_hash_size                  = 0;
+	ssize_t read_count                       = 0;
+	int result                               = 0;
+
+	if( digest_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest job.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest_job->digest_hash_type )
+	{
+		case DIGEST_HASH_TYPE_MD5:
+			digest_hash_size = LIBHMAC_MD5_HASH_SIZE;
+
+			result = libhmac_md5_initialize(
+			          &md5_context,
+			          error );
+			break;
+
+		case DIGEST_HASH_TYPE_SHA1:
+			digest_hash_size = LIBHMAC_SHA1_HASH_SIZE;
+
+			result = libhmac_sha1_initialize(
+			          &sha1_context,
+			          error );
+			break;
+
+		case DIGEST_HASH_TYPE_SHA256:
+			digest_hash_size = LIBHMAC_SHA256_HASH_SIZE;
+
+			result = libhmac_sha256_initialize(
+			          &sha256_context,
+			          error );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest hash type.",
+			 function );
+
+			return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize digest hash context.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfsapfs_volume_get_file_entry_by_identifier(
+	          digest_job->volume,
+	          digest_job->file_entry_identifier,
+	          &file_entry,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry: %" PRIu64 ".",
+		 function,
+		 digest_job->file_entry_identifier );
+
+		goto on_error;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * DIGEST_POOL_READ_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		read_count = libfsapfs_file_entry_read_buffer(
+		              file_entry,
+		              buffer,
+		              DIGEST_POOL_READ_BUFFER_SIZE,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data from file entry: %" PRIu64 ".",
+			 function,
+			 digest_job->file_entry_identifier );
+
+			goto on_error;
+		}
+		else if( read_count > 0 )
+		{
+			if( md5_context != NULL )
+			{
+				result = libhmac_md5_update(
+				          md5_context,
+				          buffer,
+				          (size_t) read_count,
+				          error );
+			}
+			else if( sha1_context != NULL )
+			{
+				result = libhmac_sha1_update(
+				          sha1_context,
+				          buffer,
+				          (size_t) read_count,
+				          error );
+			}
+			else
+			{
+				result = libhmac_sha256_update(
+				          sha256_context,
+				          buffer,
+				          (size_t) read_count,
+				          error );
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update digest hash.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	while( read_count > 0 );
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( libfsapfs_file_entry_free(
+	     &file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context != NULL )
+	{
+		result = libhmac_md5_finalize(
+		          md5_context,
+		          digest_hash,
+		          digest_hash_size,
+		          error );
+	}
+	else if( sha1_context != NULL )
+	{
+		result = libhmac_sha1_finalize(
+		          sha1_context,
+		          digest_hash,
+		          digest_hash_size,
+		          error );
+	}
+	else
+	{
+		result = libhmac_sha256_finalize(
+		          sha256_context,
+		          digest_hash,
+		          digest_hash_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to finalize digest hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_hash_copy_to_string(
+	     digest_hash,
+	     digest_hash_size,
+	     digest_job->digest_hash_string,
+	     DIGEST_HASH_MAXIMUM_STRING_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy digest hash to string.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context != NULL )
+	{
+		result = libhmac_md5_free(
+		          &md5_context,
+		          error );
+	}
+	else if( sha1_context != NULL )
+	{
+		result = libhmac_sha1_free(
+		          &sha1_context,
+		          error );
+	}
+	else
+	{
+		result = libhmac_sha256_free(
+		          &sha256_context,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free digest hash context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( file_entry != NULL )
+	{
+		libfsapfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	if( sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &sha256_context,
+		 NULL );
+	}
+	if( sha1_context != NULL )
+	{
+		libhmac_sha1_free(
+		 &sha1_context,
+		 NULL );
+	}
+	if( md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates a digest pool
+ * Make sure the value digest_pool is referencing, is set to NULL
+ * Without multi-threading support the jobs are calculated when they are pushed
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pool_initialize(
+     digest_pool_t **digest_pool,
+     int number_of_threads,
+     int maximum_number_of_jobs,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pool_initialize";
+
+	if( digest_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > DIGEST_POOL_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_jobs <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of jobs value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_pool = memory_allocate_structure(
+	                digest_pool_t );
+
+	if( *digest_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_pool,
+	     0,
+	     sizeof( digest_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest pool.",
+		 function );
+
+		memory_free(
+		 *digest_pool );
+
+		*digest_pool = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *digest_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *digest_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *digest_pool )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     maximum_number_of_jobs,
+	     (int (*)(intptr_t *, void *)) &digest_pool_calculate_job,
+	     (void *) *digest_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *digest_pool )->number_of_threads = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( *digest_pool != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *digest_pool )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *digest_pool )->condition ),
+			 NULL );
+		}
+		if( ( *digest_pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *digest_pool )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *digest_pool );
+
+		*digest_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a digest pool
+ * This waits for the pending jobs to complete
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pool_free(
+     digest_pool_t **digest_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pool_free";
+	int result            = 1;
+
+	if( digest_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_pool != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *digest_pool )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *digest_pool )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *digest_pool )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *digest_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *digest_pool );
+
+		*digest_pool = NULL;
+	}
+	return( result );
+}
+
+/* Calculates the digest hash of a job
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pool_calculate_job(
+     digest_job_t *digest_job,
+     digest_pool_t *digest_pool )
+{
+	int result = 0;
+
+	if( digest_job == NULL )
+	{
+		return( -1 );
+	}
+	if( digest_pool == NULL )
+	{
+		return( -1 );
+	}
+	/* There is no caller to report the error to, hence the error is
+	 * stored in the job and reported when the job is waited for
+	 */
+	result = digest_job_calculate(
+	          digest_job,
+	          &( digest_job->error ) );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     digest_pool->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	digest_job->result       = result;
+	digest_job->is_completed = 1;
+
+	if( libcthreads_condition_broadcast(
+	     digest_pool->condition,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     digest_pool->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+#else
+	digest_job->result       = result;
+	digest_job->is_completed = 1;
+#endif
+	return( result );
+}
+
+/* Pushes a job that calculates the digest hash of the data of a file entry onto the digest pool
+ * The job and the volume must remain available until the job has been waited for
+ * This blocks if the queue of the digest pool is full
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pool_push_job(
+     digest_pool_t *digest_pool,
+     digest_job_t *digest_job,
+     libfsapfs_volume_t *volume,
+     uint64_t file_entry_identifier,
+     int digest_hash_type,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pool_push_job";
+
+	if( digest_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest job.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest_hash_type != DIGEST_HASH_TYPE_MD5 )
+	 && ( digest_hash_type != DIGEST_HASH_TYPE_SHA1 )
+	 && ( digest_hash_type != DIGEST_HASH_TYPE_SHA256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest hash type.",
+		 function );
+
+		return( -1 );
+	}
+	digest_job->volume                  = volume;
+	digest_job->file_entry_identifier   = file_entry_identifier;
+	digest_job->digest_hash_type        = digest_hash_type;
+	digest_job->digest_hash_string[ 0 ] = 0;
+	digest_job->result                  = 0;
+	digest_job->is_completed            = 0;
+
+	if( digest_job->error != NULL )
+	{
+		libcerror_error_free(
+		 &( digest_job->error ) );
+	}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_thread_pool_push(
+	     digest_pool->thread_pool,
+	     (intptr_t *) digest_job,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push job onto thread pool.",
+		 function );
+
+		/* The job was not queued hence it will never complete
+		 */
+		digest_job->result       = -1;
+		digest_job->is_completed = 1;
+
+		return( -1 );
+	}
+#else
+	digest_pool_calculate_job(
+	 digest_job,
+	 digest_pool );
+#endif
+	return( 1 );
+}
+
+/* Waits for a job of the digest pool to complete
+ * If the digest hash could not be calculated the error of the job is set,
+ * the caller is responsible for freeing it
+ * Returns 1 if successful, 0 if the digest hash could not be calculated or -1 on error
+ */
+int digest_pool_wait_for_job(
+     digest_pool_t *digest_pool,
+     digest_job_t *digest_job,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pool_wait_for_job";
+	int result            = 0;
+
+	if( digest_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest job.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     digest_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( digest_job->is_completed == 0 )
+	{
+		if( libcthreads_condition_wait(
+		     digest_pool->condition,
+		     digest_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 digest_pool->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	result = digest_job->result;
+
+	if( libcthreads_mutex_release(
+	     digest_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	result = digest_job->result;
+#endif
+	if( result != 1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,137 @@
+/*
+ * Digest pool functions
+ *
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_POOL_H )
+#define _DIGEST_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "digest_hash.h"
+#include "fsapfstools_libcerror.h"
+#include "fsapfstools_libcthreads.h"
+#include "fsapfstools_libfsapfs.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define DIGEST_POOL_DEFAULT_NUMBER_OF_THREADS	4
+#define DIGEST_POOL_MAXIMUM_NUMBER_OF_THREADS	64
+
+/* The size of the buffer used by a job to read the data of a file entry
+ */
+#define DIGEST_POOL_READ_BUFFER_SIZE		65536
+
+typedef struct digest_job digest_job_t;
+
+struct digest_job
+{
+	/* The volume that contains the file entry
+	 */
+	libfsapfs_volume_t *volume;
+
+	/* The file entry identifier
+	 */
+	uint64_t file_entry_identifier;
+
+	/* The digest hash type
+	 */
+	int digest_hash_type;
+
+	/* The digest hash string
+	 */
+	char digest_hash_string[ DIGEST_HASH_MAXIMUM_STRING_SIZE ];
+
+	/* The result, which is -1 if the digest hash could not be calculated
+	 */
+	int result;
+
+	/* The error, which is set when the digest hash could not be calculated
+	 */
+	libcerror_error_t *error;
+
+	/* Value to indicate the job was completed
+	 */
+	uint8_t is_completed;
+};
+
+typedef struct digest_pool digest_pool_t;
+
+struct digest_pool
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a job was completed
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int digest_job_calculate(
+     digest_job_t *digest_job,
+     libcerror_error_t **error );
+
+int digest_pool_initialize(
+     digest_pool_t **digest_pool,
+     int number_of_threads,
+     int maximum_number_of_jobs,
+     libcerror_error_t **error );
+
+int digest_pool_free(
+     digest_pool_t **digest_pool,
+     libcerror_error_t **error );
+
+int digest_pool_calculate_job(
+     digest_job_t *digest_job,
+     digest_pool_t *digest_pool );
+
+int digest_pool_push_job(
+     digest_pool_t *digest_pool,
+     digest_job_t *digest_job,
+     libfsapfs_volume_t *volume,
+     uint64_t file_entry_identifier,
+     int digest_hash_type,
+     libcerror_error_t **error );
+
+int digest_pool_wait_for_job(
+     digest_pool_t *digest_pool,
+     digest_job_t *digest_job,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_POOL_H ) */
+
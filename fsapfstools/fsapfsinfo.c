@@ -67,14 +67,17 @@ void usage_fprint(
 	fprintf( stream, "Use fsapfsinfo to determine information about an Apple\n"
 	                 " File System (APFS).\n\n" );
 
-	fprintf( stream, "Usage: fsapfsinfo [ -B bodyfile ] [ -E identifier ]\n"
+	fprintf( stream, "Usage: fsapfsinfo [ -B bodyfile ] [ -d type ] [ -E identifier ]\n"
 	                 "                  [ -f file_system_index ] [ -F path ]\n"
 	                 "                  [ -o offset ] [ -p password ]\n"
-	                 "                  [ -r password ] [ -hHvV ] source\n\n" );
+	                 "                  [ -r password ] [ -t threads ] [ -hHSvV ]\n"
+	                 "                  source\n\n" );
 
 	fprintf( stream, "\tsource: the source file or device\n\n" );
 
 	fprintf( stream, "\t-B:     output file system information as a bodyfile\n" );
+	fprintf( stream, "\t-d:     calculate a digest hash of the data of the file entries\n"
+	                 "\t        to include in the bodyfile, options: md5, sha1, sha256\n" );
 	fprintf( stream, "\t-E:     show information about a specific file system entry or \"all\"\n" );
 	fprintf( stream, "\t-f:     show information about a specific file system or \"all\"\n" );
 	fprintf( stream, "\t-F:     show information about a specific file entry path\n" );
@@ -83,6 +86,11 @@ void usage_fprint(
 	fprintf( stream, "\t-o:     specify the volume offset\n" );
 	fprintf( stream, "\t-p:     specify the password\n" );
 	fprintf( stream, "\t-r:     specify the recovery password\n" );
+	fprintf( stream, "\t-S:     use a single pass scan of the file system metadata\n"
+	                 "\t        to show the file system hierarchy, this is faster but\n"
+	                 "\t        the entries are not in directory order\n" );
+	fprintf( stream, "\t-t:     specify the number of threads used to calculate digest\n"
+	                 "\t        hashes (default is 4)\n" );
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
 	fprintf( stream, "\t-V:     print version\n" );
 }
@@ -141,9 +149,11 @@ int main( int argc, char * const argv[] )
 {
 	libfsapfs_error_t *error                         = NULL;
 	system_character_t *option_bodyfile              = NULL;
+	system_character_t *option_digest_hash_type      = NULL;
 	system_character_t *option_file_entry_identifier = NULL;
 	system_character_t *option_file_entry_path       = NULL;
 	system_character_t *option_file_system_index     = NULL;
+	system_character_t *option_number_of_threads     = NULL;
 	system_character_t *option_password              = NULL;
 	system_character_t *option_recovery_password     = NULL;
 	system_character_t *option_volume_offset         = NULL;
@@ -153,6 +163,8 @@ int main( int argc, char * const argv[] )
 	size_t string_length                             = 0;
 	uint64_t file_entry_identifier                   = 0;
 	int option_mode                                  = FSAPFSINFO_MODE_CONTAINER;
+	int result                                       = 0;
+	int use_scan                                     = 0;
 	int verbose                                      = 0;
 
 	libcnotify_stream_set(
@@ -188,7 +200,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = fsapfstools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "B:E:f:F:hHo:p:r:vV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "B:d:E:f:F:hHo:p:r:St:vV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -209,6 +221,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'd':
+				option_digest_hash_type = optarg;
+
+				break;
+
 			case (system_integer_t) 'E':
 				option_mode                  = FSAPFSINFO_MODE_FILE_ENTRY_BY_IDENTIFIER;
 				option_file_entry_identifier = optarg;
@@ -252,6 +269,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'S':
+				use_scan = 1;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -295,6 +322,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	fsapfsinfo_info_handle->use_scan = (uint8_t) use_scan;
+
 	if( option_bodyfile != NULL )
 	{
 		if( info_handle_set_bodyfile(
@@ -309,6 +338,44 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_digest_hash_type != NULL )
+	{
+		result = info_handle_set_digest_hash_type(
+		          fsapfsinfo_info_handle,
+		          option_digest_hash_type,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set digest hash type.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported digest hash type.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		if( info_handle_set_number_of_digest_threads(
+		     fsapfsinfo_info_handle,
+		     option_number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_file_system_index != NULL )
 	{
 		if( info_handle_set_file_system_index(
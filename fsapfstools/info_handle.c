@@ -27,6 +27,12 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "digest_hash.h"
+#include "digest_pool.h"
 #include "fsapfstools_libbfio.h"
 #include "fsapfstools_libcerror.h"
 #include "fsapfstools_libclocale.h"
@@ -35,6 +41,7 @@
 #include "fsapfstools_libfdatetime.h"
 #include "fsapfstools_libfguid.h"
 #include "fsapfstools_libfsapfs.h"
+#include "fsapfstools_libuna.h"
 #include "info_handle.h"
 
 #if !defined( LIBFSAPFS_HAVE_BFIO )
@@ -50,6 +57,10 @@ int libfsapfs_container_open_file_io_handle(
 
 #define INFO_HANDLE_NOTIFY_STREAM	stdout
 
+/* The number of bodyfile entries that can be pending their digest hash per digest thread
+ */
+#define INFO_HANDLE_BODYFILE_ENTRIES_PER_DIGEST_THREAD	16
+
 /* Copies a string of a decimal value to a 64-bit value
  * Returns 1 if successful or -1 on error
  */
@@ -251,7 +262,8 @@ int info_handle_initialize(
 
 		goto on_error;
 	}
-	( *info_handle )->notify_stream = INFO_HANDLE_NOTIFY_STREAM;
+	( *info_handle )->number_of_digest_threads = DIGEST_POOL_DEFAULT_NUMBER_OF_THREADS;
+	( *info_handle )->notify_stream            = INFO_HANDLE_NOTIFY_STREAM;
 
 	return( 1 );
 
@@ -295,6 +307,45 @@ int info_handle_free(
 	}
 	if( *info_handle != NULL )
 	{
+		/* The digest jobs reference the volume, hence they need to complete
+		 * before the input container is freed
+		 */
+		if( ( *info_handle )->bodyfile_entries != NULL )
+		{
+			if( info_handle_bodyfile_entries_clear(
+			     *info_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to clear bodyfile entries.",
+				 function );
+
+				result = -1;
+			}
+			memory_free(
+			 ( *info_handle )->bodyfile_entries );
+
+			( *info_handle )->bodyfile_entries = NULL;
+		}
+		if( ( *info_handle )->digest_pool != NULL )
+		{
+			if( digest_pool_free(
+			     &( ( *info_handle )->digest_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest pool.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libfsapfs_container_free(
 		     &( ( *info_handle )->input_container ),
 		     error ) != 1 )
@@ -337,6 +388,22 @@ int info_handle_free(
 			}
 			( *info_handle )->bodyfile_stream = NULL;
 		}
+		if( ( *info_handle )->scan_entries != NULL )
+		{
+			if( info_handle_scan_entries_free(
+			     *info_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free scan entries.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( ( *info_handle )->recovery_password != NULL )
 		{
 			if( memory_set(
@@ -491,6 +558,170 @@ int info_handle_set_bodyfile(
 	return( 1 );
 }
 
+/* Sets the digest hash type
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int info_handle_set_digest_hash_type(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_digest_hash_type";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 3 )
+	{
+		if( system_string_compare_no_case(
+		     string,
+		     _SYSTEM_STRING( "md5" ),
+		     3 ) == 0 )
+		{
+			info_handle->digest_hash_type = DIGEST_HASH_TYPE_MD5;
+			result                        = 1;
+		}
+	}
+	else if( string_length == 4 )
+	{
+		if( system_string_compare_no_case(
+		     string,
+		     _SYSTEM_STRING( "sha1" ),
+		     4 ) == 0 )
+		{
+			info_handle->digest_hash_type = DIGEST_HASH_TYPE_SHA1;
+			result                        = 1;
+		}
+	}
+	else if( string_length == 5 )
+	{
+		if( system_string_compare_no_case(
+		     string,
+		     _SYSTEM_STRING( "sha-1" ),
+		     5 ) == 0 )
+		{
+			info_handle->digest_hash_type = DIGEST_HASH_TYPE_SHA1;
+			result                        = 1;
+		}
+	}
+	else if( string_length == 6 )
+	{
+		if( system_string_compare_no_case(
+		     string,
+		     _SYSTEM_STRING( "sha256" ),
+		     6 ) == 0 )
+		{
+			info_handle->digest_hash_type = DIGEST_HASH_TYPE_SHA256;
+			result                        = 1;
+		}
+	}
+	else if( string_length == 7 )
+	{
+		if( system_string_compare_no_case(
+		     string,
+		     _SYSTEM_STRING( "sha-256" ),
+		     7 ) == 0 )
+		{
+			info_handle->digest_hash_type = DIGEST_HASH_TYPE_SHA256;
+			result                        = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of threads used to calculate digest hashes
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_number_of_digest_threads(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_number_of_digest_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->digest_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid info handle - digest pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( fsapfstools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) DIGEST_POOL_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of digest threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	info_handle->number_of_digest_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
 /* Sets the file system index
  * Returns 1 if successful or -1 on error
  */
@@ -789,6 +1020,7 @@ int info_handle_open_input(
 {
 	static char *function  = "info_handle_open_input";
 	size_t filename_length = 0;
+	int access_flags       = LIBFSAPFS_OPEN_READ;
 
 	if( info_handle == NULL )
 	{
@@ -842,10 +1074,17 @@ int info_handle_open_input(
 
 		return( -1 );
 	}
+	/* The digest pool threads read file entry data concurrently
+	 * hence each reads through its own clone of the file IO handle
+	 */
+	if( info_handle->digest_hash_type != DIGEST_HASH_TYPE_NONE )
+	{
+		access_flags |= LIBFSAPFS_ACCESS_FLAG_CLONE_FILE_IO_HANDLE;
+	}
 	if( libfsapfs_container_open_file_io_handle(
 	     info_handle->input_container,
 	     info_handle->input_file_io_handle,
-	     LIBFSAPFS_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1288,660 +1527,1387 @@ on_error:
 	return( -1 );
 }
 
-/* Prints a file entry value
- * Returns 1 if successful, 0 if not or -1 on error
+/* Copies the file mode to a string
+ * The string is formatted similar to ls -l, for example "drwxr-xr-x"
+ * Returns 1 if successful or -1 on error
  */
-int info_handle_file_entry_value_fprint(
-     info_handle_t *info_handle,
-     libfsapfs_file_entry_t *file_entry,
-     const system_character_t *path,
+int info_handle_file_mode_copy_to_string(
+     uint16_t file_mode,
+     char *string,
+     size_t string_size,
      libcerror_error_t **error )
 {
-	system_character_t *file_entry_name = NULL;
-	static char *function               = "info_handle_file_entry_value_fprint";
-	size_t file_entry_name_size         = 0;
-	int result                          = 0;
+	static char *function = "info_handle_file_mode_copy_to_string";
 
-	if( info_handle == NULL )
+	if( string == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid info handle.",
+		 "%s: invalid string.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libfsapfs_file_entry_get_utf16_name_size(
-	          file_entry,
-	          &file_entry_name_size,
-	          error );
-#else
-	result = libfsapfs_file_entry_get_utf8_name_size(
-	          file_entry,
-	          &file_entry_name_size,
-	          error );
-#endif
-	if( result == -1 )
+	if( string_size < 11 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file entry name string size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid string size value too small.",
 		 function );
 
-		goto on_error;
-	}
-	if( ( result == 1 )
-	 && ( file_entry_name_size > 0 ) )
-	{
-		file_entry_name = system_string_allocate(
-		                   file_entry_name_size );
-
-		if( file_entry_name == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create file entry name string.",
-			 function );
-
-			goto on_error;
-		}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libfsapfs_file_entry_get_utf16_name(
-		          file_entry,
-		          (uint16_t *) file_entry_name,
-		          file_entry_name_size,
-		          error );
-#else
-		result = libfsapfs_file_entry_get_utf8_name(
-		          file_entry,
-		          (uint8_t *) file_entry_name,
-		          file_entry_name_size,
-		          error );
-#endif
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve file entry name string.",
-			 function );
-
-			goto on_error;
-		}
+		return( -1 );
 	}
-	if( info_handle_file_entry_value_with_name_fprint(
-	     info_handle,
-	     file_entry,
-	     path,
-	     file_entry_name,
-	     error ) != 1 )
+	if( memory_set(
+	     string,
+	     '-',
+	     10 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-		 "%s: unable to print file entry.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear string.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( file_entry_name != NULL )
+	string[ 10 ] = 0;
+
+	if( ( file_mode & 0x0001 ) != 0 )
 	{
-		memory_free(
-		 file_entry_name );
-
-		file_entry_name = NULL;
-	}
-	return( 1 );
-
-on_error:
-	if( file_entry_name != NULL )
-	{
-		memory_free(
-		 file_entry_name );
-	}
-	return( -1 );
-}
-
-/* Prints a file entry value with name
- * Returns 1 if successful, 0 if not or -1 on error
- */
-int info_handle_file_entry_value_with_name_fprint(
-     info_handle_t *info_handle,
-     libfsapfs_file_entry_t *file_entry,
-     const system_character_t *path,
-     const system_character_t *file_entry_name,
-     libcerror_error_t **error )
-{
-	char file_mode_string[ 11 ]                        = { '-', '-', '-', '-', '-', '-', '-', '-', '-', '-', 0 };
-
-	libfsapfs_extended_attribute_t *extended_attribute = NULL;
-	system_character_t *extended_attribute_name        = NULL;
-	system_character_t *symbolic_link_target           = NULL;
-	static char *function                              = "info_handle_file_entry_value_with_name_fprint";
-	size64_t size                                      = 0;
-	size_t extended_attribute_name_size                = 0;
-	size_t symbolic_link_target_size                   = 0;
-	uint64_t identifier                                = 0;
-	int64_t access_time                                = 0;
-	int64_t creation_time                              = 0;
-	int64_t inode_change_time                          = 0;
-	int64_t modification_time                          = 0;
-	uint32_t group_identifier                          = 0;
-	uint32_t owner_identifier                          = 0;
-	uint16_t file_mode                                 = 0;
-	int extended_attribute_index                       = 0;
-	int number_of_extended_attributes                  = 0;
-	int result                                         = 0;
-
-	if( info_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid info handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( libfsapfs_file_entry_get_identifier(
-	     file_entry,
-	     &identifier,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve identifier.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsapfs_file_entry_get_creation_time(
-	     file_entry,
-	     &creation_time,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve creation time.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsapfs_file_entry_get_modification_time(
-	     file_entry,
-	     &modification_time,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve modification time.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsapfs_file_entry_get_inode_change_time(
-	     file_entry,
-	     &inode_change_time,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve inode change time.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsapfs_file_entry_get_access_time(
-	     file_entry,
-	     &access_time,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve access time.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsapfs_file_entry_get_owner_identifier(
-	     file_entry,
-	     &owner_identifier,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve owner identifier.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsapfs_file_entry_get_group_identifier(
-	     file_entry,
-	     &group_identifier,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve group identifier.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsapfs_file_entry_get_file_mode(
-	     file_entry,
-	     &file_mode,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file mode.",
-		 function );
-
-		goto on_error;
-	}
-/* TODO move into function */
-	if( ( file_mode & 0x0001 ) != 0 )
-	{
-		file_mode_string[ 9 ] = 'x';
+		string[ 9 ] = 'x';
 	}
 	if( ( file_mode & 0x0002 ) != 0 )
 	{
-		file_mode_string[ 8 ] = 'w';
+		string[ 8 ] = 'w';
 	}
 	if( ( file_mode & 0x0004 ) != 0 )
 	{
-		file_mode_string[ 7 ] = 'r';
+		string[ 7 ] = 'r';
 	}
 	if( ( file_mode & 0x0008 ) != 0 )
 	{
-		file_mode_string[ 6 ] = 'x';
+		string[ 6 ] = 'x';
 	}
 	if( ( file_mode & 0x0010 ) != 0 )
 	{
-		file_mode_string[ 5 ] = 'w';
+		string[ 5 ] = 'w';
 	}
 	if( ( file_mode & 0x0020 ) != 0 )
 	{
-		file_mode_string[ 4 ] = 'r';
+		string[ 4 ] = 'r';
 	}
 	if( ( file_mode & 0x0040 ) != 0 )
 	{
-		file_mode_string[ 3 ] = 'x';
+		string[ 3 ] = 'x';
 	}
 	if( ( file_mode & 0x0080 ) != 0 )
 	{
-		file_mode_string[ 2 ] = 'w';
+		string[ 2 ] = 'w';
 	}
 	if( ( file_mode & 0x0100 ) != 0 )
 	{
-		file_mode_string[ 1 ] = 'r';
+		string[ 1 ] = 'r';
 	}
 	switch( file_mode & 0xf000 )
 	{
 		case 0x1000:
-			file_mode_string[ 0 ] = 'p';
+			string[ 0 ] = 'p';
 			break;
 
 		case 0x2000:
-			file_mode_string[ 0 ] = 'c';
+			string[ 0 ] = 'c';
 			break;
 
 		case 0x4000:
-			file_mode_string[ 0 ] = 'd';
+			string[ 0 ] = 'd';
 			break;
 
 		case 0x6000:
-			file_mode_string[ 0 ] = 'b';
+			string[ 0 ] = 'b';
 			break;
 
 		case 0xa000:
-			file_mode_string[ 0 ] = 'l';
+			string[ 0 ] = 'l';
 			break;
 
 		case 0xc000:
-			file_mode_string[ 0 ] = 's';
+			string[ 0 ] = 's';
 			break;
 
 		default:
 			break;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libfsapfs_file_entry_get_utf16_symbolic_link_target_size(
-	          file_entry,
-	          &symbolic_link_target_size,
-	          error );
-#else
-	result = libfsapfs_file_entry_get_utf8_symbolic_link_target_size(
-	          file_entry,
-	          &symbolic_link_target_size,
-	          error );
-#endif
-	if( result == -1 )
+	return( 1 );
+}
+
+/* Sets the volume of the file entries in the bodyfile
+ * The volume is used to calculate the digest hashes of the file entries
+ * and is only set when digest hashes are calculated
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_bodyfile_volume(
+     info_handle_t *info_handle,
+     libfsapfs_volume_t *volume,
+     libcerror_error_t **error )
+{
+	static char *function                  = "info_handle_set_bodyfile_volume";
+	size_t bodyfile_entries_size           = 0;
+	int maximum_number_of_bodyfile_entries = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( info_handle->bodyfile_stream == NULL )
+	 || ( info_handle->digest_hash_type == DIGEST_HASH_TYPE_NONE ) )
+	{
+		return( 1 );
+	}
+	if( info_handle->number_of_bodyfile_entries != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve symbolic link target string size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid info handle - bodyfile entries are pending.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	else if( result != 0 )
+	if( ( volume != NULL )
+	 && ( info_handle->bodyfile_entries == NULL ) )
 	{
-		symbolic_link_target = system_string_allocate(
-		                        symbolic_link_target_size );
+		if( ( info_handle->number_of_digest_threads <= 0 )
+		 || ( info_handle->number_of_digest_threads > DIGEST_POOL_MAXIMUM_NUMBER_OF_THREADS ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid info handle - number of digest threads value out of bounds.",
+			 function );
 
-		if( symbolic_link_target == NULL )
+			return( -1 );
+		}
+		maximum_number_of_bodyfile_entries = info_handle->number_of_digest_threads * INFO_HANDLE_BODYFILE_ENTRIES_PER_DIGEST_THREAD;
+
+		bodyfile_entries_size = sizeof( info_handle_bodyfile_entry_t ) * maximum_number_of_bodyfile_entries;
+
+		info_handle->bodyfile_entries = (info_handle_bodyfile_entry_t *) memory_allocate(
+		                                                                  bodyfile_entries_size );
+
+		if( info_handle->bodyfile_entries == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
 			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create symbolic link target string.",
+			 "%s: unable to create bodyfile entries.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     info_handle->bodyfile_entries,
+		     0,
+		     bodyfile_entries_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear bodyfile entries.",
 			 function );
 
 			goto on_error;
 		}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libfsapfs_file_entry_get_utf16_symbolic_link_target(
-		          file_entry,
-		          (uint16_t *) symbolic_link_target,
-		          symbolic_link_target_size,
-		          error );
-#else
-		result = libfsapfs_file_entry_get_utf8_symbolic_link_target(
-		          file_entry,
-		          (uint8_t *) symbolic_link_target,
-		          symbolic_link_target_size,
-		          error );
-#endif
-		if( result != 1 )
+		/* The queue of the digest pool can hold all the pending bodyfile entries
+		 * hence pushing a digest job does not block
+		 */
+		if( digest_pool_initialize(
+		     &( info_handle->digest_pool ),
+		     info_handle->number_of_digest_threads,
+		     maximum_number_of_bodyfile_entries,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve symbolic link target string.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest pool.",
 			 function );
 
 			goto on_error;
 		}
+		info_handle->maximum_number_of_bodyfile_entries = maximum_number_of_bodyfile_entries;
+		info_handle->first_bodyfile_entry_index         = 0;
 	}
-	if( libfsapfs_file_entry_get_size(
-	     file_entry,
-	     &size,
+	info_handle->bodyfile_volume = volume;
+
+	return( 1 );
+
+on_error:
+	if( info_handle->bodyfile_entries != NULL )
+	{
+		memory_free(
+		 info_handle->bodyfile_entries );
+
+		info_handle->bodyfile_entries = NULL;
+	}
+	return( -1 );
+}
+
+/* Prints a bodyfile entry
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_bodyfile_entry_fprint(
+     info_handle_t *info_handle,
+     info_handle_bodyfile_entry_t *bodyfile_entry,
+     const system_character_t *path,
+     const system_character_t *file_entry_name,
+     const char *digest_hash_string,
+     libcerror_error_t **error )
+{
+	char file_mode_string[ 11 ];
+
+	static char *function = "info_handle_bodyfile_entry_fprint";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->bodyfile_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid info handle - missing bodyfile stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( bodyfile_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bodyfile entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle_file_mode_copy_to_string(
+	     bodyfile_entry->file_mode,
+	     file_mode_string,
+	     11,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size.",
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy file mode to string.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( info_handle->bodyfile_stream != NULL )
+	/* Colums in a Sleuthkit 3.x and later bodyfile
+	 * MD5|name|inode|mode_as_string|UID|GID|size|atime|mtime|ctime|crtime
+	 */
+	if( digest_hash_string != NULL )
+	{
+		fprintf(
+		 info_handle->bodyfile_stream,
+		 "%s|",
+		 digest_hash_string );
+	}
+	else
 	{
-		/* Colums in a Sleuthkit 3.x and later bodyfile
-		 * MD5|name|inode|mode_as_string|UID|GID|size|atime|mtime|ctime|crtime
-		 */
 		fprintf(
 		 info_handle->bodyfile_stream,
 		 "0|" );
-
-		if( path != NULL )
-		{
-			fprintf(
-			 info_handle->bodyfile_stream,
-			 "%" PRIs_SYSTEM "",
-			 path );
-		}
-		if( ( file_entry_name != NULL )
-		 && ( identifier != 2 ) )
-		{
-			fprintf(
-			 info_handle->bodyfile_stream,
-			 "%" PRIs_SYSTEM "",
-			 file_entry_name );
-		}
+	}
+	if( path != NULL )
+	{
 		fprintf(
 		 info_handle->bodyfile_stream,
-		 "|%" PRIu64 "|%s|%" PRIu32 "|%" PRIu32 "|%" PRIu64 "|%.9f|%.9f|%.9f|%.9f\n",
-		 identifier,
-		 file_mode_string,
-		 owner_identifier,
-		 group_identifier,
-		 size,
-		 (double) access_time / 1000000000,
-		 (double) modification_time / 1000000000,
-		 (double) inode_change_time / 1000000000,
-		 (double) creation_time / 1000000000 );
+		 "%" PRIs_SYSTEM "",
+		 path );
 	}
-	else
+	if( file_entry_name != NULL )
 	{
 		fprintf(
-		 info_handle->notify_stream,
-		 "\tIdentifier\t\t: %" PRIu64 "\n",
-		 identifier );
+		 info_handle->bodyfile_stream,
+		 "%" PRIs_SYSTEM "",
+		 file_entry_name );
+	}
+	fprintf(
+	 info_handle->bodyfile_stream,
+	 "|%" PRIu64 "|%s|%" PRIu32 "|%" PRIu32 "|%" PRIu64 "|%.9f|%.9f|%.9f|%.9f\n",
+	 bodyfile_entry->identifier,
+	 file_mode_string,
+	 bodyfile_entry->owner_identifier,
+	 bodyfile_entry->group_identifier,
+	 bodyfile_entry->size,
+	 (double) bodyfile_entry->access_time / 1000000000,
+	 (double) bodyfile_entry->modification_time / 1000000000,
+	 (double) bodyfile_entry->inode_change_time / 1000000000,
+	 (double) bodyfile_entry->creation_time / 1000000000 );
 
-		if( file_entry_name != NULL )
-		{
-			fprintf(
-			 info_handle->notify_stream,
-			 "\tName\t\t\t: " );
+	return( 1 );
+}
 
-			if( path != NULL )
-			{
-				fprintf(
-				 info_handle->notify_stream,
-				 "%" PRIs_SYSTEM "",
-				 path );
-			}
-			fprintf(
-			 info_handle->notify_stream,
-			 "%" PRIs_SYSTEM "\n",
-			 file_entry_name );
-		}
-		fprintf(
-		 info_handle->notify_stream,
-		 "\tSize\t\t\t: %" PRIu64 "\n",
-		 size );
+/* Appends a bodyfile entry
+ * If digest hashes are calculated the bodyfile entry is printed after its digest hash
+ * has been calculated and the preceding bodyfile entries have been printed,
+ * otherwise the bodyfile entry is printed directly
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_bodyfile_entries_append(
+     info_handle_t *info_handle,
+     info_handle_bodyfile_entry_t *bodyfile_entry,
+     const system_character_t *path,
+     const system_character_t *file_entry_name,
+     libcerror_error_t **error )
+{
+	info_handle_bodyfile_entry_t *pending_bodyfile_entry = NULL;
+	static char *function                                = "info_handle_bodyfile_entries_append";
+	size_t file_entry_name_length                        = 0;
+	size_t path_length                                   = 0;
+	int bodyfile_entry_index                             = 0;
 
-		if( info_handle_posix_time_value_fprint(
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bodyfile_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bodyfile entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->bodyfile_volume == NULL )
+	{
+		if( info_handle_bodyfile_entry_fprint(
 		     info_handle,
-		     "\tCreation time\t\t",
-		     creation_time,
+		     bodyfile_entry,
+		     path,
+		     file_entry_name,
+		     NULL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print POSIX time value.",
+			 "%s: unable to print bodyfile entry.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( info_handle_posix_time_value_fprint(
+		return( 1 );
+	}
+	if( ( info_handle->bodyfile_entries == NULL )
+	 || ( info_handle->digest_pool == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid info handle - missing bodyfile entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->number_of_bodyfile_entries >= info_handle->maximum_number_of_bodyfile_entries )
+	{
+		if( info_handle_bodyfile_entries_fprint_first(
 		     info_handle,
-		     "\tModification time\t",
-		     modification_time,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print POSIX time value.",
+			 "%s: unable to print first pending bodyfile entry.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( info_handle_posix_time_value_fprint(
-		     info_handle,
-		     "\tInode change time\t",
-		     inode_change_time,
-		     error ) != 1 )
+	}
+	if( path != NULL )
+	{
+		path_length = system_string_length(
+		               path );
+	}
+	if( file_entry_name != NULL )
+	{
+		file_entry_name_length = system_string_length(
+		                          file_entry_name );
+	}
+	bodyfile_entry_index = ( info_handle->first_bodyfile_entry_index + info_handle->number_of_bodyfile_entries )
+	                     % info_handle->maximum_number_of_bodyfile_entries;
+
+	pending_bodyfile_entry = &( info_handle->bodyfile_entries[ bodyfile_entry_index ] );
+
+	if( memory_copy(
+	     pending_bodyfile_entry,
+	     bodyfile_entry,
+	     sizeof( info_handle_bodyfile_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy bodyfile entry.",
+		 function );
+
+		return( -1 );
+	}
+	pending_bodyfile_entry->path           = NULL;
+	pending_bodyfile_entry->has_digest_job = 0;
+
+	pending_bodyfile_entry->path = system_string_allocate(
+	                                path_length + file_entry_name_length + 1 );
+
+	if( pending_bodyfile_entry->path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > 0 )
+	{
+		if( system_string_copy(
+		     pending_bodyfile_entry->path,
+		     path,
+		     path_length ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print POSIX time value.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy path.",
 			 function );
 
 			goto on_error;
 		}
-		if( info_handle_posix_time_value_fprint(
-		     info_handle,
-		     "\tAccess time\t\t",
-		     access_time,
-		     error ) != 1 )
+	}
+	if( file_entry_name_length > 0 )
+	{
+		if( system_string_copy(
+		     &( pending_bodyfile_entry->path[ path_length ] ),
+		     file_entry_name,
+		     file_entry_name_length ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print POSIX time value.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy file entry name.",
 			 function );
 
 			goto on_error;
 		}
-		fprintf(
-		 info_handle->notify_stream,
-		 "\tOwner identifier\t: %" PRIu32 "\n",
-		 owner_identifier );
-
-		fprintf(
-		 info_handle->notify_stream,
-		 "\tGroup identifier\t: %" PRIu32 "\n",
-		 group_identifier );
+	}
+	pending_bodyfile_entry->path[ path_length + file_entry_name_length ] = 0;
 
-		fprintf(
-		 info_handle->notify_stream,
-		 "\tFile mode\t\t: %s (%07" PRIo16 ")\n",
-		 file_mode_string,
-		 file_mode );
+	info_handle->number_of_bodyfile_entries += 1;
 
-		if( symbolic_link_target != NULL )
-		{
-			fprintf(
-			 info_handle->notify_stream,
-			 "\tSymbolic link target\t: %" PRIs_SYSTEM "\n",
-			 symbolic_link_target );
-		}
-		if( libfsapfs_file_entry_get_number_of_extended_attributes(
-		     file_entry,
-		     &number_of_extended_attributes,
+	/* Only the data of regular files is hashed
+	 */
+	if( ( bodyfile_entry->file_mode & 0xf000 ) == 0x8000 )
+	{
+		if( digest_pool_push_job(
+		     info_handle->digest_pool,
+		     &( pending_bodyfile_entry->digest_job ),
+		     info_handle->bodyfile_volume,
+		     bodyfile_entry->identifier,
+		     info_handle->digest_hash_type,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of extended attributes.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push digest job.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( number_of_extended_attributes > 0 )
-		{
-			fprintf(
-			 info_handle->notify_stream,
-			 "\tExtended attributes:\n" );
-
-			for( extended_attribute_index = 0;
-			     extended_attribute_index < number_of_extended_attributes;
-			     extended_attribute_index++ )
+		pending_bodyfile_entry->has_digest_job = 1;
+	}
+	return( 1 );
+
+on_error:
+	if( pending_bodyfile_entry->path != NULL )
+	{
+		memory_free(
+		 pending_bodyfile_entry->path );
+
+		pending_bodyfile_entry->path = NULL;
+	}
+	return( -1 );
+}
+
+/* Prints the first pending bodyfile entry
+ * This waits for the digest hash of the bodyfile entry to be calculated
+ * Returns 1 if successful, 0 if there are no pending bodyfile entries or -1 on error
+ */
+int info_handle_bodyfile_entries_fprint_first(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	info_handle_bodyfile_entry_t *pending_bodyfile_entry = NULL;
+	const char *digest_hash_string                       = NULL;
+	static char *function                                = "info_handle_bodyfile_entries_fprint_first";
+	int result                                           = 1;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->number_of_bodyfile_entries <= 0 )
+	{
+		return( 0 );
+	}
+	pending_bodyfile_entry = &( info_handle->bodyfile_entries[ info_handle->first_bodyfile_entry_index ] );
+
+	if( pending_bodyfile_entry->has_digest_job != 0 )
+	{
+		result = digest_pool_wait_for_job(
+		          info_handle->digest_pool,
+		          &( pending_bodyfile_entry->digest_job ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve digest hash of file entry: %" PRIu64 ".",
+			 function,
+			 pending_bodyfile_entry->identifier );
+		}
+		else if( result == 0 )
+		{
+			/* A file entry of which the data cannot be read should not stop the bodyfile
+			 * hence the digest hash column is set to 0 and a warning is printed instead
+			 */
+			fprintf(
+			 info_handle->notify_stream,
+			 "Unable to calculate digest hash of file entry: %" PRIu64 ".\n",
+			 pending_bodyfile_entry->identifier );
+
+			if( pending_bodyfile_entry->digest_job.error != NULL )
 			{
-				if( libfsapfs_file_entry_get_extended_attribute_by_index(
-				     file_entry,
-				     extended_attribute_index,
-				     &extended_attribute,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve extended attribute: %d.",
-					 function,
-					 extended_attribute_index );
+				libcerror_error_backtrace_fprint(
+				 pending_bodyfile_entry->digest_job.error,
+				 info_handle->notify_stream );
 
-					goto on_error;
-				}
+				libcerror_error_free(
+				 &( pending_bodyfile_entry->digest_job.error ) );
+			}
+			result = 1;
+		}
+		else
+		{
+			digest_hash_string = pending_bodyfile_entry->digest_job.digest_hash_string;
+		}
+	}
+	if( result == 1 )
+	{
+		if( info_handle_bodyfile_entry_fprint(
+		     info_handle,
+		     pending_bodyfile_entry,
+		     pending_bodyfile_entry->path,
+		     NULL,
+		     digest_hash_string,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print bodyfile entry.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* The bodyfile entry is removed regardless of the result
+	 * to keep the pending bodyfile entries consistent
+	 */
+	if( pending_bodyfile_entry->path != NULL )
+	{
+		memory_free(
+		 pending_bodyfile_entry->path );
+
+		pending_bodyfile_entry->path = NULL;
+	}
+	pending_bodyfile_entry->has_digest_job = 0;
+
+	info_handle->first_bodyfile_entry_index = ( info_handle->first_bodyfile_entry_index + 1 )
+	                                        % info_handle->maximum_number_of_bodyfile_entries;
+	info_handle->number_of_bodyfile_entries -= 1;
+
+	return( result );
+}
+
+/* Prints the pending bodyfile entries
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_bodyfile_entries_flush(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_bodyfile_entries_flush";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( info_handle->number_of_bodyfile_entries > 0 )
+	{
+		if( info_handle_bodyfile_entries_fprint_first(
+		     info_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print first pending bodyfile entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Clears the pending bodyfile entries without printing them
+ * This waits for the digest jobs of the bodyfile entries to complete
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_bodyfile_entries_clear(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	info_handle_bodyfile_entry_t *pending_bodyfile_entry = NULL;
+	static char *function                                = "info_handle_bodyfile_entries_clear";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( info_handle->number_of_bodyfile_entries > 0 )
+	{
+		pending_bodyfile_entry = &( info_handle->bodyfile_entries[ info_handle->first_bodyfile_entry_index ] );
+
+		/* The result of the digest job is irrelevant here, only that it has completed
+		 */
+		if( pending_bodyfile_entry->has_digest_job != 0 )
+		{
+			digest_pool_wait_for_job(
+			 info_handle->digest_pool,
+			 &( pending_bodyfile_entry->digest_job ),
+			 NULL );
+
+			if( pending_bodyfile_entry->digest_job.error != NULL )
+			{
+				libcerror_error_free(
+				 &( pending_bodyfile_entry->digest_job.error ) );
+			}
+			pending_bodyfile_entry->has_digest_job = 0;
+		}
+		if( pending_bodyfile_entry->path != NULL )
+		{
+			memory_free(
+			 pending_bodyfile_entry->path );
+
+			pending_bodyfile_entry->path = NULL;
+		}
+		info_handle->first_bodyfile_entry_index = ( info_handle->first_bodyfile_entry_index + 1 )
+		                                        % info_handle->maximum_number_of_bodyfile_entries;
+		info_handle->number_of_bodyfile_entries -= 1;
+	}
+	info_handle->first_bodyfile_entry_index = 0;
+
+	return( 1 );
+}
+
+/* Prints a file entry value
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int info_handle_file_entry_value_fprint(
+     info_handle_t *info_handle,
+     libfsapfs_file_entry_t *file_entry,
+     const system_character_t *path,
+     libcerror_error_t **error )
+{
+	system_character_t *file_entry_name = NULL;
+	static char *function               = "info_handle_file_entry_value_fprint";
+	size_t file_entry_name_size         = 0;
+	int result                          = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-				result = libfsapfs_extended_attribute_get_utf16_name_size(
-				          extended_attribute,
-				          &extended_attribute_name_size,
-				          error );
+	result = libfsapfs_file_entry_get_utf16_name_size(
+	          file_entry,
+	          &file_entry_name_size,
+	          error );
 #else
-				result = libfsapfs_extended_attribute_get_utf8_name_size(
-				          extended_attribute,
-				          &extended_attribute_name_size,
-				          error );
+	result = libfsapfs_file_entry_get_utf8_name_size(
+	          file_entry,
+	          &file_entry_name_size,
+	          error );
 #endif
-				if( result == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve extended attribute name string size.",
-					 function );
-
-					goto on_error;
-				}
-				fprintf(
-				 info_handle->notify_stream,
-				 "\t\tAttribute: %d\t: ",
-				 extended_attribute_index + 1 );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry name string size.",
+		 function );
 
-				if( ( result == 1 )
-				 && ( extended_attribute_name_size > 0 ) )
-				{
-					extended_attribute_name = system_string_allocate(
-					                           extended_attribute_name_size );
+		goto on_error;
+	}
+	if( ( result == 1 )
+	 && ( file_entry_name_size > 0 ) )
+	{
+		file_entry_name = system_string_allocate(
+		                   file_entry_name_size );
 
-					if( extended_attribute_name == NULL )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_MEMORY,
-						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-						 "%s: unable to create extended attribute name string.",
-						 function );
+		if( file_entry_name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create file entry name string.",
+			 function );
 
-						goto on_error;
-					}
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libfsapfs_file_entry_get_utf16_name(
+		          file_entry,
+		          (uint16_t *) file_entry_name,
+		          file_entry_name_size,
+		          error );
+#else
+		result = libfsapfs_file_entry_get_utf8_name(
+		          file_entry,
+		          (uint8_t *) file_entry_name,
+		          file_entry_name_size,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file entry name string.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( info_handle_file_entry_value_with_name_fprint(
+	     info_handle,
+	     file_entry,
+	     path,
+	     file_entry_name,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_entry_name != NULL )
+	{
+		memory_free(
+		 file_entry_name );
+
+		file_entry_name = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( file_entry_name != NULL )
+	{
+		memory_free(
+		 file_entry_name );
+	}
+	return( -1 );
+}
+
+/* Prints a file entry value with name
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int info_handle_file_entry_value_with_name_fprint(
+     info_handle_t *info_handle,
+     libfsapfs_file_entry_t *file_entry,
+     const system_character_t *path,
+     const system_character_t *file_entry_name,
+     libcerror_error_t **error )
+{
+	char file_mode_string[ 11 ];
+
+	info_handle_bodyfile_entry_t bodyfile_entry;
+
+	libfsapfs_extended_attribute_t *extended_attribute = NULL;
+	system_character_t *extended_attribute_name        = NULL;
+	system_character_t *symbolic_link_target           = NULL;
+	static char *function                              = "info_handle_file_entry_value_with_name_fprint";
+	size64_t size                                      = 0;
+	size_t extended_attribute_name_size                = 0;
+	size_t symbolic_link_target_size                   = 0;
+	uint64_t identifier                                = 0;
+	int64_t access_time                                = 0;
+	int64_t creation_time                              = 0;
+	int64_t inode_change_time                          = 0;
+	int64_t modification_time                          = 0;
+	uint32_t group_identifier                          = 0;
+	uint32_t owner_identifier                          = 0;
+	uint16_t file_mode                                 = 0;
+	int extended_attribute_index                       = 0;
+	int number_of_extended_attributes                  = 0;
+	int result                                         = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &bodyfile_entry,
+	     0,
+	     sizeof( info_handle_bodyfile_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear bodyfile entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_identifier(
+	     file_entry,
+	     &identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_entry_get_creation_time(
+	     file_entry,
+	     &creation_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve creation time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_entry_get_modification_time(
+	     file_entry,
+	     &modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_entry_get_inode_change_time(
+	     file_entry,
+	     &inode_change_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve inode change time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_entry_get_access_time(
+	     file_entry,
+	     &access_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve access time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_entry_get_owner_identifier(
+	     file_entry,
+	     &owner_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve owner identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_entry_get_group_identifier(
+	     file_entry,
+	     &group_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve group identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_entry_get_file_mode(
+	     file_entry,
+	     &file_mode,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file mode.",
+		 function );
+
+		goto on_error;
+	}
+	if( info_handle_file_mode_copy_to_string(
+	     file_mode,
+	     file_mode_string,
+	     11,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy file mode to string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfsapfs_file_entry_get_utf16_symbolic_link_target_size(
+	          file_entry,
+	          &symbolic_link_target_size,
+	          error );
+#else
+	result = libfsapfs_file_entry_get_utf8_symbolic_link_target_size(
+	          file_entry,
+	          &symbolic_link_target_size,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve symbolic link target string size.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		symbolic_link_target = system_string_allocate(
+		                        symbolic_link_target_size );
+
+		if( symbolic_link_target == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create symbolic link target string.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libfsapfs_file_entry_get_utf16_symbolic_link_target(
+		          file_entry,
+		          (uint16_t *) symbolic_link_target,
+		          symbolic_link_target_size,
+		          error );
+#else
+		result = libfsapfs_file_entry_get_utf8_symbolic_link_target(
+		          file_entry,
+		          (uint8_t *) symbolic_link_target,
+		          symbolic_link_target_size,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve symbolic link target string.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfsapfs_file_entry_get_size(
+	     file_entry,
+	     &size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size.",
+		 function );
+
+		goto on_error;
+	}
+	if( info_handle->bodyfile_stream != NULL )
+	{
+		bodyfile_entry.identifier        = identifier;
+		bodyfile_entry.creation_time     = creation_time;
+		bodyfile_entry.modification_time = modification_time;
+		bodyfile_entry.inode_change_time = inode_change_time;
+		bodyfile_entry.access_time       = access_time;
+		bodyfile_entry.size              = size;
+		bodyfile_entry.owner_identifier  = owner_identifier;
+		bodyfile_entry.group_identifier  = group_identifier;
+		bodyfile_entry.file_mode         = file_mode;
+
+		if( info_handle_bodyfile_entries_append(
+		     info_handle,
+		     &bodyfile_entry,
+		     path,
+		     ( identifier != 2 ) ? file_entry_name : NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append bodyfile entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tIdentifier\t\t: %" PRIu64 "\n",
+		 identifier );
+
+		if( file_entry_name != NULL )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tName\t\t\t: " );
+
+			if( path != NULL )
+			{
+				fprintf(
+				 info_handle->notify_stream,
+				 "%" PRIs_SYSTEM "",
+				 path );
+			}
+			fprintf(
+			 info_handle->notify_stream,
+			 "%" PRIs_SYSTEM "\n",
+			 file_entry_name );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tSize\t\t\t: %" PRIu64 "\n",
+		 size );
+
+		if( info_handle_posix_time_value_fprint(
+		     info_handle,
+		     "\tCreation time\t\t",
+		     creation_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print POSIX time value.",
+			 function );
+
+			goto on_error;
+		}
+		if( info_handle_posix_time_value_fprint(
+		     info_handle,
+		     "\tModification time\t",
+		     modification_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print POSIX time value.",
+			 function );
+
+			goto on_error;
+		}
+		if( info_handle_posix_time_value_fprint(
+		     info_handle,
+		     "\tInode change time\t",
+		     inode_change_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print POSIX time value.",
+			 function );
+
+			goto on_error;
+		}
+		if( info_handle_posix_time_value_fprint(
+		     info_handle,
+		     "\tAccess time\t\t",
+		     access_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print POSIX time value.",
+			 function );
+
+			goto on_error;
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tOwner identifier\t: %" PRIu32 "\n",
+		 owner_identifier );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tGroup identifier\t: %" PRIu32 "\n",
+		 group_identifier );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tFile mode\t\t: %s (%07" PRIo16 ")\n",
+		 file_mode_string,
+		 file_mode );
+
+		if( symbolic_link_target != NULL )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tSymbolic link target\t: %" PRIs_SYSTEM "\n",
+			 symbolic_link_target );
+		}
+		if( libfsapfs_file_entry_get_number_of_extended_attributes(
+		     file_entry,
+		     &number_of_extended_attributes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of extended attributes.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_extended_attributes > 0 )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "\tExtended attributes:\n" );
+
+			for( extended_attribute_index = 0;
+			     extended_attribute_index < number_of_extended_attributes;
+			     extended_attribute_index++ )
+			{
+				if( libfsapfs_file_entry_get_extended_attribute_by_index(
+				     file_entry,
+				     extended_attribute_index,
+				     &extended_attribute,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve extended attribute: %d.",
+					 function,
+					 extended_attribute_index );
+
+					goto on_error;
+				}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+				result = libfsapfs_extended_attribute_get_utf16_name_size(
+				          extended_attribute,
+				          &extended_attribute_name_size,
+				          error );
+#else
+				result = libfsapfs_extended_attribute_get_utf8_name_size(
+				          extended_attribute,
+				          &extended_attribute_name_size,
+				          error );
+#endif
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve extended attribute name string size.",
+					 function );
+
+					goto on_error;
+				}
+				fprintf(
+				 info_handle->notify_stream,
+				 "\t\tAttribute: %d\t: ",
+				 extended_attribute_index + 1 );
+
+				if( ( result == 1 )
+				 && ( extended_attribute_name_size > 0 ) )
+				{
+					extended_attribute_name = system_string_allocate(
+					                           extended_attribute_name_size );
+
+					if( extended_attribute_name == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to create extended attribute name string.",
+						 function );
+
+						goto on_error;
+					}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 					result = libfsapfs_extended_attribute_get_utf16_name(
 					          extended_attribute,
@@ -1949,103 +2915,1017 @@ int info_handle_file_entry_value_with_name_fprint(
 					          extended_attribute_name_size,
 					          error );
 #else
-					result = libfsapfs_extended_attribute_get_utf8_name(
-					          extended_attribute,
-					          (uint8_t *) extended_attribute_name,
-					          extended_attribute_name_size,
-					          error );
+					result = libfsapfs_extended_attribute_get_utf8_name(
+					          extended_attribute,
+					          (uint8_t *) extended_attribute_name,
+					          extended_attribute_name_size,
+					          error );
+#endif
+					if( result != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve extended attribute name string.",
+						 function );
+
+						goto on_error;
+					}
+					fprintf(
+					 info_handle->notify_stream,
+					 "%" PRIs_SYSTEM "",
+					 extended_attribute_name );
+
+					memory_free(
+					 extended_attribute_name );
+
+					extended_attribute_name = NULL;
+				}
+				fprintf(
+				 info_handle->notify_stream,
+				 "\n" );
+
+				if( libfsapfs_extended_attribute_free(
+				     &extended_attribute,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free extended attribute: %d.",
+					 function,
+					 extended_attribute_index );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	if( symbolic_link_target != NULL )
+	{
+		memory_free(
+		 symbolic_link_target );
+
+		symbolic_link_target = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( extended_attribute_name != NULL )
+	{
+		memory_free(
+		 extended_attribute_name );
+	}
+	if( extended_attribute != NULL )
+	{
+		libfsapfs_extended_attribute_free(
+		 &extended_attribute,
+		 NULL );
+	}
+	if( symbolic_link_target != NULL )
+	{
+		memory_free(
+		 symbolic_link_target );
+	}
+	return( -1 );
+}
+
+/* Prints file entry information as part of the file system hierarchy
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_file_system_hierarchy_fprint_file_entry(
+     info_handle_t *info_handle,
+     libfsapfs_file_entry_t *file_entry,
+     const system_character_t *path,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_entry_t *sub_file_entry = NULL;
+	system_character_t *file_entry_name    = NULL;
+	system_character_t *sub_path           = NULL;
+	static char *function                  = "info_handle_file_system_hierarchy_fprint_file_entry";
+	size_t file_entry_name_size            = 0;
+	size_t path_length                     = 0;
+	size_t sub_path_size                   = 0;
+	uint64_t identifier                    = 0;
+	int number_of_sub_file_entries         = 0;
+	int result                             = 0;
+	int sub_file_entry_index               = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_identifier(
+	     file_entry,
+	     &identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_entry_get_number_of_sub_file_entries(
+	     file_entry,
+	     &number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub file entries.",
+		 function );
+
+		goto on_error;
+	}
+	path_length = system_string_length(
+	               path );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfsapfs_file_entry_get_utf16_name_size(
+	          file_entry,
+	          &file_entry_name_size,
+	          error );
+#else
+	result = libfsapfs_file_entry_get_utf8_name_size(
+	          file_entry,
+	          &file_entry_name_size,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry name string size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( result == 1 )
+	 && ( file_entry_name_size > 0 ) )
+	{
+		file_entry_name = system_string_allocate(
+		                   file_entry_name_size );
+
+		if( file_entry_name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create file entry name string.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libfsapfs_file_entry_get_utf16_name(
+		          file_entry,
+		          (uint16_t *) file_entry_name,
+		          file_entry_name_size,
+		          error );
+#else
+		result = libfsapfs_file_entry_get_utf8_name(
+		          file_entry,
+		          (uint8_t *) file_entry_name,
+		          file_entry_name_size,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file entry name string.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( info_handle->bodyfile_stream != NULL )
+	{
+		if( info_handle_file_entry_value_with_name_fprint(
+		     info_handle,
+		     file_entry,
+		     path,
+		     file_entry_name,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print file entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "%" PRIs_SYSTEM "",
+		 path );
+
+		if( ( file_entry_name != NULL )
+		 && ( identifier != 2 ) )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "%" PRIs_SYSTEM "",
+			 file_entry_name );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+	}
+	if( number_of_sub_file_entries > 0 )
+	{
+		sub_path_size = path_length + 1;
+
+		if( ( file_entry_name != NULL )
+		 && ( identifier != 2 ) )
+		{
+			sub_path_size += file_entry_name_size;
+		}
+		sub_path = system_string_allocate(
+		            sub_path_size );
+
+		if( sub_path == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sub path.",
+			 function );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     sub_path,
+		     path,
+		     path_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy path to sub path.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( file_entry_name != NULL )
+		 && ( identifier != 2 ) )
+		{
+			if( system_string_copy(
+			     &( sub_path[ path_length ] ),
+			     file_entry_name,
+			     file_entry_name_size - 1 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy file entry name to sub path.",
+				 function );
+
+				goto on_error;
+			}
+			sub_path[ sub_path_size - 2 ] = (system_character_t) LIBFSAPFS_SEPARATOR;
+		}
+		sub_path[ sub_path_size - 1 ] = (system_character_t) 0;
+
+		for( sub_file_entry_index = 0;
+		     sub_file_entry_index < number_of_sub_file_entries;
+		     sub_file_entry_index++ )
+		{
+			if( libfsapfs_file_entry_get_sub_file_entry_by_index(
+			     file_entry,
+			     sub_file_entry_index,
+			     &sub_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub file entry: %d.",
+				 function,
+				 sub_file_entry_index );
+
+				goto on_error;
+			}
+			if( info_handle_file_system_hierarchy_fprint_file_entry(
+			     info_handle,
+			     sub_file_entry,
+			     sub_path,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print file entry: %d information.",
+				 function,
+				 sub_file_entry_index );
+
+				goto on_error;
+			}
+			if( libfsapfs_file_entry_free(
+			     &sub_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub file entry: %d.",
+				 function,
+				 sub_file_entry_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( sub_path != NULL )
+	{
+		memory_free(
+		 sub_path );
+
+		sub_path = NULL;
+	}
+	if( file_entry_name != NULL )
+	{
+		memory_free(
+		 file_entry_name );
+
+		file_entry_name = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( sub_file_entry != NULL )
+	{
+		libfsapfs_file_entry_free(
+		 &sub_file_entry,
+		 NULL );
+	}
+	if( sub_path != NULL )
+	{
+		memory_free(
+		 sub_path );
+	}
+	if( file_entry_name != NULL )
+	{
+		memory_free(
+		 file_entry_name );
+	}
+	return( -1 );
+}
+
+/* Frees the scan entries and scan names
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_scan_entries_free(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_scan_entries_free";
+	int name_index        = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->scan_entries != NULL )
+	{
+		memory_free(
+		 info_handle->scan_entries );
+
+		info_handle->scan_entries = NULL;
+	}
+	info_handle->number_of_scan_entries           = 0;
+	info_handle->number_of_allocated_scan_entries = 0;
+
+	if( info_handle->scan_names != NULL )
+	{
+		for( name_index = 0;
+		     name_index < info_handle->number_of_scan_names;
+		     name_index++ )
+		{
+			if( info_handle->scan_names[ name_index ].name != NULL )
+			{
+				memory_free(
+				 info_handle->scan_names[ name_index ].name );
+			}
+		}
+		memory_free(
+		 info_handle->scan_names );
+
+		info_handle->scan_names = NULL;
+	}
+	info_handle->number_of_scan_names           = 0;
+	info_handle->number_of_allocated_scan_names = 0;
+
+	return( 1 );
+}
+
+/* Adds the file entry of an inode record to the scan entries and the name
+ * of a directory record to the scan names
+ * Callback function for libfsapfs_volume_scan
+ * Returns 1 to continue, 0 to stop (when abort was signalled) or -1 on error
+ */
+int info_handle_scan_record_callback(
+     const libfsapfs_scan_record_t *scan_record,
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	info_handle_t *info_handle = NULL;
+	static char *function      = "info_handle_scan_record_callback";
+
+	if( scan_record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan record.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback data.",
+		 function );
+
+		return( -1 );
+	}
+	info_handle = (info_handle_t *) callback_data;
+
+	if( info_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	if( ( scan_record->record_type == LIBFSAPFS_RECORD_TYPE_INODE )
+	 && ( scan_record->file_entry != NULL ) )
+	{
+		if( info_handle_scan_entries_append_file_entry(
+		     info_handle,
+		     scan_record->file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append scan entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( ( scan_record->record_type == LIBFSAPFS_RECORD_TYPE_DIRECTORY_RECORD )
+	      && ( scan_record->directory_record != NULL ) )
+	{
+		if( info_handle_scan_names_append_directory_record(
+		     info_handle,
+		     scan_record->directory_record,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append scan name.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Appends the file entry of an inode record to the scan entries
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_scan_entries_append_file_entry(
+     info_handle_t *info_handle,
+     libfsapfs_file_entry_t *file_entry,
+     libcerror_error_t **error )
+{
+	info_handle_scan_entry_t *scan_entry   = NULL;
+	info_handle_scan_entry_t *scan_entries = NULL;
+	static char *function                  = "info_handle_scan_entries_append_file_entry";
+	int number_of_allocated_scan_entries   = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->number_of_scan_entries >= info_handle->number_of_allocated_scan_entries )
+	{
+		if( info_handle->number_of_allocated_scan_entries == 0 )
+		{
+			number_of_allocated_scan_entries = 1024;
+		}
+		else if( info_handle->number_of_allocated_scan_entries <= ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_scan_entries = info_handle->number_of_allocated_scan_entries * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of scan entries value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( (size_t) number_of_allocated_scan_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( info_handle_scan_entry_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated scan entries value exceeds maximum allocation size.",
+			 function );
+
+			return( -1 );
+		}
+		scan_entries = (info_handle_scan_entry_t *) memory_reallocate(
+		                                             info_handle->scan_entries,
+		                                             sizeof( info_handle_scan_entry_t ) * number_of_allocated_scan_entries );
+
+		if( scan_entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize scan entries.",
+			 function );
+
+			return( -1 );
+		}
+		info_handle->scan_entries                     = scan_entries;
+		info_handle->number_of_allocated_scan_entries = number_of_allocated_scan_entries;
+	}
+	scan_entry = &( info_handle->scan_entries[ info_handle->number_of_scan_entries ] );
+
+	if( memory_set(
+	     scan_entry,
+	     0,
+	     sizeof( info_handle_scan_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_identifier(
+	     file_entry,
+	     &( scan_entry->identifier ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_creation_time(
+	     file_entry,
+	     &( scan_entry->creation_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve creation time.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_modification_time(
+	     file_entry,
+	     &( scan_entry->modification_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_inode_change_time(
+	     file_entry,
+	     &( scan_entry->inode_change_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve inode change time.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_access_time(
+	     file_entry,
+	     &( scan_entry->access_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve access time.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_owner_identifier(
+	     file_entry,
+	     &( scan_entry->owner_identifier ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve owner identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_group_identifier(
+	     file_entry,
+	     &( scan_entry->group_identifier ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve group identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_file_mode(
+	     file_entry,
+	     &( scan_entry->file_mode ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_size(
+	     file_entry,
+	     &( scan_entry->size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size.",
+		 function );
+
+		return( -1 );
+	}
+	info_handle->number_of_scan_entries += 1;
+
+	return( 1 );
+}
+
+/* Appends the name of a directory record to the scan names
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_scan_names_append_directory_record(
+     info_handle_t *info_handle,
+     const libfsapfs_directory_record_values_t *directory_record,
+     libcerror_error_t **error )
+{
+	info_handle_scan_name_t *scan_name  = NULL;
+	info_handle_scan_name_t *scan_names = NULL;
+	static char *function               = "info_handle_scan_names_append_directory_record";
+	size_t name_size                    = 0;
+	size_t utf8_name_size               = 0;
+	int number_of_allocated_scan_names  = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory record.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( directory_record->utf8_name == NULL )
+	 && ( directory_record->utf8_name_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory record - missing UTF-8 name.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->number_of_scan_names >= info_handle->number_of_allocated_scan_names )
+	{
+		if( info_handle->number_of_allocated_scan_names == 0 )
+		{
+			number_of_allocated_scan_names = 1024;
+		}
+		else if( info_handle->number_of_allocated_scan_names <= ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_scan_names = info_handle->number_of_allocated_scan_names * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of scan names value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( (size_t) number_of_allocated_scan_names > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( info_handle_scan_name_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated scan names value exceeds maximum allocation size.",
+			 function );
+
+			return( -1 );
+		}
+		scan_names = (info_handle_scan_name_t *) memory_reallocate(
+		                                          info_handle->scan_names,
+		                                          sizeof( info_handle_scan_name_t ) * number_of_allocated_scan_names );
+
+		if( scan_names == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize scan names.",
+			 function );
+
+			return( -1 );
+		}
+		info_handle->scan_names                     = scan_names;
+		info_handle->number_of_allocated_scan_names = number_of_allocated_scan_names;
+	}
+	scan_name = &( info_handle->scan_names[ info_handle->number_of_scan_names ] );
+
+	if( memory_set(
+	     scan_name,
+	     0,
+	     sizeof( info_handle_scan_name_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan name.",
+		 function );
+
+		return( -1 );
+	}
+	scan_name->identifier        = directory_record->identifier;
+	scan_name->parent_identifier = directory_record->parent_identifier;
+	scan_name->entry_index       = -1;
+	scan_name->parent_name_index = -1;
+
+	/* The name stored in the record is typically terminated by an end-of-string character
+	 */
+	utf8_name_size = directory_record->utf8_name_size;
+
+	while( ( utf8_name_size > 0 )
+	    && ( directory_record->utf8_name[ utf8_name_size - 1 ] == 0 ) )
+	{
+		utf8_name_size--;
+	}
+	if( utf8_name_size > 0 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libuna_utf16_string_size_from_utf8(
+		     directory_record->utf8_name,
+		     utf8_name_size,
+		     &name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine name string size.",
+			 function );
+
+			return( -1 );
+		}
+#else
+		name_size = utf8_name_size + 1;
 #endif
-					if( result != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-						 "%s: unable to retrieve extended attribute name string.",
-						 function );
-
-						goto on_error;
-					}
-					fprintf(
-					 info_handle->notify_stream,
-					 "%" PRIs_SYSTEM "",
-					 extended_attribute_name );
+		scan_name->name = system_string_allocate(
+		                   name_size );
 
-					memory_free(
-					 extended_attribute_name );
+		if( scan_name->name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name string.",
+			 function );
 
-					extended_attribute_name = NULL;
-				}
-				fprintf(
-				 info_handle->notify_stream,
-				 "\n" );
+			return( -1 );
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libuna_utf16_string_copy_from_utf8(
+		     (libuna_utf16_character_t *) scan_name->name,
+		     name_size,
+		     directory_record->utf8_name,
+		     utf8_name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy name string.",
+			 function );
 
-				if( libfsapfs_extended_attribute_free(
-				     &extended_attribute,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free extended attribute: %d.",
-					 function,
-					 extended_attribute_index );
+			goto on_error;
+		}
+#else
+		if( memory_copy(
+		     scan_name->name,
+		     directory_record->utf8_name,
+		     utf8_name_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name string.",
+			 function );
 
-					goto on_error;
-				}
-			}
+			goto on_error;
 		}
+		scan_name->name[ utf8_name_size ] = 0;
+#endif
 	}
-	if( symbolic_link_target != NULL )
-	{
-		memory_free(
-		 symbolic_link_target );
+	info_handle->number_of_scan_names += 1;
 
-		symbolic_link_target = NULL;
-	}
 	return( 1 );
 
 on_error:
-	if( extended_attribute_name != NULL )
+	if( scan_name->name != NULL )
 	{
 		memory_free(
-		 extended_attribute_name );
+		 scan_name->name );
+
+		scan_name->name = NULL;
 	}
-	if( extended_attribute != NULL )
+	return( -1 );
+}
+
+/* Compares two scan names by identifier and parent identifier
+ * Returns -1 if first is less than second, 0 if equal or 1 if greater
+ */
+int info_handle_scan_names_compare(
+     const info_handle_scan_name_t *first_scan_name,
+     const info_handle_scan_name_t *second_scan_name )
+{
+	if( first_scan_name->identifier < second_scan_name->identifier )
 	{
-		libfsapfs_extended_attribute_free(
-		 &extended_attribute,
-		 NULL );
+		return( -1 );
 	}
-	if( symbolic_link_target != NULL )
+	else if( first_scan_name->identifier > second_scan_name->identifier )
 	{
-		memory_free(
-		 symbolic_link_target );
+		return( 1 );
 	}
-	return( -1 );
+	if( first_scan_name->parent_identifier < second_scan_name->parent_identifier )
+	{
+		return( -1 );
+	}
+	else if( first_scan_name->parent_identifier > second_scan_name->parent_identifier )
+	{
+		return( 1 );
+	}
+	return( 0 );
 }
 
-/* Prints file entry information as part of the file system hierarchy
+/* Sorts the scan names by identifier and determines for every scan name
+ * the index of its scan entry and the index of the scan name of its parent
+ * The scan entries are stored in ascending identifier order
  * Returns 1 if successful or -1 on error
  */
-int info_handle_file_system_hierarchy_fprint_file_entry(
+int info_handle_scan_entries_resolve_parents(
      info_handle_t *info_handle,
-     libfsapfs_file_entry_t *file_entry,
-     const system_character_t *path,
      libcerror_error_t **error )
 {
-	libfsapfs_file_entry_t *sub_file_entry = NULL;
-	system_character_t *file_entry_name    = NULL;
-	system_character_t *sub_path           = NULL;
-	static char *function                  = "info_handle_file_system_hierarchy_fprint_file_entry";
-	size_t file_entry_name_size            = 0;
-	size_t path_length                     = 0;
-	size_t sub_path_size                   = 0;
-	uint64_t identifier                    = 0;
-	int number_of_sub_file_entries         = 0;
-	int result                             = 0;
-	int sub_file_entry_index               = 0;
+	info_handle_scan_name_t *scan_name = NULL;
+	static char *function              = "info_handle_scan_entries_resolve_parents";
+	uint64_t identifier                = 0;
+	int entry_index                    = 0;
+	int lower_index                    = 0;
+	int middle_index                   = 0;
+	int name_index                     = 0;
+	int upper_index                    = 0;
 
 	if( info_handle == NULL )
 	{
@@ -2058,293 +3938,570 @@ int info_handle_file_system_hierarchy_fprint_file_entry(
 
 		return( -1 );
 	}
-	if( path == NULL )
+	for( entry_index = 0;
+	     entry_index < info_handle->number_of_scan_entries;
+	     entry_index++ )
+	{
+		if( ( entry_index > 0 )
+		 && ( info_handle->scan_entries[ entry_index ].identifier <= info_handle->scan_entries[ entry_index - 1 ].identifier ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid scan entry: %d - identifier out of order.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	/* The directory records are stored in parent identifier order
+	 */
+	if( info_handle->number_of_scan_names > 1 )
+	{
+		qsort(
+		 info_handle->scan_names,
+		 (size_t) info_handle->number_of_scan_names,
+		 sizeof( info_handle_scan_name_t ),
+		 (int (*)(const void *, const void *)) &info_handle_scan_names_compare );
+	}
+	for( name_index = 0;
+	     name_index < info_handle->number_of_scan_names;
+	     name_index++ )
+	{
+		scan_name = &( info_handle->scan_names[ name_index ] );
+
+		identifier  = scan_name->identifier;
+		lower_index = 0;
+		upper_index = info_handle->number_of_scan_entries;
+
+		while( lower_index < upper_index )
+		{
+			middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+			if( info_handle->scan_entries[ middle_index ].identifier < identifier )
+			{
+				lower_index = middle_index + 1;
+			}
+			else
+			{
+				upper_index = middle_index;
+			}
+		}
+		if( ( lower_index < info_handle->number_of_scan_entries )
+		 && ( info_handle->scan_entries[ lower_index ].identifier == identifier ) )
+		{
+			scan_name->entry_index = lower_index;
+		}
+		else
+		{
+			scan_name->entry_index = -1;
+		}
+		/* A directory has a single name, hence the first scan name of the parent is used
+		 */
+		identifier  = scan_name->parent_identifier;
+		lower_index = 0;
+		upper_index = info_handle->number_of_scan_names;
+
+		while( lower_index < upper_index )
+		{
+			middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+			if( info_handle->scan_names[ middle_index ].identifier < identifier )
+			{
+				lower_index = middle_index + 1;
+			}
+			else
+			{
+				upper_index = middle_index;
+			}
+		}
+		if( ( lower_index < info_handle->number_of_scan_names )
+		 && ( info_handle->scan_names[ lower_index ].identifier == identifier ) )
+		{
+			scan_name->parent_name_index = lower_index;
+		}
+		else
+		{
+			scan_name->parent_name_index = -1;
+		}
+	}
+	return( 1 );
+}
+
+/* Prints a scan entry
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_scan_entry_fprint(
+     info_handle_t *info_handle,
+     info_handle_scan_entry_t *scan_entry,
+     const system_character_t *path,
+     info_handle_bodyfile_entry_t *bodyfile_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_scan_entry_fprint";
+
+	if( info_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid path.",
+		 "%s: invalid info handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfsapfs_file_entry_get_identifier(
-	     file_entry,
-	     &identifier,
-	     error ) != 1 )
+	if( scan_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve identifier.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan entry.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfsapfs_file_entry_get_number_of_sub_file_entries(
-	     file_entry,
-	     &number_of_sub_file_entries,
-	     error ) != 1 )
+	if( bodyfile_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of sub file entries.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bodyfile entry.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	path_length = system_string_length(
-	               path );
+	if( info_handle->bodyfile_stream != NULL )
+	{
+		bodyfile_entry->identifier        = scan_entry->identifier;
+		bodyfile_entry->creation_time     = scan_entry->creation_time;
+		bodyfile_entry->modification_time = scan_entry->modification_time;
+		bodyfile_entry->inode_change_time = scan_entry->inode_change_time;
+		bodyfile_entry->access_time       = scan_entry->access_time;
+		bodyfile_entry->size              = scan_entry->size;
+		bodyfile_entry->owner_identifier  = scan_entry->owner_identifier;
+		bodyfile_entry->group_identifier  = scan_entry->group_identifier;
+		bodyfile_entry->file_mode         = scan_entry->file_mode;
+
+		if( info_handle_bodyfile_entries_append(
+		     info_handle,
+		     bodyfile_entry,
+		     path,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append bodyfile entry.",
+			 function );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libfsapfs_file_entry_get_utf16_name_size(
-	          file_entry,
-	          &file_entry_name_size,
-	          error );
-#else
-	result = libfsapfs_file_entry_get_utf8_name_size(
-	          file_entry,
-	          &file_entry_name_size,
-	          error );
-#endif
-	if( result == -1 )
+			return( -1 );
+		}
+	}
+	else
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "%" PRIs_SYSTEM "\n",
+		 path );
+	}
+	return( 1 );
+}
+
+/* Prints the scan entries that are part of the file system hierarchy
+ * A scan entry is printed once for every scan name, hence once for every hard link.
+ * The path of a scan name is determined by following its parents up to the root directory,
+ * scan names that are not part of the hierarchy, such as those in the private directory, are skipped
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_scan_entries_fprint(
+     info_handle_t *info_handle,
+     const system_character_t *path,
+     libcerror_error_t **error )
+{
+	info_handle_bodyfile_entry_t bodyfile_entry;
+
+	info_handle_scan_entry_t *scan_entry   = NULL;
+	info_handle_scan_name_t *scan_name     = NULL;
+	system_character_t *entry_path         = NULL;
+	system_character_t *name               = NULL;
+	int *path_name_indexes                 = NULL;
+	void *reallocation                     = NULL;
+	static char *function                  = "info_handle_scan_entries_fprint";
+	size_t entry_path_index                = 0;
+	size_t entry_path_size                 = 0;
+	size_t maximum_entry_path_size         = 0;
+	size_t name_length                     = 0;
+	size_t path_length                     = 0;
+	int entry_index                        = 0;
+	int name_index                         = 0;
+	int path_depth                         = 0;
+	int path_name_index                    = 0;
+	int path_name_indexes_index            = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->number_of_scan_entries == 0 )
+	{
+		return( 1 );
+	}
+	if( (size_t) info_handle->number_of_scan_names > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( int ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file entry name string size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of scan names value exceeds maximum allocation size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( result == 1 )
-	 && ( file_entry_name_size > 0 ) )
+	if( memory_set(
+	     &bodyfile_entry,
+	     0,
+	     sizeof( info_handle_bodyfile_entry_t ) ) == NULL )
 	{
-		file_entry_name = system_string_allocate(
-		                   file_entry_name_size );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear bodyfile entry.",
+		 function );
 
-		if( file_entry_name == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create file entry name string.",
-			 function );
+		return( -1 );
+	}
+	/* The root directory (identifier 2) has no name
+	 */
+	for( entry_index = 0;
+	     entry_index < info_handle->number_of_scan_entries;
+	     entry_index++ )
+	{
+		scan_entry = &( info_handle->scan_entries[ entry_index ] );
 
-			goto on_error;
-		}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libfsapfs_file_entry_get_utf16_name(
-		          file_entry,
-		          (uint16_t *) file_entry_name,
-		          file_entry_name_size,
-		          error );
-#else
-		result = libfsapfs_file_entry_get_utf8_name(
-		          file_entry,
-		          (uint8_t *) file_entry_name,
-		          file_entry_name_size,
-		          error );
-#endif
-		if( result != 1 )
+		if( scan_entry->identifier >= 2 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve file entry name string.",
-			 function );
-
-			goto on_error;
+			break;
 		}
 	}
-	if( info_handle->bodyfile_stream != NULL )
+	if( ( entry_index < info_handle->number_of_scan_entries )
+	 && ( scan_entry->identifier == 2 ) )
 	{
-		if( info_handle_file_entry_value_with_name_fprint(
+		if( info_handle_scan_entry_fprint(
 		     info_handle,
-		     file_entry,
+		     scan_entry,
 		     path,
-		     file_entry_name,
+		     &bodyfile_entry,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print file entry.",
+			 "%s: unable to print root directory scan entry.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	else
+	if( info_handle->number_of_scan_names == 0 )
 	{
-		fprintf(
-		 info_handle->notify_stream,
-		 "%" PRIs_SYSTEM "",
-		 path );
-
-		if( ( file_entry_name != NULL )
-		 && ( identifier != 2 ) )
-		{
-			fprintf(
-			 info_handle->notify_stream,
-			 "%" PRIs_SYSTEM "",
-			 file_entry_name );
-		}
-		fprintf(
-		 info_handle->notify_stream,
-		 "\n" );
+		return( 1 );
 	}
-	if( number_of_sub_file_entries > 0 )
+	path_name_indexes = (int *) memory_allocate(
+	                             sizeof( int ) * info_handle->number_of_scan_names );
+
+	if( path_name_indexes == NULL )
 	{
-		sub_path_size = path_length + 1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path name indexes.",
+		 function );
 
-		if( ( file_entry_name != NULL )
-		 && ( identifier != 2 ) )
+		goto on_error;
+	}
+	path_length = system_string_length(
+	               path );
+
+	for( name_index = 0;
+	     name_index < info_handle->number_of_scan_names;
+	     name_index++ )
+	{
+		if( info_handle->scan_names[ name_index ].entry_index == -1 )
 		{
-			sub_path_size += file_entry_name_size;
+			continue;
 		}
-		sub_path = system_string_allocate(
-		            sub_path_size );
+		/* Determine the scan names of the path below the root directory (identifier 2),
+		 * where the number of scan names bounds the depth to protect against loops
+		 */
+		path_name_index = name_index;
+		path_depth      = 0;
+		entry_path_size = path_length + 1;
 
-		if( sub_path == NULL )
+		while( ( path_name_index != -1 )
+		    && ( path_depth < info_handle->number_of_scan_names ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create sub path.",
-			 function );
+			scan_name = &( info_handle->scan_names[ path_name_index ] );
 
-			goto on_error;
+			path_name_indexes[ path_depth++ ] = path_name_index;
+
+			if( scan_name->name != NULL )
+			{
+				entry_path_size += system_string_length(
+				                    scan_name->name );
+			}
+			entry_path_size += 1;
+
+			if( scan_name->parent_identifier == 2 )
+			{
+				break;
+			}
+			path_name_index = scan_name->parent_name_index;
 		}
-		if( system_string_copy(
-		     sub_path,
-		     path,
-		     path_length ) == NULL )
+		if( ( path_name_index == -1 )
+		 || ( info_handle->scan_names[ path_name_index ].parent_identifier != 2 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy path to sub path.",
-			 function );
-
-			goto on_error;
+			continue;
 		}
-		if( ( file_entry_name != NULL )
-		 && ( identifier != 2 ) )
+		if( entry_path_size > maximum_entry_path_size )
 		{
-			if( system_string_copy(
-			     &( sub_path[ path_length ] ),
-			     file_entry_name,
-			     file_entry_name_size - 1 ) == NULL )
+			if( entry_path_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy file entry name to sub path.",
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid entry path size value exceeds maximum allocation size.",
 				 function );
 
 				goto on_error;
 			}
-			sub_path[ sub_path_size - 2 ] = (system_character_t) LIBFSAPFS_SEPARATOR;
-		}
-		sub_path[ sub_path_size - 1 ] = (system_character_t) 0;
+			reallocation = memory_reallocate(
+			                entry_path,
+			                sizeof( system_character_t ) * entry_path_size );
 
-		for( sub_file_entry_index = 0;
-		     sub_file_entry_index < number_of_sub_file_entries;
-		     sub_file_entry_index++ )
-		{
-			if( libfsapfs_file_entry_get_sub_file_entry_by_index(
-			     file_entry,
-			     sub_file_entry_index,
-			     &sub_file_entry,
-			     error ) != 1 )
+			if( reallocation == NULL )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve sub file entry: %d.",
-				 function,
-				 sub_file_entry_index );
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize entry path.",
+				 function );
 
 				goto on_error;
 			}
-			if( info_handle_file_system_hierarchy_fprint_file_entry(
-			     info_handle,
-			     sub_file_entry,
-			     sub_path,
-			     error ) != 1 )
+			entry_path              = (system_character_t *) reallocation;
+			maximum_entry_path_size = entry_path_size;
+		}
+		if( system_string_copy(
+		     entry_path,
+		     path,
+		     path_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy path.",
+			 function );
+
+			goto on_error;
+		}
+		entry_path_index = path_length;
+
+		for( path_name_indexes_index = path_depth - 1;
+		     path_name_indexes_index >= 0;
+		     path_name_indexes_index-- )
+		{
+			name = info_handle->scan_names[ path_name_indexes[ path_name_indexes_index ] ].name;
+
+			if( name != NULL )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print file entry: %d information.",
-				 function,
-				 sub_file_entry_index );
+				name_length = system_string_length(
+				               name );
 
-				goto on_error;
+				if( system_string_copy(
+				     &( entry_path[ entry_path_index ] ),
+				     name,
+				     name_length ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy name.",
+					 function );
+
+					goto on_error;
+				}
+				entry_path_index += name_length;
 			}
-			if( libfsapfs_file_entry_free(
-			     &sub_file_entry,
-			     error ) != 1 )
+			if( path_name_indexes_index > 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free sub file entry: %d.",
-				 function,
-				 sub_file_entry_index );
-
-				goto on_error;
+				entry_path[ entry_path_index++ ] = (system_character_t) LIBFSAPFS_SEPARATOR;
 			}
 		}
+		entry_path[ entry_path_index ] = 0;
+
+		scan_entry = &( info_handle->scan_entries[ info_handle->scan_names[ name_index ].entry_index ] );
+
+		if( info_handle_scan_entry_fprint(
+		     info_handle,
+		     scan_entry,
+		     entry_path,
+		     &bodyfile_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print scan entry.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	if( sub_path != NULL )
+	if( entry_path != NULL )
 	{
 		memory_free(
-		 sub_path );
+		 entry_path );
+	}
+	memory_free(
+	 path_name_indexes );
+
+	return( 1 );
+
+on_error:
+	if( entry_path != NULL )
+	{
+		memory_free(
+		 entry_path );
+	}
+	if( path_name_indexes != NULL )
+	{
+		memory_free(
+		 path_name_indexes );
+	}
+	return( -1 );
+}
+
+/* Prints the file system hierarchy information of a volume using a single pass scan
+ * The file entries and names are determined with one walk of the file system B-tree
+ * after which the paths are determined from the names and parent identifiers
+ * stored in the directory records. Hence the entries are printed in identifier order
+ * and a hard linked file entry is printed once for every name.
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_file_system_hierarchy_scan_fprint(
+     info_handle_t *info_handle,
+     libfsapfs_volume_t *volume,
+     const system_character_t *path,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_file_system_hierarchy_scan_fprint";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
 
-		sub_path = NULL;
+		return( -1 );
 	}
-	if( file_entry_name != NULL )
+	if( libfsapfs_volume_scan(
+	     volume,
+	     &info_handle_scan_record_callback,
+	     (void *) info_handle,
+	     error ) != 1 )
 	{
-		memory_free(
-		 file_entry_name );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to scan file entries.",
+		 function );
 
-		file_entry_name = NULL;
+		goto on_error;
 	}
-	return( 1 );
-
-on_error:
-	if( sub_file_entry != NULL )
+	if( info_handle_scan_entries_resolve_parents(
+	     info_handle,
+	     error ) != 1 )
 	{
-		libfsapfs_file_entry_free(
-		 &sub_file_entry,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve parents of scan entries.",
+		 function );
+
+		goto on_error;
 	}
-	if( sub_path != NULL )
+	if( info_handle_scan_entries_fprint(
+	     info_handle,
+	     path,
+	     error ) != 1 )
 	{
-		memory_free(
-		 sub_path );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print scan entries.",
+		 function );
+
+		goto on_error;
 	}
-	if( file_entry_name != NULL )
+	if( info_handle_scan_entries_free(
+	     info_handle,
+	     error ) != 1 )
 	{
-		memory_free(
-		 file_entry_name );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free scan entries.",
+		 function );
+
+		goto on_error;
 	}
+	return( 1 );
+
+on_error:
+	info_handle_scan_entries_free(
+	 info_handle,
+	 NULL );
+
 	return( -1 );
 }
 
@@ -2438,6 +4595,20 @@ int info_handle_file_system_hierarchy_fprint(
 
 			goto on_error;
 		}
+		if( info_handle_set_bodyfile_volume(
+		     info_handle,
+		     volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set bodyfile volume.",
+			 function );
+
+			goto on_error;
+		}
 		if( libfsapfs_volume_get_identifier(
 		     volume,
 		     uuid_data,
@@ -2525,45 +4696,94 @@ int info_handle_file_system_hierarchy_fprint(
 
 			goto on_error;
 		}
-		if( libfsapfs_volume_get_root_directory(
-		     volume,
-		     &file_entry,
-		     error ) != 1 )
+		if( info_handle->use_scan != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve root directory file entry from volume: %d.",
-			 function,
-			 volume_index );
+			if( info_handle_file_system_hierarchy_scan_fprint(
+			     info_handle,
+			     volume,
+			     uuid_string,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print file system hierarchy of volume: %d.",
+				 function,
+				 volume_index );
 
-			goto on_error;
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( libfsapfs_volume_get_root_directory(
+			     volume,
+			     &file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve root directory file entry from volume: %d.",
+				 function,
+				 volume_index );
+
+				goto on_error;
+			}
+			if( info_handle_file_system_hierarchy_fprint_file_entry(
+			     info_handle,
+			     file_entry,
+			     uuid_string,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print root directory file entry information.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfsapfs_file_entry_free(
+			     &file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file entry.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		if( info_handle_file_system_hierarchy_fprint_file_entry(
+		if( info_handle_bodyfile_entries_flush(
 		     info_handle,
-		     file_entry,
-		     uuid_string,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print root directory file entry information.",
+			 "%s: unable to print pending bodyfile entries.",
 			 function );
 
 			goto on_error;
 		}
-		if( libfsapfs_file_entry_free(
-		     &file_entry,
+		if( info_handle_set_bodyfile_volume(
+		     info_handle,
+		     NULL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file entry.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set bodyfile volume.",
 			 function );
 
 			goto on_error;
@@ -2603,6 +4823,14 @@ on_error:
 		 &uuid,
 		 NULL );
 	}
+	if( info_handle->bodyfile_volume != NULL )
+	{
+		info_handle_bodyfile_entries_clear(
+		 info_handle,
+		 NULL );
+
+		info_handle->bodyfile_volume = NULL;
+	}
 	if( volume != NULL )
 	{
 		libfsapfs_volume_free(
@@ -2689,6 +4917,20 @@ int info_handle_file_entry_fprint_by_identifier(
 
 		goto on_error;
 	}
+	if( info_handle_set_bodyfile_volume(
+	     info_handle,
+	     volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bodyfile volume.",
+		 function );
+
+		goto on_error;
+	}
 	if( info_handle->bodyfile_stream == NULL )
 	{
 		fprintf(
@@ -2756,6 +4998,33 @@ int info_handle_file_entry_fprint_by_identifier(
 			 "\n" );
 		}
 	}
+	if( info_handle_bodyfile_entries_flush(
+	     info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print pending bodyfile entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( info_handle_set_bodyfile_volume(
+	     info_handle,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bodyfile volume.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfsapfs_volume_free(
 	     &volume,
 	     error ) != 1 )
@@ -2778,6 +5047,14 @@ on_error:
 		 &file_entry,
 		 NULL );
 	}
+	if( info_handle->bodyfile_volume != NULL )
+	{
+		info_handle_bodyfile_entries_clear(
+		 info_handle,
+		 NULL );
+
+		info_handle->bodyfile_volume = NULL;
+	}
 	if( volume != NULL )
 	{
 		libfsapfs_volume_free(
@@ -2865,6 +5142,20 @@ int info_handle_file_entry_fprint_by_path(
 
 		goto on_error;
 	}
+	if( info_handle_set_bodyfile_volume(
+	     info_handle,
+	     volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bodyfile volume.",
+		 function );
+
+		goto on_error;
+	}
 	path_length = system_string_length(
 	               path );
 
@@ -2948,6 +5239,33 @@ int info_handle_file_entry_fprint_by_path(
 
 		goto on_error;
 	}
+	if( info_handle_bodyfile_entries_flush(
+	     info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print pending bodyfile entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( info_handle_set_bodyfile_volume(
+	     info_handle,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bodyfile volume.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfsapfs_volume_free(
 	     &volume,
 	     error ) != 1 )
@@ -2976,6 +5294,14 @@ on_error:
 		 &file_entry,
 		 NULL );
 	}
+	if( info_handle->bodyfile_volume != NULL )
+	{
+		info_handle_bodyfile_entries_clear(
+		 info_handle,
+		 NULL );
+
+		info_handle->bodyfile_volume = NULL;
+	}
 	if( volume != NULL )
 	{
 		libfsapfs_volume_free(
@@ -3063,6 +5389,20 @@ int info_handle_file_entries_fprint(
 
 		goto on_error;
 	}
+	if( info_handle_set_bodyfile_volume(
+	     info_handle,
+	     volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bodyfile volume.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfsapfs_volume_get_next_file_entry_identifier(
 	     volume,
 	     &next_file_entry_identifier,
@@ -3147,6 +5487,33 @@ int info_handle_file_entries_fprint(
 			}
 		}
 	}
+	if( info_handle_bodyfile_entries_flush(
+	     info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print pending bodyfile entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( info_handle_set_bodyfile_volume(
+	     info_handle,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bodyfile volume.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfsapfs_volume_free(
 	     &volume,
 	     error ) != 1 )
@@ -3169,6 +5536,14 @@ on_error:
 		 &file_entry,
 		 NULL );
 	}
+	if( info_handle->bodyfile_volume != NULL )
+	{
+		info_handle_bodyfile_entries_clear(
+		 info_handle,
+		 NULL );
+
+		info_handle->bodyfile_volume = NULL;
+	}
 	if( volume != NULL )
 	{
 		libfsapfs_volume_free(
@@ -26,6 +26,7 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "digest_pool.h"
 #include "fsapfstools_libbfio.h"
 #include "fsapfstools_libcerror.h"
 #include "fsapfstools_libfsapfs.h"
@@ -34,6 +35,125 @@
 extern "C" {
 #endif
 
+typedef struct info_handle_scan_entry info_handle_scan_entry_t;
+
+struct info_handle_scan_entry
+{
+	/* The identifier
+	 */
+	uint64_t identifier;
+
+	/* The creation time
+	 */
+	int64_t creation_time;
+
+	/* The modification time
+	 */
+	int64_t modification_time;
+
+	/* The inode change time
+	 */
+	int64_t inode_change_time;
+
+	/* The access time
+	 */
+	int64_t access_time;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The owner identifier
+	 */
+	uint32_t owner_identifier;
+
+	/* The group identifier
+	 */
+	uint32_t group_identifier;
+
+	/* The file mode
+	 */
+	uint16_t file_mode;
+};
+
+typedef struct info_handle_scan_name info_handle_scan_name_t;
+
+struct info_handle_scan_name
+{
+	/* The identifier
+	 */
+	uint64_t identifier;
+
+	/* The parent identifier
+	 */
+	uint64_t parent_identifier;
+
+	/* The index of the scan entry or -1 if not available
+	 */
+	int entry_index;
+
+	/* The index of the scan name of the parent or -1 if not available
+	 */
+	int parent_name_index;
+
+	/* The name
+	 */
+	system_character_t *name;
+};
+
+typedef struct info_handle_bodyfile_entry info_handle_bodyfile_entry_t;
+
+struct info_handle_bodyfile_entry
+{
+	/* The path, which includes the name
+	 */
+	system_character_t *path;
+
+	/* The identifier
+	 */
+	uint64_t identifier;
+
+	/* The creation time
+	 */
+	int64_t creation_time;
+
+	/* The modification time
+	 */
+	int64_t modification_time;
+
+	/* The inode change time
+	 */
+	int64_t inode_change_time;
+
+	/* The access time
+	 */
+	int64_t access_time;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The owner identifier
+	 */
+	uint32_t owner_identifier;
+
+	/* The group identifier
+	 */
+	uint32_t group_identifier;
+
+	/* The file mode
+	 */
+	uint16_t file_mode;
+
+	/* Value to indicate the digest job was pushed onto the digest pool
+	 */
+	uint8_t has_digest_job;
+
+	/* The digest job
+	 */
+	digest_job_t digest_job;
+};
+
 typedef struct info_handle info_handle_t;
 
 struct info_handle
@@ -78,6 +198,69 @@ struct info_handle
 	 */
 	FILE *bodyfile_stream;
 
+	/* Value to indicate the file system hierarchy should be determined
+	 * with a single pass scan of the file system metadata
+	 */
+	uint8_t use_scan;
+
+	/* The scan entries
+	 */
+	info_handle_scan_entry_t *scan_entries;
+
+	/* The number of scan entries
+	 */
+	int number_of_scan_entries;
+
+	/* The number of allocated scan entries
+	 */
+	int number_of_allocated_scan_entries;
+
+	/* The scan names
+	 */
+	info_handle_scan_name_t *scan_names;
+
+	/* The number of scan names
+	 */
+	int number_of_scan_names;
+
+	/* The number of allocated scan names
+	 */
+	int number_of_allocated_scan_names;
+
+	/* The digest hash type of the data of the file entries in the bodyfile
+	 */
+	int digest_hash_type;
+
+	/* The number of threads used to calculate digest hashes
+	 */
+	int number_of_digest_threads;
+
+	/* The digest pool
+	 */
+	digest_pool_t *digest_pool;
+
+	/* The volume of the file entries in the bodyfile
+	 * This is only set when digest hashes are calculated
+	 */
+	libfsapfs_volume_t *bodyfile_volume;
+
+	/* The bodyfile entries that are pending their digest hash,
+	 * which are stored as a ring buffer to print them in order
+	 */
+	info_handle_bodyfile_entry_t *bodyfile_entries;
+
+	/* The maximum number of bodyfile entries
+	 */
+	int maximum_number_of_bodyfile_entries;
+
+	/* The index of the first pending bodyfile entry
+	 */
+	int first_bodyfile_entry_index;
+
+	/* The number of pending bodyfile entries
+	 */
+	int number_of_bodyfile_entries;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -110,6 +293,16 @@ int info_handle_set_bodyfile(
      const system_character_t *filename,
      libcerror_error_t **error );
 
+int info_handle_set_digest_hash_type(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int info_handle_set_number_of_digest_threads(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int info_handle_set_file_system_index(
      info_handle_t *info_handle,
      const system_character_t *string,
@@ -157,6 +350,44 @@ int info_handle_uuid_value_fprint(
      const uint8_t *uuid_data,
      libcerror_error_t **error );
 
+int info_handle_file_mode_copy_to_string(
+     uint16_t file_mode,
+     char *string,
+     size_t string_size,
+     libcerror_error_t **error );
+
+int info_handle_set_bodyfile_volume(
+     info_handle_t *info_handle,
+     libfsapfs_volume_t *volume,
+     libcerror_error_t **error );
+
+int info_handle_bodyfile_entry_fprint(
+     info_handle_t *info_handle,
+     info_handle_bodyfile_entry_t *bodyfile_entry,
+     const system_character_t *path,
+     const system_character_t *file_entry_name,
+     const char *digest_hash_string,
+     libcerror_error_t **error );
+
+int info_handle_bodyfile_entries_append(
+     info_handle_t *info_handle,
+     info_handle_bodyfile_entry_t *bodyfile_entry,
+     const system_character_t *path,
+     const system_character_t *file_entry_name,
+     libcerror_error_t **error );
+
+int info_handle_bodyfile_entries_fprint_first(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+int info_handle_bodyfile_entries_flush(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+int info_handle_bodyfile_entries_clear(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 int info_handle_file_entry_value_fprint(
      info_handle_t *info_handle,
      libfsapfs_file_entry_t *file_entry,
@@ -176,6 +407,51 @@ int info_handle_file_system_hierarchy_fprint_file_entry(
      const system_character_t *path,
      libcerror_error_t **error );
 
+int info_handle_scan_entries_free(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+int info_handle_scan_record_callback(
+     const libfsapfs_scan_record_t *scan_record,
+     void *callback_data,
+     libcerror_error_t **error );
+
+int info_handle_scan_entries_append_file_entry(
+     info_handle_t *info_handle,
+     libfsapfs_file_entry_t *file_entry,
+     libcerror_error_t **error );
+
+int info_handle_scan_names_append_directory_record(
+     info_handle_t *info_handle,
+     const libfsapfs_directory_record_values_t *directory_record,
+     libcerror_error_t **error );
+
+int info_handle_scan_names_compare(
+     const info_handle_scan_name_t *first_scan_name,
+     const info_handle_scan_name_t *second_scan_name );
+
+int info_handle_scan_entries_resolve_parents(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+int info_handle_scan_entry_fprint(
+     info_handle_t *info_handle,
+     info_handle_scan_entry_t *scan_entry,
+     const system_character_t *path,
+     info_handle_bodyfile_entry_t *bodyfile_entry,
+     libcerror_error_t **error );
+
+int info_handle_scan_entries_fprint(
+     info_handle_t *info_handle,
+     const system_character_t *path,
+     libcerror_error_t **error );
+
+int info_handle_file_system_hierarchy_scan_fprint(
+     info_handle_t *info_handle,
+     libfsapfs_volume_t *volume,
+     const system_character_t *path,
+     libcerror_error_t **error );
+
 int info_handle_file_system_hierarchy_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
@@ -111,6 +111,21 @@ struct fsapfs_file_system_btree_key_file_extent
 	uint8_t logical_address[ 8 ];
 };
 
+typedef struct fsapfs_file_system_btree_key_sibling_link fsapfs_file_system_btree_key_sibling_link_t;
+
+struct fsapfs_file_system_btree_key_sibling_link
+{
+	/* The file system identifier (FSID) and data type
+	 * Consists of 8 bytes
+	 */
+	uint8_t file_system_identifier[ 8 ];
+
+	/* The sibling identifier
+	 * Consists of 8 bytes
+	 */
+	uint8_t sibling_identifier[ 8 ];
+};
+
 typedef struct fsapfs_file_system_btree_value_directory_record fsapfs_file_system_btree_value_directory_record_t;
 
 struct fsapfs_file_system_btree_value_directory_record
@@ -315,6 +330,24 @@ struct fsapfs_file_system_btree_value_inode
 	 */
 };
 
+typedef struct fsapfs_file_system_btree_value_sibling_link fsapfs_file_system_btree_value_sibling_link_t;
+
+struct fsapfs_file_system_btree_value_sibling_link
+{
+	/* The parent identifier
+	 * Consists of 8 bytes
+	 */
+	uint8_t parent_identifier[ 8 ];
+
+	/* The name size
+	 * Consists of 2 bytes
+	 */
+	uint8_t name_size[ 2 ];
+
+	/* The name
+	 */
+};
+
 typedef struct fsapfs_file_system_data_stream_attribute fsapfs_file_system_data_stream_attribute_t;
 
 struct fsapfs_file_system_data_stream_attribute
@@ -0,0 +1,738 @@
+/*
+ * Hardware accelerated AES (AES-NI and VAES) functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_aes_ni.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_libcaes.h"
+#include "libfsapfs_libcerror.h"
+
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#if defined( HAVE_LIBFSAPFS_VAES_SUPPORT )
+#include <immintrin.h>
+#endif
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#if defined( _MSC_VER )
+#define LIBFSAPFS_AES_NI_TARGET
+#else
+#define LIBFSAPFS_AES_NI_TARGET		__attribute__((target("aes,sse2")))
+#endif
+
+#define LIBFSAPFS_AES_NI_VAES_TARGET	__attribute__((target("aes,sse2,avx2,avx512f,vaes")))
+
+/* Expands the AES-128 key of the previous round into the key of the next round
+ */
+#define LIBFSAPFS_AES_NI_EXPAND_KEY_128( round_keys, round_index, round_constant ) \
+	key_generation = _mm_aeskeygenassist_si128( round_keys[ round_index - 1 ], round_constant ); \
+	key_generation = _mm_shuffle_epi32( key_generation, 0xff ); \
+	round_key      = round_keys[ round_index - 1 ]; \
+	round_key      = _mm_xor_si128( round_key, _mm_slli_si128( round_key, 4 ) ); \
+	round_key      = _mm_xor_si128( round_key, _mm_slli_si128( round_key, 4 ) ); \
+	round_key      = _mm_xor_si128( round_key, _mm_slli_si128( round_key, 4 ) ); \
+	round_keys[ round_index ] = _mm_xor_si128( round_key, key_generation );
+
+/* Applies a decryption round to 4 blocks
+ */
+#define LIBFSAPFS_AES_NI_DECRYPT_ROUND_4( block0, block1, block2, block3, round_key ) \
+	block0 = _mm_aesdec_si128( block0, round_key ); \
+	block1 = _mm_aesdec_si128( block1, round_key ); \
+	block2 = _mm_aesdec_si128( block2, round_key ); \
+	block3 = _mm_aesdec_si128( block3, round_key );
+
+#endif /* defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT ) */
+
+/* Retrieves the hardware AES support flags of the processor
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_aes_ni_get_support_flags(
+     uint8_t *support_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_aes_ni_get_support_flags";
+
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+#if defined( _MSC_VER )
+	int cpu_info[ 4 ];
+#endif
+	unsigned int eax      = 0;
+	unsigned int ebx      = 0;
+	unsigned int ecx      = 0;
+	unsigned int edx      = 0;
+
+#if defined( HAVE_LIBFSAPFS_VAES_SUPPORT )
+	unsigned int xcr0_eax = 0;
+	unsigned int xcr0_edx = 0;
+#endif
+#endif /* defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT ) */
+
+	if( support_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid support flags.",
+		 function );
+
+		return( -1 );
+	}
+	*support_flags = 0;
+
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+#if defined( _MSC_VER )
+	__cpuid(
+	 cpu_info,
+	 0 );
+
+	if( cpu_info[ 0 ] < 1 )
+	{
+		return( 1 );
+	}
+	__cpuid(
+	 cpu_info,
+	 1 );
+
+	eax = (unsigned int) cpu_info[ 0 ];
+	ebx = (unsigned int) cpu_info[ 1 ];
+	ecx = (unsigned int) cpu_info[ 2 ];
+	edx = (unsigned int) cpu_info[ 3 ];
+#else
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 1 );
+	}
+#endif
+	/* CPUID.01H:ECX.AES[bit 25] and CPUID.01H:ECX.SSE2[bit 26]
+	 */
+	if( ( ( ecx & 0x02000000UL ) == 0 )
+	 || ( ( edx & 0x04000000UL ) == 0 ) )
+	{
+		return( 1 );
+	}
+	*support_flags |= LIBFSAPFS_AES_NI_SUPPORT_FLAG_AES_NI;
+
+#if defined( HAVE_LIBFSAPFS_VAES_SUPPORT )
+	/* CPUID.01H:ECX.OSXSAVE[bit 27] is needed to check if the operating system
+	 * saves the AVX-512 state
+	 */
+	if( ( ecx & 0x08000000UL ) == 0 )
+	{
+		return( 1 );
+	}
+	__asm__ __volatile__ (
+	 "xgetbv"
+	 : "=a" ( xcr0_eax ), "=d" ( xcr0_edx )
+	 : "c" ( 0 ) );
+
+	/* XCR0 needs the SSE, AVX, opmask, ZMM_Hi256 and Hi16_ZMM state enabled
+	 */
+	if( ( xcr0_eax & 0x000000e6UL ) != 0x000000e6UL )
+	{
+		return( 1 );
+	}
+	if( __get_cpuid_count(
+	     7,
+	     0,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 1 );
+	}
+	/* CPUID.07H:EBX.AVX2[bit 5], CPUID.07H:EBX.AVX512F[bit 16] and CPUID.07H:ECX.VAES[bit 9]
+	 */
+	if( ( ( ebx & 0x00000020UL ) != 0 )
+	 && ( ( ebx & 0x00010000UL ) != 0 )
+	 && ( ( ecx & 0x00000200UL ) != 0 ) )
+	{
+		*support_flags |= LIBFSAPFS_AES_NI_SUPPORT_FLAG_VAES;
+	}
+#endif /* defined( HAVE_LIBFSAPFS_VAES_SUPPORT ) */
+#endif /* defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT ) */
+
+	return( 1 );
+}
+
+/* Sets the AES-128 round keys
+ * The decryption round keys are stored in the order they are applied
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+LIBFSAPFS_AES_NI_TARGET
+#endif
+int libfsapfs_aes_ni_set_key(
+     uint8_t *round_keys,
+     size_t round_keys_size,
+     int mode,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_aes_ni_set_key";
+
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+	__m128i encryption_round_keys[ 11 ];
+
+	__m128i key_generation;
+	__m128i round_key;
+
+	int round_index       = 0;
+#endif
+
+	if( round_keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid round keys.",
+		 function );
+
+		return( -1 );
+	}
+	if( round_keys_size < LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid round keys size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBCAES_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBCAES_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_bit_size != 128 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key bit size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+	encryption_round_keys[ 0 ] = _mm_loadu_si128(
+	                              (const __m128i *) key );
+
+	LIBFSAPFS_AES_NI_EXPAND_KEY_128( encryption_round_keys, 1, 0x01 )
+	LIBFSAPFS_AES_NI_EXPAND_KEY_128( encryption_round_keys, 2, 0x02 )
+	LIBFSAPFS_AES_NI_EXPAND_KEY_128( encryption_round_keys, 3, 0x04 )
+	LIBFSAPFS_AES_NI_EXPAND_KEY_128( encryption_round_keys, 4, 0x08 )
+	LIBFSAPFS_AES_NI_EXPAND_KEY_128( encryption_round_keys, 5, 0x10 )
+	LIBFSAPFS_AES_NI_EXPAND_KEY_128( encryption_round_keys, 6, 0x20 )
+	LIBFSAPFS_AES_NI_EXPAND_KEY_128( encryption_round_keys, 7, 0x40 )
+	LIBFSAPFS_AES_NI_EXPAND_KEY_128( encryption_round_keys, 8, 0x80 )
+	LIBFSAPFS_AES_NI_EXPAND_KEY_128( encryption_round_keys, 9, 0x1b )
+	LIBFSAPFS_AES_NI_EXPAND_KEY_128( encryption_round_keys, 10, 0x36 )
+
+	for( round_index = 0;
+	     round_index < 11;
+	     round_index++ )
+	{
+		if( mode == LIBCAES_CRYPT_MODE_ENCRYPT )
+		{
+			round_key = encryption_round_keys[ round_index ];
+		}
+		else if( ( round_index == 0 )
+		      || ( round_index == 10 ) )
+		{
+			round_key = encryption_round_keys[ 10 - round_index ];
+		}
+		else
+		{
+			round_key = _mm_aesimc_si128(
+			             encryption_round_keys[ 10 - round_index ] );
+		}
+		_mm_storeu_si128(
+		 (__m128i *) &( round_keys[ round_index * 16 ] ),
+		 round_key );
+	}
+	memory_set(
+	 encryption_round_keys,
+	 0,
+	 sizeof( __m128i ) * 11 );
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: AES-NI not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT ) */
+}
+
+/* Decrypts AES-XTS sectors using AES-NI or VAES
+ * The data size must be a multiple of the bytes per sector, which must be a multiple of 16
+ * The input and output data can refer to the same buffer
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+LIBFSAPFS_AES_NI_TARGET
+#endif
+int libfsapfs_aes_ni_decrypt_xts(
+     uint8_t support_flags,
+     const uint8_t *data_round_keys,
+     const uint8_t *tweak_round_keys,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t sector_number,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	static char *function  = "libfsapfs_aes_ni_decrypt_xts";
+
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+	uint8_t tweaks[ 512 ];
+	uint64_t tweak_64bit_values[ 2 ];
+
+	__m128i tweak;
+
+	size_t block_offset    = 0;
+	size_t chunk_offset    = 0;
+	size_t chunk_size      = 0;
+	size_t data_offset     = 0;
+	uint64_t carry_bit     = 0;
+	uint64_t lower_64bit   = 0;
+	uint64_t upper_64bit   = 0;
+	int round_index        = 0;
+#endif
+
+	if( ( support_flags & LIBFSAPFS_AES_NI_SUPPORT_FLAG_AES_NI ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported support flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_round_keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data round keys.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_round_keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak round keys.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size > (size_t) SSIZE_MAX )
+	 || ( ( data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset += bytes_per_sector )
+	{
+		/* Encrypt the sector number with the tweak key
+		 */
+		tweak = _mm_set_epi64x(
+		         0,
+		         (long long) sector_number );
+
+		tweak = _mm_xor_si128(
+		         tweak,
+		         _mm_loadu_si128( (const __m128i *) tweak_round_keys ) );
+
+		for( round_index = 1;
+		     round_index < 10;
+		     round_index++ )
+		{
+			tweak = _mm_aesenc_si128(
+			         tweak,
+			         _mm_loadu_si128( (const __m128i *) &( tweak_round_keys[ round_index * 16 ] ) ) );
+		}
+		tweak = _mm_aesenclast_si128(
+		         tweak,
+		         _mm_loadu_si128( (const __m128i *) &( tweak_round_keys[ 160 ] ) ) );
+
+		_mm_storeu_si128(
+		 (__m128i *) tweak_64bit_values,
+		 tweak );
+
+		lower_64bit = tweak_64bit_values[ 0 ];
+		upper_64bit = tweak_64bit_values[ 1 ];
+
+		/* Derive the tweaks of the blocks in chunks of 32 blocks
+		 */
+		for( chunk_offset = 0;
+		     chunk_offset < bytes_per_sector;
+		     chunk_offset += chunk_size )
+		{
+			chunk_size = bytes_per_sector - chunk_offset;
+
+			if( chunk_size > 512 )
+			{
+				chunk_size = 512;
+			}
+			for( block_offset = 0;
+			     block_offset < chunk_size;
+			     block_offset += 16 )
+			{
+				_mm_storeu_si128(
+				 (__m128i *) &( tweaks[ block_offset ] ),
+				 _mm_set_epi64x(
+				  (long long) upper_64bit,
+				  (long long) lower_64bit ) );
+
+				carry_bit   = upper_64bit >> 63;
+				upper_64bit = ( upper_64bit << 1 ) | ( lower_64bit >> 63 );
+				lower_64bit = ( lower_64bit << 1 ) ^ ( carry_bit * 0x87 );
+			}
+#if defined( HAVE_LIBFSAPFS_VAES_SUPPORT )
+			if( ( support_flags & LIBFSAPFS_AES_NI_SUPPORT_FLAG_VAES ) != 0 )
+			{
+				libfsapfs_aes_ni_decrypt_xts_blocks_vaes(
+				 data_round_keys,
+				 tweaks,
+				 &( input_data[ data_offset + chunk_offset ] ),
+				 &( output_data[ data_offset + chunk_offset ] ),
+				 chunk_size );
+			}
+			else
+#endif
+			{
+				libfsapfs_aes_ni_decrypt_xts_blocks(
+				 data_round_keys,
+				 tweaks,
+				 &( input_data[ data_offset + chunk_offset ] ),
+				 &( output_data[ data_offset + chunk_offset ] ),
+				 chunk_size );
+			}
+		}
+		sector_number += 1;
+	}
+	memory_set(
+	 tweaks,
+	 0,
+	 512 );
+
+	memory_set(
+	 tweak_64bit_values,
+	 0,
+	 sizeof( uint64_t ) * 2 );
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: AES-NI not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT ) */
+}
+
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+
+/* Decrypts AES-XTS blocks using AES-NI
+ * The tweaks contain the tweak of every block and the data size must be a multiple of 16
+ */
+LIBFSAPFS_AES_NI_TARGET
+void libfsapfs_aes_ni_decrypt_xts_blocks(
+     const uint8_t *data_round_keys,
+     const uint8_t *tweaks,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size )
+{
+	__m128i round_keys[ 11 ];
+	__m128i tweak_values[ 8 ];
+
+	__m128i block0;
+	__m128i block1;
+	__m128i block2;
+	__m128i block3;
+	__m128i block4;
+	__m128i block5;
+	__m128i block6;
+	__m128i block7;
+
+	size_t data_offset = 0;
+	int round_index    = 0;
+
+	for( round_index = 0;
+	     round_index < 11;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = _mm_loadu_si128(
+		                             (const __m128i *) &( data_round_keys[ round_index * 16 ] ) );
+	}
+	/* The tweak is applied to the input with the first round key
+	 * and to the output with the last round key
+	 */
+	while( ( data_offset + 128 ) <= data_size )
+	{
+		tweak_values[ 0 ] = _mm_loadu_si128( (const __m128i *) &( tweaks[ data_offset ] ) );
+		tweak_values[ 1 ] = _mm_loadu_si128( (const __m128i *) &( tweaks[ data_offset + 16 ] ) );
+		tweak_values[ 2 ] = _mm_loadu_si128( (const __m128i *) &( tweaks[ data_offset + 32 ] ) );
+		tweak_values[ 3 ] = _mm_loadu_si128( (const __m128i *) &( tweaks[ data_offset + 48 ] ) );
+		tweak_values[ 4 ] = _mm_loadu_si128( (const __m128i *) &( tweaks[ data_offset + 64 ] ) );
+		tweak_values[ 5 ] = _mm_loadu_si128( (const __m128i *) &( tweaks[ data_offset + 80 ] ) );
+		tweak_values[ 6 ] = _mm_loadu_si128( (const __m128i *) &( tweaks[ data_offset + 96 ] ) );
+		tweak_values[ 7 ] = _mm_loadu_si128( (const __m128i *) &( tweaks[ data_offset + 112 ] ) );
+
+		block0 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( input_data[ data_offset ] ) ), _mm_xor_si128( tweak_values[ 0 ], round_keys[ 0 ] ) );
+		block1 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( input_data[ data_offset + 16 ] ) ), _mm_xor_si128( tweak_values[ 1 ], round_keys[ 0 ] ) );
+		block2 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( input_data[ data_offset + 32 ] ) ), _mm_xor_si128( tweak_values[ 2 ], round_keys[ 0 ] ) );
+		block3 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( input_data[ data_offset + 48 ] ) ), _mm_xor_si128( tweak_values[ 3 ], round_keys[ 0 ] ) );
+		block4 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( input_data[ data_offset + 64 ] ) ), _mm_xor_si128( tweak_values[ 4 ], round_keys[ 0 ] ) );
+		block5 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( input_data[ data_offset + 80 ] ) ), _mm_xor_si128( tweak_values[ 5 ], round_keys[ 0 ] ) );
+		block6 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( input_data[ data_offset + 96 ] ) ), _mm_xor_si128( tweak_values[ 6 ], round_keys[ 0 ] ) );
+		block7 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( input_data[ data_offset + 112 ] ) ), _mm_xor_si128( tweak_values[ 7 ], round_keys[ 0 ] ) );
+
+		for( round_index = 1;
+		     round_index < 10;
+		     round_index++ )
+		{
+			LIBFSAPFS_AES_NI_DECRYPT_ROUND_4( block0, block1, block2, block3, round_keys[ round_index ] )
+			LIBFSAPFS_AES_NI_DECRYPT_ROUND_4( block4, block5, block6, block7, round_keys[ round_index ] )
+		}
+		_mm_storeu_si128( (__m128i *) &( output_data[ data_offset ] ), _mm_aesdeclast_si128( block0, _mm_xor_si128( tweak_values[ 0 ], round_keys[ 10 ] ) ) );
+		_mm_storeu_si128( (__m128i *) &( output_data[ data_offset + 16 ] ), _mm_aesdeclast_si128( block1, _mm_xor_si128( tweak_values[ 1 ], round_keys[ 10 ] ) ) );
+		_mm_storeu_si128( (__m128i *) &( output_data[ data_offset + 32 ] ), _mm_aesdeclast_si128( block2, _mm_xor_si128( tweak_values[ 2 ], round_keys[ 10 ] ) ) );
+		_mm_storeu_si128( (__m128i *) &( output_data[ data_offset + 48 ] ), _mm_aesdeclast_si128( block3, _mm_xor_si128( tweak_values[ 3 ], round_keys[ 10 ] ) ) );
+		_mm_storeu_si128( (__m128i *) &( output_data[ data_offset + 64 ] ), _mm_aesdeclast_si128( block4, _mm_xor_si128( tweak_values[ 4 ], round_keys[ 10 ] ) ) );
+		_mm_storeu_si128( (__m128i *) &( output_data[ data_offset + 80 ] ), _mm_aesdeclast_si128( block5, _mm_xor_si128( tweak_values[ 5 ], round_keys[ 10 ] ) ) );
+		_mm_storeu_si128( (__m128i *) &( output_data[ data_offset + 96 ] ), _mm_aesdeclast_si128( block6, _mm_xor_si128( tweak_values[ 6 ], round_keys[ 10 ] ) ) );
+		_mm_storeu_si128( (__m128i *) &( output_data[ data_offset + 112 ] ), _mm_aesdeclast_si128( block7, _mm_xor_si128( tweak_values[ 7 ], round_keys[ 10 ] ) ) );
+
+		data_offset += 128;
+	}
+	while( ( data_offset + 16 ) <= data_size )
+	{
+		tweak_values[ 0 ] = _mm_loadu_si128( (const __m128i *) &( tweaks[ data_offset ] ) );
+
+		block0 = _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( input_data[ data_offset ] ) ), _mm_xor_si128( tweak_values[ 0 ], round_keys[ 0 ] ) );
+
+		for( round_index = 1;
+		     round_index < 10;
+		     round_index++ )
+		{
+			block0 = _mm_aesdec_si128( block0, round_keys[ round_index ] );
+		}
+		_mm_storeu_si128( (__m128i *) &( output_data[ data_offset ] ), _mm_aesdeclast_si128( block0, _mm_xor_si128( tweak_values[ 0 ], round_keys[ 10 ] ) ) );
+
+		data_offset += 16;
+	}
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT ) */
+
+#if defined( HAVE_LIBFSAPFS_VAES_SUPPORT )
+
+/* Decrypts AES-XTS blocks using VAES with 512-bit vectors
+ * The tweaks contain the tweak of every block and the data size must be a multiple of 16
+ */
+LIBFSAPFS_AES_NI_VAES_TARGET
+void libfsapfs_aes_ni_decrypt_xts_blocks_vaes(
+     const uint8_t *data_round_keys,
+     const uint8_t *tweaks,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size )
+{
+	__m512i round_keys[ 11 ];
+
+	__m512i block0;
+	__m512i block1;
+	__m512i block2;
+	__m512i block3;
+	__m512i tweak0;
+	__m512i tweak1;
+	__m512i tweak2;
+	__m512i tweak3;
+
+	size_t data_offset = 0;
+	int round_index    = 0;
+
+	for( round_index = 0;
+	     round_index < 11;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = _mm512_broadcast_i32x4(
+		                             _mm_loadu_si128( (const __m128i *) &( data_round_keys[ round_index * 16 ] ) ) );
+	}
+	while( ( data_offset + 256 ) <= data_size )
+	{
+		tweak0 = _mm512_loadu_si512( (const void *) &( tweaks[ data_offset ] ) );
+		tweak1 = _mm512_loadu_si512( (const void *) &( tweaks[ data_offset + 64 ] ) );
+		tweak2 = _mm512_loadu_si512( (const void *) &( tweaks[ data_offset + 128 ] ) );
+		tweak3 = _mm512_loadu_si512( (const void *) &( tweaks[ data_offset + 192 ] ) );
+
+		block0 = _mm512_xor_si512( _mm512_loadu_si512( (const void *) &( input_data[ data_offset ] ) ), _mm512_xor_si512( tweak0, round_keys[ 0 ] ) );
+		block1 = _mm512_xor_si512( _mm512_loadu_si512( (const void *) &( input_data[ data_offset + 64 ] ) ), _mm512_xor_si512( tweak1, round_keys[ 0 ] ) );
+		block2 = _mm512_xor_si512( _mm512_loadu_si512( (const void *) &( input_data[ data_offset + 128 ] ) ), _mm512_xor_si512( tweak2, round_keys[ 0 ] ) );
+		block3 = _mm512_xor_si512( _mm512_loadu_si512( (const void *) &( input_data[ data_offset + 192 ] ) ), _mm512_xor_si512( tweak3, round_keys[ 0 ] ) );
+
+		for( round_index = 1;
+		     round_index < 10;
+		     round_index++ )
+		{
+			block0 = _mm512_aesdec_epi128( block0, round_keys[ round_index ] );
+			block1 = _mm512_aesdec_epi128( block1, round_keys[ round_index ] );
+			block2 = _mm512_aesdec_epi128( block2, round_keys[ round_index ] );
+			block3 = _mm512_aesdec_epi128( block3, round_keys[ round_index ] );
+		}
+		_mm512_storeu_si512( (void *) &( output_data[ data_offset ] ), _mm512_aesdeclast_epi128( block0, _mm512_xor_si512( tweak0, round_keys[ 10 ] ) ) );
+		_mm512_storeu_si512( (void *) &( output_data[ data_offset + 64 ] ), _mm512_aesdeclast_epi128( block1, _mm512_xor_si512( tweak1, round_keys[ 10 ] ) ) );
+		_mm512_storeu_si512( (void *) &( output_data[ data_offset + 128 ] ), _mm512_aesdeclast_epi128( block2, _mm512_xor_si512( tweak2, round_keys[ 10 ] ) ) );
+		_mm512_storeu_si512( (void *) &( output_data[ data_offset + 192 ] ), _mm512_aesdeclast_epi128( block3, _mm512_xor_si512( tweak3, round_keys[ 10 ] ) ) );
+
+		data_offset += 256;
+	}
+	while( ( data_offset + 64 ) <= data_size )
+	{
+		tweak0 = _mm512_loadu_si512( (const void *) &( tweaks[ data_offset ] ) );
+
+		block0 = _mm512_xor_si512( _mm512_loadu_si512( (const void *) &( input_data[ data_offset ] ) ), _mm512_xor_si512( tweak0, round_keys[ 0 ] ) );
+
+		for( round_index = 1;
+		     round_index < 10;
+		     round_index++ )
+		{
+			block0 = _mm512_aesdec_epi128( block0, round_keys[ round_index ] );
+		}
+		_mm512_storeu_si512( (void *) &( output_data[ data_offset ] ), _mm512_aesdeclast_epi128( block0, _mm512_xor_si512( tweak0, round_keys[ 10 ] ) ) );
+
+		data_offset += 64;
+	}
+	if( data_offset < data_size )
+	{
+		libfsapfs_aes_ni_decrypt_xts_blocks(
+		 data_round_keys,
+		 &( tweaks[ data_offset ] ),
+		 &( input_data[ data_offset ] ),
+		 &( output_data[ data_offset ] ),
+		 data_size - data_offset );
+	}
+}
+
+#endif /* defined( HAVE_LIBFSAPFS_VAES_SUPPORT ) */
+
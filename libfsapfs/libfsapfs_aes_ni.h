@@ -0,0 +1,99 @@
+/*
+ * Hardware accelerated AES (AES-NI and VAES) functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_AES_NI_H )
+#define _LIBFSAPFS_AES_NI_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* HAVE_AES_NI_INTRINSICS and HAVE_VAES_INTRINSICS are determined by configure
+ * or defined by the Visual Studio project
+ */
+#if defined( HAVE_AES_NI_INTRINSICS ) && ( defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 ) )
+#define HAVE_LIBFSAPFS_AES_NI_SUPPORT
+
+#if defined( HAVE_VAES_INTRINSICS ) && !defined( _MSC_VER )
+#define HAVE_LIBFSAPFS_VAES_SUPPORT
+#endif
+#endif
+
+/* The size of the AES-128 round keys
+ */
+#define LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE	( 11 * 16 )
+
+int libfsapfs_aes_ni_get_support_flags(
+     uint8_t *support_flags,
+     libcerror_error_t **error );
+
+int libfsapfs_aes_ni_set_key(
+     uint8_t *round_keys,
+     size_t round_keys_size,
+     int mode,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
+int libfsapfs_aes_ni_decrypt_xts(
+     uint8_t support_flags,
+     const uint8_t *data_round_keys,
+     const uint8_t *tweak_round_keys,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t sector_number,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT )
+
+void libfsapfs_aes_ni_decrypt_xts_blocks(
+     const uint8_t *data_round_keys,
+     const uint8_t *tweaks,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size );
+
+#endif /* defined( HAVE_LIBFSAPFS_AES_NI_SUPPORT ) */
+
+#if defined( HAVE_LIBFSAPFS_VAES_SUPPORT )
+
+void libfsapfs_aes_ni_decrypt_xts_blocks_vaes(
+     const uint8_t *data_round_keys,
+     const uint8_t *tweaks,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size );
+
+#endif /* defined( HAVE_LIBFSAPFS_VAES_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_AES_NI_H ) */
+
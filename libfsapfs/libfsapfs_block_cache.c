@@ -0,0 +1,1171 @@
+/*
+ * Block cache functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_block_cache.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_libfcache.h"
+#include "libfsapfs_libfdata.h"
+
+/* The block cache is shared by all the data block vectors of a container.
+ * The cache entries are keyed by the physical block number, so that a block
+ * that is read by different B-trees or data handles is cached only once.
+ * A physical block has a single decoded form: it is either stored unencrypted
+ * or encrypted with the key of the volume it belongs to.
+ * The cache entries are distributed over a number of shards, based on the
+ * physical block number. Every shard has its own lock so that lookups of blocks
+ * in different shards do not contend with each other.
+ */
+
+/* Creates a block cache
+ * Make sure the value block_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_initialize(
+     libfsapfs_block_cache_t **block_cache,
+     int maximum_number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	libfsapfs_block_cache_shard_t *shard = NULL;
+	static char *function                = "libfsapfs_block_cache_initialize";
+	size_t shards_size                   = 0;
+	int maximum_number_of_shard_entries  = 0;
+	int shard_index                      = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of cache entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*block_cache = memory_allocate_structure(
+	                libfsapfs_block_cache_t );
+
+	if( *block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_cache,
+	     0,
+	     sizeof( libfsapfs_block_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block cache.",
+		 function );
+
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+
+		return( -1 );
+	}
+	shards_size = sizeof( libfsapfs_block_cache_shard_t ) * LIBFSAPFS_BLOCK_CACHE_NUMBER_OF_SHARDS;
+
+	( *block_cache )->shards = (libfsapfs_block_cache_shard_t *) memory_allocate(
+	                                                              shards_size );
+
+	if( ( *block_cache )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *block_cache )->shards,
+	     0,
+	     shards_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		memory_free(
+		 ( *block_cache )->shards );
+
+		( *block_cache )->shards = NULL;
+
+		goto on_error;
+	}
+	maximum_number_of_shard_entries = maximum_number_of_cache_entries / LIBFSAPFS_BLOCK_CACHE_NUMBER_OF_SHARDS;
+
+	if( ( maximum_number_of_cache_entries % LIBFSAPFS_BLOCK_CACHE_NUMBER_OF_SHARDS ) != 0 )
+	{
+		maximum_number_of_shard_entries += 1;
+	}
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_BLOCK_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		shard = &( ( *block_cache )->shards[ shard_index ] );
+
+		if( libfcache_cache_initialize(
+		     &( shard->cache ),
+		     maximum_number_of_shard_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d cache.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( libfcache_cache_initialize(
+		     &( shard->read_cache ),
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d read cache.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_initialize(
+		     &( shard->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize shard: %d read/write lock.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+		( *block_cache )->number_of_shards += 1;
+	}
+	( *block_cache )->maximum_number_of_cache_entries = maximum_number_of_cache_entries;
+
+	return( 1 );
+
+on_error:
+	if( *block_cache != NULL )
+	{
+		libfsapfs_block_cache_free(
+		 block_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a block cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_free(
+     libfsapfs_block_cache_t **block_cache,
+     libcerror_error_t **error )
+{
+	libfsapfs_block_cache_shard_t *shard = NULL;
+	static char *function                = "libfsapfs_block_cache_free";
+	int result                           = 1;
+	int shard_index                      = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+		if( ( *block_cache )->shards != NULL )
+		{
+			/* The shards are cleared on initialization so that
+			 * partially initialized shards are freed as well
+			 */
+			for( shard_index = 0;
+			     shard_index < LIBFSAPFS_BLOCK_CACHE_NUMBER_OF_SHARDS;
+			     shard_index++ )
+			{
+				shard = &( ( *block_cache )->shards[ shard_index ] );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+				if( shard->read_write_lock != NULL )
+				{
+					if( libcthreads_read_write_lock_free(
+					     &( shard->read_write_lock ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d read/write lock.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+#endif
+				if( shard->cache != NULL )
+				{
+					if( libfcache_cache_free(
+					     &( shard->cache ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d cache.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+				if( shard->read_cache != NULL )
+				{
+					if( libfcache_cache_free(
+					     &( shard->read_cache ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d read cache.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 ( *block_cache )->shards );
+		}
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+	}
+	return( result );
+}
+
+/* Empties a block cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_empty(
+     libfsapfs_block_cache_t *block_cache,
+     libcerror_error_t **error )
+{
+	libfsapfs_block_cache_shard_t *shard = NULL;
+	static char *function                = "libfsapfs_block_cache_empty";
+	int result                           = 1;
+	int shard_index                      = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < block_cache->number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( block_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d read/write lock for writing.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( libfcache_cache_empty(
+		     shard->cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to empty shard: %d cache.",
+			 function,
+			 shard_index );
+
+			result = -1;
+		}
+		if( libfcache_cache_empty(
+		     shard->read_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to empty shard: %d read cache.",
+			 function,
+			 shard_index );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d read/write lock for writing.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Resizes a block cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_resize(
+     libfsapfs_block_cache_t *block_cache,
+     int maximum_number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	libfsapfs_block_cache_shard_t *shard = NULL;
+	static char *function                = "libfsapfs_block_cache_resize";
+	int maximum_number_of_shard_entries  = 0;
+	int result                           = 1;
+	int shard_index                      = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_cache->number_of_shards <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block cache - number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of cache entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_shard_entries = maximum_number_of_cache_entries / block_cache->number_of_shards;
+
+	if( ( maximum_number_of_cache_entries % block_cache->number_of_shards ) != 0 )
+	{
+		maximum_number_of_shard_entries += 1;
+	}
+	for( shard_index = 0;
+	     shard_index < block_cache->number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( block_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d read/write lock for writing.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( libfcache_cache_resize(
+		     shard->cache,
+		     maximum_number_of_shard_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize shard: %d cache.",
+			 function,
+			 shard_index );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d read/write lock for writing.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+	block_cache->maximum_number_of_cache_entries = maximum_number_of_cache_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the shard of a specific physical block number
+ * Consecutive block numbers map onto consecutive shards
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_get_shard_by_block_number(
+     libfsapfs_block_cache_t *block_cache,
+     uint64_t block_number,
+     libfsapfs_block_cache_shard_t **shard,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_block_cache_get_shard_by_block_number";
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_cache->number_of_shards <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block cache - number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	*shard = &( block_cache->shards[ block_number % (uint64_t) block_cache->number_of_shards ] );
+
+	return( 1 );
+}
+
+/* Retrieves the cache entry index of a specific physical block number within its shard
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_get_cache_entry_index(
+     libfsapfs_block_cache_t *block_cache,
+     libfsapfs_block_cache_shard_t *shard,
+     uint64_t block_number,
+     int *cache_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfsapfs_block_cache_get_cache_entry_index";
+	int number_of_cache_entries = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_cache->number_of_shards <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block cache - number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     shard->cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block numbers of a shard differ by a multiple of the number of shards
+	 */
+	*cache_entry_index = (int) ( ( block_number / (uint64_t) block_cache->number_of_shards ) % (uint64_t) number_of_cache_entries );
+
+	return( 1 );
+}
+
+/* Retrieves the value of a specific element of a data block vector
+ * The element is cached by the physical block number it is stored in, which
+ * is shared by all the data block vectors of the container, so that a block
+ * that is read by different B-trees or data handles is only cached once
+ * On success the shard of the block remains locked and the element value is
+ * valid until libfsapfs_block_cache_release_element_value_by_block_number
+ * is called. On error the shard is released.
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_get_element_value_by_index(
+     libfsapfs_block_cache_t *block_cache,
+     libfdata_vector_t *vector,
+     libbfio_handle_t *file_io_handle,
+     int element_index,
+     uint64_t block_number,
+     intptr_t **element_value,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	libfsapfs_block_cache_shard_t *shard = NULL;
+	static char *function                = "libfsapfs_block_cache_get_element_value_by_index";
+	off64_t cache_value_offset           = 0;
+	int64_t cache_value_timestamp        = 0;
+	int cache_entry_index                = 0;
+	int cache_value_file_index           = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_number > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid element value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_block_cache_get_shard_by_block_number(
+	     block_cache,
+	     block_number,
+	     &shard,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard of block: %" PRIu64 ".",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_block_cache_get_cache_entry_index(
+	     block_cache,
+	     shard,
+	     block_number,
+	     &cache_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry index of block: %" PRIu64 ".",
+		 function,
+		 block_number );
+
+		goto on_error;
+	}
+	if( libfcache_cache_get_value_by_index(
+	     shard->cache,
+	     cache_entry_index,
+	     &cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry: %d value.",
+		 function,
+		 cache_entry_index );
+
+		goto on_error;
+	}
+	*element_value = NULL;
+
+	if( cache_value != NULL )
+	{
+		if( libfcache_cache_value_get_identifier(
+		     cache_value,
+		     &cache_value_file_index,
+		     &cache_value_offset,
+		     &cache_value_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache value identifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( cache_value_file_index == 0 )
+		 && ( cache_value_offset == (off64_t) block_number ) )
+		{
+			if( libfcache_cache_value_get_value(
+			     cache_value,
+			     element_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache value.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( *element_value == NULL )
+	{
+		if( libfsapfs_block_cache_add_miss(
+		     block_cache,
+		     block_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add miss of block: %" PRIu64 ".",
+			 function,
+			 block_number );
+
+			goto on_error;
+		}
+		/* The read cache only passes the data block from the read callback of
+		 * the vector, which hands it over to the block cache, hence it is ignored
+		 * on lookup
+		 */
+		if( libfdata_vector_get_element_value_by_index(
+		     vector,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) shard->read_cache,
+		     element_index,
+		     element_value,
+		     LIBFDATA_READ_FLAG_IGNORE_CACHE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d value.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	shard->number_of_lookups += 1;
+
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 shard->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Releases the shard of a specific block retrieved by
+ * libfsapfs_block_cache_get_element_value_by_index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_release_element_value_by_block_number(
+     libfsapfs_block_cache_t *block_cache,
+     uint64_t block_number,
+     libcerror_error_t **error )
+{
+	libfsapfs_block_cache_shard_t *shard = NULL;
+	static char *function                = "libfsapfs_block_cache_release_element_value_by_block_number";
+
+	if( libfsapfs_block_cache_get_shard_by_block_number(
+	     block_cache,
+	     block_number,
+	     &shard,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard of block: %" PRIu64 ".",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the value of a specific block
+ * The block cache takes over management of the element value
+ * This function is called by the data block vector read callbacks, while the shard
+ * of the block is locked by libfsapfs_block_cache_get_element_value_by_index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_set_element_value_by_block_number(
+     libfsapfs_block_cache_t *block_cache,
+     uint64_t block_number,
+     intptr_t *element_value,
+     int (*free_element_value)(
+            intptr_t **element_value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libfsapfs_block_cache_shard_t *shard = NULL;
+	static char *function                = "libfsapfs_block_cache_set_element_value_by_block_number";
+	int cache_entry_index                = 0;
+
+	if( block_number > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_block_cache_get_shard_by_block_number(
+	     block_cache,
+	     block_number,
+	     &shard,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard of block: %" PRIu64 ".",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+	if( libfsapfs_block_cache_get_cache_entry_index(
+	     block_cache,
+	     shard,
+	     block_number,
+	     &cache_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry index of block: %" PRIu64 ".",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+	if( libfcache_cache_set_value_by_index(
+	     shard->cache,
+	     cache_entry_index,
+	     0,
+	     (off64_t) block_number,
+	     0,
+	     element_value,
+	     free_element_value,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set cache entry: %d value.",
+		 function,
+		 cache_entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds a miss for a specific block
+ * This function is called while the shard of the block is locked
+ * by libfsapfs_block_cache_get_element_value_by_index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_add_miss(
+     libfsapfs_block_cache_t *block_cache,
+     uint64_t block_number,
+     libcerror_error_t **error )
+{
+	libfsapfs_block_cache_shard_t *shard = NULL;
+	static char *function                = "libfsapfs_block_cache_add_miss";
+
+	if( libfsapfs_block_cache_get_shard_by_block_number(
+	     block_cache,
+	     block_number,
+	     &shard,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard of block: %" PRIu64 ".",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+	shard->number_of_misses += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the cache statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_block_cache_get_statistics(
+     libfsapfs_block_cache_t *block_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libfsapfs_block_cache_shard_t *shard = NULL;
+	static char *function                = "libfsapfs_block_cache_get_statistics";
+	uint64_t safe_number_of_lookups      = 0;
+	uint64_t safe_number_of_misses       = 0;
+	int shard_index                      = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < block_cache->number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( block_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d read/write lock for reading.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_number_of_lookups += shard->number_of_lookups;
+		safe_number_of_misses  += shard->number_of_misses;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d read/write lock for reading.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	/* A miss of a lookup that failed is not counted as a lookup
+	 */
+	if( safe_number_of_misses > safe_number_of_lookups )
+	{
+		safe_number_of_misses = safe_number_of_lookups;
+	}
+	*number_of_hits   = safe_number_of_lookups - safe_number_of_misses;
+	*number_of_misses = safe_number_of_misses;
+
+	return( 1 );
+}
+
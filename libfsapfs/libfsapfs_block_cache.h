@@ -0,0 +1,152 @@
+/*
+ * Block cache functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_BLOCK_CACHE_H )
+#define _LIBFSAPFS_BLOCK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_libfcache.h"
+#include "libfsapfs_libfdata.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_block_cache_shard libfsapfs_block_cache_shard_t;
+
+struct libfsapfs_block_cache_shard
+{
+	/* The cache
+	 */
+	libfcache_cache_t *cache;
+
+	/* The cache used to read the elements of a data block vector
+	 */
+	libfcache_cache_t *read_cache;
+
+	/* The number of lookups
+	 */
+	uint64_t number_of_lookups;
+
+	/* The number of misses
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+typedef struct libfsapfs_block_cache libfsapfs_block_cache_t;
+
+struct libfsapfs_block_cache
+{
+	/* The maximum number of cache entries
+	 */
+	int maximum_number_of_cache_entries;
+
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The shards
+	 */
+	libfsapfs_block_cache_shard_t *shards;
+};
+
+int libfsapfs_block_cache_initialize(
+     libfsapfs_block_cache_t **block_cache,
+     int maximum_number_of_cache_entries,
+     libcerror_error_t **error );
+
+int libfsapfs_block_cache_free(
+     libfsapfs_block_cache_t **block_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_block_cache_empty(
+     libfsapfs_block_cache_t *block_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_block_cache_resize(
+     libfsapfs_block_cache_t *block_cache,
+     int maximum_number_of_cache_entries,
+     libcerror_error_t **error );
+
+int libfsapfs_block_cache_get_shard_by_block_number(
+     libfsapfs_block_cache_t *block_cache,
+     uint64_t block_number,
+     libfsapfs_block_cache_shard_t **shard,
+     libcerror_error_t **error );
+
+int libfsapfs_block_cache_get_cache_entry_index(
+     libfsapfs_block_cache_t *block_cache,
+     libfsapfs_block_cache_shard_t *shard,
+     uint64_t block_number,
+     int *cache_entry_index,
+     libcerror_error_t **error );
+
+int libfsapfs_block_cache_get_element_value_by_index(
+     libfsapfs_block_cache_t *block_cache,
+     libfdata_vector_t *vector,
+     libbfio_handle_t *file_io_handle,
+     int element_index,
+     uint64_t block_number,
+     intptr_t **element_value,
+     libcerror_error_t **error );
+
+int libfsapfs_block_cache_release_element_value_by_block_number(
+     libfsapfs_block_cache_t *block_cache,
+     uint64_t block_number,
+     libcerror_error_t **error );
+
+int libfsapfs_block_cache_set_element_value_by_block_number(
+     libfsapfs_block_cache_t *block_cache,
+     uint64_t block_number,
+     intptr_t *element_value,
+     int (*free_element_value)(
+            intptr_t **element_value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libfsapfs_block_cache_add_miss(
+     libfsapfs_block_cache_t *block_cache,
+     uint64_t block_number,
+     libcerror_error_t **error );
+
+int libfsapfs_block_cache_get_statistics(
+     libfsapfs_block_cache_t *block_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_BLOCK_CACHE_H ) */
+
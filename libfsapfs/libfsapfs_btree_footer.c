@@ -216,6 +216,10 @@ int libfsapfs_btree_footer_read_data(
 	 ( (fsapfs_btree_footer_t *) data )->maximum_value_size,
 	 btree_footer->maximum_value_size );
 
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsapfs_btree_footer_t *) data )->total_number_of_keys,
+	 btree_footer->total_number_of_keys );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -256,13 +260,10 @@ int libfsapfs_btree_footer_read_data(
 		 function,
 		 btree_footer->maximum_value_size );
 
-		byte_stream_copy_to_uint64_little_endian(
-		 ( (fsapfs_btree_footer_t *) data )->total_number_of_keys,
-		 value_64bit );
 		libcnotify_printf(
 		 "%s: total number of keys\t\t\t: %" PRIu64 "\n",
 		 function,
-		 value_64bit );
+		 btree_footer->total_number_of_keys );
 
 		byte_stream_copy_to_uint64_little_endian(
 		 ( (fsapfs_btree_footer_t *) data )->total_number_of_nodes,
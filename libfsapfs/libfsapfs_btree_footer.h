@@ -54,6 +54,10 @@ struct libfsapfs_btree_footer
 	/* The maximum value size
 	 */
 	uint32_t maximum_value_size;
+
+	/* The total number of keys
+	 */
+	uint64_t total_number_of_keys;
 };
 
 int libfsapfs_btree_footer_initialize(
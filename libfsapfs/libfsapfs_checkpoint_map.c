@@ -164,6 +164,16 @@ int libfsapfs_checkpoint_map_free(
 
 			result = -1;
 		}
+		if( ( *checkpoint_map )->index_entries != NULL )
+		{
+			memory_free(
+			 ( *checkpoint_map )->index_entries );
+		}
+		if( ( *checkpoint_map )->sorted_entries != NULL )
+		{
+			memory_free(
+			 ( *checkpoint_map )->sorted_entries );
+		}
 		memory_free(
 		 *checkpoint_map );
 
@@ -207,27 +217,11 @@ int libfsapfs_checkpoint_map_read_file_io_handle(
 		 file_offset );
 	}
 #endif
-	if( libbfio_handle_seek_offset(
-	     file_io_handle,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek checkpoint map offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 file_offset,
-		 file_offset );
-
-		return( -1 );
-	}
-	read_count = libbfio_handle_read_buffer(
+	read_count = libbfio_handle_read_buffer_at_offset(
 	              file_io_handle,
 	              (uint8_t *) &checkpoint_map_data,
 	              4096,
+	              file_offset,
 	              error );
 
 	if( read_count != (ssize_t) 4096 )
@@ -236,8 +230,10 @@ int libfsapfs_checkpoint_map_read_file_io_handle(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read checkpoint map data.",
-		 function );
+		 "%s: unable to read checkpoint map data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
 
 		return( -1 );
 	}
@@ -278,6 +274,7 @@ int libfsapfs_checkpoint_map_read_data(
 	uint32_t object_subtype                     = 0;
 	uint32_t object_type                        = 0;
 	int entry_index                             = 0;
+	int first_entry_index                       = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	uint64_t value_64bit                        = 0;
@@ -468,6 +465,20 @@ int libfsapfs_checkpoint_map_read_data(
 
 		goto on_error;
 	}
+	if( libcdata_array_get_number_of_entries(
+	     checkpoint_map->entries_array,
+	     &first_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from array.",
+		 function );
+
+		goto on_error;
+	}
 	for( map_entry_index = 0;
 	     map_entry_index < number_of_map_entries;
 	     map_entry_index++ )
@@ -530,6 +541,20 @@ int libfsapfs_checkpoint_map_read_data(
 		}
 		map_entry = NULL;
 	}
+	if( libfsapfs_checkpoint_map_build_index(
+	     checkpoint_map,
+	     first_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build index.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -542,19 +567,27 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the physical address of a specific object identifier
- * Returns 1 if successful, 0 if no such value or -1 on error
+/* Builds the index of the checkpoint map entries
+ * The entries from first entry index onwards are the entries read from the last
+ * checkpoint map block, these are merged into the previously sorted entries
+ * Returns 1 if successful or -1 on error
  */
-int libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
+int libfsapfs_checkpoint_map_build_index(
      libfsapfs_checkpoint_map_t *checkpoint_map,
-     uint64_t object_identifier,
-     uint64_t *physical_address,
+     int first_entry_index,
      libcerror_error_t **error )
 {
-	libfsapfs_checkpoint_map_entry_t *map_entry = NULL;
-	static char *function                       = "libfsapfs_checkpoint_map_get_physical_address_by_object_identifier";
-	int entry_index                             = 0;
-	int number_of_entries                       = 0;
+	libfsapfs_checkpoint_map_entry_t *block_entries  = NULL;
+	libfsapfs_checkpoint_map_entry_t *index_entries  = NULL;
+	libfsapfs_checkpoint_map_entry_t *map_entry      = NULL;
+	libfsapfs_checkpoint_map_entry_t *sorted_entries = NULL;
+	static char *function                            = "libfsapfs_checkpoint_map_build_index";
+	size_t index_entries_size                        = 0;
+	int block_entry_index                            = 0;
+	int entry_index                                  = 0;
+	int number_of_block_entries                      = 0;
+	int number_of_entries                            = 0;
+	int sorted_entry_index                           = 0;
 
 	if( checkpoint_map == NULL )
 	{
@@ -567,13 +600,13 @@ int libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
 
 		return( -1 );
 	}
-	if( physical_address == NULL )
+	if( first_entry_index != checkpoint_map->number_of_sorted_entries )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid physical address.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first entry index value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -592,10 +625,47 @@ int libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
 
 		return( -1 );
 	}
-	for( entry_index = 0;
-	     entry_index < number_of_entries;
-	     entry_index++ )
+	if( ( number_of_entries < first_entry_index )
+	 || ( (size_t) number_of_entries >= ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsapfs_checkpoint_map_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_block_entries = number_of_entries - first_entry_index;
+
+	if( number_of_block_entries == 0 )
+	{
+		return( 1 );
+	}
+	block_entries = (libfsapfs_checkpoint_map_entry_t *) memory_allocate(
+	                                                       sizeof( libfsapfs_checkpoint_map_entry_t ) * number_of_block_entries );
+
+	if( block_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block entries.",
+		 function );
+
+		goto on_error;
+	}
+	/* A checkpoint map block contains at most 101 entries,
+	 * hence an insertion sort is used to sort the entries of the block
+	 */
+	for( block_entry_index = 0;
+	     block_entry_index < number_of_block_entries;
+	     block_entry_index++ )
 	{
+		entry_index = first_entry_index + block_entry_index;
+
 		if( libcdata_array_get_entry_by_index(
 		     checkpoint_map->entries_array,
 		     entry_index,
@@ -610,7 +680,7 @@ int libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
 			 function,
 			 entry_index );
 
-			return( -1 );
+			goto on_error;
 		}
 		if( map_entry == NULL )
 		{
@@ -622,16 +692,342 @@ int libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
 			 function,
 			 entry_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( object_identifier == map_entry->object_identifier )
+		sorted_entry_index = block_entry_index;
+
+		while( ( sorted_entry_index > 0 )
+		    && ( block_entries[ sorted_entry_index - 1 ].object_identifier > map_entry->object_identifier ) )
 		{
-			*physical_address = map_entry->physical_address;
+			block_entries[ sorted_entry_index ].object_identifier = block_entries[ sorted_entry_index - 1 ].object_identifier;
+			block_entries[ sorted_entry_index ].physical_address  = block_entries[ sorted_entry_index - 1 ].physical_address;
 
-			return( 1 );
+			sorted_entry_index--;
 		}
-		map_entry = NULL;
+		block_entries[ sorted_entry_index ].object_identifier = map_entry->object_identifier;
+		block_entries[ sorted_entry_index ].physical_address  = map_entry->physical_address;
 	}
-	return( 0 );
+	sorted_entries = (libfsapfs_checkpoint_map_entry_t *) memory_reallocate(
+	                                                        checkpoint_map->sorted_entries,
+	                                                        sizeof( libfsapfs_checkpoint_map_entry_t ) * number_of_entries );
+
+	if( sorted_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize sorted entries.",
+		 function );
+
+		goto on_error;
+	}
+	checkpoint_map->sorted_entries = sorted_entries;
+
+	/* Merge the sorted block entries into the previously sorted entries,
+	 * starting at the end so that the merge can be done in place
+	 */
+	entry_index        = number_of_entries - 1;
+	sorted_entry_index = first_entry_index - 1;
+	block_entry_index  = number_of_block_entries - 1;
+
+	while( block_entry_index >= 0 )
+	{
+		if( ( sorted_entry_index >= 0 )
+		 && ( sorted_entries[ sorted_entry_index ].object_identifier > block_entries[ block_entry_index ].object_identifier ) )
+		{
+			sorted_entries[ entry_index ].object_identifier = sorted_entries[ sorted_entry_index ].object_identifier;
+			sorted_entries[ entry_index ].physical_address  = sorted_entries[ sorted_entry_index ].physical_address;
+
+			sorted_entry_index--;
+		}
+		else
+		{
+			sorted_entries[ entry_index ].object_identifier = block_entries[ block_entry_index ].object_identifier;
+			sorted_entries[ entry_index ].physical_address  = block_entries[ block_entry_index ].physical_address;
+
+			block_entry_index--;
+		}
+		entry_index--;
+	}
+	checkpoint_map->number_of_sorted_entries = number_of_entries;
+
+	memory_free(
+	 block_entries );
+
+	block_entries = NULL;
+
+	index_entries_size = sizeof( libfsapfs_checkpoint_map_entry_t ) * ( number_of_entries + 1 );
+
+	index_entries = (libfsapfs_checkpoint_map_entry_t *) memory_allocate(
+	                                                       index_entries_size );
+
+	if( index_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     index_entries,
+	     0,
+	     index_entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( checkpoint_map->index_entries != NULL )
+	{
+		memory_free(
+		 checkpoint_map->index_entries );
+	}
+	checkpoint_map->index_entries           = index_entries;
+	checkpoint_map->number_of_index_entries = number_of_entries;
+
+	index_entries = NULL;
+
+	sorted_entry_index = 0;
+
+	if( libfsapfs_checkpoint_map_fill_index(
+	     checkpoint_map,
+	     sorted_entries,
+	     &sorted_entry_index,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to fill index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( index_entries != NULL )
+	{
+		memory_free(
+		 index_entries );
+	}
+	if( block_entries != NULL )
+	{
+		memory_free(
+		 block_entries );
+	}
+	return( -1 );
+}
+
+/* Fills the index from the sorted entries
+ * The index entries are filled by an in-order traversal of the implicit tree,
+ * where the children of index entry N are 2N and 2N + 1
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_checkpoint_map_fill_index(
+     libfsapfs_checkpoint_map_t *checkpoint_map,
+     libfsapfs_checkpoint_map_entry_t *sorted_entries,
+     int *sorted_entry_index,
+     int index_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_checkpoint_map_fill_index";
+
+	if( checkpoint_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint map.",
+		 function );
+
+		return( -1 );
+	}
+	if( checkpoint_map->index_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid checkpoint map - missing index entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( sorted_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sorted entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( sorted_entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sorted entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_entry_index <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid index entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_entry_index > checkpoint_map->number_of_index_entries )
+	{
+		return( 1 );
+	}
+	if( libfsapfs_checkpoint_map_fill_index(
+	     checkpoint_map,
+	     sorted_entries,
+	     sorted_entry_index,
+	     2 * index_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to fill index entry: %d.",
+		 function,
+		 2 * index_entry_index );
+
+		return( -1 );
+	}
+	if( ( *sorted_entry_index < 0 )
+	 || ( *sorted_entry_index >= checkpoint_map->number_of_index_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sorted entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	checkpoint_map->index_entries[ index_entry_index ].object_identifier = sorted_entries[ *sorted_entry_index ].object_identifier;
+	checkpoint_map->index_entries[ index_entry_index ].physical_address  = sorted_entries[ *sorted_entry_index ].physical_address;
+
+	*sorted_entry_index += 1;
+
+	if( libfsapfs_checkpoint_map_fill_index(
+	     checkpoint_map,
+	     sorted_entries,
+	     sorted_entry_index,
+	     ( 2 * index_entry_index ) + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to fill index entry: %d.",
+		 function,
+		 ( 2 * index_entry_index ) + 1 );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the physical address of a specific object identifier
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
+     libfsapfs_checkpoint_map_t *checkpoint_map,
+     uint64_t object_identifier,
+     uint64_t *physical_address,
+     libcerror_error_t **error )
+{
+	libfsapfs_checkpoint_map_entry_t *index_entries = NULL;
+	static char *function                           = "libfsapfs_checkpoint_map_get_physical_address_by_object_identifier";
+	int index_entry_index                           = 0;
+	int number_of_index_entries                     = 0;
+
+	if( checkpoint_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint map.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_address == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid physical address.",
+		 function );
+
+		return( -1 );
+	}
+	index_entries           = checkpoint_map->index_entries;
+	number_of_index_entries = checkpoint_map->number_of_index_entries;
+
+	if( ( index_entries == NULL )
+	 || ( number_of_index_entries <= 0 ) )
+	{
+		return( 0 );
+	}
+	/* Descend the implicit tree, where every step goes to the left child
+	 * if the object identifier is less than or equal to that of the index entry
+	 */
+	index_entry_index = 1;
+
+	while( index_entry_index <= number_of_index_entries )
+	{
+		index_entry_index = ( 2 * index_entry_index ) + ( index_entries[ index_entry_index ].object_identifier < object_identifier );
+	}
+	/* The last step to the left child was made from the first index entry with an object identifier
+	 * equal to or greater than the lookup identifier, which is retrieved by removing the steps to
+	 * the right child made after it
+	 */
+	while( ( index_entry_index & 1 ) != 0 )
+	{
+		index_entry_index >>= 1;
+	}
+	index_entry_index >>= 1;
+
+	if( ( index_entry_index == 0 )
+	 || ( index_entries[ index_entry_index ].object_identifier != object_identifier ) )
+	{
+		return( 0 );
+	}
+	*physical_address = index_entries[ index_entry_index ].physical_address;
+
+	return( 1 );
 }
 
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_checkpoint_map_entry.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
@@ -40,6 +41,23 @@ struct libfsapfs_checkpoint_map
 	/* The entries array
 	 */
 	libcdata_array_t *entries_array;
+
+	/* The entries sorted by object identifier
+	 */
+	libfsapfs_checkpoint_map_entry_t *sorted_entries;
+
+	/* The number of sorted entries
+	 */
+	int number_of_sorted_entries;
+
+	/* The index entries, which are the entries sorted by object identifier in Eytzinger layout
+	 * The first index entry is unused so that the children of index entry N are 2N and 2N + 1
+	 */
+	libfsapfs_checkpoint_map_entry_t *index_entries;
+
+	/* The number of index entries, not including the first unused index entry
+	 */
+	int number_of_index_entries;
 };
 
 int libfsapfs_checkpoint_map_initialize(
@@ -62,6 +80,18 @@ int libfsapfs_checkpoint_map_read_data(
      size_t data_size,
      libcerror_error_t **error );
 
+int libfsapfs_checkpoint_map_build_index(
+     libfsapfs_checkpoint_map_t *checkpoint_map,
+     int first_entry_index,
+     libcerror_error_t **error );
+
+int libfsapfs_checkpoint_map_fill_index(
+     libfsapfs_checkpoint_map_t *checkpoint_map,
+     libfsapfs_checkpoint_map_entry_t *sorted_entries,
+     int *sorted_entry_index,
+     int index_entry_index,
+     libcerror_error_t **error );
+
 int libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
      libfsapfs_checkpoint_map_t *checkpoint_map,
      uint64_t object_identifier,
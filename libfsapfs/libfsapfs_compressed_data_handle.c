@@ -26,26 +26,37 @@
 
 #include "libfsapfs_compressed_data_handle.h"
 #include "libfsapfs_compression.h"
+#include "libfsapfs_decompressed_block_cache.h"
+#include "libfsapfs_decompression_job.h"
 #include "libfsapfs_definitions.h"
+#include "libfsapfs_io_handle.h"
+#include "libfsapfs_job_pool.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
+#include "libfsapfs_profiler.h"
 #include "libfsapfs_unused.h"
 
-#define LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE	65536
+#define LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE			65536
+#define LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_NUMBER_OF_READ_BLOCKS	32
 
 /* Creates compressed data handle
  * Make sure the value data_handle is referencing, is set to NULL
+ * The IO handle is optional and provides the decompression pool used for large reads
+ * and the cache size budget the decompressed blocks are counted against
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_compressed_data_handle_initialize(
      libfsapfs_compressed_data_handle_t **data_handle,
+     libfsapfs_io_handle_t *io_handle,
      libfdata_stream_t *compressed_data_stream,
      size64_t uncompressed_data_size,
      int compression_method,
      libcerror_error_t **error )
 {
-	static char *function = "libfsapfs_compressed_data_handle_initialize";
+	static char *function                = "libfsapfs_compressed_data_handle_initialize";
+	size64_t number_of_blocks            = 0;
+	int number_of_cache_entries          = 0;
 
 	if( data_handle == NULL )
 	{
@@ -140,37 +151,170 @@ int libfsapfs_compressed_data_handle_initialize(
 
 		goto on_error;
 	}
+	number_of_blocks = uncompressed_data_size / LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+
+	if( ( uncompressed_data_size % LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ) != 0 )
+	{
+		number_of_blocks += 1;
+	}
 	if( compression_method != LIBFSAPFS_COMPRESSION_METHOD_UNKNOWN5 )
 	{
-		( *data_handle )->segment_data = (uint8_t *) memory_allocate(
-		                                              sizeof( uint8_t ) * LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE );
+		/* Keep multiple decompressed blocks so that random and interleaved reads
+		 * do not decompress the same block over and over again
+		 */
+		if( number_of_blocks > (size64_t) LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DECOMPRESSED_BLOCKS )
+		{
+			number_of_cache_entries = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DECOMPRESSED_BLOCKS;
+		}
+		else if( number_of_blocks == 0 )
+		{
+			number_of_cache_entries = 1;
+		}
+		else
+		{
+			number_of_cache_entries = (int) number_of_blocks;
+		}
+		if( io_handle != NULL )
+		{
+			/* The decompressed blocks are counted against the cache size budget of the IO handle
+			 * in units of a decompressed block. The decompressed block cache also serves
+			 * as the decompression buffer hence at least 1 block is reserved
+			 */
+			if( libfsapfs_io_handle_reserve_cache_entries_of_size(
+			     io_handle,
+			     LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+			     LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE,
+			     (size64_t) number_of_cache_entries * LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE,
+			     &( ( *data_handle )->number_of_reserved_block_cache_entries ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to reserve decompressed block cache entries.",
+				 function );
 
-		if( ( *data_handle )->segment_data == NULL )
+				goto on_error;
+			}
+			number_of_cache_entries = ( *data_handle )->number_of_reserved_block_cache_entries;
+		}
+		if( libfsapfs_decompressed_block_cache_initialize(
+		     &( ( *data_handle )->block_cache ),
+		     number_of_cache_entries,
+		     LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create segment data.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create decompressed block cache.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	( *data_handle )->compressed_data_stream         = compressed_data_stream;
-	( *data_handle )->current_compressed_block_index = (uint32_t) -1;
-	( *data_handle )->uncompressed_data_size         = uncompressed_data_size;
-	( *data_handle )->compression_method             = compression_method;
+	/* The compressed data of a run of adjacent compressed blocks is read into
+	 * a buffer that is kept for the lifetime of the data handle
+	 */
+	if( number_of_blocks > (size64_t) LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_NUMBER_OF_READ_BLOCKS )
+	{
+		( *data_handle )->maximum_number_of_read_blocks = LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_NUMBER_OF_READ_BLOCKS;
+	}
+	else if( number_of_blocks == 0 )
+	{
+		( *data_handle )->maximum_number_of_read_blocks = 1;
+	}
+	else
+	{
+		( *data_handle )->maximum_number_of_read_blocks = (uint32_t) number_of_blocks;
+	}
+	if( ( io_handle != NULL )
+	 && ( ( *data_handle )->maximum_number_of_read_blocks > 1 ) )
+	{
+		/* The compressed blocks data is counted against the cache size budget of the IO handle
+		 * in units of a compressed block
+		 */
+		if( libfsapfs_io_handle_reserve_cache_entries_of_size(
+		     io_handle,
+		     LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+		     LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1,
+		     (size64_t) ( *data_handle )->maximum_number_of_read_blocks * ( LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1 ),
+		     &( ( *data_handle )->number_of_reserved_read_blocks ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to reserve compressed blocks data cache entries.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( *data_handle )->number_of_reserved_read_blocks <= 1 )
+		{
+			/* A run of a single block is read into the compressed segment data
+			 * hence no compressed blocks data is allocated
+			 */
+			if( libfsapfs_io_handle_release_cache_entries_of_size(
+			     io_handle,
+			     LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1,
+			     ( *data_handle )->number_of_reserved_read_blocks,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release compressed blocks data cache entries.",
+				 function );
+
+				goto on_error;
+			}
+			( *data_handle )->number_of_reserved_read_blocks = 0;
+			( *data_handle )->maximum_number_of_read_blocks  = 1;
+		}
+		else
+		{
+			( *data_handle )->maximum_number_of_read_blocks = (uint32_t) ( *data_handle )->number_of_reserved_read_blocks;
+		}
+	}
+	( *data_handle )->io_handle              = io_handle;
+	( *data_handle )->compressed_data_stream = compressed_data_stream;
+	( *data_handle )->uncompressed_data_size = uncompressed_data_size;
+	( *data_handle )->compression_method     = compression_method;
 
 	return( 1 );
 
 on_error:
 	if( *data_handle != NULL )
 	{
-		if( ( *data_handle )->segment_data != NULL )
+		if( io_handle != NULL )
 		{
-			memory_free(
-			 ( *data_handle )->segment_data );
+			if( ( *data_handle )->number_of_reserved_block_cache_entries > 0 )
+			{
+				libfsapfs_io_handle_release_cache_entries_of_size(
+				 io_handle,
+				 LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE,
+				 ( *data_handle )->number_of_reserved_block_cache_entries,
+				 NULL );
+			}
+			if( ( *data_handle )->number_of_reserved_read_blocks > 0 )
+			{
+				libfsapfs_io_handle_release_cache_entries_of_size(
+				 io_handle,
+				 LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1,
+				 ( *data_handle )->number_of_reserved_read_blocks,
+				 NULL );
+			}
+		}
+		if( ( *data_handle )->block_cache != NULL )
+		{
+			libfsapfs_decompressed_block_cache_free(
+			 &( ( *data_handle )->block_cache ),
+			 NULL );
 		}
 		if( ( *data_handle )->compressed_segment_data != NULL )
 		{
@@ -193,6 +337,7 @@ int libfsapfs_compressed_data_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "libfsapfs_compressed_data_handle_free";
+	int result            = 1;
 
 	if( data_handle == NULL )
 	{
@@ -207,16 +352,70 @@ int libfsapfs_compressed_data_handle_free(
 	}
 	if( *data_handle != NULL )
 	{
-		if( ( *data_handle )->segment_data != NULL )
+		if( ( *data_handle )->block_cache != NULL )
 		{
-			memory_free(
-			 ( *data_handle )->segment_data );
+			if( libfsapfs_decompressed_block_cache_free(
+			     &( ( *data_handle )->block_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free decompressed block cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( ( *data_handle )->io_handle != NULL )
+		 && ( ( *data_handle )->number_of_reserved_block_cache_entries > 0 ) )
+		{
+			if( libfsapfs_io_handle_release_cache_entries_of_size(
+			     ( *data_handle )->io_handle,
+			     LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE,
+			     ( *data_handle )->number_of_reserved_block_cache_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release decompressed block cache entries.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( ( *data_handle )->io_handle != NULL )
+		 && ( ( *data_handle )->number_of_reserved_read_blocks > 0 ) )
+		{
+			if( libfsapfs_io_handle_release_cache_entries_of_size(
+			     ( *data_handle )->io_handle,
+			     LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1,
+			     ( *data_handle )->number_of_reserved_read_blocks,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release compressed blocks data cache entries.",
+				 function );
+
+				result = -1;
+			}
 		}
 		if( ( *data_handle )->compressed_segment_data != NULL )
 		{
 			memory_free(
 			 ( *data_handle )->compressed_segment_data );
 		}
+		if( ( *data_handle )->compressed_blocks_data != NULL )
+		{
+			memory_free(
+			 ( *data_handle )->compressed_blocks_data );
+		}
 		if( ( *data_handle )->compressed_block_offsets != NULL )
 		{
 			memory_free(
@@ -227,7 +426,7 @@ int libfsapfs_compressed_data_handle_free(
 
 		*data_handle = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Determines the compressed block offsets
@@ -800,6 +999,452 @@ on_error:
 	return( -1 );
 }
 
+/* Reads the compressed data of a run of adjacent compressed blocks
+ * The compressed blocks are stored back-to-back, hence the run is read with a single read.
+ * A single block is read into the compressed segment data, multiple blocks are read into
+ * the compressed blocks data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_compressed_data_handle_read_compressed_blocks(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     uint32_t compressed_block_index,
+     uint32_t number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function            = "libfsapfs_compressed_data_handle_read_compressed_blocks";
+	uint8_t *compressed_data         = NULL;
+	size_t read_size                 = 0;
+	ssize_t read_count               = 0;
+	off64_t data_stream_offset       = 0;
+
+#if defined( HAVE_PROFILER )
+	int64_t profiler_start_timestamp = 0;
+#endif
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->compressed_block_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing compressed block offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_blocks == 0 )
+	 || ( number_of_blocks > data_handle->maximum_number_of_read_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_block_index >= data_handle->number_of_compressed_blocks )
+	 || ( number_of_blocks > ( data_handle->number_of_compressed_blocks - compressed_block_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == 1 )
+	{
+		compressed_data = data_handle->compressed_segment_data;
+	}
+	else
+	{
+		if( data_handle->compressed_blocks_data == NULL )
+		{
+			data_handle->compressed_blocks_data = (uint8_t *) memory_allocate(
+			                                                   sizeof( uint8_t ) * data_handle->maximum_number_of_read_blocks * ( LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1 ) );
+
+			if( data_handle->compressed_blocks_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create compressed blocks data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		compressed_data = data_handle->compressed_blocks_data;
+	}
+	/* The size of every compressed block was validated when the compressed block offsets
+	 * were read, hence the run fits in the buffer
+	 */
+	data_stream_offset = data_handle->compressed_block_offsets[ compressed_block_index ];
+	read_size          = (size_t) ( data_handle->compressed_block_offsets[ compressed_block_index + number_of_blocks ] - data_stream_offset );
+
+#if defined( HAVE_PROFILER )
+	if( ( data_handle->io_handle != NULL )
+	 && ( data_handle->io_handle->profiler != NULL ) )
+	{
+		if( libfsapfs_profiler_start_timing(
+		     data_handle->io_handle->profiler,
+		     &profiler_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start timing.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( HAVE_PROFILER ) */
+
+	read_count = libfdata_stream_read_buffer_at_offset(
+	              data_handle->compressed_data_stream,
+	              (intptr_t *) file_io_handle,
+	              compressed_data,
+	              read_size,
+	              data_stream_offset,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x08%" PRIx64 ") from data stream.",
+		 function,
+		 data_stream_offset,
+		 data_stream_offset );
+
+		return( -1 );
+	}
+#if defined( HAVE_PROFILER )
+	if( ( data_handle->io_handle != NULL )
+	 && ( data_handle->io_handle->profiler != NULL ) )
+	{
+		if( libfsapfs_profiler_stop_timing(
+		     data_handle->io_handle->profiler,
+		     profiler_start_timestamp,
+		     function,
+		     data_stream_offset,
+		     (size64_t) read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to stop timing.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( HAVE_PROFILER ) */
+
+	return( 1 );
+}
+
+/* Reads compressed blocks and decompresses them in parallel using the decompression pool
+ * The blocks are decompressed directly into the data, hence only blocks that decompress
+ * to a full block can be read this way
+ * Returns 1 if successful, 0 if no decompression pool was set or -1 on error
+ */
+int libfsapfs_compressed_data_handle_read_blocks_in_parallel(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     uint32_t compressed_block_index,
+     uint32_t number_of_blocks,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_decompression_job_t decompression_jobs[ LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_NUMBER_OF_READ_BLOCKS ];
+
+	libfsapfs_job_pool_t *decompression_pool = NULL;
+	libfsapfs_job_request_t *job_request     = NULL;
+	uint8_t *compressed_data                 = NULL;
+	static char *function                    = "libfsapfs_compressed_data_handle_read_blocks_in_parallel";
+	size_t compressed_block_size             = 0;
+	size_t compressed_data_offset            = 0;
+	size_t data_offset                       = 0;
+	uint32_t block_index                     = 0;
+	uint32_t job_index                       = 0;
+	int result                               = 1;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->compressed_block_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing compressed block offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_blocks == 0 )
+	 || ( number_of_blocks > LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_JOBS )
+	 || ( number_of_blocks > LIBFSAPFS_COMPRESSED_DATA_HANDLE_MAXIMUM_NUMBER_OF_READ_BLOCKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_block_index >= data_handle->number_of_compressed_blocks )
+	 || ( number_of_blocks > ( data_handle->number_of_compressed_blocks - compressed_block_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size > (size_t) SSIZE_MAX )
+	 || ( data_size < ( (size_t) number_of_blocks * LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The decompression pool is held until its jobs have been waited for,
+	 * so that it cannot be freed or replaced while in use
+	 */
+	if( libfsapfs_io_handle_grab_job_pool(
+	     data_handle->io_handle,
+	     LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION,
+	     &decompression_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab decompression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( decompression_pool == NULL )
+	{
+		if( libfsapfs_io_handle_release_job_pool(
+		     data_handle->io_handle,
+		     LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release decompression pool.",
+			 function );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+	if( libfsapfs_compressed_data_handle_read_compressed_blocks(
+	     data_handle,
+	     file_io_handle,
+	     compressed_block_index,
+	     number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read compressed blocks.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_job_request_initialize(
+	     &job_request,
+	     (int (*)(intptr_t *, libcerror_error_t **)) &libfsapfs_decompression_job_run,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create job request.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_blocks == 1 )
+	{
+		compressed_data = data_handle->compressed_segment_data;
+	}
+	else
+	{
+		compressed_data = data_handle->compressed_blocks_data;
+	}
+	for( block_index = compressed_block_index;
+	     block_index < ( compressed_block_index + number_of_blocks );
+	     block_index++ )
+	{
+		compressed_block_size = (size_t) ( data_handle->compressed_block_offsets[ block_index + 1 ] - data_handle->compressed_block_offsets[ block_index ] );
+
+		job_index = block_index - compressed_block_index;
+
+		decompression_jobs[ job_index ].compression_method     = data_handle->compression_method;
+		decompression_jobs[ job_index ].compressed_data        = &( compressed_data[ compressed_data_offset ] );
+		decompression_jobs[ job_index ].compressed_data_size   = compressed_block_size;
+		decompression_jobs[ job_index ].uncompressed_data      = &( data[ data_offset ] );
+		decompression_jobs[ job_index ].uncompressed_data_size = LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+
+		if( libfsapfs_job_pool_push_job(
+		     decompression_pool,
+		     job_request,
+		     (intptr_t *) &( decompression_jobs[ job_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push decompression job.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		compressed_data_offset += compressed_block_size;
+		data_offset            += LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+	}
+	/* The jobs that have been pushed reference the compressed blocks data and the data,
+	 * hence the request must be waited for even if pushing a job failed
+	 */
+	if( libfsapfs_job_request_wait(
+	     job_request,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress blocks.",
+			 function );
+		}
+		result = -1;
+	}
+	if( libfsapfs_job_request_free(
+	     &job_request,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free job request.",
+			 function );
+		}
+		result = -1;
+	}
+	if( libfsapfs_io_handle_release_job_pool(
+	     data_handle->io_handle,
+	     LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release decompression pool.",
+			 function );
+		}
+		result = -1;
+	}
+	return( result );
+
+on_error:
+	libfsapfs_io_handle_release_job_pool(
+	 data_handle->io_handle,
+	 LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION,
+	 NULL );
+
+	return( -1 );
+}
+
 /* Reads data from the current offset into a compressed
  * Callback for the data stream
  * Returns the number of bytes read or -1 on error
@@ -815,14 +1460,21 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
          uint8_t read_flags LIBFSAPFS_ATTRIBUTE_UNUSED,
          libcerror_error_t **error )
 {
-	static char *function             = "libfsapfs_compressed_data_handle_read_segment_data";
-	size_t data_offset                = 0;
-	size_t read_size                  = 0;
-	size_t segment_data_offset        = 0;
-	ssize_t read_count                = 0;
-	off64_t data_stream_offset        = 0;
-	off64_t uncompressed_block_offset = 0;
-	uint32_t compressed_block_index   = 0;
+	libfsapfs_decompressed_block_cache_entry_t *cache_entry = NULL;
+	uint8_t *compressed_data                                = NULL;
+	static char *function                                   = "libfsapfs_compressed_data_handle_read_segment_data";
+	size_t compressed_data_offset                           = 0;
+	size_t compressed_data_size                             = 0;
+	size_t data_offset                                      = 0;
+	size_t read_size                                        = 0;
+	size_t segment_data_offset                              = 0;
+	off64_t uncompressed_block_offset                       = 0;
+	uint64_t maximum_number_of_blocks                       = 0;
+	uint32_t compressed_block_index                         = 0;
+	uint32_t first_read_block_index                         = 0;
+	uint32_t number_of_blocks                               = 0;
+	uint32_t number_of_read_blocks                          = 0;
+	int result                                              = 0;
 
 	LIBFSAPFS_UNREFERENCED_PARAMETER( file_io_handle )
 	LIBFSAPFS_UNREFERENCED_PARAMETER( segment_file_index )
@@ -939,33 +1591,145 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
 
 			return( -1 );
 		}
-		if( data_handle->current_compressed_block_index != compressed_block_index )
+		if( ( data_offset == 0 )
+		 && ( data_handle->io_handle != NULL ) )
 		{
-			data_stream_offset = data_handle->compressed_block_offsets[ compressed_block_index ];
-			read_size          = (size_t) ( data_handle->compressed_block_offsets[ compressed_block_index + 1 ] - data_stream_offset );
-
-			read_count = libfdata_stream_read_buffer_at_offset(
-			              data_handle->compressed_data_stream,
-			              (intptr_t *) file_io_handle,
-			              (uint8_t *) data_handle->compressed_segment_data,
-			              read_size,
-			              data_stream_offset,
-			              0,
-			              error );
-
-			if( read_count != (ssize_t) read_size )
+			/* Only the full blocks that are read entirely are decompressed in parallel,
+			 * the remaining blocks are read through the decompressed block cache
+			 */
+			number_of_blocks         = (uint32_t) ( segment_data_size / LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE );
+			maximum_number_of_blocks = data_handle->uncompressed_data_size / LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+
+			if( maximum_number_of_blocks > (uint64_t) data_handle->number_of_compressed_blocks )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read buffer at offset: %" PRIi64 " (0x08%" PRIx64 ") from data stream.",
-				 function,
-				 data_stream_offset,
-				 data_stream_offset );
+				maximum_number_of_blocks = (uint64_t) data_handle->number_of_compressed_blocks;
+			}
+			if( (uint64_t) compressed_block_index >= maximum_number_of_blocks )
+			{
+				maximum_number_of_blocks = 0;
+			}
+			else
+			{
+				maximum_number_of_blocks -= compressed_block_index;
+			}
+			if( maximum_number_of_blocks > (uint64_t) LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_JOBS )
+			{
+				maximum_number_of_blocks = (uint64_t) LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_JOBS;
+			}
+			if( maximum_number_of_blocks > (uint64_t) data_handle->maximum_number_of_read_blocks )
+			{
+				maximum_number_of_blocks = (uint64_t) data_handle->maximum_number_of_read_blocks;
+			}
+			if( (uint64_t) number_of_blocks > maximum_number_of_blocks )
+			{
+				number_of_blocks = (uint32_t) maximum_number_of_blocks;
+			}
+			if( number_of_blocks >= LIBFSAPFS_DECOMPRESSION_POOL_MINIMUM_NUMBER_OF_BLOCKS )
+			{
+				result = libfsapfs_compressed_data_handle_read_blocks_in_parallel(
+				          data_handle,
+				          (libbfio_handle_t *) file_io_handle,
+				          compressed_block_index,
+				          number_of_blocks,
+				          &( segment_data[ segment_data_offset ] ),
+				          segment_data_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read compressed blocks: %" PRIu32 " - %" PRIu32 ".",
+					 function,
+					 compressed_block_index,
+					 compressed_block_index + number_of_blocks - 1 );
 
-				return( -1 );
+					return( -1 );
+				}
+				else if( result != 0 )
+				{
+					read_size = (size_t) number_of_blocks * LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+
+					segment_data_size      -= read_size;
+					segment_data_offset    += read_size;
+					compressed_block_index += number_of_blocks;
+
+					continue;
+				}
 			}
+		}
+		result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+		          data_handle->block_cache,
+		          compressed_block_index,
+		          &cache_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve decompressed block: %" PRIu32 " from cache.",
+			 function,
+			 compressed_block_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			if( ( number_of_read_blocks == 0 )
+			 || ( compressed_block_index < first_read_block_index )
+			 || ( compressed_block_index >= ( first_read_block_index + number_of_read_blocks ) ) )
+			{
+				/* The compressed data of the blocks that remain to be read is read with a single read
+				 */
+				maximum_number_of_blocks = ( (uint64_t) data_offset + segment_data_size + LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE - 1 ) / LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+
+				if( maximum_number_of_blocks > (uint64_t) ( data_handle->number_of_compressed_blocks - compressed_block_index ) )
+				{
+					maximum_number_of_blocks = (uint64_t) ( data_handle->number_of_compressed_blocks - compressed_block_index );
+				}
+				if( maximum_number_of_blocks > (uint64_t) data_handle->maximum_number_of_read_blocks )
+				{
+					maximum_number_of_blocks = (uint64_t) data_handle->maximum_number_of_read_blocks;
+				}
+				first_read_block_index = compressed_block_index;
+				number_of_read_blocks  = (uint32_t) maximum_number_of_blocks;
+
+				if( libfsapfs_compressed_data_handle_read_compressed_blocks(
+				     data_handle,
+				     (libbfio_handle_t *) file_io_handle,
+				     first_read_block_index,
+				     number_of_read_blocks,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read compressed blocks: %" PRIu32 " - %" PRIu32 ".",
+					 function,
+					 first_read_block_index,
+					 first_read_block_index + number_of_read_blocks - 1 );
+
+					return( -1 );
+				}
+			}
+			if( number_of_read_blocks == 1 )
+			{
+				compressed_data = data_handle->compressed_segment_data;
+			}
+			else
+			{
+				compressed_data_offset = (size_t) ( data_handle->compressed_block_offsets[ compressed_block_index ] - data_handle->compressed_block_offsets[ first_read_block_index ] );
+
+				compressed_data = &( data_handle->compressed_blocks_data[ compressed_data_offset ] );
+			}
+			compressed_data_size = (size_t) ( data_handle->compressed_block_offsets[ compressed_block_index + 1 ] - data_handle->compressed_block_offsets[ compressed_block_index ] );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
 			{
@@ -973,19 +1737,19 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
 				 "%s: compressed block data:\n",
 				 function );
 				libcnotify_print_data(
-				 data_handle->compressed_segment_data,
-				 read_size,
+				 compressed_data,
+				 compressed_data_size,
 				 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 			}
 #endif
-			data_handle->segment_data_size = LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+			cache_entry->data_size = LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
 
 			if( libfsapfs_decompress_data(
-			     data_handle->compressed_segment_data,
-			     (size_t) read_count,
+			     compressed_data,
+			     compressed_data_size,
 			     data_handle->compression_method,
-			     data_handle->segment_data,
-			     &( data_handle->segment_data_size ),
+			     cache_entry->data,
+			     &( cache_entry->data_size ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -1004,15 +1768,15 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
 				 "%s: uncompressed block data:\n",
 				 function );
 				libcnotify_print_data(
-				 data_handle->segment_data,
-				 data_handle->segment_data_size,
+				 cache_entry->data,
+				 cache_entry->data_size,
 				 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 			}
 #endif
 			uncompressed_block_offset = ( compressed_block_index + 1 ) * LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
 
 			if( ( (size64_t) uncompressed_block_offset < data_handle->uncompressed_data_size )
-			 && ( data_handle->segment_data_size != LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ) )
+			 && ( cache_entry->data_size != LIBFSAPFS_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ) )
 			{
 				libcerror_error_set(
 				 error,
@@ -1023,9 +1787,11 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
 
 				return( -1 );
 			}
-			data_handle->current_compressed_block_index = compressed_block_index;
+			/* The block index is only set once the block has been successfully decompressed
+			 */
+			cache_entry->block_index = compressed_block_index;
 		}
-		if( data_offset >= data_handle->segment_data_size )
+		if( data_offset >= cache_entry->data_size )
 		{
 			libcerror_error_set(
 			 error,
@@ -1036,7 +1802,7 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
 
 			return( -1 );
 		}
-		read_size = data_handle->segment_data_size - data_offset;
+		read_size = cache_entry->data_size - data_offset;
 
 		if( read_size > segment_data_size )
 		{
@@ -1044,7 +1810,7 @@ ssize_t libfsapfs_compressed_data_handle_read_segment_data(
 		}
 		if( memory_copy(
 		     &( segment_data[ segment_data_offset ] ),
-		     &( data_handle->segment_data[ data_offset ] ),
+		     &( cache_entry->data[ data_offset ] ),
 		     read_size ) == NULL )
 		{
 			libcerror_error_set(
@@ -25,6 +25,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_decompressed_block_cache.h"
+#include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libfdata.h"
@@ -41,6 +43,10 @@ struct libfsapfs_compressed_data_handle
 	 */
 	off64_t current_segment_offset;
 
+	/* The IO handle
+	 */
+	libfsapfs_io_handle_t *io_handle;
+
 	/* The compressed data steam
 	 */
 	libfdata_stream_t *compressed_data_stream;
@@ -53,21 +59,29 @@ struct libfsapfs_compressed_data_handle
 	 */
 	int compression_method;
 
-	/* The current compressed block index
-	 */
-	uint32_t current_compressed_block_index;
-
 	/* The compressed segment data
 	 */
 	uint8_t *compressed_segment_data;
 
-	/* The (uncompressed) segment data
+	/* The cache of decompressed blocks
+	 */
+	libfsapfs_decompressed_block_cache_t *block_cache;
+
+	/* The number of decompressed block cache entries reserved in the IO handle
+	 */
+	int number_of_reserved_block_cache_entries;
+
+	/* The compressed data of a run of adjacent compressed blocks
+	 */
+	uint8_t *compressed_blocks_data;
+
+	/* The maximum number of compressed blocks that are read as a run
 	 */
-	uint8_t *segment_data;
+	uint32_t maximum_number_of_read_blocks;
 
-	/* The (uncompressed) segment data size
+	/* The number of compressed blocks data entries reserved in the IO handle
 	 */
-	size_t segment_data_size;
+	int number_of_reserved_read_blocks;
 
 	/* The number of compressed blocks
 	 */
@@ -80,6 +94,7 @@ struct libfsapfs_compressed_data_handle
 
 int libfsapfs_compressed_data_handle_initialize(
      libfsapfs_compressed_data_handle_t **data_handle,
+     libfsapfs_io_handle_t *io_handle,
      libfdata_stream_t *compressed_data_stream,
      size64_t uncompressed_data_size,
      int compression_method,
@@ -94,6 +109,22 @@ int libfsapfs_compressed_data_handle_get_compressed_block_offsets(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libfsapfs_compressed_data_handle_read_compressed_blocks(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     uint32_t compressed_block_index,
+     uint32_t number_of_blocks,
+     libcerror_error_t **error );
+
+int libfsapfs_compressed_data_handle_read_blocks_in_parallel(
+     libfsapfs_compressed_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     uint32_t compressed_block_index,
+     uint32_t number_of_blocks,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
 ssize_t libfsapfs_compressed_data_handle_read_segment_data(
          libfsapfs_compressed_data_handle_t *data_handle,
          intptr_t *file_io_handle,
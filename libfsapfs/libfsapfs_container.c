@@ -25,6 +25,7 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libfsapfs_block_cache.h"
 #include "libfsapfs_checkpoint_map.h"
 #include "libfsapfs_container.h"
 #include "libfsapfs_container_data_handle.h"
@@ -34,6 +35,7 @@
 #include "libfsapfs_container_superblock.h"
 #include "libfsapfs_debug.h"
 #include "libfsapfs_definitions.h"
+#include "libfsapfs_file_io_handle_pool.h"
 #include "libfsapfs_fusion_middle_tree.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
@@ -121,6 +123,38 @@ int libfsapfs_container_initialize(
 
 		goto on_error;
 	}
+	if( libfsapfs_io_handle_reserve_cache_entries(
+	     internal_container->io_handle,
+	     LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	     0,
+	     &( internal_container->maximum_number_of_cached_blocks ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to reserve block cache entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_block_cache_initialize(
+	     &( internal_container->block_cache ),
+	     internal_container->maximum_number_of_cached_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block cache.",
+		 function );
+
+		goto on_error;
+	}
+	internal_container->io_handle->block_cache = internal_container->block_cache;
+
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_initialize(
 	     &( internal_container->read_write_lock ),
@@ -143,6 +177,18 @@ int libfsapfs_container_initialize(
 on_error:
 	if( internal_container != NULL )
 	{
+		if( internal_container->block_cache != NULL )
+		{
+			libfsapfs_block_cache_free(
+			 &( internal_container->block_cache ),
+			 NULL );
+		}
+		if( internal_container->io_handle != NULL )
+		{
+			libfsapfs_io_handle_free(
+			 &( internal_container->io_handle ),
+			 NULL );
+		}
 		memory_free(
 		 internal_container );
 	}
@@ -208,6 +254,19 @@ int libfsapfs_container_free(
 			result = -1;
 		}
 #endif
+		if( libfsapfs_block_cache_free(
+		     &( internal_container->block_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block cache.",
+			 function );
+
+			result = -1;
+		}
 		if( libfsapfs_io_handle_free(
 		     &( internal_container->io_handle ),
 		     error ) != 1 )
@@ -266,6 +325,434 @@ int libfsapfs_container_signal_abort(
 	return( 1 );
 }
 
+/* Sets the cache limits
+ * The maximum B-tree nodes cache size is in bytes and applies to every individual B-tree node cache,
+ * where 0 represents the default. The maximum data blocks cache size is in bytes and applies to the
+ * block cache that is shared by the container and its volumes, where 0 represents the default.
+ * The maximum cache size is in bytes and applies to all the caches of the container and its volumes
+ * combined, where 0 represents no maximum.
+ * Caches that are created when the maximum cache size has been reached are limited to a single entry.
+ * The cache limits should be set before the container is opened, since apart from the object map B-tree
+ * of the container, they only apply to caches that are created after they have been set
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_set_cache_limits(
+     libfsapfs_container_t *container,
+     size64_t maximum_btree_nodes_cache_size,
+     size64_t maximum_data_blocks_cache_size,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_set_cache_limits";
+	int result                                         = 1;
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_io_handle_set_cache_limits(
+	     internal_container->io_handle,
+	     maximum_btree_nodes_cache_size,
+	     maximum_data_blocks_cache_size,
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set cache limits in IO handle.",
+		 function );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		if( libfsapfs_internal_container_resize_block_cache(
+		     internal_container,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize block cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_container->object_map_btree != NULL ) )
+	{
+		if( libfsapfs_object_map_btree_set_cache_limits(
+		     internal_container->object_map_btree,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache limits of object map B-tree.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the number of threads used to decrypt large reads of encrypted data
+ * Large reads are split into chunks that are decrypted in parallel while the next chunk
+ * is being read, where 0 disables parallel decryption. The decryption pool is shared by
+ * the container and its volumes. Parallel decryption is only used when hardware AES is
+ * supported, since the software AES contexts cannot be used by multiple threads at once
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_set_number_of_decryption_threads(
+     libfsapfs_container_t *container,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_container_set_number_of_decryption_threads";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_internal_container_set_number_of_job_threads(
+	     (libfsapfs_internal_container_t *) container,
+	     LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION,
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of decryption threads.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the number of threads used to decompress large reads of compressed data
+ * The compressed blocks of large reads are decompressed in parallel, where 0 disables
+ * parallel decompression. The decompression pool is shared by the container and its volumes
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_set_number_of_decompression_threads(
+     libfsapfs_container_t *container,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_container_set_number_of_decompression_threads";
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_internal_container_set_number_of_job_threads(
+	     (libfsapfs_internal_container_t *) container,
+	     LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION,
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of decompression threads.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the number of threads of one of the job pools that are shared by the container and its volumes
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_internal_container_set_number_of_job_threads(
+     libfsapfs_internal_container_t *internal_container,
+     int job_pool_type,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_internal_container_set_number_of_job_threads";
+	int result            = 1;
+
+	if( internal_container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_container->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid container - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_io_handle_set_number_of_job_threads(
+	     internal_container->io_handle,
+	     job_pool_type,
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of job threads in IO handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Resizes the block cache to the maximum data blocks cache size of the IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_internal_container_resize_block_cache(
+     libfsapfs_internal_container_t *internal_container,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_internal_container_resize_block_cache";
+
+	if( internal_container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_io_handle_release_cache_entries(
+	     internal_container->io_handle,
+	     internal_container->maximum_number_of_cached_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release block cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container->maximum_number_of_cached_blocks = 0;
+
+	if( libfsapfs_io_handle_reserve_cache_entries(
+	     internal_container->io_handle,
+	     LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	     0,
+	     &( internal_container->maximum_number_of_cached_blocks ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to reserve block cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_block_cache_resize(
+	     internal_container->block_cache,
+	     internal_container->maximum_number_of_cached_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize block cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the block cache statistics
+ * The block cache is shared by the container and its volumes
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_container_get_cache_statistics(
+     libfsapfs_container_t *container,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_container_t *internal_container = NULL;
+	static char *function                              = "libfsapfs_container_get_cache_statistics";
+	int result                                         = 1;
+
+	if( container == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid container.",
+		 function );
+
+		return( -1 );
+	}
+	internal_container = (libfsapfs_internal_container_t *) container;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_block_cache_get_statistics(
+	     internal_container->block_cache,
+	     number_of_cache_hits,
+	     number_of_cache_misses,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block cache statistics.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_container->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Opens a container
  * Returns 1 if successful or -1 on error
  */
@@ -611,6 +1098,8 @@ on_error:
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
 /* Opens a container using a Basic File IO (bfio) handle
+ * With LIBFSAPFS_ACCESS_FLAG_CLONE_FILE_IO_HANDLE file entry data is read using clones
+ * of the file IO handle, which requires that the clones can be read independently
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_container_open_file_io_handle(
@@ -720,6 +1209,8 @@ int libfsapfs_container_open_file_io_handle(
 		}
 		file_io_handle_opened_in_library = 1;
 	}
+	internal_container->io_handle->preload_object_maps = (uint8_t) ( ( access_flags & LIBFSAPFS_ACCESS_FLAG_PRELOAD_OBJECT_MAP ) != 0 );
+
 	if( libfsapfs_internal_container_open_read(
 	     internal_container,
 	     file_io_handle,
@@ -735,6 +1226,27 @@ int libfsapfs_container_open_file_io_handle(
 
 		goto on_error;
 	}
+	if( ( access_flags & LIBFSAPFS_ACCESS_FLAG_CLONE_FILE_IO_HANDLE ) != 0 )
+	{
+		/* File entry data is read using clones of the file IO handle, so that
+		 * reads from different threads do not share the file IO handle
+		 */
+		if( libfsapfs_file_io_handle_pool_initialize(
+		     &( internal_container->file_io_handle_pool ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle pool.",
+			 function );
+
+			goto on_error;
+		}
+		internal_container->io_handle->file_io_handle_pool = internal_container->file_io_handle_pool;
+	}
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_container->read_write_lock,
@@ -774,6 +1286,14 @@ int libfsapfs_container_open_file_io_handle(
 	return( 1 );
 
 on_error:
+	if( internal_container->file_io_handle_pool != NULL )
+	{
+		internal_container->io_handle->file_io_handle_pool = NULL;
+
+		libfsapfs_file_io_handle_pool_free(
+		 &( internal_container->file_io_handle_pool ),
+		 NULL );
+	}
 	if( file_io_handle_opened_in_library != 0 )
 	{
 		libbfio_handle_close(
@@ -854,6 +1374,24 @@ int libfsapfs_container_close(
 		}
 	}
 #endif
+	if( internal_container->file_io_handle_pool != NULL )
+	{
+		internal_container->io_handle->file_io_handle_pool = NULL;
+
+		if( libfsapfs_file_io_handle_pool_free(
+		     &( internal_container->file_io_handle_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle pool.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( internal_container->file_io_handle_opened_in_library != 0 )
 	{
 		if( libbfio_handle_close(
@@ -964,6 +1502,19 @@ int libfsapfs_container_close(
 
 		result = -1;
 	}
+	if( libfsapfs_block_cache_empty(
+	     internal_container->block_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty block cache.",
+		 function );
+
+		result = -1;
+	}
 	if( internal_container->object_map_btree != NULL )
 	{
 		if( libfsapfs_object_map_btree_free(
@@ -1733,6 +2284,23 @@ int libfsapfs_internal_container_open_read(
 
 		goto on_error;
 	}
+	if( internal_container->io_handle->preload_object_maps != 0 )
+	{
+		if( libfsapfs_object_map_btree_read_index(
+		     internal_container->object_map_btree,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to preload object map.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libfsapfs_object_map_free(
 	     &object_map,
 	     error ) != 1 )
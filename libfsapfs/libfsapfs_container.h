@@ -25,11 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_block_cache.h"
 #include "libfsapfs_checkpoint_map.h"
 #include "libfsapfs_container_data_handle.h"
 #include "libfsapfs_container_key_bag.h"
 #include "libfsapfs_container_superblock.h"
 #include "libfsapfs_extern.h"
+#include "libfsapfs_file_io_handle_pool.h"
 #include "libfsapfs_fusion_middle_tree.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
@@ -79,6 +81,14 @@ struct libfsapfs_internal_container
 	 */
 	libfsapfs_io_handle_t *io_handle;
 
+	/* The block cache
+	 */
+	libfsapfs_block_cache_t *block_cache;
+
+	/* The maximum number of cached blocks
+	 */
+	int maximum_number_of_cached_blocks;
+
 	/* The file IO handle
 	 */
 	libbfio_handle_t *file_io_handle;
@@ -91,6 +101,10 @@ struct libfsapfs_internal_container
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* The file IO handle pool, which contains clones of the file IO handle
+	 */
+	libfsapfs_file_io_handle_pool_t *file_io_handle_pool;
+
 #if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -113,6 +127,43 @@ int libfsapfs_container_signal_abort(
      libfsapfs_container_t *container,
      libcerror_error_t **error );
 
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_set_cache_limits(
+     libfsapfs_container_t *container,
+     size64_t maximum_btree_nodes_cache_size,
+     size64_t maximum_data_blocks_cache_size,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_set_number_of_decryption_threads(
+     libfsapfs_container_t *container,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_set_number_of_decompression_threads(
+     libfsapfs_container_t *container,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_container_set_number_of_job_threads(
+     libfsapfs_internal_container_t *internal_container,
+     int job_pool_type,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_container_resize_block_cache(
+     libfsapfs_internal_container_t *internal_container,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_get_cache_statistics(
+     libfsapfs_container_t *container,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_container_open(
      libfsapfs_container_t *container,
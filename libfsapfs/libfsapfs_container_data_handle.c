@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_block_cache.h"
 #include "libfsapfs_data_block.h"
 #include "libfsapfs_definitions.h"
 #include "libfsapfs_libbfio.h"
@@ -169,6 +170,7 @@ int libfsapfs_container_data_handle_read_data_block(
 {
 	libfsapfs_data_block_t *data_block = NULL;
 	static char *function              = "libfsapfs_container_data_handle_read_data_block";
+	uint8_t element_value_flags        = LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED;
 
 #if defined( HAVE_PROFILER )
 	int64_t profiler_start_timestamp   = 0;
@@ -200,6 +202,17 @@ int libfsapfs_container_data_handle_read_data_block(
 
 		return( -1 );
 	}
+	if( container_data_handle->io_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid container data handle - invalid IO handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( element_data_size > (size64_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
@@ -286,6 +299,13 @@ int libfsapfs_container_data_handle_read_data_block(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
+	/* The data block is handed over to the block cache, which keys it by
+	 * its physical block number
+	 */
+	if( container_data_handle->io_handle->block_cache != NULL )
+	{
+		element_value_flags = LIBFDATA_LIST_ELEMENT_VALUE_FLAG_NON_MANAGED;
+	}
 	if( libfdata_vector_set_element_value_by_index(
 	     vector,
 	     (intptr_t *) file_io_handle,
@@ -293,7 +313,7 @@ int libfsapfs_container_data_handle_read_data_block(
 	     element_index,
 	     (intptr_t *) data_block,
 	     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_data_block_free,
-	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+	     element_value_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -305,6 +325,25 @@ int libfsapfs_container_data_handle_read_data_block(
 
 		goto on_error;
 	}
+	if( element_value_flags == LIBFDATA_LIST_ELEMENT_VALUE_FLAG_NON_MANAGED )
+	{
+		if( libfsapfs_block_cache_set_element_value_by_block_number(
+		     container_data_handle->io_handle->block_cache,
+		     (uint64_t) element_data_offset / container_data_handle->io_handle->block_size,
+		     (intptr_t *) data_block,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_data_block_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set data block in block cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
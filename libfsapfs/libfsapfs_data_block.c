@@ -261,7 +261,6 @@ int libfsapfs_data_block_read(
      uint64_t encryption_identifier,
      libcerror_error_t **error )
 {
-	uint8_t *read_buffer  = NULL;
 	static char *function = "libfsapfs_data_block_read";
 	ssize_t read_count    = 0;
 
@@ -330,47 +329,11 @@ int libfsapfs_data_block_read(
 		 file_offset );
 	}
 #endif
-	if( libbfio_handle_seek_offset(
-	     file_io_handle,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek data block offset: %" PRIi64 ".",
-		 function,
-		 file_offset );
-
-		goto on_error;
-	}
-	if( encryption_context == NULL )
-	{
-		read_buffer = data_block->data;
-	}
-	else
-	{
-		read_buffer = (uint8_t *) memory_allocate(
-		                           sizeof( uint8_t ) * data_block->data_size );
-
-		if( read_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create read buffer.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	read_count = libbfio_handle_read_buffer(
+	read_count = libbfio_handle_read_buffer_at_offset(
 	              file_io_handle,
-	              read_buffer,
+	              data_block->data,
 	              data_block->data_size,
+	              file_offset,
 	              error );
 
 	if( read_count != (ssize_t) data_block->data_size )
@@ -379,10 +342,12 @@ int libfsapfs_data_block_read(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read data block.",
-		 function );
+		 "%s: unable to read data block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( encryption_context != NULL )
 	{
@@ -393,7 +358,7 @@ int libfsapfs_data_block_read(
 			 "%s: encrypted data block:\n",
 			 function );
 			libcnotify_print_data(
-			 read_buffer,
+			 data_block->data,
 			 data_block->data_size,
 			 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 		}
@@ -401,10 +366,12 @@ int libfsapfs_data_block_read(
 		encryption_identifier *= data_block->data_size;
 		encryption_identifier /= io_handle->bytes_per_sector;
 
+		/* The data block is decrypted in place
+		 */
 		if( libfsapfs_encryption_context_crypt(
 		     encryption_context,
 		     LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
-		     read_buffer,
+		     data_block->data,
 		     data_block->data_size,
 		     data_block->data,
 		     data_block->data_size,
@@ -419,12 +386,8 @@ int libfsapfs_data_block_read(
 			 "%s: unable to decrypt data block.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		memory_free(
-		 read_buffer );
-
-		read_buffer = NULL;
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -439,14 +402,5 @@ int libfsapfs_data_block_read(
 	}
 #endif
 	return( 1 );
-
-on_error:
-	if( ( read_buffer != NULL )
-	 && ( read_buffer != data_block->data ) )
-	{
-		memory_free(
-		 read_buffer );
-	}
-	return( -1 );
 }
 
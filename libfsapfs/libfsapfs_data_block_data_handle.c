@@ -23,17 +23,24 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_block_cache.h"
 #include "libfsapfs_data_block.h"
 #include "libfsapfs_data_block_data_handle.h"
 #include "libfsapfs_data_block_vector.h"
+#include "libfsapfs_decryption_job.h"
 #include "libfsapfs_definitions.h"
 #include "libfsapfs_encryption_context.h"
+#include "libfsapfs_file_extent.h"
 #include "libfsapfs_file_system_data_handle.h"
+#include "libfsapfs_io_handle.h"
+#include "libfsapfs_job_pool.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcnotify.h"
 #include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
+#include "libfsapfs_profiler.h"
 #include "libfsapfs_unused.h"
 
 /* Creates a data block data handle
@@ -163,20 +170,9 @@ int libfsapfs_data_block_data_handle_initialize(
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( ( *data_handle )->data_block_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DATA_BLOCKS,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data block cache.",
-		 function );
+	( *data_handle )->io_handle = io_handle;
+	( *data_handle )->is_sparse = is_sparse;
 
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -225,19 +221,6 @@ int libfsapfs_data_block_data_handle_free(
 	}
 	if( *data_handle != NULL )
 	{
-		if( libfcache_cache_free(
-		     &( ( *data_handle )->data_block_cache ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free data block cache.",
-			 function );
-
-			result = -1;
-		}
 		if( libfdata_vector_free(
 		     &( ( *data_handle )->data_block_vector ),
 		     error ) != 1 )
@@ -287,11 +270,18 @@ ssize_t libfsapfs_data_block_data_handle_read_segment_data(
          uint8_t read_flags LIBFSAPFS_ATTRIBUTE_UNUSED,
          libcerror_error_t **error )
 {
-	libfsapfs_data_block_t *data_block = NULL;
-	static char *function              = "libfsapfs_data_block_data_handle_read_segment_data";
-	size_t read_size                   = 0;
-	size_t segment_data_offset         = 0;
-	off64_t data_block_offset          = 0;
+	libfsapfs_data_block_t *data_block   = NULL;
+	libfsapfs_file_extent_t *file_extent = NULL;
+	static char *function                = "libfsapfs_data_block_data_handle_read_segment_data";
+	size_t read_size                     = 0;
+	size_t segment_data_offset           = 0;
+	ssize_t read_count                   = 0;
+	off64_t data_block_offset            = 0;
+	off64_t element_index                = 0;
+	off64_t extent_data_offset           = 0;
+	uint64_t block_number                = 0;
+	int extent_index                     = 0;
+	int result                           = 1;
 
 	LIBFSAPFS_UNREFERENCED_PARAMETER( segment_file_index )
 	LIBFSAPFS_UNREFERENCED_PARAMETER( segment_flags )
@@ -308,6 +298,28 @@ ssize_t libfsapfs_data_block_data_handle_read_segment_data(
 
 		return( -1 );
 	}
+	if( data_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->io_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data handle - invalid IO handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( data_handle->current_offset < 0 )
 	{
 		libcerror_error_set(
@@ -358,92 +370,1043 @@ ssize_t libfsapfs_data_block_data_handle_read_segment_data(
 	}
 	while( segment_data_size > 0 )
 	{
-		if( libfdata_vector_get_element_value_at_offset(
-		     data_handle->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) data_handle->data_block_cache,
-		     data_handle->current_offset,
-		     &data_block_offset,
-		     (intptr_t **) &data_block,
-		     0,
+		data_block_offset = data_handle->current_offset % data_handle->io_handle->block_size;
+
+		/* Full blocks are read directly into the segment data, the block cache
+		 * is only used for partial blocks
+		 */
+		read_size = 0;
+
+		if( ( data_block_offset == 0 )
+		 && ( segment_data_size >= data_handle->io_handle->block_size ) )
+		{
+			read_size = segment_data_size - ( segment_data_size % data_handle->io_handle->block_size );
+
+			if( (size64_t) read_size > ( data_handle->data_size - data_handle->current_offset ) )
+			{
+				read_size  = (size_t) ( data_handle->data_size - data_handle->current_offset );
+				read_size -= read_size % data_handle->io_handle->block_size;
+			}
+		}
+		if( read_size > 0 )
+		{
+			read_count = libfsapfs_data_block_data_handle_read_extent_data(
+			              data_handle,
+			              file_io_handle,
+			              &( segment_data[ segment_data_offset ] ),
+			              read_size,
+			              error );
+
+			if( read_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read extent data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 data_handle->current_offset,
+				 data_handle->current_offset );
+
+				return( -1 );
+			}
+			read_size = (size_t) read_count;
+		}
+		else
+		{
+			element_index = data_handle->current_offset / data_handle->io_handle->block_size;
+
+			if( element_index > (off64_t) INT_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid element index value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			if( libfsapfs_data_block_data_handle_get_current_file_extent(
+			     data_handle,
+			     &extent_index,
+			     &file_extent,
+			     &extent_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve file extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 data_handle->current_offset,
+				 data_handle->current_offset );
+
+				return( -1 );
+			}
+			/* The block cache is keyed by physical block number, sparse blocks
+			 * have no physical block and are not cached
+			 */
+			if( ( data_handle->is_sparse != 0 )
+			 && ( file_extent->physical_block_number == 0 ) )
+			{
+				read_size = (size_t) ( data_handle->io_handle->block_size - data_block_offset );
+
+				if( read_size > segment_data_size )
+				{
+					read_size = segment_data_size;
+				}
+				if( (size64_t) read_size > ( data_handle->data_size - data_handle->current_offset ) )
+				{
+					read_size = (size_t) ( data_handle->data_size - data_handle->current_offset );
+				}
+				if( memory_set(
+				     &( segment_data[ segment_data_offset ] ),
+				     0,
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear segment data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			else
+			{
+				block_number = file_extent->physical_block_number + (uint64_t) ( extent_data_offset / data_handle->io_handle->block_size );
+
+				if( libfsapfs_block_cache_get_element_value_by_index(
+				     data_handle->io_handle->block_cache,
+				     data_handle->data_block_vector,
+				     file_io_handle,
+				     (int) element_index,
+				     block_number,
+				     (intptr_t **) &data_block,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve data block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 data_handle->current_offset,
+					 data_handle->current_offset );
+
+					return( -1 );
+				}
+				if( data_block == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: invalid data block.",
+					 function );
+
+					result = -1;
+				}
+				else if( data_block->data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: invalid data block - missing data.",
+					 function );
+
+					result = -1;
+				}
+				else if( (size64_t) data_block_offset >= data_block->data_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid data block offset value out of bounds.",
+					 function );
+
+					result = -1;
+				}
+				else
+				{
+					read_size = data_block->data_size - data_block_offset;
+
+					if( read_size > segment_data_size )
+					{
+						read_size = segment_data_size;
+					}
+					if( memory_copy(
+					     &( segment_data[ segment_data_offset ] ),
+					     &( data_block->data[ data_block_offset ] ),
+					     read_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy data block data.",
+						 function );
+
+						result = -1;
+					}
+				}
+				if( libfsapfs_block_cache_release_element_value_by_block_number(
+				     data_handle->io_handle->block_cache,
+				     block_number,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release data block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 data_handle->current_offset,
+					 data_handle->current_offset );
+
+					result = -1;
+				}
+			}
+			if( result != 1 )
+			{
+				return( -1 );
+			}
+		}
+		segment_data_offset += read_size;
+		segment_data_size   -= read_size;
+
+		data_handle->current_offset += read_size;
+
+		if( (size64_t) data_handle->current_offset >= data_handle->data_size )
+		{
+			break;
+		}
+	}
+	return( (ssize_t) segment_data_offset );
+}
+
+/* Retrieves the file extent at the current offset
+ * Sequential reads continue from the file extent that was last read from
+ * Returns 1 if successful, 0 if no file extent was found or -1 on error
+ */
+int libfsapfs_data_block_data_handle_get_current_file_extent(
+     libfsapfs_data_block_data_handle_t *data_handle,
+     int *extent_index,
+     libfsapfs_file_extent_t **file_extent,
+     off64_t *extent_data_offset,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_extent_t *safe_file_extent = NULL;
+	static char *function                     = "libfsapfs_data_block_data_handle_get_current_file_extent";
+	int number_of_extents                     = 0;
+	int safe_extent_index                     = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing file system data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file extent.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     data_handle->file_system_data_handle->file_extents,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file extents.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->current_offset < data_handle->current_extent_offset )
+	{
+		data_handle->current_extent_index  = 0;
+		data_handle->current_extent_offset = 0;
+	}
+	for( safe_extent_index = data_handle->current_extent_index;
+	     safe_extent_index < number_of_extents;
+	     safe_extent_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     data_handle->file_system_data_handle->file_extents,
+		     safe_extent_index,
+		     (intptr_t **) &safe_file_extent,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 "%s: unable to retrieve file extent: %d.",
 			 function,
-			 data_handle->current_offset,
-			 data_handle->current_offset );
+			 safe_extent_index );
 
 			return( -1 );
 		}
-		if( data_block == NULL )
+		if( safe_file_extent == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid data block.",
+			 "%s: missing file extent: %d.",
+			 function,
+			 safe_extent_index );
+
+			return( -1 );
+		}
+		if( (size64_t) ( data_handle->current_offset - data_handle->current_extent_offset ) < safe_file_extent->data_size )
+		{
+			break;
+		}
+		data_handle->current_extent_offset += (off64_t) safe_file_extent->data_size;
+	}
+	data_handle->current_extent_index = safe_extent_index;
+
+	if( safe_extent_index >= number_of_extents )
+	{
+		return( 0 );
+	}
+	*extent_index       = safe_extent_index;
+	*file_extent        = safe_file_extent;
+	*extent_data_offset = data_handle->current_offset - data_handle->current_extent_offset;
+
+	return( 1 );
+}
+
+/* Reads block aligned data at the current offset directly into a buffer
+ * Physically contiguous file extents are read with a single read
+ * Note that the current offset is not updated
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsapfs_data_block_data_handle_read_extent_data(
+         libfsapfs_data_block_data_handle_t *data_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         libcerror_error_t **error )
+{
+	libfsapfs_file_extent_t *file_extent      = NULL;
+	libfsapfs_file_extent_t *next_file_extent = NULL;
+	libfsapfs_job_pool_t *decryption_pool     = NULL;
+	static char *function                     = "libfsapfs_data_block_data_handle_read_extent_data";
+	size_t read_size                          = 0;
+	ssize_t read_count                        = 0;
+	off64_t extent_data_offset                = 0;
+	off64_t file_offset                       = 0;
+	uint64_t encryption_identifier            = 0;
+	uint64_t sector_number                    = 0;
+	int extent_index                          = 0;
+	int next_extent_index                     = 0;
+	int number_of_extents                     = 0;
+	int result                                = 1;
+
+#if defined( HAVE_PROFILER )
+	int64_t profiler_start_timestamp          = 0;
+#endif
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->io_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data handle - invalid IO handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing file system data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_handle->current_offset < 0 )
+	 || ( ( data_handle->current_offset % data_handle->io_handle->block_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment data.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsapfs_data_block_data_handle_get_current_file_extent(
+	          data_handle,
+	          &extent_index,
+	          &file_extent,
+	          &extent_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file extent at current offset.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     data_handle->file_system_data_handle->file_extents,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file extents.",
+		 function );
+
+		return( -1 );
+	}
+
+	read_size = segment_data_size;
+
+	if( (size64_t) read_size > ( file_extent->data_size - extent_data_offset ) )
+	{
+		read_size = (size_t) ( file_extent->data_size - extent_data_offset );
+	}
+	if( ( data_handle->is_sparse != 0 )
+	 && ( file_extent->physical_block_number == 0 ) )
+	{
+		if( memory_set(
+		     segment_data,
+		     0,
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear segment data.",
 			 function );
 
 			return( -1 );
 		}
-		if( data_block->data == NULL )
+		return( (ssize_t) read_size );
+	}
+	file_offset           = (off64_t) ( file_extent->physical_block_number * data_handle->io_handle->block_size ) + extent_data_offset;
+	encryption_identifier = file_extent->encryption_identifier + (uint64_t) ( extent_data_offset / data_handle->io_handle->block_size );
+
+	/* Extend the read with the file extents that directly follow on disk
+	 */
+	for( next_extent_index = extent_index + 1;
+	     next_extent_index < number_of_extents;
+	     next_extent_index++ )
+	{
+		if( ( read_size >= segment_data_size )
+		 || ( ( read_size % data_handle->io_handle->block_size ) != 0 ) )
+		{
+			break;
+		}
+		if( libcdata_array_get_entry_by_index(
+		     data_handle->file_system_data_handle->file_extents,
+		     next_extent_index,
+		     (intptr_t **) &next_file_extent,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file extent: %d.",
+			 function,
+			 next_extent_index );
+
+			return( -1 );
+		}
+		if( next_file_extent == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid data block - missing data.",
+			 "%s: missing file extent: %d.",
+			 function,
+			 next_extent_index );
+
+			return( -1 );
+		}
+		if( (off64_t) ( next_file_extent->physical_block_number * data_handle->io_handle->block_size ) != ( file_offset + (off64_t) read_size ) )
+		{
+			break;
+		}
+		/* The encryption identifier of an encrypted file extent is used as the sector number
+		 * of its first block, hence it must continue the preceding file extent
+		 */
+		if( ( data_handle->file_system_data_handle->encryption_context != NULL )
+		 && ( next_file_extent->encryption_identifier != ( encryption_identifier + (uint64_t) ( read_size / data_handle->io_handle->block_size ) ) ) )
+		{
+			break;
+		}
+		if( (size64_t) ( segment_data_size - read_size ) > next_file_extent->data_size )
+		{
+			read_size += (size_t) next_file_extent->data_size;
+		}
+		else
+		{
+			read_size = segment_data_size;
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading %" PRIzd " bytes of extent data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 read_size,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+#if defined( HAVE_PROFILER )
+	if( data_handle->io_handle->profiler != NULL )
+	{
+		if( libfsapfs_profiler_start_timing(
+		     data_handle->io_handle->profiler,
+		     &profiler_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start timing.",
 			 function );
 
 			return( -1 );
 		}
-		if( ( data_block_offset < 0 )
-		 || ( (size64_t) data_block_offset >= data_block->data_size ) )
+	}
+#endif /* defined( HAVE_PROFILER ) */
+
+	if( ( data_handle->file_system_data_handle->encryption_context != NULL )
+	 && ( data_handle->file_system_data_handle->encryption_context->aes_ni_support_flags != 0 )
+	 && ( read_size >= LIBFSAPFS_DECRYPTION_POOL_MINIMUM_READ_SIZE ) )
+	{
+		/* The decryption pool is held until its jobs have been waited for,
+		 * so that it cannot be freed or replaced while in use
+		 */
+		if( libfsapfs_io_handle_grab_job_pool(
+		     data_handle->io_handle,
+		     LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION,
+		     &decryption_pool,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid data block offset value out of bounds.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab decryption pool.",
 			 function );
 
 			return( -1 );
 		}
-		read_size = data_block->data_size - data_block_offset;
+		if( decryption_pool != NULL )
+		{
+			/* Large encrypted runs are read in chunks that are decrypted by the decryption pool
+			 * while the next chunk is being read. The jobs share the encryption context, which
+			 * is only safe for the hardware AES round keys since these are not modified while
+			 * decrypting, unlike the state of the libcaes contexts
+			 */
+			result = libfsapfs_data_block_data_handle_read_and_decrypt_chunks(
+			          data_handle,
+			          decryption_pool,
+			          file_io_handle,
+			          segment_data,
+			          read_size,
+			          file_offset,
+			          encryption_identifier,
+			          error );
 
-		if( read_size > segment_data_size )
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read and decrypt extent data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 file_offset,
+				 file_offset );
+			}
+		}
+		if( libfsapfs_io_handle_release_job_pool(
+		     data_handle->io_handle,
+		     LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION,
+		     ( result == 1 ) ? error : NULL ) != 1 )
 		{
-			read_size = segment_data_size;
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release decryption pool.",
+				 function );
+			}
+			result = -1;
 		}
-		if( memory_copy(
-		     &( segment_data[ segment_data_offset ] ),
-		     &( data_block->data[ data_block_offset ] ),
-		     read_size ) == NULL )
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+	if( decryption_pool == NULL )
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              segment_data,
+		              read_size,
+		              file_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy data block data.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extent data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			return( -1 );
+		}
+		if( data_handle->file_system_data_handle->encryption_context != NULL )
+		{
+			if( data_handle->io_handle->bytes_per_sector == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid data handle - invalid IO handle - missing bytes per sector.",
+				 function );
+
+				return( -1 );
+			}
+			sector_number  = encryption_identifier * data_handle->io_handle->block_size;
+			sector_number /= data_handle->io_handle->bytes_per_sector;
+
+			/* The run of file extents has consecutive encryption identifiers
+			 * and is decrypted in place with a single call
+			 */
+			if( libfsapfs_encryption_context_crypt(
+			     data_handle->file_system_data_handle->encryption_context,
+			     LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+			     segment_data,
+			     read_size,
+			     segment_data,
+			     read_size,
+			     sector_number,
+			     data_handle->io_handle->bytes_per_sector,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to decrypt extent data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+#if defined( HAVE_PROFILER )
+	if( data_handle->io_handle->profiler != NULL )
+	{
+		if( libfsapfs_profiler_stop_timing(
+		     data_handle->io_handle->profiler,
+		     profiler_start_timestamp,
+		     function,
+		     file_offset,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to stop timing.",
 			 function );
 
 			return( -1 );
 		}
-		segment_data_offset += read_size;
-		segment_data_size   -= read_size;
+	}
+#endif /* defined( HAVE_PROFILER ) */
 
-		data_handle->current_offset += read_size;
+	return( (ssize_t) read_size );
+}
 
-		if( (size64_t) data_handle->current_offset >= data_handle->data_size )
+/* Reads encrypted data in chunks and decrypts the chunks in place using the decryption pool
+ * The decryption pool must be grabbed by the caller until this function returns
+ * Every chunk is queued for decryption as soon as it has been read, so that its decryption
+ * overlaps with reading the next chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_data_block_data_handle_read_and_decrypt_chunks(
+     libfsapfs_data_block_data_handle_t *data_handle,
+     libfsapfs_job_pool_t *decryption_pool,
+     libbfio_handle_t *file_io_handle,
+     uint8_t *data,
+     size_t data_size,
+     off64_t file_offset,
+     uint64_t encryption_identifier,
+     libcerror_error_t **error )
+{
+	libfsapfs_decryption_job_t decryption_jobs[ LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_JOBS ];
+
+	libfsapfs_job_request_t *job_request = NULL;
+	static char *function                = "libfsapfs_data_block_data_handle_read_and_decrypt_chunks";
+	size_t chunk_size                    = 0;
+	size_t data_offset                   = 0;
+	size_t read_size                     = 0;
+	ssize_t read_count                   = 0;
+	uint64_t sector_number               = 0;
+	int job_index                        = 0;
+	int result                           = 1;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_handle->io_handle->block_size == 0 )
+	 || ( data_handle->io_handle->bytes_per_sector == 0 )
+	 || ( ( data_handle->io_handle->block_size % data_handle->io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data handle - invalid IO handle - block size or bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->file_system_data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing file system data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( decryption_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decryption pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunks are block aligned and there are no more chunks than a request can hold
+	 */
+	chunk_size = ( data_size + LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_JOBS - 1 ) / LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_JOBS;
+
+	if( chunk_size < LIBFSAPFS_DECRYPTION_POOL_CHUNK_SIZE )
+	{
+		chunk_size = LIBFSAPFS_DECRYPTION_POOL_CHUNK_SIZE;
+	}
+	chunk_size = ( ( chunk_size + data_handle->io_handle->block_size - 1 ) / data_handle->io_handle->block_size ) * data_handle->io_handle->block_size;
+
+	sector_number  = encryption_identifier * data_handle->io_handle->block_size;
+	sector_number /= data_handle->io_handle->bytes_per_sector;
+
+	if( libfsapfs_job_request_initialize(
+	     &job_request,
+	     (int (*)(intptr_t *, libcerror_error_t **)) &libfsapfs_decryption_job_run,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create job request.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		if( job_index >= LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_JOBS )
 		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid job index value out of bounds.",
+			 function );
+
+			result = -1;
+
 			break;
 		}
+		read_size = data_size - data_offset;
+
+		if( read_size > chunk_size )
+		{
+			read_size = chunk_size;
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              &( data[ data_offset ] ),
+		              read_size,
+		              file_offset + (off64_t) data_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset + (off64_t) data_offset,
+			 file_offset + (off64_t) data_offset );
+
+			result = -1;
+
+			break;
+		}
+		decryption_jobs[ job_index ].encryption_context = data_handle->file_system_data_handle->encryption_context;
+		decryption_jobs[ job_index ].data               = &( data[ data_offset ] );
+		decryption_jobs[ job_index ].data_size          = read_size;
+		decryption_jobs[ job_index ].sector_number      = sector_number + (uint64_t) ( data_offset / data_handle->io_handle->bytes_per_sector );
+		decryption_jobs[ job_index ].bytes_per_sector   = data_handle->io_handle->bytes_per_sector;
+
+		if( libfsapfs_job_pool_push_job(
+		     decryption_pool,
+		     job_request,
+		     (intptr_t *) &( decryption_jobs[ job_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push decryption job.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		data_offset += read_size;
+
+		job_index++;
 	}
-	return( (ssize_t) segment_data_offset );
+	/* The jobs that have been pushed reference the data, hence the request
+	 * must be waited for even if reading a chunk failed
+	 */
+	if( libfsapfs_job_request_wait(
+	     job_request,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt chunks.",
+			 function );
+		}
+		result = -1;
+	}
+	if( libfsapfs_job_request_free(
+	     &job_request,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free job request.",
+			 function );
+		}
+		result = -1;
+	}
+	return( result );
 }
 
 /* Seeks a certain offset of the data
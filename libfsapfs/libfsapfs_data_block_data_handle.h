@@ -26,8 +26,10 @@
 #include <types.h>
 
 #include "libfsapfs_encryption_context.h"
+#include "libfsapfs_file_extent.h"
 #include "libfsapfs_file_system_data_handle.h"
 #include "libfsapfs_io_handle.h"
+#include "libfsapfs_job_pool.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
@@ -42,6 +44,10 @@ typedef struct libfsapfs_data_block_data_handle libfsapfs_data_block_data_handle
 
 struct libfsapfs_data_block_data_handle
 {
+	/* The IO handle
+	 */
+	libfsapfs_io_handle_t *io_handle;
+
 	/* The current offset
 	 */
 	off64_t current_offset;
@@ -58,9 +64,17 @@ struct libfsapfs_data_block_data_handle
 	 */
 	libfdata_vector_t *data_block_vector;
 
-	/* The data block cache
+	/* Value to indicate the data is sparse
+	 */
+	uint8_t is_sparse;
+
+	/* The index of the file extent that was last read from
 	 */
-	libfcache_cache_t *data_block_cache;
+	int current_extent_index;
+
+	/* The (logical) offset of the file extent that was last read from
+	 */
+	off64_t current_extent_offset;
 };
 
 int libfsapfs_data_block_data_handle_initialize(
@@ -86,6 +100,30 @@ ssize_t libfsapfs_data_block_data_handle_read_segment_data(
          uint8_t read_flags,
          libcerror_error_t **error );
 
+int libfsapfs_data_block_data_handle_get_current_file_extent(
+     libfsapfs_data_block_data_handle_t *data_handle,
+     int *extent_index,
+     libfsapfs_file_extent_t **file_extent,
+     off64_t *extent_data_offset,
+     libcerror_error_t **error );
+
+ssize_t libfsapfs_data_block_data_handle_read_extent_data(
+         libfsapfs_data_block_data_handle_t *data_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         libcerror_error_t **error );
+
+int libfsapfs_data_block_data_handle_read_and_decrypt_chunks(
+     libfsapfs_data_block_data_handle_t *data_handle,
+     libfsapfs_job_pool_t *decryption_pool,
+     libbfio_handle_t *file_io_handle,
+     uint8_t *data,
+     size_t data_size,
+     off64_t file_offset,
+     uint64_t encryption_identifier,
+     libcerror_error_t **error );
+
 off64_t libfsapfs_data_block_data_handle_seek_segment_offset(
          libfsapfs_data_block_data_handle_t *data_handle,
          intptr_t *file_io_handle,
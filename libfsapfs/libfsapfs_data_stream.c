@@ -258,6 +258,7 @@ on_error:
  */
 int libfsapfs_data_stream_initialize_from_compressed_data_stream(
      libfdata_stream_t **data_stream,
+     libfsapfs_io_handle_t *io_handle,
      libfdata_stream_t *compressed_data_stream,
      size64_t uncompressed_data_size,
      int compression_method,
@@ -281,6 +282,7 @@ int libfsapfs_data_stream_initialize_from_compressed_data_stream(
 	}
 	if( libfsapfs_compressed_data_handle_initialize(
 	     &data_handle,
+	     io_handle,
 	     compressed_data_stream,
 	     uncompressed_data_size,
 	     compression_method,
@@ -51,6 +51,7 @@ int libfsapfs_data_stream_initialize_from_file_extents(
 
 int libfsapfs_data_stream_initialize_from_compressed_data_stream(
      libfdata_stream_t **data_stream,
+     libfsapfs_io_handle_t *io_handle,
      libfdata_stream_t *compressed_data_stream,
      size64_t uncompressed_data_size,
      int compression_method,
@@ -0,0 +1,391 @@
+/*
+ * Decompressed block cache functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_decompressed_block_cache.h"
+#include "libfsapfs_libcerror.h"
+
+/* Creates a decompressed block cache
+ * Make sure the value block_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_decompressed_block_cache_initialize(
+     libfsapfs_decompressed_block_cache_t **block_cache,
+     int number_of_entries,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_decompressed_block_cache_initialize";
+	size_t entries_size   = 0;
+	int entry_index       = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries <= 0 )
+	 || ( (size_t) number_of_entries > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsapfs_decompressed_block_cache_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*block_cache = memory_allocate_structure(
+	                libfsapfs_decompressed_block_cache_t );
+
+	if( *block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_cache,
+	     0,
+	     sizeof( libfsapfs_decompressed_block_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block cache.",
+		 function );
+
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+
+		return( -1 );
+	}
+	entries_size = sizeof( libfsapfs_decompressed_block_cache_entry_t ) * number_of_entries;
+
+	( *block_cache )->entries = (libfsapfs_decompressed_block_cache_entry_t *) memory_allocate(
+	                                                                            entries_size );
+
+	if( ( *block_cache )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *block_cache )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	/* The data of an entry is allocated when the entry is first used
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		( *block_cache )->entries[ entry_index ].block_index = (uint32_t) -1;
+	}
+	( *block_cache )->number_of_entries = number_of_entries;
+	( *block_cache )->block_size        = block_size;
+
+	return( 1 );
+
+on_error:
+	if( *block_cache != NULL )
+	{
+		if( ( *block_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *block_cache )->entries );
+		}
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a decompressed block cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_decompressed_block_cache_free(
+     libfsapfs_decompressed_block_cache_t **block_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_decompressed_block_cache_free";
+	int entry_index       = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+		if( ( *block_cache )->entries != NULL )
+		{
+			for( entry_index = 0;
+			     entry_index < ( *block_cache )->number_of_entries;
+			     entry_index++ )
+			{
+				if( ( *block_cache )->entries[ entry_index ].data != NULL )
+				{
+					memory_free(
+					 ( *block_cache )->entries[ entry_index ].data );
+				}
+			}
+			memory_free(
+			 ( *block_cache )->entries );
+		}
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the cache entry of a specific compressed block
+ * If the block is not cached the least recently used entry is reused for the block. Its block
+ * index is set to (uint32_t) -1 and should be set by the caller once the block has been decompressed
+ * into the data of the entry
+ * Returns 1 if the block is cached, 0 if not or -1 on error
+ */
+int libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+     libfsapfs_decompressed_block_cache_t *block_cache,
+     uint32_t block_index,
+     libfsapfs_decompressed_block_cache_entry_t **cache_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_decompressed_block_cache_entry_t *least_recently_used_entry = NULL;
+	libfsapfs_decompressed_block_cache_entry_t *safe_cache_entry          = NULL;
+	static char *function                                                 = "libfsapfs_decompressed_block_cache_get_entry_by_block_index";
+	int entry_index                                                       = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_cache->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid block cache - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index == (uint32_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	block_cache->access_counter += 1;
+
+	/* The number of entries is small, hence a linear search is used
+	 */
+	for( entry_index = 0;
+	     entry_index < block_cache->number_of_entries;
+	     entry_index++ )
+	{
+		safe_cache_entry = &( block_cache->entries[ entry_index ] );
+
+		if( safe_cache_entry->block_index == block_index )
+		{
+			safe_cache_entry->last_access = block_cache->access_counter;
+
+			block_cache->number_of_hits += 1;
+
+			*cache_entry = safe_cache_entry;
+
+			return( 1 );
+		}
+		if( ( least_recently_used_entry == NULL )
+		 || ( safe_cache_entry->last_access < least_recently_used_entry->last_access ) )
+		{
+			least_recently_used_entry = safe_cache_entry;
+		}
+	}
+	if( least_recently_used_entry->data == NULL )
+	{
+		least_recently_used_entry->data = (uint8_t *) memory_allocate(
+		                                               sizeof( uint8_t ) * block_cache->block_size );
+
+		if( least_recently_used_entry->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	least_recently_used_entry->block_index = (uint32_t) -1;
+	least_recently_used_entry->data_size   = 0;
+	least_recently_used_entry->last_access = block_cache->access_counter;
+
+	block_cache->number_of_misses += 1;
+
+	*cache_entry = least_recently_used_entry;
+
+	return( 0 );
+}
+
+/* Retrieves the decompressed block cache statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_decompressed_block_cache_get_statistics(
+     libfsapfs_decompressed_block_cache_t *block_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_decompressed_block_cache_get_statistics";
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_hits   = block_cache->number_of_hits;
+	*number_of_misses = block_cache->number_of_misses;
+
+	return( 1 );
+}
+
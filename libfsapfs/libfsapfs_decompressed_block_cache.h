@@ -0,0 +1,111 @@
+/*
+ * Decompressed block cache functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_DECOMPRESSED_BLOCK_CACHE_H )
+#define _LIBFSAPFS_DECOMPRESSED_BLOCK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_decompressed_block_cache_entry libfsapfs_decompressed_block_cache_entry_t;
+
+struct libfsapfs_decompressed_block_cache_entry
+{
+	/* The compressed block index, (uint32_t) -1 if the entry is not in use
+	 */
+	uint32_t block_index;
+
+	/* The (decompressed) data
+	 */
+	uint8_t *data;
+
+	/* The (decompressed) data size
+	 */
+	size_t data_size;
+
+	/* The value of the access counter when the entry was last used
+	 */
+	uint64_t last_access;
+};
+
+typedef struct libfsapfs_decompressed_block_cache libfsapfs_decompressed_block_cache_t;
+
+struct libfsapfs_decompressed_block_cache
+{
+	/* The entries
+	 */
+	libfsapfs_decompressed_block_cache_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The access counter
+	 */
+	uint64_t access_counter;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+};
+
+int libfsapfs_decompressed_block_cache_initialize(
+     libfsapfs_decompressed_block_cache_t **block_cache,
+     int number_of_entries,
+     size_t block_size,
+     libcerror_error_t **error );
+
+int libfsapfs_decompressed_block_cache_free(
+     libfsapfs_decompressed_block_cache_t **block_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+     libfsapfs_decompressed_block_cache_t *block_cache,
+     uint32_t block_index,
+     libfsapfs_decompressed_block_cache_entry_t **cache_entry,
+     libcerror_error_t **error );
+
+int libfsapfs_decompressed_block_cache_get_statistics(
+     libfsapfs_decompressed_block_cache_t *block_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_DECOMPRESSED_BLOCK_CACHE_H ) */
+
@@ -0,0 +1,86 @@
+/*
+ * Decompression job functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_compression.h"
+#include "libfsapfs_decompression_job.h"
+#include "libfsapfs_libcerror.h"
+
+/* Decompresses the data of a job
+ * Callback function for the job pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_decompression_job_run(
+     libfsapfs_decompression_job_t *decompression_job,
+     libcerror_error_t **error )
+{
+	static char *function         = "libfsapfs_decompression_job_run";
+	size_t uncompressed_data_size = 0;
+
+	if( decompression_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompression job.",
+		 function );
+
+		return( -1 );
+	}
+	uncompressed_data_size = decompression_job->uncompressed_data_size;
+
+	if( libfsapfs_decompress_data(
+	     decompression_job->compressed_data,
+	     decompression_job->compressed_data_size,
+	     decompression_job->compression_method,
+	     decompression_job->uncompressed_data,
+	     &uncompressed_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress data.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data is written directly into the buffer of the caller,
+	 * hence a block that decompresses to less data than expected is an error
+	 */
+	if( uncompressed_data_size != decompression_job->uncompressed_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: invalid uncompressed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,73 @@
+/*
+ * Decryption job functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_decryption_job.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_encryption_context.h"
+#include "libfsapfs_libcerror.h"
+
+/* Decrypts the data of a job in place
+ * Callback function for the job pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_decryption_job_run(
+     libfsapfs_decryption_job_t *decryption_job,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_decryption_job_run";
+
+	if( decryption_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decryption job.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_encryption_context_crypt(
+	     decryption_job->encryption_context,
+	     LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	     decryption_job->data,
+	     decryption_job->data_size,
+	     decryption_job->data,
+	     decryption_job->data_size,
+	     decryption_job->sector_number,
+	     decryption_job->bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to decrypt data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,69 @@
+/*
+ * Decryption job functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_DECRYPTION_JOB_H )
+#define _LIBFSAPFS_DECRYPTION_JOB_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_encryption_context.h"
+#include "libfsapfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_decryption_job libfsapfs_decryption_job_t;
+
+struct libfsapfs_decryption_job
+{
+	/* The encryption context
+	 */
+	libfsapfs_encryption_context_t *encryption_context;
+
+	/* The data, which is decrypted in place
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The sector number of the start of the data
+	 */
+	uint64_t sector_number;
+
+	/* The bytes per sector
+	 */
+	uint16_t bytes_per_sector;
+};
+
+int libfsapfs_decryption_job_run(
+     libfsapfs_decryption_job_t *decryption_job,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_DECRYPTION_JOB_H ) */
+
@@ -24,11 +24,13 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_aes_ni.h"
 #include "libfsapfs_definitions.h"
 #include "libfsapfs_encryption_context.h"
 #include "libfsapfs_libcaes.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
+#include "libfsapfs_libcthreads.h"
 
 /* Creates an encryption context
  * Make sure the value encryption context is referencing, is set to NULL
@@ -120,6 +122,47 @@ int libfsapfs_encryption_context_initialize(
 
 		goto on_error;
 	}
+	if( libcaes_context_initialize(
+	     &( ( *context )->data_decryption_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize data decryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcaes_context_initialize(
+	     &( ( *context )->tweak_encryption_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize tweak encryption context.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *context )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *context )->method = method;
 
 	return( 1 );
@@ -127,6 +170,18 @@ int libfsapfs_encryption_context_initialize(
 on_error:
 	if( *context != NULL )
 	{
+		if( ( *context )->tweak_encryption_context != NULL )
+		{
+			libcaes_context_free(
+			 &( ( *context )->tweak_encryption_context ),
+			 NULL );
+		}
+		if( ( *context )->data_decryption_context != NULL )
+		{
+			libcaes_context_free(
+			 &( ( *context )->data_decryption_context ),
+			 NULL );
+		}
 		if( ( *context )->decryption_context != NULL )
 		{
 			libcaes_tweaked_context_free(
@@ -177,6 +232,57 @@ int libfsapfs_encryption_context_free(
 
 			result = -1;
 		}
+		if( libcaes_context_free(
+		     &( ( *context )->data_decryption_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable free data decryption context.",
+			 function );
+
+			result = -1;
+		}
+		if( libcaes_context_free(
+		     &( ( *context )->tweak_encryption_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable free tweak encryption context.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *context )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_set(
+		 ( *context )->aes_ni_data_round_keys,
+		 0,
+		 LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE );
+
+		memory_set(
+		 ( *context )->aes_ni_tweak_round_keys,
+		 0,
+		 LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE );
+
 		memory_free(
 		 *context );
 
@@ -196,9 +302,10 @@ int libfsapfs_encryption_context_set_keys(
      size_t tweak_key_size,
      libcerror_error_t **error )
 {
-	static char *function = "libfsapfs_encryption_context_set_keys";
-	size_t key_bit_size   = 0;
-	size_t key_byte_size  = 0;
+	static char *function        = "libfsapfs_encryption_context_set_keys";
+	size_t key_bit_size          = 0;
+	size_t key_byte_size         = 0;
+	uint8_t aes_ni_support_flags = 0;
 
 	if( context == NULL )
 	{
@@ -301,10 +408,98 @@ int libfsapfs_encryption_context_set_keys(
 
 		return( -1 );
 	}
+	if( libcaes_context_set_key(
+	     context->data_decryption_context,
+	     LIBCAES_CRYPT_MODE_DECRYPT,
+	     key,
+	     key_bit_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in data decryption context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcaes_context_set_key(
+	     context->tweak_encryption_context,
+	     LIBCAES_CRYPT_MODE_ENCRYPT,
+	     tweak_key,
+	     key_bit_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in tweak encryption context.",
+		 function );
+
+		return( -1 );
+	}
+	context->aes_ni_support_flags = 0;
+
+	if( libfsapfs_aes_ni_get_support_flags(
+	     &aes_ni_support_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hardware AES support flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( aes_ni_support_flags != 0 )
+	 && ( key_bit_size == 128 ) )
+	{
+		if( libfsapfs_aes_ni_set_key(
+		     context->aes_ni_data_round_keys,
+		     LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE,
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hardware AES data round keys.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfsapfs_aes_ni_set_key(
+		     context->aes_ni_tweak_round_keys,
+		     LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE,
+		     LIBCAES_CRYPT_MODE_ENCRYPT,
+		     tweak_key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hardware AES tweak round keys.",
+			 function );
+
+			return( -1 );
+		}
+		context->aes_ni_support_flags = aes_ni_support_flags;
+	}
 	return( 1 );
 }
 
 /* De- or encrypts a block of data
+ * The data can be decrypted in place, when the input and output data refer to the same buffer,
+ * if the bytes per sector is a multiple of 16 and the data size a multiple of the bytes per sector
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_encryption_context_crypt(
@@ -320,8 +515,11 @@ int libfsapfs_encryption_context_crypt(
 {
 	uint8_t tweak_value[ 16 ];
 
-	static char *function = "libfsapfs_encryption_context_crypt";
-	size_t data_offset    = 0;
+	static char *function     = "libfsapfs_encryption_context_crypt";
+	size_t data_offset        = 0;
+	size_t data_size          = 0;
+	size_t maximum_batch_size = 0;
+	uint8_t is_batched        = 0;
 
 	if( context == NULL )
 	{
@@ -400,6 +598,60 @@ int libfsapfs_encryption_context_crypt(
 
 		return( -1 );
 	}
+	if( bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid bytes per sector value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	/* Decrypt runs of whole sectors in batches, which requires no ciphertext stealing
+	 */
+	is_batched = (uint8_t) ( ( ( bytes_per_sector % 16 ) == 0 ) && ( ( input_data_size % bytes_per_sector ) == 0 ) );
+
+	if( is_batched != 0 )
+	{
+		if( context->aes_ni_support_flags != 0 )
+		{
+			if( libfsapfs_aes_ni_decrypt_xts(
+			     context->aes_ni_support_flags,
+			     context->aes_ni_data_round_keys,
+			     context->aes_ni_tweak_round_keys,
+			     input_data,
+			     output_data,
+			     input_data_size,
+			     sector_number,
+			     bytes_per_sector,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+				 "%s: unable to decrypt sectors using hardware AES.",
+				 function );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+	}
+	else if( input_data == output_data )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported in place decryption with bytes per sector: %" PRIu16 ".",
+		 function,
+		 bytes_per_sector );
+
+		return( -1 );
+	}
 	if( memory_set(
 	     tweak_value,
 	     0,
@@ -412,41 +664,132 @@ int libfsapfs_encryption_context_crypt(
 		 "%s: unable to clear tweak value.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	for( data_offset = 0;
-	     data_offset < input_data_size;
-	     data_offset += bytes_per_sector )
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The libcaes contexts are shared by all the threads reading the volume
+	 */
+	if( libcthreads_mutex_grab(
+	     context->mutex,
+	     error ) != 1 )
 	{
-		byte_stream_copy_from_uint64_little_endian(
-		 tweak_value,
-		 sector_number );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
 
-		if( libcaes_crypt_xts(
-		     context->decryption_context,
-		     LIBCAES_CRYPT_MODE_DECRYPT,
-		     tweak_value,
-		     16,
-		     &( input_data[ data_offset ] ),
-		     bytes_per_sector,
-		     &( output_data[ data_offset ] ),
-		     bytes_per_sector,
-		     error ) != 1 )
+		return( -1 );
+	}
+#endif
+	if( is_batched != 0 )
+	{
+		maximum_batch_size = (size_t) bytes_per_sector * LIBFSAPFS_ENCRYPTION_MAXIMUM_NUMBER_OF_XTS_SECTORS;
+
+		for( data_offset = 0;
+		     data_offset < input_data_size;
+		     data_offset += data_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
-			 "%s: unable to decrypt data.",
-			 function );
+			data_size = input_data_size - data_offset;
 
-			goto on_error;
+			if( data_size > maximum_batch_size )
+			{
+				data_size = maximum_batch_size;
+			}
+			if( libfsapfs_encryption_context_decrypt_xts_sectors(
+			     context,
+			     &( input_data[ data_offset ] ),
+			     &( output_data[ data_offset ] ),
+			     data_size,
+			     sector_number,
+			     bytes_per_sector,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+				 "%s: unable to decrypt sectors.",
+				 function );
+
+				goto on_error;
+			}
+			sector_number += data_size / bytes_per_sector;
+		}
+	}
+	else
+	{
+		for( data_offset = 0;
+		     data_offset < input_data_size;
+		     data_offset += data_size )
+		{
+			data_size = input_data_size - data_offset;
+
+			if( data_size > (size_t) bytes_per_sector )
+			{
+				data_size = (size_t) bytes_per_sector;
+			}
+			byte_stream_copy_from_uint64_little_endian(
+			 tweak_value,
+			 sector_number );
+
+			if( libcaes_crypt_xts(
+			     context->decryption_context,
+			     LIBCAES_CRYPT_MODE_DECRYPT,
+			     tweak_value,
+			     16,
+			     &( input_data[ data_offset ] ),
+			     data_size,
+			     &( output_data[ data_offset ] ),
+			     data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+				 "%s: unable to decrypt data.",
+				 function );
+
+				goto on_error;
+			}
+			sector_number += 1;
 		}
-		sector_number += 1;
 	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     context->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		memory_set(
+		 tweak_value,
+		 0,
+		 16 );
+
+		return( -1 );
+	}
+#endif
+	memory_set(
+	 tweak_value,
+	 0,
+	 16 );
+
 	return( 1 );
 
 on_error:
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 context->mutex,
+	 NULL );
+#endif
 	memory_set(
 	 tweak_value,
 	 0,
@@ -455,6 +798,249 @@ on_error:
 	return( -1 );
 }
 
+/* Decrypts a run of consecutive AES-XTS sectors
+ * The tweak values of all sectors are encrypted with a single call and the sector data
+ * is decrypted with a single call, instead of setting up every sector separately
+ * The input and output data can refer to the same buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_encryption_context_decrypt_xts_sectors(
+     libfsapfs_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t sector_number,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	uint8_t tweak_values[ 16 * LIBFSAPFS_ENCRYPTION_MAXIMUM_NUMBER_OF_XTS_SECTORS ];
+
+	static char *function    = "libfsapfs_encryption_context_decrypt_xts_sectors";
+	size_t number_of_sectors = 0;
+	size_t sector_index      = 0;
+	size_t tweak_values_size = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( ( data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sectors = data_size / bytes_per_sector;
+
+	if( number_of_sectors > LIBFSAPFS_ENCRYPTION_MAXIMUM_NUMBER_OF_XTS_SECTORS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of sectors value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	tweak_values_size = number_of_sectors * 16;
+
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( tweak_values[ sector_index * 16 ] ),
+		 sector_number + sector_index );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( tweak_values[ ( sector_index * 16 ) + 8 ] ),
+		 (uint64_t) 0 );
+	}
+	if( libcaes_crypt_ecb(
+	     context->tweak_encryption_context,
+	     LIBCAES_CRYPT_MODE_ENCRYPT,
+	     tweak_values,
+	     tweak_values_size,
+	     tweak_values,
+	     tweak_values_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+		 "%s: unable to encrypt tweak values.",
+		 function );
+
+		goto on_error;
+	}
+	libfsapfs_encryption_context_xor_xts_tweaks(
+	 input_data,
+	 output_data,
+	 data_size,
+	 tweak_values,
+	 bytes_per_sector );
+
+	if( libcaes_crypt_ecb(
+	     context->data_decryption_context,
+	     LIBCAES_CRYPT_MODE_DECRYPT,
+	     output_data,
+	     data_size,
+	     output_data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to decrypt data.",
+		 function );
+
+		goto on_error;
+	}
+	libfsapfs_encryption_context_xor_xts_tweaks(
+	 output_data,
+	 output_data,
+	 data_size,
+	 tweak_values,
+	 bytes_per_sector );
+
+	memory_set(
+	 tweak_values,
+	 0,
+	 tweak_values_size );
+
+	return( 1 );
+
+on_error:
+	memory_set(
+	 tweak_values,
+	 0,
+	 tweak_values_size );
+
+	return( -1 );
+}
+
+/* Applies the AES-XTS tweaks to a run of consecutive sectors
+ * The tweak values contain the encrypted tweak of the first block of every sector,
+ * the tweaks of the successive blocks are derived by multiplication with alpha in GF(2^128)
+ */
+void libfsapfs_encryption_context_xor_xts_tweaks(
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     const uint8_t *tweak_values,
+     uint16_t bytes_per_sector )
+{
+	uint8_t tweak_value[ 16 ];
+
+	size_t block_offset        = 0;
+	size_t data_offset         = 0;
+	size_t tweak_values_offset = 0;
+	uint64_t carry_bit         = 0;
+	uint64_t lower_64bit       = 0;
+	uint64_t upper_64bit       = 0;
+	uint8_t byte_index         = 0;
+
+	if( ( input_data == NULL )
+	 || ( output_data == NULL )
+	 || ( tweak_values == NULL )
+	 || ( bytes_per_sector == 0 ) )
+	{
+		return;
+	}
+	for( data_offset = 0;
+	     ( data_offset + bytes_per_sector ) <= data_size;
+	     data_offset += bytes_per_sector )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( tweak_values[ tweak_values_offset ] ),
+		 lower_64bit );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( tweak_values[ tweak_values_offset + 8 ] ),
+		 upper_64bit );
+
+		tweak_values_offset += 16;
+
+		for( block_offset = data_offset;
+		     block_offset < ( data_offset + bytes_per_sector );
+		     block_offset += 16 )
+		{
+			byte_stream_copy_from_uint64_little_endian(
+			 &( tweak_value[ 0 ] ),
+			 lower_64bit );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( tweak_value[ 8 ] ),
+			 upper_64bit );
+
+			for( byte_index = 0;
+			     byte_index < 16;
+			     byte_index++ )
+			{
+				output_data[ block_offset + byte_index ] = input_data[ block_offset + byte_index ] ^ tweak_value[ byte_index ];
+			}
+			carry_bit   = upper_64bit >> 63;
+			upper_64bit = ( upper_64bit << 1 ) | ( lower_64bit >> 63 );
+			lower_64bit = ( lower_64bit << 1 ) ^ ( carry_bit * 0x87 );
+		}
+	}
+	memory_set(
+	 tweak_value,
+	 0,
+	 16 );
+}
+
 /* Unwrap data using AES Key Wrap (RFC3394)
  * Returns 1 if successful or -1 on error
  */
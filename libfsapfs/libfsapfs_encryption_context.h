@@ -25,8 +25,10 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_aes_ni.h"
 #include "libfsapfs_libcaes.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -43,6 +45,34 @@ struct libfsapfs_encryption_context
 	/* The AES-XTS decryption context
 	 */
 	libcaes_tweaked_context_t *decryption_context;
+
+	/* The AES data decryption context
+	 */
+	libcaes_context_t *data_decryption_context;
+
+	/* The AES tweak encryption context
+	 */
+	libcaes_context_t *tweak_encryption_context;
+
+	/* The hardware AES support flags, which are set when the hardware
+	 * AES round keys are set
+	 */
+	uint8_t aes_ni_support_flags;
+
+	/* The hardware AES data decryption round keys
+	 */
+	uint8_t aes_ni_data_round_keys[ LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE ];
+
+	/* The hardware AES tweak encryption round keys
+	 */
+	uint8_t aes_ni_tweak_round_keys[ LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE ];
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The mutex, which serializes the use of the libcaes contexts
+	 * since these can keep per call state, such as an OpenSSL cipher context
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
 };
 
 int libfsapfs_encryption_context_initialize(
@@ -73,6 +103,22 @@ int libfsapfs_encryption_context_crypt(
      uint16_t bytes_per_sector,
      libcerror_error_t **error );
 
+int libfsapfs_encryption_context_decrypt_xts_sectors(
+     libfsapfs_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t sector_number,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error );
+
+void libfsapfs_encryption_context_xor_xts_tweaks(
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     const uint8_t *tweak_values,
+     uint16_t bytes_per_sector );
+
 int libfsapfs_encryption_aes_key_unwrap(
      const uint8_t *key,
      size_t key_size_bits,
@@ -30,7 +30,9 @@
 #include "libfsapfs_extended_attribute.h"
 #include "libfsapfs_file_entry.h"
 #include "libfsapfs_file_extent.h"
+#include "libfsapfs_file_io_handle_pool.h"
 #include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_file_system_btree_cursor.h"
 #include "libfsapfs_inode.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
@@ -136,6 +138,19 @@ int libfsapfs_file_entry_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_file_entry->data_stream_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize data stream mutex.",
+		 function );
+
+		goto on_error;
+	}
 #endif
 	*file_entry = (libfsapfs_file_entry_t *) internal_file_entry;
 
@@ -144,6 +159,14 @@ int libfsapfs_file_entry_initialize(
 on_error:
 	if( internal_file_entry != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBFSAPFS )
+		if( internal_file_entry->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_file_entry->read_write_lock ),
+			 NULL );
+		}
+#endif
 		memory_free(
 		 internal_file_entry );
 	}
@@ -191,6 +214,19 @@ int libfsapfs_file_entry_free(
 
 			result = -1;
 		}
+		if( libcthreads_mutex_free(
+		     &( internal_file_entry->data_stream_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data stream mutex.",
+			 function );
+
+			result = -1;
+		}
 #endif
 		/* The file_io_handle and file_system_btree references are freed elsewhere
 		 */
@@ -260,6 +296,23 @@ int libfsapfs_file_entry_free(
 				result = -1;
 			}
 		}
+		if( internal_file_entry->sub_file_entry_inodes != NULL )
+		{
+			if( libcdata_array_free(
+			     &( internal_file_entry->sub_file_entry_inodes ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_inode_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub file entry inodes array.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( internal_file_entry->file_extents != NULL )
 		{
 			if( libcdata_array_free(
@@ -1519,12 +1572,10 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
      libfsapfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error )
 {
-	libfsapfs_extended_attribute_t *extended_attribute = NULL;
-	static char *function                              = "libfsapfs_internal_file_entry_get_extended_attributes";
-	uint64_t file_system_identifier                    = 0;
-	int extended_attribute_index                       = 0;
-	int number_of_extended_attributes                  = 0;
-	int result                                         = 0;
+	libcdata_array_t *extended_attributes = NULL;
+	static char *function                 = "libfsapfs_internal_file_entry_get_extended_attributes";
+	uint64_t file_system_identifier       = 0;
+	int result                            = 0;
 
 	if( internal_file_entry == NULL )
 	{
@@ -1563,7 +1614,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 		goto on_error;
 	}
 	if( libcdata_array_initialize(
-	     &( internal_file_entry->extended_attributes ),
+	     &extended_attributes,
 	     0,
 	     error ) != 1 )
 	{
@@ -1580,7 +1631,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 		  internal_file_entry->file_system_btree,
 		  internal_file_entry->file_io_handle,
 		  file_system_identifier,
-		  internal_file_entry->extended_attributes,
+		  extended_attributes,
 		  error );
 
 	if( result == -1 )
@@ -1594,8 +1645,85 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 
 		goto on_error;
 	}
+	if( libfsapfs_internal_file_entry_set_extended_attributes(
+	     internal_file_entry,
+	     &extended_attributes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set extended attributes.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( extended_attributes != NULL )
+	{
+		libcdata_array_free(
+		 &extended_attributes,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_internal_extended_attribute_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the extended attributes
+ * The file entry takes over management of the extended attributes array
+ * and determines the extended attributes with a special meaning
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_internal_file_entry_set_extended_attributes(
+     libfsapfs_internal_file_entry_t *internal_file_entry,
+     libcdata_array_t **extended_attributes,
+     libcerror_error_t **error )
+{
+	libfsapfs_extended_attribute_t *extended_attribute = NULL;
+	static char *function                              = "libfsapfs_internal_file_entry_set_extended_attributes";
+	int extended_attribute_index                       = 0;
+	int number_of_extended_attributes                  = 0;
+	int result                                         = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->extended_attributes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry - extended attributes value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extended_attributes == NULL )
+	 || ( *extended_attributes == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extended attributes.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_array_get_number_of_entries(
-	     internal_file_entry->extended_attributes,
+	     *extended_attributes,
 	     &number_of_extended_attributes,
 	     error ) != 1 )
 	{
@@ -1606,14 +1734,14 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 		 "%s: unable to retrieve number of entries from extended attributes array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	for( extended_attribute_index = 0;
 	     extended_attribute_index < number_of_extended_attributes;
 	     extended_attribute_index++ )
 	{
 		if( libcdata_array_get_entry_by_index(
-		     internal_file_entry->extended_attributes,
+		     *extended_attributes,
 		     extended_attribute_index,
 		     (intptr_t **) &extended_attribute,
 		     error ) != 1 )
@@ -1626,7 +1754,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 			 function,
 			 extended_attribute_index );
 
-			return( -1 );
+			goto on_error;
 		}
 		result = libfsapfs_extended_attribute_compare_name_with_utf8_string(
 		          extended_attribute,
@@ -1643,7 +1771,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 			 "%s: unable to compare UTF-8 string with name of extended attribute.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		else if( result == LIBUNA_COMPARE_EQUAL )
 		{
@@ -1666,7 +1794,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 			 "%s: unable to compare UTF-8 string with name of extended attribute.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		else if( result == LIBUNA_COMPARE_EQUAL )
 		{
@@ -1689,7 +1817,7 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 			 "%s: unable to compare UTF-8 string with name of extended attribute.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		else if( result == LIBUNA_COMPARE_EQUAL )
 		{
@@ -1698,16 +1826,16 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
 			continue;
 		}
 	}
+	internal_file_entry->extended_attributes = *extended_attributes;
+	*extended_attributes                     = NULL;
+
 	return( 1 );
 
 on_error:
-	if( internal_file_entry->extended_attributes != NULL )
-	{
-		libcdata_array_free(
-		 &( internal_file_entry->extended_attributes ),
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_internal_extended_attribute_free,
-		 NULL );
-	}
+	internal_file_entry->compressed_data_extended_attribute = NULL;
+	internal_file_entry->resource_fork_extended_attribute   = NULL;
+	internal_file_entry->symbolic_link_extended_attribute   = NULL;
+
 	return( -1 );
 }
 
@@ -3185,18 +3313,49 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the number of sub file entries
+/* Compares two file system identifiers
+ * Returns -1 if the first identifier is less, 1 if greater or 0 if equal
+ */
+int libfsapfs_internal_file_entry_compare_identifiers(
+     const void *first_identifier,
+     const void *second_identifier )
+{
+	uint64_t first_value  = *( (const uint64_t *) first_identifier );
+	uint64_t second_value = *( (const uint64_t *) second_identifier );
+
+	if( first_value < second_value )
+	{
+		return( -1 );
+	}
+	else if( first_value > second_value )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Determines the inodes of the sub file entries
+ * The directory entries are stored in name hash order, hence the identifiers of the sub file entries
+ * are sorted so that all inodes can be retrieved with a single forward walk of the file system B-tree
+ * instead of a root to leaf node lookup per sub file entry
  * Returns 1 if successful or -1 on error
  */
-int libfsapfs_file_entry_get_number_of_sub_file_entries(
-     libfsapfs_file_entry_t *file_entry,
-     int *number_of_sub_file_entries,
+int libfsapfs_internal_file_entry_get_sub_file_entry_inodes(
+     libfsapfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error )
 {
-	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
-	static char *function                                = "libfsapfs_file_entry_get_number_of_sub_file_entries";
+	libfsapfs_directory_record_t *directory_record = NULL;
+	libfsapfs_inode_t **inodes                     = NULL;
+	uint64_t *identifier                           = NULL;
+	uint64_t *identifiers                          = NULL;
+	static char *function                          = "libfsapfs_internal_file_entry_get_sub_file_entry_inodes";
+	uint64_t file_system_identifier                = 0;
+	int directory_entry_index                      = 0;
+	int identifier_index                           = 0;
+	int number_of_directory_entries                = 0;
+	int number_of_identifiers                      = 0;
 
-	if( file_entry == NULL )
+	if( internal_file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3207,157 +3366,466 @@ int libfsapfs_file_entry_get_number_of_sub_file_entries(
 
 		return( -1 );
 	}
-	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
-
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_file_entry->read_write_lock,
-	     error ) != 1 )
+	if( internal_file_entry->sub_file_entry_inodes != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry - sub file entry inodes value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_file_entry->directory_entries == NULL )
-	{
-		if( libfsapfs_internal_file_entry_get_directory_entries(
-		     internal_file_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine directory entries.",
-			 function );
-
-			goto on_error;
-		}
-	}
 	if( libcdata_array_get_number_of_entries(
 	     internal_file_entry->directory_entries,
-	     number_of_sub_file_entries,
+	     &number_of_directory_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from array.",
+		 "%s: unable to retrieve number of directory entries.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_file_entry->read_write_lock,
-	     error ) != 1 )
+	if( ( (size_t) number_of_directory_entries > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) )
+	 || ( (size_t) number_of_directory_entries > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsapfs_inode_t * ) ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of directory entries value out of bounds.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_file_entry->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Retrieves the sub file entry for the specific index
- * Returns 1 if successful or -1 on error
- */
-int libfsapfs_file_entry_get_sub_file_entry_by_index(
-     libfsapfs_file_entry_t *file_entry,
-     int sub_file_entry_index,
-     libfsapfs_file_entry_t **sub_file_entry,
-     libcerror_error_t **error )
-{
-	libfsapfs_directory_record_t *directory_record       = NULL;
-	libfsapfs_directory_record_t *directory_record_copy  = NULL;
-	libfsapfs_inode_t *inode                             = NULL;
-	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
-	static char *function                                = "libfsapfs_file_entry_get_sub_file_entry_by_index";
-	uint64_t file_system_identifier                      = 0;
-
-	if( file_entry == NULL )
+	if( libcdata_array_initialize(
+	     &( internal_file_entry->sub_file_entry_inodes ),
+	     number_of_directory_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file entry.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sub file entry inodes array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
-
-	if( sub_file_entry == NULL )
+	if( number_of_directory_entries == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid sub file entry.",
-		 function );
-
-		return( -1 );
+		return( 1 );
 	}
-	if( *sub_file_entry != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid sub file entry value already set.",
-		 function );
+	identifiers = (uint64_t *) memory_allocate(
+	                            sizeof( uint64_t ) * number_of_directory_entries );
 
-		return( -1 );
-	}
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_file_entry->read_write_lock,
-	     error ) != 1 )
+	if( identifiers == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create identifiers.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( internal_file_entry->directory_entries == NULL )
+	for( directory_entry_index = 0;
+	     directory_entry_index < number_of_directory_entries;
+	     directory_entry_index++ )
 	{
-		if( libfsapfs_internal_file_entry_get_directory_entries(
-		     internal_file_entry,
+		if( libcdata_array_get_entry_by_index(
+		     internal_file_entry->directory_entries,
+		     directory_entry_index,
+		     (intptr_t **) &directory_record,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine directory entries.",
-			 function );
+			 "%s: unable to retrieve directory entry: %d.",
+			 function,
+			 directory_entry_index );
+
+			goto on_error;
+		}
+		if( libfsapfs_directory_record_get_identifier(
+		     directory_record,
+		     &( identifiers[ directory_entry_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file system identifier from directory entry: %d.",
+			 function,
+			 directory_entry_index );
+
+			goto on_error;
+		}
+	}
+	qsort(
+	 identifiers,
+	 (size_t) number_of_directory_entries,
+	 sizeof( uint64_t ),
+	 &libfsapfs_internal_file_entry_compare_identifiers );
+
+	/* Remove duplicate identifiers, a directory can contain multiple hard links to the same inode
+	 */
+	number_of_identifiers = 1;
+
+	for( identifier_index = 1;
+	     identifier_index < number_of_directory_entries;
+	     identifier_index++ )
+	{
+		if( identifiers[ identifier_index ] != identifiers[ number_of_identifiers - 1 ] )
+		{
+			identifiers[ number_of_identifiers++ ] = identifiers[ identifier_index ];
+		}
+	}
+	inodes = (libfsapfs_inode_t **) memory_allocate(
+	                                 sizeof( libfsapfs_inode_t * ) * number_of_identifiers );
+
+	if( inodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create inodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     inodes,
+	     0,
+	     sizeof( libfsapfs_inode_t * ) * number_of_identifiers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear inodes.",
+		 function );
+
+		memory_free(
+		 inodes );
+
+		inodes = NULL;
+
+		goto on_error;
+	}
+	if( libfsapfs_file_system_btree_get_inodes_by_identifiers(
+	     internal_file_entry->file_system_btree,
+	     internal_file_entry->file_io_handle,
+	     identifiers,
+	     number_of_identifiers,
+	     inodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve inodes from file system B-tree.",
+		 function );
+
+		goto on_error;
+	}
+	/* Hand out every inode once, in directory entry order, additional hard links
+	 * to the same inode are retrieved on demand
+	 */
+	for( directory_entry_index = 0;
+	     directory_entry_index < number_of_directory_entries;
+	     directory_entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_file_entry->directory_entries,
+		     directory_entry_index,
+		     (intptr_t **) &directory_record,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry: %d.",
+			 function,
+			 directory_entry_index );
+
+			goto on_error;
+		}
+		if( libfsapfs_directory_record_get_identifier(
+		     directory_record,
+		     &file_system_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file system identifier from directory entry: %d.",
+			 function,
+			 directory_entry_index );
+
+			goto on_error;
+		}
+		identifier = (uint64_t *) bsearch(
+		                           &file_system_identifier,
+		                           identifiers,
+		                           (size_t) number_of_identifiers,
+		                           sizeof( uint64_t ),
+		                           &libfsapfs_internal_file_entry_compare_identifiers );
+
+		if( identifier == NULL )
+		{
+			continue;
+		}
+		identifier_index = (int) ( identifier - identifiers );
+
+		if( inodes[ identifier_index ] == NULL )
+		{
+			continue;
+		}
+		if( libcdata_array_set_entry_by_index(
+		     internal_file_entry->sub_file_entry_inodes,
+		     directory_entry_index,
+		     (intptr_t *) inodes[ identifier_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set sub file entry inode: %d in array.",
+			 function,
+			 directory_entry_index );
+
+			goto on_error;
+		}
+		inodes[ identifier_index ] = NULL;
+	}
+	memory_free(
+	 inodes );
+
+	memory_free(
+	 identifiers );
+
+	return( 1 );
+
+on_error:
+	if( inodes != NULL )
+	{
+		for( identifier_index = 0;
+		     identifier_index < number_of_identifiers;
+		     identifier_index++ )
+		{
+			if( inodes[ identifier_index ] != NULL )
+			{
+				libfsapfs_inode_free(
+				 &( inodes[ identifier_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 inodes );
+	}
+	if( identifiers != NULL )
+	{
+		memory_free(
+		 identifiers );
+	}
+	if( internal_file_entry->sub_file_entry_inodes != NULL )
+	{
+		libcdata_array_free(
+		 &( internal_file_entry->sub_file_entry_inodes ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_inode_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of sub file entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_entry_get_number_of_sub_file_entries(
+     libfsapfs_file_entry_t *file_entry,
+     int *number_of_sub_file_entries,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsapfs_file_entry_get_number_of_sub_file_entries";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file_entry->directory_entries == NULL )
+	{
+		if( libfsapfs_internal_file_entry_get_directory_entries(
+		     internal_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine directory entries.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_file_entry->directory_entries,
+	     number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_file_entry->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the sub file entry for the specific index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_entry_get_sub_file_entry_by_index(
+     libfsapfs_file_entry_t *file_entry,
+     int sub_file_entry_index,
+     libfsapfs_file_entry_t **sub_file_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_directory_record_t *directory_record       = NULL;
+	libfsapfs_directory_record_t *directory_record_copy  = NULL;
+	libfsapfs_inode_t *inode                             = NULL;
+	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsapfs_file_entry_get_sub_file_entry_by_index";
+	uint64_t file_system_identifier                      = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
+
+	if( sub_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sub_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sub file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file_entry->directory_entries == NULL )
+	{
+		if( libfsapfs_internal_file_entry_get_directory_entries(
+		     internal_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine directory entries.",
+			 function );
 
 			goto on_error;
 		}
@@ -3391,83 +3859,419 @@ int libfsapfs_file_entry_get_sub_file_entry_by_index(
 		 function,
 		 sub_file_entry_index );
 
-		goto on_error;
+		goto on_error;
+	}
+	if( internal_file_entry->sub_file_entry_inodes == NULL )
+	{
+		if( libfsapfs_internal_file_entry_get_sub_file_entry_inodes(
+		     internal_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sub file entry inodes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_file_entry->sub_file_entry_inodes,
+	     sub_file_entry_index,
+	     (intptr_t **) &inode,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry inode: %d.",
+		 function,
+		 sub_file_entry_index );
+
+		inode = NULL;
+
+		goto on_error;
+	}
+	if( inode != NULL )
+	{
+		/* The sub file entry takes over management of the inode
+		 */
+		if( libcdata_array_set_entry_by_index(
+		     internal_file_entry->sub_file_entry_inodes,
+		     sub_file_entry_index,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set sub file entry inode: %d in array.",
+			 function,
+			 sub_file_entry_index );
+
+			inode = NULL;
+
+			goto on_error;
+		}
+	}
+	else if( libfsapfs_file_system_btree_get_inode_by_identifier(
+	          internal_file_entry->file_system_btree,
+	          internal_file_entry->file_io_handle,
+	          file_system_identifier,
+	          &inode,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve inode: %" PRIu64 " from file system B-tree.",
+		 function,
+		 file_system_identifier );
+
+		 goto on_error;
+	}
+	if( libfsapfs_directory_record_clone(
+	     &directory_record_copy,
+	     directory_record,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory record copy.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_entry_initialize(
+	     sub_file_entry,
+	     internal_file_entry->io_handle,
+	     internal_file_entry->file_io_handle,
+	     internal_file_entry->encryption_context,
+	     internal_file_entry->file_system_btree,
+	     inode,
+	     directory_record_copy,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry.",
+		 function );
+
+		goto on_error;
+	}
+	inode                 = NULL;
+	directory_record_copy = NULL;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( directory_record_copy != NULL )
+	{
+		libfsapfs_directory_record_free(
+		 &directory_record_copy,
+		 NULL );
+	}
+	if( inode != NULL )
+	{
+		libfsapfs_inode_free(
+		 &inode,
+		 NULL );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_file_entry->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Iterates over the sub file entries
+ * The directory records are read as the leaf nodes of the file system B-tree are walked,
+ * which bounds the memory used and does not require all directory entries to be determined
+ * before the first sub file entry is passed to the callback function
+ * The sub file entry passed to the callback function is freed after the callback function returns
+ * The callback function should return 1 to continue, 0 to stop the iteration or -1 on error
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_entry_iterate_sub_file_entries(
+     libfsapfs_file_entry_t *file_entry,
+     int (*callback_function)(
+            libfsapfs_file_entry_t *sub_file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libfsapfs_directory_record_t *directory_record                 = NULL;
+	libfsapfs_file_entry_t *sub_file_entry                         = NULL;
+	libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor = NULL;
+	libfsapfs_inode_t *inode                                       = NULL;
+	libfsapfs_internal_file_entry_t *internal_file_entry           = NULL;
+	static char *function                                          = "libfsapfs_file_entry_iterate_sub_file_entries";
+	uint64_t file_system_identifier                                = 0;
+	uint64_t parent_identifier                                     = 0;
+	int callback_result                                            = 0;
+	int result                                                     = 1;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
+
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_inode_get_identifier(
+	     internal_file_entry->inode,
+	     &parent_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier from inode.",
+		 function );
+
+		result = -1;
 	}
-	if( libfsapfs_file_system_btree_get_inode_by_identifier(
-	     internal_file_entry->file_system_btree,
-	     internal_file_entry->file_io_handle,
-	     file_system_identifier,
-	     &inode,
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file_entry->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve inode: %" PRIu64 " from file system B-tree.",
-		 function,
-		 file_system_identifier );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-		 goto on_error;
+		return( -1 );
 	}
-	if( libfsapfs_directory_record_clone(
-	     &directory_record_copy,
-	     directory_record,
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	/* The lock is not held while iterating so that the callback function can use the file entry,
+	 * the file system B-tree and IO handles referenced by the file entry do not change
+	 */
+	if( libfsapfs_file_system_btree_cursor_initialize(
+	     &file_system_btree_cursor,
+	     internal_file_entry->file_system_btree,
+	     internal_file_entry->file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create directory record copy.",
+		 "%s: unable to create file system B-tree cursor.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfsapfs_file_entry_initialize(
-	     sub_file_entry,
-	     internal_file_entry->io_handle,
-	     internal_file_entry->file_io_handle,
-	     internal_file_entry->encryption_context,
-	     internal_file_entry->file_system_btree,
-	     inode,
-	     directory_record_copy,
+	if( libfsapfs_file_system_btree_cursor_seek(
+	     file_system_btree_cursor,
+	     parent_identifier,
+	     LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file entry.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to seek directory entries: %" PRIu64 " in file system B-tree.",
+		 function,
+		 parent_identifier );
 
 		goto on_error;
 	}
-	inode                 = NULL;
-	directory_record_copy = NULL;
+	do
+	{
+		result = libfsapfs_file_system_btree_cursor_get_next_directory_record(
+		          file_system_btree_cursor,
+		          parent_identifier,
+		          &directory_record,
+		          error );
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_file_entry->read_write_lock,
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next directory record.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libfsapfs_directory_record_get_identifier(
+		     directory_record,
+		     &file_system_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file system identifier from directory record.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_file_system_btree_get_inode_by_identifier(
+		     internal_file_entry->file_system_btree,
+		     internal_file_entry->file_io_handle,
+		     file_system_identifier,
+		     &inode,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve inode: %" PRIu64 " from file system B-tree.",
+			 function,
+			 file_system_identifier );
+
+			goto on_error;
+		}
+		if( libfsapfs_file_entry_initialize(
+		     &sub_file_entry,
+		     internal_file_entry->io_handle,
+		     internal_file_entry->file_io_handle,
+		     internal_file_entry->encryption_context,
+		     internal_file_entry->file_system_btree,
+		     inode,
+		     directory_record,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sub file entry.",
+			 function );
+
+			goto on_error;
+		}
+		inode            = NULL;
+		directory_record = NULL;
+
+		callback_result = callback_function(
+		                   sub_file_entry,
+		                   callback_data,
+		                   error );
+
+		if( callback_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: callback function failed for sub file entry: %" PRIu64 ".",
+			 function,
+			 file_system_identifier );
+
+			goto on_error;
+		}
+		if( libfsapfs_file_entry_free(
+		     &sub_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sub file entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( callback_result == 1 );
+
+	if( libfsapfs_file_system_btree_cursor_free(
+	     &file_system_btree_cursor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file system B-tree cursor.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
 	return( 1 );
 
 on_error:
-	if( directory_record_copy != NULL )
+	if( sub_file_entry != NULL )
 	{
-		libfsapfs_directory_record_free(
-		 &directory_record_copy,
+		libfsapfs_file_entry_free(
+		 &sub_file_entry,
 		 NULL );
 	}
 	if( inode != NULL )
@@ -3476,11 +4280,18 @@ on_error:
 		 &inode,
 		 NULL );
 	}
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_file_entry->read_write_lock,
-	 NULL );
-#endif
+	if( directory_record != NULL )
+	{
+		libfsapfs_directory_record_free(
+		 &directory_record,
+		 NULL );
+	}
+	if( file_system_btree_cursor != NULL )
+	{
+		libfsapfs_file_system_btree_cursor_free(
+		 &file_system_btree_cursor,
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -4073,53 +4884,250 @@ int libfsapfs_internal_file_entry_get_data_stream(
 				 "%s: unable to retrieve data stream from resource fork extended attribute.",
 				 function );
 
-				goto on_error;
-			}
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( libfsapfs_extended_attribute_get_data_stream(
+			     internal_file_entry->compressed_data_extended_attribute,
+			     &compressed_data_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data stream from compressed data extended attribute.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libfsapfs_data_stream_initialize_from_compressed_data_stream(
+		     &( internal_file_entry->data_stream ),
+		     internal_file_entry->io_handle,
+		     compressed_data_stream,
+		     internal_file_entry->file_size,
+		     compression_method,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data stream from compressed data stream.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( internal_file_entry->data_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &( internal_file_entry->data_stream ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Grabs the data stream for reading
+ * This takes the read/write lock for reading and creates the data stream on first use.
+ * The data stream mutex is held until the data stream is released, because the data
+ * stream keeps a current offset and segment data cache, that cannot be shared
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_internal_file_entry_grab_data_stream(
+     libfsapfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_internal_file_entry_grab_data_stream";
+	int result            = 1;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file_entry->data_stream == NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		/* The read/write lock cannot be upgraded, hence it is released and grabbed for writing
+		 * and the data stream is checked again, since another thread could have created it
+		 */
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
 		}
-		else
+		if( internal_file_entry->data_stream == NULL )
 		{
-			if( libfsapfs_extended_attribute_get_data_stream(
-			     internal_file_entry->compressed_data_extended_attribute,
-			     &compressed_data_stream,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve data stream from compressed data extended attribute.",
-				 function );
+			result = libfsapfs_internal_file_entry_get_data_stream(
+			          internal_file_entry,
+			          error );
+		}
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
 
-				goto on_error;
-			}
+			return( -1 );
 		}
-		if( libfsapfs_data_stream_initialize_from_compressed_data_stream(
-		     &( internal_file_entry->data_stream ),
-		     compressed_data_stream,
-		     internal_file_entry->file_size,
-		     compression_method,
+#else
+		result = libfsapfs_internal_file_entry_get_data_stream(
+		          internal_file_entry,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine data stream.",
+			 function );
+
+			return( -1 );
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_file_entry->read_write_lock,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create data stream from compressed data stream.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
+#endif
 	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_file_entry->data_stream_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab data stream mutex.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 internal_file_entry->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
 	return( 1 );
+}
 
-on_error:
-	if( internal_file_entry->data_stream != NULL )
+/* Releases the data stream grabbed by libfsapfs_internal_file_entry_grab_data_stream
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_internal_file_entry_release_data_stream(
+     libfsapfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_internal_file_entry_release_data_stream";
+	int result            = 1;
+
+	if( internal_file_entry == NULL )
 	{
-		libfdata_stream_free(
-		 &( internal_file_entry->data_stream ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
 	}
-	return( -1 );
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_file_entry->data_stream_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release data stream mutex.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	return( result );
 }
 
 /* Reads data at the current offset into a buffer
@@ -4131,6 +5139,7 @@ ssize_t libfsapfs_file_entry_read_buffer(
          size_t buffer_size,
          libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle                     = NULL;
 	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
 	static char *function                                = "libfsapfs_file_entry_read_buffer";
 	ssize_t read_count                                   = 0;
@@ -4148,40 +5157,43 @@ ssize_t libfsapfs_file_entry_read_buffer(
 	}
 	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_file_entry->read_write_lock,
+	if( libfsapfs_internal_file_entry_grab_data_stream(
+	     internal_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab data stream.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_file_entry->data_stream == NULL )
+	file_io_handle = internal_file_entry->file_io_handle;
+
+	if( internal_file_entry->io_handle->file_io_handle_pool != NULL )
 	{
-		if( libfsapfs_internal_file_entry_get_data_stream(
-		     internal_file_entry,
+		if( libfsapfs_file_io_handle_pool_grab_handle(
+		     internal_file_entry->io_handle->file_io_handle_pool,
+		     &file_io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine data stream.",
+			 "%s: unable to grab file IO handle from pool.",
 			 function );
 
+			file_io_handle = NULL;
+
 			goto on_error;
 		}
 	}
 	read_count = libfdata_stream_read_buffer(
 	              internal_file_entry->data_stream,
-	              (intptr_t *) internal_file_entry->file_io_handle,
+	              (intptr_t *) file_io_handle,
 	              (uint8_t *) buffer,
 	              buffer_size,
 	              0,
@@ -4198,29 +5210,53 @@ ssize_t libfsapfs_file_entry_read_buffer(
 
 		goto on_error;
 	}
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_file_entry->read_write_lock,
+	if( internal_file_entry->io_handle->file_io_handle_pool != NULL )
+	{
+		if( libfsapfs_file_io_handle_pool_release_handle(
+		     internal_file_entry->io_handle->file_io_handle_pool,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO handle to pool.",
+			 function );
+
+			file_io_handle = NULL;
+
+			goto on_error;
+		}
+	}
+	if( libfsapfs_internal_file_entry_release_data_stream(
+	     internal_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release data stream.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	return( read_count );
 
 on_error:
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_file_entry->read_write_lock,
+	if( ( internal_file_entry->io_handle->file_io_handle_pool != NULL )
+	 && ( file_io_handle != NULL ) )
+	{
+		libfsapfs_file_io_handle_pool_release_handle(
+		 internal_file_entry->io_handle->file_io_handle_pool,
+		 file_io_handle,
+		 NULL );
+	}
+	libfsapfs_internal_file_entry_release_data_stream(
+	 internal_file_entry,
 	 NULL );
-#endif
+
 	return( -1 );
 }
 
@@ -4234,6 +5270,7 @@ ssize_t libfsapfs_file_entry_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle                     = NULL;
 	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
 	static char *function                                = "libfsapfs_file_entry_read_buffer_at_offset";
 	ssize_t read_count                                   = 0;
@@ -4251,40 +5288,43 @@ ssize_t libfsapfs_file_entry_read_buffer_at_offset(
 	}
 	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_file_entry->read_write_lock,
+	if( libfsapfs_internal_file_entry_grab_data_stream(
+	     internal_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab data stream.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_file_entry->data_stream == NULL )
+	file_io_handle = internal_file_entry->file_io_handle;
+
+	if( internal_file_entry->io_handle->file_io_handle_pool != NULL )
 	{
-		if( libfsapfs_internal_file_entry_get_data_stream(
-		     internal_file_entry,
+		if( libfsapfs_file_io_handle_pool_grab_handle(
+		     internal_file_entry->io_handle->file_io_handle_pool,
+		     &file_io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine data stream.",
+			 "%s: unable to grab file IO handle from pool.",
 			 function );
 
+			file_io_handle = NULL;
+
 			goto on_error;
 		}
 	}
 	read_count = libfdata_stream_read_buffer_at_offset(
 	              internal_file_entry->data_stream,
-	              (intptr_t *) internal_file_entry->file_io_handle,
+	              (intptr_t *) file_io_handle,
 	              (uint8_t *) buffer,
 	              buffer_size,
 	              offset,
@@ -4302,29 +5342,53 @@ ssize_t libfsapfs_file_entry_read_buffer_at_offset(
 
 		goto on_error;
 	}
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_file_entry->read_write_lock,
+	if( internal_file_entry->io_handle->file_io_handle_pool != NULL )
+	{
+		if( libfsapfs_file_io_handle_pool_release_handle(
+		     internal_file_entry->io_handle->file_io_handle_pool,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO handle to pool.",
+			 function );
+
+			file_io_handle = NULL;
+
+			goto on_error;
+		}
+	}
+	if( libfsapfs_internal_file_entry_release_data_stream(
+	     internal_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release data stream.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	return( read_count );
 
 on_error:
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_file_entry->read_write_lock,
+	if( ( internal_file_entry->io_handle->file_io_handle_pool != NULL )
+	 && ( file_io_handle != NULL ) )
+	{
+		libfsapfs_file_io_handle_pool_release_handle(
+		 internal_file_entry->io_handle->file_io_handle_pool,
+		 file_io_handle,
+		 NULL );
+	}
+	libfsapfs_internal_file_entry_release_data_stream(
+	 internal_file_entry,
 	 NULL );
-#endif
+
 	return( -1 );
 }
 
@@ -4353,37 +5417,19 @@ off64_t libfsapfs_file_entry_seek_offset(
 	}
 	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_file_entry->read_write_lock,
+	if( libfsapfs_internal_file_entry_grab_data_stream(
+	     internal_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab data stream.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_file_entry->data_stream == NULL )
-	{
-		if( libfsapfs_internal_file_entry_get_data_stream(
-		     internal_file_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine data stream.",
-			 function );
-
-			goto on_error;
-		}
-	}
 	offset = libfdata_stream_seek_offset(
 	          internal_file_entry->data_stream,
 	          offset,
@@ -4401,29 +5447,26 @@ off64_t libfsapfs_file_entry_seek_offset(
 
 		goto on_error;
 	}
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_file_entry->read_write_lock,
+	if( libfsapfs_internal_file_entry_release_data_stream(
+	     internal_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release data stream.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	return( offset );
 
 on_error:
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_file_entry->read_write_lock,
+	libfsapfs_internal_file_entry_release_data_stream(
+	 internal_file_entry,
 	 NULL );
-#endif
+
 	return( -1 );
 }
 
@@ -4451,37 +5494,19 @@ int libfsapfs_file_entry_get_offset(
 	}
 	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
 
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_file_entry->read_write_lock,
+	if( libfsapfs_internal_file_entry_grab_data_stream(
+	     internal_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab data stream.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_file_entry->data_stream == NULL )
-	{
-		if( libfsapfs_internal_file_entry_get_data_stream(
-		     internal_file_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine data stream.",
-			 function );
-
-			goto on_error;
-		}
-	}
 	if( libfdata_stream_get_offset(
 	     internal_file_entry->data_stream,
 	     offset,
@@ -4496,29 +5521,26 @@ int libfsapfs_file_entry_get_offset(
 
 		goto on_error;
 	}
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_file_entry->read_write_lock,
+	if( libfsapfs_internal_file_entry_release_data_stream(
+	     internal_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release data stream.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	return( 1 );
 
 on_error:
-#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_file_entry->read_write_lock,
+	libfsapfs_internal_file_entry_release_data_stream(
+	 internal_file_entry,
 	 NULL );
-#endif
+
 	return( -1 );
 }
 
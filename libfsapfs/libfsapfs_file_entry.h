@@ -97,6 +97,10 @@ struct libfsapfs_internal_file_entry
 	 */
 	libcdata_array_t *directory_entries;
 
+	/* The inodes of the sub file entries, the array is indexed by directory entry
+	 */
+	libcdata_array_t *sub_file_entry_inodes;
+
 	/* The file size
 	 */
 	size64_t file_size;
@@ -117,6 +121,11 @@ struct libfsapfs_internal_file_entry
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The data stream mutex, which serializes the use of the data stream
+	 * while the read/write lock is held for reading
+	 */
+	libcthreads_mutex_t *data_stream_mutex;
 #endif
 };
 
@@ -225,6 +234,11 @@ int libfsapfs_internal_file_entry_get_extended_attributes(
      libfsapfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error );
 
+int libfsapfs_internal_file_entry_set_extended_attributes(
+     libfsapfs_internal_file_entry_t *internal_file_entry,
+     libcdata_array_t **extended_attributes,
+     libcerror_error_t **error );
+
 int libfsapfs_internal_file_entry_get_symbolic_link_data(
      libfsapfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error );
@@ -302,6 +316,14 @@ int libfsapfs_internal_file_entry_get_directory_entries(
      libfsapfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error );
 
+int libfsapfs_internal_file_entry_compare_identifiers(
+     const void *first_identifier,
+     const void *second_identifier );
+
+int libfsapfs_internal_file_entry_get_sub_file_entry_inodes(
+     libfsapfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_file_entry_get_number_of_sub_file_entries(
      libfsapfs_file_entry_t *file_entry,
@@ -315,6 +337,16 @@ int libfsapfs_file_entry_get_sub_file_entry_by_index(
      libfsapfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error );
 
+LIBFSAPFS_EXTERN \
+int libfsapfs_file_entry_iterate_sub_file_entries(
+     libfsapfs_file_entry_t *file_entry,
+     int (*callback_function)(
+            libfsapfs_file_entry_t *sub_file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_file_entry_get_sub_file_entry_by_utf8_name(
      libfsapfs_file_entry_t *file_entry,
@@ -339,6 +371,14 @@ int libfsapfs_internal_file_entry_get_data_stream(
      libfsapfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error );
 
+int libfsapfs_internal_file_entry_grab_data_stream(
+     libfsapfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error );
+
+int libfsapfs_internal_file_entry_release_data_stream(
+     libfsapfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 ssize_t libfsapfs_file_entry_read_buffer(
          libfsapfs_file_entry_t *file_entry,
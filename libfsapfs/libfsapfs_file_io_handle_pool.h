@@ -0,0 +1,92 @@
+/*
+ * File IO handle pool functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_FILE_IO_HANDLE_POOL_H )
+#define _LIBFSAPFS_FILE_IO_HANDLE_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_file_io_handle_pool libfsapfs_file_io_handle_pool_t;
+
+struct libfsapfs_file_io_handle_pool
+{
+	/* The source file IO handle, which is not managed by the pool
+	 */
+	libbfio_handle_t *source_file_io_handle;
+
+	/* The file IO handles that were cloned from the source file IO handle
+	 */
+	libbfio_handle_t *file_io_handles[ LIBFSAPFS_FILE_IO_HANDLE_POOL_MAXIMUM_NUMBER_OF_HANDLES ];
+
+	/* The number of cloned file IO handles
+	 */
+	int number_of_file_io_handles;
+
+	/* The cloned file IO handles that are not in use
+	 */
+	libbfio_handle_t *free_file_io_handles[ LIBFSAPFS_FILE_IO_HANDLE_POOL_MAXIMUM_NUMBER_OF_HANDLES ];
+
+	/* The number of cloned file IO handles that are not in use
+	 */
+	int number_of_free_file_io_handles;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libfsapfs_file_io_handle_pool_initialize(
+     libfsapfs_file_io_handle_pool_t **file_io_handle_pool,
+     libbfio_handle_t *source_file_io_handle,
+     libcerror_error_t **error );
+
+int libfsapfs_file_io_handle_pool_free(
+     libfsapfs_file_io_handle_pool_t **file_io_handle_pool,
+     libcerror_error_t **error );
+
+int libfsapfs_file_io_handle_pool_grab_handle(
+     libfsapfs_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libfsapfs_file_io_handle_pool_release_handle(
+     libfsapfs_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_FILE_IO_HANDLE_POOL_H ) */
+
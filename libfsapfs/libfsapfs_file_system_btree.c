@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_block_cache.h"
 #include "libfsapfs_btree_entry.h"
 #include "libfsapfs_btree_node.h"
 #include "libfsapfs_data_block.h"
@@ -34,18 +35,18 @@
 #include "libfsapfs_extended_attribute.h"
 #include "libfsapfs_file_extent.h"
 #include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_file_system_btree_cursor.h"
 #include "libfsapfs_inode.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
-#include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
 #include "libfsapfs_libuna.h"
 #include "libfsapfs_name_hash.h"
+#include "libfsapfs_node_cache.h"
 #include "libfsapfs_object_map_btree.h"
-#include "libfsapfs_object_map_descriptor.h"
 
 #include "fsapfs_file_system.h"
 #include "fsapfs_object.h"
@@ -121,23 +122,32 @@ int libfsapfs_file_system_btree_initialize(
 
 		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &( ( *file_system_btree )->data_block_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DATA_BLOCKS,
-	     error ) != 1 )
+	if( io_handle == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data block cache.",
-		 function );
+		( *file_system_btree )->maximum_number_of_cached_nodes = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES;
+	}
+	else
+	{
+		if( libfsapfs_io_handle_reserve_cache_entries(
+		     io_handle,
+		     LIBFSAPFS_CACHE_TYPE_BTREE_NODES,
+		     0,
+		     &( ( *file_system_btree )->maximum_number_of_cached_nodes ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to reserve node cache entries.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	if( libfcache_cache_initialize(
+	if( libfsapfs_node_cache_initialize(
 	     &( ( *file_system_btree )->node_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES,
+	     ( *file_system_btree )->maximum_number_of_cached_nodes,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -161,6 +171,19 @@ int libfsapfs_file_system_btree_initialize(
 on_error:
 	if( *file_system_btree != NULL )
 	{
+		if( ( *file_system_btree )->node_cache != NULL )
+		{
+			libfsapfs_node_cache_free(
+			 &( ( *file_system_btree )->node_cache ),
+			 NULL );
+		}
+		if( io_handle != NULL )
+		{
+			libfsapfs_io_handle_release_cache_entries(
+			 io_handle,
+			 ( *file_system_btree )->maximum_number_of_cached_nodes,
+			 NULL );
+		}
 		memory_free(
 		 *file_system_btree );
 
@@ -194,7 +217,7 @@ int libfsapfs_file_system_btree_free(
 	{
 		/* The io_handle, data_block_vector iand object_map_btree are referenced and freed elsewhere
 		 */
-		if( libfcache_cache_free(
+		if( libfsapfs_node_cache_free(
 		     &( ( *file_system_btree )->node_cache ),
 		     error ) != 1 )
 		{
@@ -207,18 +230,38 @@ int libfsapfs_file_system_btree_free(
 
 			result = -1;
 		}
-		if( libfcache_cache_free(
-		     &( ( *file_system_btree )->data_block_cache ),
-		     error ) != 1 )
+		if( ( *file_system_btree )->root_node != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free data block cache.",
-			 function );
+			if( libfsapfs_btree_node_free(
+			     &( ( *file_system_btree )->root_node ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free root node.",
+				 function );
 
-			result = -1;
+				result = -1;
+			}
+		}
+		if( ( *file_system_btree )->io_handle != NULL )
+		{
+			if( libfsapfs_io_handle_release_cache_entries(
+			     ( *file_system_btree )->io_handle,
+			     ( *file_system_btree )->maximum_number_of_cached_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release node cache entries.",
+				 function );
+
+				result = -1;
+			}
 		}
 		memory_free(
 		 *file_system_btree );
@@ -228,6 +271,88 @@ int libfsapfs_file_system_btree_free(
 	return( result );
 }
 
+/* Sets the cache limits
+ * The maximum cache size is in bytes, where 0 represents the limit set in the IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_set_cache_limits(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     size64_t maximum_btree_nodes_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_set_cache_limits";
+
+	if( file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system B-tree - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_io_handle_release_cache_entries(
+	     file_system_btree->io_handle,
+	     file_system_btree->maximum_number_of_cached_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release node cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	file_system_btree->maximum_number_of_cached_nodes = 0;
+
+	if( libfsapfs_io_handle_reserve_cache_entries(
+	     file_system_btree->io_handle,
+	     LIBFSAPFS_CACHE_TYPE_BTREE_NODES,
+	     maximum_btree_nodes_cache_size,
+	     &( file_system_btree->maximum_number_of_cached_nodes ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to reserve node cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_node_cache_resize(
+	     file_system_btree->node_cache,
+	     file_system_btree->maximum_number_of_cached_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize node cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the sub node block number from a B-tree entry
  * Returns 1 if successful, 0 if not found or -1 on error
  */
@@ -238,10 +363,11 @@ int libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
      uint64_t *sub_node_block_number,
      libcerror_error_t **error )
 {
-	libfsapfs_object_map_descriptor_t *object_map_descriptor = NULL;
-	static char *function                                    = "libfsapfs_file_system_btree_get_sub_node_block_number_from_entry";
-	uint64_t sub_node_object_identifier                      = 0;
-	int result                                               = 0;
+	static char *function               = "libfsapfs_file_system_btree_get_sub_node_block_number_from_entry";
+	uint64_t physical_address           = 0;
+	uint64_t sub_node_object_identifier = 0;
+	uint32_t object_flags               = 0;
+	int result                          = 0;
 
 	if( file_system_btree == NULL )
 	{
@@ -311,11 +437,12 @@ int libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
 		 sub_node_object_identifier );
 	}
 #endif
-	result = libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
+	result = libfsapfs_object_map_btree_get_physical_address_by_object_identifier(
 	          file_system_btree->object_map_btree,
 	          file_io_handle,
 	          sub_node_object_identifier,
-	          &object_map_descriptor,
+	          &physical_address,
+	          &object_flags,
 	          error );
 
 	if( result == -1 )
@@ -324,63 +451,30 @@ int libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve object map descriptor for sub node object identifier: %" PRIu64 ".",
+		 "%s: unable to retrieve physical address for sub node object identifier: %" PRIu64 ".",
 		 function,
 		 sub_node_object_identifier );
 
-		goto on_error;
+		return( -1 );
 	}
 	else if( result != 0 )
 	{
-		if( object_map_descriptor == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid object map descriptor.",
-			 function );
-
-			goto on_error;
-		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
 			libcnotify_printf(
 			 "%s: sub node block number: %" PRIu64 "\n",
 			 function,
-			 object_map_descriptor->physical_address );
+			 physical_address );
 		}
 #endif
-		*sub_node_block_number = object_map_descriptor->physical_address;
-
-		if( libfsapfs_object_map_descriptor_free(
-		     &object_map_descriptor,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free object map descriptor.",
-			 function );
-
-			goto on_error;
-		}
+		*sub_node_block_number = physical_address;
 	}
 	return( result );
-
-on_error:
-	if( object_map_descriptor != NULL )
-	{
-		libfsapfs_object_map_descriptor_free(
-		 &object_map_descriptor,
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Retrieves the file system B-tree root node
+ * The node must be released with libfsapfs_file_system_btree_release_node
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_file_system_btree_get_root_node(
@@ -390,14 +484,13 @@ int libfsapfs_file_system_btree_get_root_node(
      libfsapfs_btree_node_t **root_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	libfsapfs_btree_node_t *node         = NULL;
-	libfsapfs_data_block_t *data_block   = NULL;
-	static char *function                = "libfsapfs_file_system_btree_get_root_node";
-	int result                           = 0;
+	libfsapfs_btree_node_t *node       = NULL;
+	libfsapfs_data_block_t *data_block = NULL;
+	static char *function              = "libfsapfs_file_system_btree_get_root_node";
+	int result                         = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp   = 0;
 #endif
 
 	if( file_system_btree == NULL )
@@ -444,6 +537,13 @@ int libfsapfs_file_system_btree_get_root_node(
 
 		return( -1 );
 	}
+	if( ( file_system_btree->root_node != NULL )
+	 && ( root_node_block_number == file_system_btree->root_node_block_number ) )
+	{
+		*root_node = file_system_btree->root_node;
+
+		return( 1 );
+	}
 #if defined( HAVE_PROFILER )
 	if( file_system_btree->io_handle->profiler != NULL )
 	{
@@ -464,12 +564,10 @@ int libfsapfs_file_system_btree_get_root_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	result = libfcache_cache_get_value_by_identifier(
+	result = libfsapfs_node_cache_get_node_by_block_number(
 	          file_system_btree->node_cache,
-	          0,
-	          (off64_t) root_node_block_number,
-	          0,
-	          &cache_value,
+	          root_node_block_number,
+	          root_node,
 	          error );
 
 	if( result == -1 )
@@ -485,13 +583,26 @@ int libfsapfs_file_system_btree_get_root_node(
 	}
 	else if( result == 0 )
 	{
-		if( libfdata_vector_get_element_value_by_index(
+		if( libfsapfs_btree_node_initialize(
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create B-tree node.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_block_cache_get_element_value_by_index(
+		     file_system_btree->io_handle->block_cache,
 		     file_system_btree->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) file_system_btree->data_block_cache,
+		     file_io_handle,
 		     (int) root_node_block_number,
+		     root_node_block_number,
 		     (intptr_t **) &data_block,
-		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -514,34 +625,40 @@ int libfsapfs_file_system_btree_get_root_node(
 			 function,
 			 root_node_block_number );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_initialize(
-		     &node,
-		     error ) != 1 )
+		else if( libfsapfs_btree_node_read_data(
+		          node,
+		          data_block->data,
+		          data_block->data_size,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree node.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read B-tree node.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_read_data(
-		     node,
-		     data_block->data,
-		     data_block->data_size,
+		if( libfsapfs_block_cache_release_element_value_by_block_number(
+		     file_system_btree->io_handle->block_cache,
+		     root_node_block_number,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read B-tree node.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release data block: %" PRIu64 ".",
+			 function,
+			 root_node_block_number );
 
+			result = -1;
+		}
+		if( result == -1 )
+		{
 			goto on_error;
 		}
 		if( ( node->object_type != 0x00000002UL )
@@ -578,7 +695,7 @@ int libfsapfs_file_system_btree_get_root_node(
 			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
 			 "%s: unsupported flags: 0x%04" PRIx16 ".",
 			 function,
-			 ( *root_node )->node_header->flags );
+			 node->node_header->flags );
 
 			goto on_error;
 		}
@@ -615,44 +732,29 @@ int libfsapfs_file_system_btree_get_root_node(
 
 			goto on_error;
 		}
-		if( libfcache_cache_set_value_by_identifier(
-		     file_system_btree->node_cache,
-		     0,
-		     (off64_t) root_node_block_number,
-		     0,
-		     (intptr_t *) node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
-		     error ) != 1 )
+		/* The root node of the B-tree is kept outside the node cache
+		 */
+		if( root_node_block_number == file_system_btree->root_node_block_number )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value in cache.",
-			 function );
-
-			goto on_error;
+			file_system_btree->root_node = node;
 		}
-		node = NULL;
-
-		if( libfcache_cache_get_value_by_identifier(
-		     file_system_btree->node_cache,
-		     0,
-		     (off64_t) root_node_block_number,
-		     0,
-		     &cache_value,
-		     error ) != 1 )
+		else if( libfsapfs_node_cache_set_node_by_block_number(
+		          file_system_btree->node_cache,
+		          root_node_block_number,
+		          &node,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
+		*root_node = node;
+		node       = NULL;
 	}
 #if defined( HAVE_PROFILER )
 	if( file_system_btree->io_handle->profiler != NULL )
@@ -677,20 +779,6 @@ int libfsapfs_file_system_btree_get_root_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     (intptr_t **) root_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve root node.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -704,6 +792,7 @@ on_error:
 }
 
 /* Retrieves a file system B-tree sub node
+ * The node must be released with libfsapfs_file_system_btree_release_node
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_file_system_btree_get_sub_node(
@@ -713,14 +802,13 @@ int libfsapfs_file_system_btree_get_sub_node(
      libfsapfs_btree_node_t **sub_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	libfsapfs_btree_node_t *node         = NULL;
-	libfsapfs_data_block_t *data_block   = NULL;
-	static char *function                = "libfsapfs_file_system_btree_get_sub_node";
-	int result                           = 0;
+	libfsapfs_btree_node_t *node       = NULL;
+	libfsapfs_data_block_t *data_block = NULL;
+	static char *function              = "libfsapfs_file_system_btree_get_sub_node";
+	int result                         = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp   = 0;
 #endif
 
 	if( file_system_btree == NULL )
@@ -787,12 +875,10 @@ int libfsapfs_file_system_btree_get_sub_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	result = libfcache_cache_get_value_by_identifier(
+	result = libfsapfs_node_cache_get_node_by_block_number(
 	          file_system_btree->node_cache,
-	          0,
-	          (off64_t) sub_node_block_number,
-	          0,
-	          &cache_value,
+	          sub_node_block_number,
+	          sub_node,
 	          error );
 
 	if( result == -1 )
@@ -808,13 +894,26 @@ int libfsapfs_file_system_btree_get_sub_node(
 	}
 	else if( result == 0 )
 	{
-		if( libfdata_vector_get_element_value_by_index(
+		if( libfsapfs_btree_node_initialize(
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create B-tree node.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_block_cache_get_element_value_by_index(
+		     file_system_btree->io_handle->block_cache,
 		     file_system_btree->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) file_system_btree->data_block_cache,
+		     file_io_handle,
 		     (int) sub_node_block_number,
+		     sub_node_block_number,
 		     (intptr_t **) &data_block,
-		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -837,36 +936,42 @@ int libfsapfs_file_system_btree_get_sub_node(
 			 function,
 			 sub_node_block_number );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_initialize(
-		     &node,
-		     error ) != 1 )
+		else if( libfsapfs_btree_node_read_data(
+		          node,
+		          data_block->data,
+		          data_block->data_size,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree node.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read B-tree node.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_read_data(
-		     node,
-		     data_block->data,
-		     data_block->data_size,
+		if( libfsapfs_block_cache_release_element_value_by_block_number(
+		     file_system_btree->io_handle->block_cache,
+		     sub_node_block_number,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read B-tree node.",
-			 function );
-
-			goto on_error;
-		}
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release data block: %" PRIu64 ".",
+			 function,
+			 sub_node_block_number );
+
+			result = -1;
+		}
+		if( result == -1 )
+		{
+			goto on_error;
+		}
 		if( ( node->object_type != 0x00000003UL )
 		 && ( node->object_type != 0x10000003UL ) )
 		{
@@ -905,44 +1010,23 @@ int libfsapfs_file_system_btree_get_sub_node(
 
 			goto on_error;
 		}
-		if( libfcache_cache_set_value_by_identifier(
+		if( libfsapfs_node_cache_set_node_by_block_number(
 		     file_system_btree->node_cache,
-		     0,
-		     (off64_t) sub_node_block_number,
-		     0,
-		     (intptr_t *) node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     sub_node_block_number,
+		     &node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value in cache.",
-			 function );
-
-			goto on_error;
-		}
-		node = NULL;
-
-		if( libfcache_cache_get_value_by_identifier(
-		     file_system_btree->node_cache,
-		     0,
-		     (off64_t) sub_node_block_number,
-		     0,
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
+		*sub_node = node;
+		node       = NULL;
 	}
 #if defined( HAVE_PROFILER )
 	if( file_system_btree->io_handle->profiler != NULL )
@@ -967,20 +1051,6 @@ int libfsapfs_file_system_btree_get_sub_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     (intptr_t **) sub_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve sub node.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -993,7 +1063,68 @@ on_error:
 	return( -1 );
 }
 
+/* Releases a node retrieved from the file system B-tree
+ * The root node of the B-tree is kept outside the node cache and is not reference counted
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_release_node(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_release_node";
+
+	if( file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node == NULL )
+	{
+		return( 1 );
+	}
+	if( *node == file_system_btree->root_node )
+	{
+		*node = NULL;
+
+		return( 1 );
+	}
+	if( libfsapfs_node_cache_release_node(
+	     file_system_btree->node_cache,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release node in cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves an entry for a specific identifier from the file system B-tree node
+ * The node entries are sorted by identifier and data type, hence a binary search is used
  * Returns 1 if successful, 0 if not found or -1 on error
  */
 int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
@@ -1004,15 +1135,17 @@ int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
      libfsapfs_btree_entry_t **btree_entry,
      libcerror_error_t **error )
 {
-	libfsapfs_btree_entry_t *entry          = NULL;
-	libfsapfs_btree_entry_t *previous_entry = NULL;
-	static char *function                   = "libfsapfs_file_system_btree_get_entry_from_node_by_identifier";
-	uint64_t file_system_identifier         = 0;
-	uint64_t lookup_identifier              = 0;
-	uint8_t file_system_data_type           = 0;
-	int btree_entry_index                   = 0;
-	int is_leaf_node                        = 0;
-	int number_of_entries                   = 0;
+	libfsapfs_btree_entry_t *entry       = NULL;
+	libfsapfs_btree_entry_t *upper_entry = NULL;
+	static char *function                = "libfsapfs_file_system_btree_get_entry_from_node_by_identifier";
+	uint64_t file_system_identifier      = 0;
+	uint8_t file_system_data_type        = 0;
+	uint8_t upper_entry_is_match         = 0;
+	int btree_entry_index                = 0;
+	int is_leaf_node                     = 0;
+	int lower_entry_index                = 0;
+	int number_of_entries                = 0;
+	int upper_entry_index                = 0;
 
 	if( file_system_btree == NULL )
 	{
@@ -1088,12 +1221,15 @@ int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
 
 		return( -1 );
 	}
-	lookup_identifier = ( (uint64_t) data_type << 60 ) | identifier;
+	/* Search for the first entry with a key equal to or greater than the lookup key
+	 */
+	lower_entry_index = 0;
+	upper_entry_index = number_of_entries;
 
-	for( btree_entry_index = 0;
-	     btree_entry_index < number_of_entries;
-	     btree_entry_index++ )
+	while( lower_entry_index < upper_entry_index )
 	{
+		btree_entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
 		if( libfsapfs_btree_node_get_entry_by_index(
 		     node,
 		     btree_entry_index,
@@ -1104,8 +1240,9 @@ int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from B-tree node.",
-			 function );
+			 "%s: unable to retrieve B-tree entry: %d.",
+			 function,
+			 btree_entry_index );
 
 			return( -1 );
 		}
@@ -1121,7 +1258,8 @@ int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
 
 			return( -1 );
 		}
-		if( entry->key_data == NULL )
+		if( ( entry->key_data == NULL )
+		 || ( entry->key_data_size < 8 ) )
 		{
 			libcerror_error_set(
 			 error,
@@ -1137,7 +1275,8 @@ int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
 		 entry->key_data,
 		 file_system_identifier );
 
-		file_system_data_type = (uint8_t) ( file_system_identifier >> 60 );
+		file_system_data_type   = (uint8_t) ( file_system_identifier >> 60 );
+		file_system_identifier &= 0x0fffffffffffffffUL;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
@@ -1146,50 +1285,66 @@ int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
 			 "%s: B-tree entry: %d, identifier: %" PRIu64 ", data type: 0x%" PRIx8 " %s\n",
 			 function,
 			 btree_entry_index,
-			 file_system_identifier & 0x0fffffffffffffffUL,
+			 file_system_identifier,
 			 file_system_data_type,
 			 libfsapfs_debug_print_file_system_data_type(
 			  file_system_data_type ) );
 		}
 #endif
-		if( is_leaf_node != 0 )
+		if( ( file_system_identifier < identifier )
+		 || ( ( file_system_identifier == identifier )
+		  &&  ( file_system_data_type < data_type ) ) )
 		{
-			if( file_system_identifier == lookup_identifier )
-			{
-				*btree_entry = entry;
-
-				return( 1 );
-			}
+			lower_entry_index = btree_entry_index + 1;
 		}
 		else
 		{
-			file_system_identifier &= 0x0fffffffffffffffUL;
-
-			if( file_system_identifier >= identifier )
-			{
-				if( ( previous_entry == NULL )
-				 || ( ( file_system_identifier == identifier )
-				  &&  ( file_system_data_type <= data_type ) ) )
-				{
-					previous_entry = entry;
-				}
-				*btree_entry = previous_entry;
-
-				return( 1 );
-			}
-			previous_entry = entry;
+			upper_entry_index    = btree_entry_index;
+			upper_entry          = entry;
+			upper_entry_is_match = (uint8_t) ( ( file_system_identifier == identifier ) && ( file_system_data_type == data_type ) );
 		}
 	}
-	if( is_leaf_node == 0 )
+	if( ( lower_entry_index < number_of_entries )
+	 && ( upper_entry_is_match != 0 ) )
 	{
-		*btree_entry = previous_entry;
+		*btree_entry = upper_entry;
 
 		return( 1 );
 	}
-	return( 0 );
+	if( is_leaf_node != 0 )
+	{
+		return( 0 );
+	}
+	/* In a branch node the sub node that can contain the key is referenced
+	 * by the last entry with a key less than the lookup key
+	 */
+	if( lower_entry_index == 0 )
+	{
+		*btree_entry = upper_entry;
+
+		return( 1 );
+	}
+	if( libfsapfs_btree_node_get_entry_by_index(
+	     node,
+	     lower_entry_index - 1,
+	     btree_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree entry: %d.",
+		 function,
+		 lower_entry_index - 1 );
+
+		return( -1 );
+	}
+	return( 1 );
 }
 
 /* Retrieves an entry for a specific identifier from the file system B-tree
+ * The B-tree node is referenced and must be released with libfsapfs_file_system_btree_release_node
  * Returns 1 if successful, 0 if not found or -1 on error
  */
 int libfsapfs_file_system_btree_get_entry_by_identifier(
@@ -1270,7 +1425,7 @@ int libfsapfs_file_system_btree_get_entry_by_identifier(
 			 "%s: invalid recursion depth value out of bounds.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		is_leaf_node = libfsapfs_btree_node_is_leaf_node(
 		                node,
@@ -1285,7 +1440,7 @@ int libfsapfs_file_system_btree_get_entry_by_identifier(
 			 "%s: unable to determine if B-tree node is a leaf node.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
 		          file_system_btree,
@@ -1304,7 +1459,7 @@ int libfsapfs_file_system_btree_get_entry_by_identifier(
 			 "%s: unable to retrieve entry from B-tree node.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		else if( result == 0 )
 		{
@@ -1331,10 +1486,22 @@ int libfsapfs_file_system_btree_get_entry_by_identifier(
 			 "%s: unable to determine sub node block number.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		node = NULL;
+		if( libfsapfs_file_system_btree_release_node(
+		     file_system_btree,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
 
+			goto on_error;
+		}
 		if( libfsapfs_file_system_btree_get_sub_node(
 		     file_system_btree,
 		     file_io_handle,
@@ -1350,13 +1517,37 @@ int libfsapfs_file_system_btree_get_entry_by_identifier(
 			 function,
 			 sub_node_block_number );
 
-			return( -1 );
+			goto on_error;
 		}
 		recursion_depth++;
 	}
 	while( is_leaf_node == 0 );
 
+	if( libfsapfs_file_system_btree_release_node(
+	     file_system_btree,
+	     &node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
+
+		goto on_error;
+	}
 	return( 0 );
+
+on_error:
+	if( node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &node,
+		 NULL );
+	}
+	return( -1 );
 }
 
 /* Retrieves a directory record for an UTF-8 encoded name from the file system B-tree leaf node
@@ -1968,11 +2159,30 @@ int libfsapfs_file_system_btree_get_directory_record_from_branch_node_by_utf8_na
 
 		goto on_error;
 	}
-	sub_node = NULL;
+	if( libfsapfs_file_system_btree_release_node(
+	     file_system_btree,
+	     &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
 
+		goto on_error;
+	}
 	return( result );
 
 on_error:
+	if( sub_node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &sub_node,
+		 NULL );
+	}
 	if( *directory_record != NULL )
 	{
 		libfsapfs_directory_record_free(
@@ -2597,11 +2807,30 @@ int libfsapfs_file_system_btree_get_directory_record_from_branch_node_by_utf16_n
 
 		goto on_error;
 	}
-	sub_node = NULL;
+	if( libfsapfs_file_system_btree_release_node(
+	     file_system_btree,
+	     &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
 
+		goto on_error;
+	}
 	return( result );
 
 on_error:
+	if( sub_node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &sub_node,
+		 NULL );
+	}
 	if( *directory_record != NULL )
 	{
 		libfsapfs_directory_record_free(
@@ -2617,29 +2846,25 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves directory entries for a specific parent identifier from the file system B-tree leaf node
+/* Retrieves directory entries for a specific parent identifier from the file system B-tree
  * Returns 1 if successful, 0 if not found or -1 on error
  */
-int libfsapfs_file_system_btree_get_directory_entries_from_leaf_node(
+int libfsapfs_file_system_btree_get_directory_entries(
      libfsapfs_file_system_btree_t *file_system_btree,
-     libfsapfs_btree_node_t *node,
+     libbfio_handle_t *file_io_handle,
      uint64_t parent_identifier,
      libcdata_array_t *directory_entries,
      libcerror_error_t **error )
 {
-	libfsapfs_btree_entry_t *btree_entry           = NULL;
-	libfsapfs_directory_record_t *directory_record = NULL;
-	static char *function                          = "libfsapfs_file_system_btree_get_directory_entries_from_leaf_node";
-	uint64_t file_system_identifier                = 0;
-	uint64_t lookup_identifier                     = 0;
-	int btree_entry_index                          = 0;
-	int entry_index                                = 0;
-	int found_directory_entry                      = 0;
-	int is_leaf_node                               = 0;
-	int number_of_entries                          = 0;
+	libfsapfs_directory_record_t *directory_record                 = NULL;
+	libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor = NULL;
+	static char *function                                          = "libfsapfs_file_system_btree_get_directory_entries";
+	int entry_index                                                = 0;
+	int found_directory_entry                                      = 0;
+	int result                                                     = 0;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	uint8_t file_system_data_type                  = 0;
+#if defined( HAVE_PROFILER )
+	int64_t profiler_start_timestamp                               = 0;
 #endif
 
 	if( file_system_btree == NULL )
@@ -2653,153 +2878,310 @@ int libfsapfs_file_system_btree_get_directory_entries_from_leaf_node(
 
 		return( -1 );
 	}
-	if( node == NULL )
+#if defined( HAVE_PROFILER )
+	if( file_system_btree->io_handle->profiler != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
-		 function );
+		if( libfsapfs_profiler_start_timing(
+		     file_system_btree->io_handle->profiler,
+		     &profiler_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start timing.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                node,
-	                error );
+#endif /* defined( HAVE_PROFILER ) */
 
-	if( is_leaf_node == -1 )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: retrieving directory entries of: %" PRIu64 "\n",
+		 function,
+		 parent_identifier );
+	}
+#endif
+	if( libfsapfs_file_system_btree_cursor_initialize(
+	     &file_system_btree_cursor,
+	     file_system_btree,
+	     file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree node is a leaf node.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system B-tree cursor.",
 		 function );
 
 		goto on_error;
 	}
-	else if( is_leaf_node == 0 )
+	if( libfsapfs_file_system_btree_cursor_seek(
+	     file_system_btree_cursor,
+	     parent_identifier,
+	     LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid node - not a leaf node.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to seek directory entries: %" PRIu64 " in file system B-tree.",
+		 function,
+		 parent_identifier );
 
 		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	result = libfsapfs_file_system_btree_cursor_get_next_directory_record(
+	          file_system_btree_cursor,
+	          parent_identifier,
+	          &directory_record,
+	          error );
+
+	while( result == 1 )
 	{
-		libcnotify_printf(
-		 "%s: retrieving directory entries of: %" PRIu64 "\n",
-		 function,
-		 parent_identifier );
+		if( libcdata_array_append_entry(
+		     directory_entries,
+		     &entry_index,
+		     (intptr_t *) directory_record,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append directory record to array.",
+			 function );
+
+			goto on_error;
+		}
+		directory_record = NULL;
+
+		found_directory_entry = 1;
+
+		result = libfsapfs_file_system_btree_cursor_get_next_directory_record(
+		          file_system_btree_cursor,
+		          parent_identifier,
+		          &directory_record,
+		          error );
 	}
-#endif
-	if( libfsapfs_btree_node_get_number_of_entries(
-	     node,
-	     &number_of_entries,
-	     error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from B-tree node.",
+		 "%s: unable to retrieve next directory record.",
 		 function );
 
 		goto on_error;
 	}
-	lookup_identifier = ( (uint64_t) LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD << 60 ) | parent_identifier;
+	if( libfsapfs_file_system_btree_cursor_free(
+	     &file_system_btree_cursor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file system B-tree cursor.",
+		 function );
 
-	for( btree_entry_index = 0;
-	     btree_entry_index < number_of_entries;
-	     btree_entry_index++ )
+		goto on_error;
+	}
+#if defined( HAVE_PROFILER )
+	if( file_system_btree->io_handle->profiler != NULL )
 	{
-		if( libfsapfs_btree_node_get_entry_by_index(
-		     node,
-		     btree_entry_index,
-		     &btree_entry,
+		if( libfsapfs_profiler_stop_timing(
+		     file_system_btree->io_handle->profiler,
+		     profiler_start_timestamp,
+		     function,
+		     0,
+		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from B-tree node.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to stop timing.",
 			 function );
 
 			goto on_error;
 		}
-		if( btree_entry == NULL )
+	}
+#endif /* defined( HAVE_PROFILER ) */
+
+	return( found_directory_entry );
+
+on_error:
+	if( directory_record != NULL )
+	{
+		libfsapfs_directory_record_free(
+		 &directory_record,
+		 NULL );
+	}
+	if( file_system_btree_cursor != NULL )
+	{
+		libfsapfs_file_system_btree_cursor_free(
+		 &file_system_btree_cursor,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 directory_entries,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_directory_record_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves extended attributes for a specific identifier from the file system B-tree
+ * Returns 1 if successful, 0 if not found or -1 on error
+ */
+int libfsapfs_file_system_btree_get_extended_attributes(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libbfio_handle_t *file_io_handle,
+     uint64_t identifier,
+     libcdata_array_t *extended_attributes,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *btree_entry                           = NULL;
+	libfsapfs_extended_attribute_t *extended_attribute             = NULL;
+	libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor = NULL;
+	static char *function                                          = "libfsapfs_file_system_btree_get_extended_attributes";
+	int compare_result                                             = 0;
+	int entry_index                                                = 0;
+	int found_extended_attribute                                   = 0;
+	int result                                                     = 0;
+
+#if defined( HAVE_PROFILER )
+	int64_t profiler_start_timestamp                               = 0;
+#endif
+
+	if( file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_PROFILER )
+	if( file_system_btree->io_handle->profiler != NULL )
+	{
+		if( libfsapfs_profiler_start_timing(
+		     file_system_btree->io_handle->profiler,
+		     &profiler_start_timestamp,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d.",
-			 function,
-			 btree_entry_index );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start timing.",
+			 function );
 
 			goto on_error;
 		}
-		if( btree_entry->key_data == NULL )
+	}
+#endif /* defined( HAVE_PROFILER ) */
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: retrieving extended attributes of: %" PRIu64 "\n",
+		 function,
+		 identifier );
+	}
+#endif
+	if( libfsapfs_file_system_btree_cursor_initialize(
+	     &file_system_btree_cursor,
+	     file_system_btree,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system B-tree cursor.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_system_btree_cursor_seek(
+	     file_system_btree_cursor,
+	     identifier,
+	     LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_EXTENDED_ATTRIBUTE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to seek extended attributes: %" PRIu64 " in file system B-tree.",
+		 function,
+		 identifier );
+
+		goto on_error;
+	}
+	result = libfsapfs_file_system_btree_cursor_get_next_entry(
+	          file_system_btree_cursor,
+	          &btree_entry,
+	          error );
+
+	while( result == 1 )
+	{
+		compare_result = libfsapfs_file_system_btree_cursor_compare_entry_key(
+		                  btree_entry,
+		                  identifier,
+		                  LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_EXTENDED_ATTRIBUTE,
+		                  error );
+
+		if( compare_result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d - missing key data.",
-			 function,
-			 btree_entry_index );
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare key of B-tree entry.",
+			 function );
 
 			goto on_error;
 		}
-		byte_stream_copy_to_uint64_little_endian(
-		 ( (fsapfs_file_system_btree_key_common_t *) btree_entry->key_data )->file_system_identifier,
-		 file_system_identifier );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			file_system_data_type = (uint8_t) ( file_system_identifier >> 60 );
-
-			libcnotify_printf(
-			 "%s: B-tree entry: %d, identifier: %" PRIu64 ", data type: 0x%" PRIx8 " %s\n",
-			 function,
-			 btree_entry_index,
-			 file_system_identifier & 0x0fffffffffffffffUL,
-			 file_system_data_type,
-			 libfsapfs_debug_print_file_system_data_type(
-			  file_system_data_type ) );
-		}
-#endif
-		if( ( file_system_identifier & 0x0fffffffffffffffUL ) > parent_identifier )
+		else if( compare_result != LIBCDATA_COMPARE_EQUAL )
 		{
 			break;
 		}
-		if( file_system_identifier != lookup_identifier )
-		{
-			continue;
-		}
-		if( libfsapfs_directory_record_initialize(
-		     &directory_record,
+		if( libfsapfs_extended_attribute_initialize(
+		     &extended_attribute,
+		     file_system_btree->io_handle,
+		     file_io_handle,
+		     file_system_btree->encryption_context,
+		     file_system_btree,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create directory record.",
+			 "%s: unable to create extended attribute.",
 			 function );
 
 			goto on_error;
 		}
-		if( libfsapfs_directory_record_read_key_data(
-		     directory_record,
+		if( libfsapfs_extended_attribute_read_key_data(
+		     extended_attribute,
 		     btree_entry->key_data,
 		     (size_t) btree_entry->key_data_size,
 		     error ) != 1 )
@@ -2808,13 +3190,13 @@ int libfsapfs_file_system_btree_get_directory_entries_from_leaf_node(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read directory record key data.",
+			 "%s: unable to read extended attribute key data.",
 			 function );
 
 			goto on_error;
 		}
-		if( libfsapfs_directory_record_read_value_data(
-		     directory_record,
+		if( libfsapfs_extended_attribute_read_value_data(
+		     extended_attribute,
 		     btree_entry->value_data,
 		     (size_t) btree_entry->value_data_size,
 		     error ) != 1 )
@@ -2823,429 +3205,334 @@ int libfsapfs_file_system_btree_get_directory_entries_from_leaf_node(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read directory record value data.",
+			 "%s: unable to read extended attribute value data.",
 			 function );
 
 			goto on_error;
 		}
 		if( libcdata_array_append_entry(
-		     directory_entries,
+		     extended_attributes,
 		     &entry_index,
-		     (intptr_t *) directory_record,
+		     (intptr_t *) extended_attribute,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append directory record to array.",
+			 "%s: unable to append extended attribute to array.",
 			 function );
 
 			goto on_error;
 		}
-		directory_record = NULL;
+		extended_attribute = NULL;
 
-		found_directory_entry = 1;
-	}
-	return( found_directory_entry );
+		found_extended_attribute = 1;
 
-on_error:
-	if( directory_record != NULL )
-	{
-		libfsapfs_directory_record_free(
-		 &directory_record,
-		 NULL );
+		result = libfsapfs_file_system_btree_cursor_get_next_entry(
+		          file_system_btree_cursor,
+		          &btree_entry,
+		          error );
 	}
-	libcdata_array_empty(
-	 directory_entries,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_directory_record_free,
-	 NULL );
-
-	return( -1 );
-}
-
-/* Retrieves directory entries for a specific parent identifier from the file system B-tree branch node
- * Returns 1 if successful, 0 if not found or -1 on error
- */
-int libfsapfs_file_system_btree_get_directory_entries_from_branch_node(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libbfio_handle_t *file_io_handle,
-     libfsapfs_btree_node_t *node,
-     uint64_t parent_identifier,
-     libcdata_array_t *directory_entries,
-     int recursion_depth,
-     libcerror_error_t **error )
-{
-	libfsapfs_btree_entry_t *entry          = NULL;
-	libfsapfs_btree_entry_t *previous_entry = NULL;
-	libfsapfs_btree_node_t *sub_node        = NULL;
-	static char *function                   = "libfsapfs_file_system_btree_get_directory_entries_from_branch_node";
-	uint64_t file_system_identifier         = 0;
-	uint64_t sub_node_block_number          = 0;
-	uint8_t file_system_data_type           = 0;
-	int entry_index                         = 0;
-	int found_directory_entry               = 0;
-	int is_leaf_node                        = 0;
-	int number_of_entries                   = 0;
-	int result                              = 0;
-
-	if( file_system_btree == NULL )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file system B-tree.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next B-tree entry.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( node == NULL )
+	if( libfsapfs_file_system_btree_cursor_free(
+	     &file_system_btree_cursor,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file system B-tree cursor.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( recursion_depth < 0 )
-	 || ( recursion_depth > LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH ) )
+#if defined( HAVE_PROFILER )
+	if( file_system_btree->io_handle->profiler != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid recursion depth value out of bounds.",
-		 function );
+		if( libfsapfs_profiler_stop_timing(
+		     file_system_btree->io_handle->profiler,
+		     profiler_start_timestamp,
+		     function,
+		     0,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to stop timing.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                node,
-	                error );
+#endif /* defined( HAVE_PROFILER ) */
 
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree node is a leaf node.",
-		 function );
+	return( found_extended_attribute );
 
-		goto on_error;
+on_error:
+	if( extended_attribute != NULL )
+	{
+		libfsapfs_internal_extended_attribute_free(
+		 (libfsapfs_internal_extended_attribute_t **) &extended_attribute,
+		 NULL );
 	}
-	else if( is_leaf_node != 0 )
+	if( file_system_btree_cursor != NULL )
+	{
+		libfsapfs_file_system_btree_cursor_free(
+		 &file_system_btree_cursor,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 extended_attributes,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_internal_extended_attribute_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves file extents for a specific identifier from the file system B-tree
+ * Returns 1 if successful, 0 if not found or -1 on error
+ */
+int libfsapfs_file_system_btree_get_file_extents(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libbfio_handle_t *file_io_handle,
+     uint64_t identifier,
+     libcdata_array_t *file_extents,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *btree_entry                           = NULL;
+	libfsapfs_file_extent_t *file_extent                           = NULL;
+	libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor = NULL;
+	static char *function                                          = "libfsapfs_file_system_btree_get_file_extents";
+	int compare_result                                             = 0;
+	int entry_index                                                = 0;
+	int found_file_extent                                          = 0;
+	int result                                                     = 0;
+
+	if( file_system_btree == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid node - not a branch node.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "%s: retrieving directory entries of: %" PRIu64 "\n",
+		 "%s: retrieving file extents of: %" PRIu64 "\n",
 		 function,
-		 parent_identifier );
+		 identifier );
 	}
 #endif
-	if( libfsapfs_btree_node_get_number_of_entries(
-	     node,
-	     &number_of_entries,
+	if( libfsapfs_file_system_btree_cursor_initialize(
+	     &file_system_btree_cursor,
+	     file_system_btree,
+	     file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from B-tree node.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system B-tree cursor.",
 		 function );
 
 		goto on_error;
 	}
-	for( entry_index = 0;
-	     entry_index < number_of_entries;
-	     entry_index++ )
+	if( libfsapfs_file_system_btree_cursor_seek(
+	     file_system_btree_cursor,
+	     identifier,
+	     LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT,
+	     error ) != 1 )
 	{
-		if( libfsapfs_btree_node_get_entry_by_index(
-		     node,
-		     entry_index,
-		     &entry,
-		     error ) != 1 )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to seek file extents: %" PRIu64 " in file system B-tree.",
+		 function,
+		 identifier );
+
+		goto on_error;
+	}
+	result = libfsapfs_file_system_btree_cursor_get_next_entry(
+	          file_system_btree_cursor,
+	          &btree_entry,
+	          error );
+
+	while( result == 1 )
+	{
+		compare_result = libfsapfs_file_system_btree_cursor_compare_entry_key(
+		                  btree_entry,
+		                  identifier,
+		                  LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT,
+		                  error );
+
+		if( compare_result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from B-tree node.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare key of B-tree entry.",
 			 function );
 
 			goto on_error;
 		}
-		if( entry == NULL )
+		else if( compare_result != LIBCDATA_COMPARE_EQUAL )
+		{
+			break;
+		}
+		if( libfsapfs_file_extent_initialize(
+		     &file_extent,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d.",
-			 function,
-			 entry_index );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file extent.",
+			 function );
 
 			goto on_error;
 		}
-		if( entry->key_data == NULL )
+		if( libfsapfs_file_extent_read_key_data(
+		     file_extent,
+		     btree_entry->key_data,
+		     (size_t) btree_entry->key_data_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d - missing key data.",
-			 function,
-			 entry_index );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file extent key data.",
+			 function );
 
 			goto on_error;
 		}
-		byte_stream_copy_to_uint64_little_endian(
-		 ( (fsapfs_file_system_btree_key_common_t *) entry->key_data )->file_system_identifier,
-		 file_system_identifier );
-
-		file_system_data_type = (uint8_t) ( file_system_identifier >> 60 );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( libfsapfs_file_extent_read_value_data(
+		     file_extent,
+		     btree_entry->value_data,
+		     (size_t) btree_entry->value_data_size,
+		     error ) != 1 )
 		{
-			libcnotify_printf(
-			 "%s: B-tree entry: %d, identifier: %" PRIu64 ", data type: 0x%" PRIx8 " %s\n",
-			 function,
-			 entry_index,
-			 file_system_identifier & 0x0fffffffffffffffUL,
-			 file_system_data_type,
-			 libfsapfs_debug_print_file_system_data_type(
-			  file_system_data_type ) );
-		}
-#endif
-		file_system_identifier &= 0x0fffffffffffffffUL;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file extent value data.",
+			 function );
 
-		if( ( file_system_identifier > parent_identifier )
-		 || ( ( file_system_identifier == parent_identifier )
-		  &&  ( file_system_data_type > LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD ) ) )
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     file_extents,
+		     &entry_index,
+		     (intptr_t *) file_extent,
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append file extent to array.",
+			 function );
+
+			goto on_error;
 		}
-		if( ( file_system_identifier == parent_identifier )
-		 && ( file_system_data_type == LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD )
-		 && ( previous_entry != NULL ) )
-		{
-			if( libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
-			     file_system_btree,
-			     file_io_handle,
-			     previous_entry,
-			     &sub_node_block_number,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine sub node block number.",
-				 function );
+		file_extent = NULL;
 
-				goto on_error;
-			}
-			if( libfsapfs_file_system_btree_get_sub_node(
-			     file_system_btree,
-			     file_io_handle,
-			     sub_node_block_number,
-			     &sub_node,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve B-tree sub node from block: %" PRIu64 ".",
-				 function,
-				 sub_node_block_number );
+		found_file_extent = 1;
 
-				goto on_error;
-			}
-			is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-			                sub_node,
-			                error );
+		result = libfsapfs_file_system_btree_cursor_get_next_entry(
+		          file_system_btree_cursor,
+		          &btree_entry,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next B-tree entry.",
+		 function );
 
-			if( is_leaf_node == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if B-tree sub node is a leaf node.",
-				 function );
-
-				goto on_error;
-			}
-			if( is_leaf_node != 0 )
-			{
-				result = libfsapfs_file_system_btree_get_directory_entries_from_leaf_node(
-				          file_system_btree,
-				          sub_node,
-				          parent_identifier,
-				          directory_entries,
-				          error );
-			}
-			else
-			{
-				result = libfsapfs_file_system_btree_get_directory_entries_from_branch_node(
-				          file_system_btree,
-				          file_io_handle,
-				          sub_node,
-				          parent_identifier,
-				          directory_entries,
-				          recursion_depth + 1,
-				          error );
-			}
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve directory entries: %" PRIu64 " from file system B-tree sub node.",
-				 function,
-				 parent_identifier );
-
-				goto on_error;
-			}
-			else if( result != 0 )
-			{
-				found_directory_entry = 1;
-			}
-			sub_node = NULL;
-		}
-		previous_entry = entry;
-	}
-	if( libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
-	     file_system_btree,
-	     file_io_handle,
-	     previous_entry,
-	     &sub_node_block_number,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine sub node block number.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsapfs_file_system_btree_get_sub_node(
-	     file_system_btree,
-	     file_io_handle,
-	     sub_node_block_number,
-	     &sub_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve B-tree sub node from block: %" PRIu64 ".",
-		 function,
-		 sub_node_block_number );
+		goto on_error;
+	}
+	if( libfsapfs_file_system_btree_cursor_free(
+	     &file_system_btree_cursor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file system B-tree cursor.",
+		 function );
 
 		goto on_error;
 	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                sub_node,
-	                error );
-
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree sub node is a leaf node.",
-		 function );
+	return( found_file_extent );
 
-		goto on_error;
-	}
-	if( is_leaf_node != 0 )
-	{
-		result = libfsapfs_file_system_btree_get_directory_entries_from_leaf_node(
-		          file_system_btree,
-		          sub_node,
-		          parent_identifier,
-		          directory_entries,
-		          error );
-	}
-	else
-	{
-		result = libfsapfs_file_system_btree_get_directory_entries_from_branch_node(
-		          file_system_btree,
-		          file_io_handle,
-		          sub_node,
-		          parent_identifier,
-		          directory_entries,
-		          recursion_depth + 1,
-		          error );
-	}
-	if( result == -1 )
+on_error:
+	if( file_extent != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve directory entries: %" PRIu64 " from file system B-tree sub node.",
-		 function,
-		 parent_identifier );
-
-		goto on_error;
+		libfsapfs_file_extent_free(
+		 &file_extent,
+		 NULL );
 	}
-	else if( result != 0 )
+	if( file_system_btree_cursor != NULL )
 	{
-		found_directory_entry = 1;
+		libfsapfs_file_system_btree_cursor_free(
+		 &file_system_btree_cursor,
+		 NULL );
 	}
-	return( found_directory_entry );
-
-on_error:
 	libcdata_array_empty(
-	 directory_entries,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_directory_record_free,
+	 file_extents,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
 	 NULL );
 
 	return( -1 );
 }
 
-/* Retrieves directory entries for a specific parent identifier from the file system B-tree
+/* Retrieves an inode for a specific identifier from the file system B-tree
  * Returns 1 if successful, 0 if not found or -1 on error
  */
-int libfsapfs_file_system_btree_get_directory_entries(
+int libfsapfs_file_system_btree_get_inode_by_identifier(
      libfsapfs_file_system_btree_t *file_system_btree,
      libbfio_handle_t *file_io_handle,
-     uint64_t parent_identifier,
-     libcdata_array_t *directory_entries,
+     uint64_t identifier,
+     libfsapfs_inode_t **inode,
      libcerror_error_t **error )
 {
-	libfsapfs_btree_node_t *root_node = NULL;
-	static char *function             = "libfsapfs_file_system_btree_get_directory_entries";
-	int is_leaf_node                  = 0;
-	int result                        = 0;
+	libfsapfs_btree_entry_t *btree_entry = NULL;
+	libfsapfs_btree_node_t *btree_node   = NULL;
+	static char *function                = "libfsapfs_file_system_btree_get_inode_by_identifier";
+	int result                           = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp  = 0;
+	int64_t profiler_start_timestamp     = 0;
 #endif
 
 	if( file_system_btree == NULL )
@@ -3259,6 +3546,28 @@ int libfsapfs_file_system_btree_get_directory_entries(
 
 		return( -1 );
 	}
+	if( inode == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid inode.",
+		 function );
+
+		return( -1 );
+	}
+	if( *inode != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid inode value already set.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_PROFILER )
 	if( file_system_btree->io_handle->profiler != NULL )
 	{
@@ -3283,322 +3592,85 @@ int libfsapfs_file_system_btree_get_directory_entries(
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "%s: retrieving directory entries of: %" PRIu64 "\n",
+		 "%s: retrieving inode of: %" PRIu64 "\n",
 		 function,
-		 parent_identifier );
+		 identifier );
 	}
 #endif
-	if( libfsapfs_file_system_btree_get_root_node(
-	     file_system_btree,
-	     file_io_handle,
-	     file_system_btree->root_node_block_number,
-	     &root_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve B-tree root node.",
-		 function );
-
-		goto on_error;
-	}
-	if( root_node == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid B-tree root node.",
-		 function );
-
-		goto on_error;
-	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                root_node,
-	                error );
-
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree root node is a leaf node.",
-		 function );
+	result = libfsapfs_file_system_btree_get_entry_by_identifier(
+	          file_system_btree,
+	          file_io_handle,
+	          identifier,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          &btree_node,
+	          &btree_entry,
+	          error );
 
-		goto on_error;
-	}
-	if( is_leaf_node != 0 )
-	{
-		result = libfsapfs_file_system_btree_get_directory_entries_from_leaf_node(
-		          file_system_btree,
-		          root_node,
-		          parent_identifier,
-		          directory_entries,
-		          error );
-	}
-	else
-	{
-		result = libfsapfs_file_system_btree_get_directory_entries_from_branch_node(
-		          file_system_btree,
-		          file_io_handle,
-		          root_node,
-		          parent_identifier,
-		          directory_entries,
-		          0,
-		          error );
-	}
 	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve directory entries: %" PRIu64 " from file system B-tree root node.",
-		 function,
-		 parent_identifier );
+		 "%s: unable to retrieve entry from B-tree node.",
+		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_PROFILER )
-	if( file_system_btree->io_handle->profiler != NULL )
+	else if( result != 0 )
 	{
-		if( libfsapfs_profiler_stop_timing(
-		     file_system_btree->io_handle->profiler,
-		     profiler_start_timestamp,
-		     function,
-		     0,
-		     0,
-		     error ) != 1 )
+		if( btree_node == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to stop timing.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree node.",
 			 function );
 
 			goto on_error;
 		}
-	}
-#endif /* defined( HAVE_PROFILER ) */
-
-	return( result );
+		if( btree_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree entry.",
+			 function );
 
-on_error:
-	libcdata_array_empty(
-	 directory_entries,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_directory_record_free,
-	 NULL );
+			goto on_error;
+		}
+		if( libfsapfs_inode_initialize(
+		     inode,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create inode.",
+			 function );
 
-	return( -1 );
-}
-
-/* Retrieves extended attributes for a specific identifier from the file system B-tree leaf node
- * Returns 1 if successful, 0 if not found or -1 on error
- */
-int libfsapfs_file_system_btree_get_extended_attributes_from_leaf_node(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libbfio_handle_t *file_io_handle,
-     libfsapfs_btree_node_t *node,
-     uint64_t identifier,
-     libcdata_array_t *extended_attributes,
-     libcerror_error_t **error )
-{
-	libfsapfs_btree_entry_t *btree_entry               = NULL;
-	libfsapfs_extended_attribute_t *extended_attribute = NULL;
-	static char *function                              = "libfsapfs_file_system_btree_get_extended_attributes_from_leaf_node";
-	uint64_t file_system_identifier                    = 0;
-	uint64_t lookup_identifier                         = 0;
-	int btree_entry_index                              = 0;
-	int entry_index                                    = 0;
-	int found_extended_attribute                       = 0;
-	int is_leaf_node                                   = 0;
-	int number_of_entries                              = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	uint8_t file_system_data_type                      = 0;
-#endif
-
-	if( file_system_btree == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file system B-tree.",
-		 function );
-
-		return( -1 );
-	}
-	if( node == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
-		 function );
-
-		return( -1 );
-	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                node,
-	                error );
-
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree node is a leaf node.",
-		 function );
-
-		goto on_error;
-	}
-	else if( is_leaf_node == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid node - not a leaf node.",
-		 function );
-
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: retrieving extended attributes of: %" PRIu64 "\n",
-		 function,
-		 identifier );
-	}
-#endif
-	if( libfsapfs_btree_node_get_number_of_entries(
-	     node,
-	     &number_of_entries,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from B-tree node.",
-		 function );
-
-		goto on_error;
-	}
-	lookup_identifier = ( (uint64_t) LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_EXTENDED_ATTRIBUTE << 60 ) | identifier;
-
-	for( btree_entry_index = 0;
-	     btree_entry_index < number_of_entries;
-	     btree_entry_index++ )
-	{
-		if( libfsapfs_btree_node_get_entry_by_index(
-		     node,
-		     btree_entry_index,
-		     &btree_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from B-tree node.",
-			 function );
-
-			goto on_error;
-		}
-		if( btree_entry == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d.",
-			 function,
-			 btree_entry_index );
-
-			goto on_error;
-		}
-		if( btree_entry->key_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d - missing key data.",
-			 function,
-			 btree_entry_index );
-
-			goto on_error;
-		}
-		byte_stream_copy_to_uint64_little_endian(
-		 ( (fsapfs_file_system_btree_key_common_t *) btree_entry->key_data )->file_system_identifier,
-		 file_system_identifier );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			file_system_data_type = (uint8_t) ( file_system_identifier >> 60 );
-
-			libcnotify_printf(
-			 "%s: B-tree entry: %d, identifier: %" PRIu64 ", data type: 0x%" PRIx8 " %s\n",
-			 function,
-			 btree_entry_index,
-			 file_system_identifier & 0x0fffffffffffffffUL,
-			 file_system_data_type,
-			 libfsapfs_debug_print_file_system_data_type(
-			  file_system_data_type ) );
-		}
-#endif
-		if( ( file_system_identifier & 0x0fffffffffffffffUL ) > identifier )
-		{
-			break;
-		}
-		if( file_system_identifier != lookup_identifier )
-		{
-			continue;
-		}
-		if( libfsapfs_extended_attribute_initialize(
-		     &extended_attribute,
-		     file_system_btree->io_handle,
-		     file_io_handle,
-		     file_system_btree->encryption_context,
-		     file_system_btree,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create extended attribute.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsapfs_extended_attribute_read_key_data(
-		     extended_attribute,
-		     btree_entry->key_data,
-		     (size_t) btree_entry->key_data_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read extended attribute key data.",
-			 function );
+			goto on_error;
+		}
+		if( libfsapfs_inode_read_key_data(
+		     *inode,
+		     btree_entry->key_data,
+		     (size_t) btree_entry->key_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read inode key data.",
+			 function );
 
 			goto on_error;
 		}
-		if( libfsapfs_extended_attribute_read_value_data(
-		     extended_attribute,
+		if( libfsapfs_inode_read_value_data(
+		     *inode,
 		     btree_entry->value_data,
 		     (size_t) btree_entry->value_data_size,
 		     error ) != 1 )
@@ -3607,1324 +3679,91 @@ int libfsapfs_file_system_btree_get_extended_attributes_from_leaf_node(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read extended attribute value data.",
+			 "%s: unable to read inode value data.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_array_append_entry(
-		     extended_attributes,
-		     &entry_index,
-		     (intptr_t *) extended_attribute,
+		if( libfsapfs_file_system_btree_release_node(
+		     file_system_btree,
+		     &btree_node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append extended attribute to array.",
-			 function );
-
-			goto on_error;
-		}
-		extended_attribute = NULL;
-
-		found_extended_attribute = 1;
-	}
-	return( found_extended_attribute );
-
-on_error:
-	if( extended_attribute != NULL )
-	{
-		libfsapfs_internal_extended_attribute_free(
-		 (libfsapfs_internal_extended_attribute_t **) &extended_attribute,
-		 NULL );
-	}
-	libcdata_array_empty(
-	 extended_attributes,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_internal_extended_attribute_free,
-	 NULL );
-
-	return( -1 );
-}
-
-/* Retrieves extended attributes for a specific identifier from the file system B-tree branch node
- * Returns 1 if successful, 0 if not found or -1 on error
- */
-int libfsapfs_file_system_btree_get_extended_attributes_from_branch_node(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libbfio_handle_t *file_io_handle,
-     libfsapfs_btree_node_t *node,
-     uint64_t identifier,
-     libcdata_array_t *extended_attributes,
-     int recursion_depth,
-     libcerror_error_t **error )
-{
-	libfsapfs_btree_entry_t *entry          = NULL;
-	libfsapfs_btree_entry_t *previous_entry = NULL;
-	libfsapfs_btree_node_t *sub_node        = NULL;
-	static char *function                   = "libfsapfs_file_system_btree_get_extended_attributes_from_branch_node";
-	uint64_t file_system_identifier         = 0;
-	uint64_t sub_node_block_number          = 0;
-	uint8_t file_system_data_type           = 0;
-	int entry_index                         = 0;
-	int found_extended_attribute            = 0;
-	int is_leaf_node                        = 0;
-	int number_of_entries                   = 0;
-	int result                              = 0;
-
-	if( file_system_btree == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file system B-tree.",
-		 function );
-
-		return( -1 );
-	}
-	if( node == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( recursion_depth < 0 )
-	 || ( recursion_depth > LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid recursion depth value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                node,
-	                error );
-
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree node is a leaf node.",
-		 function );
-
-		goto on_error;
-	}
-	else if( is_leaf_node != 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid node - not a branch node.",
-		 function );
-
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: retrieving extended attributes of: %" PRIu64 "\n",
-		 function,
-		 identifier );
-	}
-#endif
-	if( libfsapfs_btree_node_get_number_of_entries(
-	     node,
-	     &number_of_entries,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from B-tree node.",
-		 function );
-
-		goto on_error;
-	}
-	for( entry_index = 0;
-	     entry_index < number_of_entries;
-	     entry_index++ )
-	{
-		if( libfsapfs_btree_node_get_entry_by_index(
-		     node,
-		     entry_index,
-		     &entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from B-tree node.",
-			 function );
-
-			goto on_error;
-		}
-		if( entry == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d.",
-			 function,
-			 entry_index );
-
-			goto on_error;
-		}
-		if( entry->key_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d - missing key data.",
-			 function,
-			 entry_index );
-
-			goto on_error;
-		}
-		byte_stream_copy_to_uint64_little_endian(
-		 ( (fsapfs_file_system_btree_key_common_t *) entry->key_data )->file_system_identifier,
-		 file_system_identifier );
-
-		file_system_data_type = (uint8_t) ( file_system_identifier >> 60 );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: B-tree entry: %d, identifier: %" PRIu64 ", data type: 0x%" PRIx8 " %s\n",
-			 function,
-			 entry_index,
-			 file_system_identifier & 0x0fffffffffffffffUL,
-			 file_system_data_type,
-			 libfsapfs_debug_print_file_system_data_type(
-			  file_system_data_type ) );
-		}
-#endif
-		file_system_identifier &= 0x0fffffffffffffffUL;
-
-		if( ( file_system_identifier > identifier )
-		 || ( ( file_system_identifier == identifier )
-		  &&  ( file_system_data_type > LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_EXTENDED_ATTRIBUTE ) ) )
-		{
-			break;
-		}
-		if( ( file_system_identifier == identifier )
-		 && ( file_system_data_type == LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_EXTENDED_ATTRIBUTE )
-		 && ( previous_entry != NULL ) )
-		{
-			if( libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
-			     file_system_btree,
-			     file_io_handle,
-			     previous_entry,
-			     &sub_node_block_number,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine sub node block number.",
-				 function );
-
-				goto on_error;
-			}
-			if( libfsapfs_file_system_btree_get_sub_node(
-			     file_system_btree,
-			     file_io_handle,
-			     sub_node_block_number,
-			     &sub_node,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve B-tree sub node from block: %" PRIu64 ".",
-				 function,
-				 sub_node_block_number );
-
-				goto on_error;
-			}
-			is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-			                sub_node,
-			                error );
-
-			if( is_leaf_node == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if B-tree sub node is a leaf node.",
-				 function );
-
-				goto on_error;
-			}
-			if( is_leaf_node != 0 )
-			{
-				result = libfsapfs_file_system_btree_get_extended_attributes_from_leaf_node(
-				          file_system_btree,
-				          file_io_handle,
-				          sub_node,
-				          identifier,
-				          extended_attributes,
-				          error );
-			}
-			else
-			{
-				result = libfsapfs_file_system_btree_get_extended_attributes_from_branch_node(
-				          file_system_btree,
-				          file_io_handle,
-				          sub_node,
-				          identifier,
-				          extended_attributes,
-				          recursion_depth + 1,
-				          error );
-			}
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve extended attributes: %" PRIu64 " from file system B-tree sub node.",
-				 function,
-				 identifier );
-
-				goto on_error;
-			}
-			else if( result != 0 )
-			{
-				found_extended_attribute = 1;
-			}
-			sub_node = NULL;
-		}
-		previous_entry = entry;
-	}
-	if( libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
-	     file_system_btree,
-	     file_io_handle,
-	     previous_entry,
-	     &sub_node_block_number,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine sub node block number.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsapfs_file_system_btree_get_sub_node(
-	     file_system_btree,
-	     file_io_handle,
-	     sub_node_block_number,
-	     &sub_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve B-tree sub node from block: %" PRIu64 ".",
-		 function,
-		 sub_node_block_number );
-
-		goto on_error;
-	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                sub_node,
-	                error );
-
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree sub node is a leaf node.",
-		 function );
-
-		goto on_error;
-	}
-	if( is_leaf_node != 0 )
-	{
-		result = libfsapfs_file_system_btree_get_extended_attributes_from_leaf_node(
-		          file_system_btree,
-		          file_io_handle,
-		          sub_node,
-		          identifier,
-		          extended_attributes,
-		          error );
-	}
-	else
-	{
-		result = libfsapfs_file_system_btree_get_extended_attributes_from_branch_node(
-		          file_system_btree,
-		          file_io_handle,
-		          sub_node,
-		          identifier,
-		          extended_attributes,
-		          recursion_depth + 1,
-		          error );
-	}
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve extended attributes: %" PRIu64 " from file system B-tree sub node.",
-		 function,
-		 identifier );
-
-		goto on_error;
-	}
-	else if( result != 0 )
-	{
-		found_extended_attribute = 1;
-	}
-	return( found_extended_attribute );
-
-on_error:
-	libcdata_array_empty(
-	 extended_attributes,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_internal_extended_attribute_free,
-	 NULL );
-
-	return( -1 );
-}
-
-/* Retrieves extended attributes for a specific identifier from the file system B-tree
- * Returns 1 if successful, 0 if not found or -1 on error
- */
-int libfsapfs_file_system_btree_get_extended_attributes(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libbfio_handle_t *file_io_handle,
-     uint64_t identifier,
-     libcdata_array_t *extended_attributes,
-     libcerror_error_t **error )
-{
-	libfsapfs_btree_node_t *root_node = NULL;
-	static char *function             = "libfsapfs_file_system_btree_get_extended_attributes";
-	int is_leaf_node                  = 0;
-	int result                        = 0;
-
-#if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp  = 0;
-#endif
-
-	if( file_system_btree == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file system B-tree.",
-		 function );
-
-		return( -1 );
-	}
-#if defined( HAVE_PROFILER )
-	if( file_system_btree->io_handle->profiler != NULL )
-	{
-		if( libfsapfs_profiler_start_timing(
-		     file_system_btree->io_handle->profiler,
-		     &profiler_start_timestamp,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to start timing.",
-			 function );
-
-			goto on_error;
-		}
-	}
-#endif /* defined( HAVE_PROFILER ) */
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: retrieving extended attributes of: %" PRIu64 "\n",
-		 function,
-		 identifier );
-	}
-#endif
-	if( libfsapfs_file_system_btree_get_root_node(
-	     file_system_btree,
-	     file_io_handle,
-	     file_system_btree->root_node_block_number,
-	     &root_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve B-tree root node.",
-		 function );
-
-		goto on_error;
-	}
-	if( root_node == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid B-tree root node.",
-		 function );
-
-		goto on_error;
-	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                root_node,
-	                error );
-
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree root node is a leaf node.",
-		 function );
-
-		goto on_error;
-	}
-	if( is_leaf_node != 0 )
-	{
-		result = libfsapfs_file_system_btree_get_extended_attributes_from_leaf_node(
-		          file_system_btree,
-		          file_io_handle,
-		          root_node,
-		          identifier,
-		          extended_attributes,
-		          error );
-	}
-	else
-	{
-		result = libfsapfs_file_system_btree_get_extended_attributes_from_branch_node(
-		          file_system_btree,
-		          file_io_handle,
-		          root_node,
-		          identifier,
-		          extended_attributes,
-		          0,
-		          error );
-	}
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve extended attributes: %" PRIu64 " from file system B-tree root node.",
-		 function,
-		 identifier );
-
-		goto on_error;
-	}
-#if defined( HAVE_PROFILER )
-	if( file_system_btree->io_handle->profiler != NULL )
-	{
-		if( libfsapfs_profiler_stop_timing(
-		     file_system_btree->io_handle->profiler,
-		     profiler_start_timestamp,
-		     function,
-		     0,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to stop timing.",
-			 function );
-
-			goto on_error;
-		}
-	}
-#endif /* defined( HAVE_PROFILER ) */
-
-	return( result );
-
-on_error:
-	libcdata_array_empty(
-	 extended_attributes,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_internal_extended_attribute_free,
-	 NULL );
-
-	return( -1 );
-}
-
-/* Retrieves file extents for a specific identifier from the file system B-tree leaf node
- * Returns 1 if successful, 0 if not found or -1 on error
- */
-int libfsapfs_file_system_btree_get_file_extents_from_leaf_node(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libfsapfs_btree_node_t *node,
-     uint64_t identifier,
-     libcdata_array_t *file_extents,
-     libcerror_error_t **error )
-{
-	libfsapfs_btree_entry_t *btree_entry = NULL;
-	libfsapfs_file_extent_t *file_extent = NULL;
-	static char *function                = "libfsapfs_file_system_btree_get_file_extents_from_leaf_node";
-	uint64_t file_system_identifier      = 0;
-	uint64_t lookup_identifier           = 0;
-	int btree_entry_index                = 0;
-	int entry_index                      = 0;
-	int found_file_extent                = 0;
-	int is_leaf_node                     = 0;
-	int number_of_entries                = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	uint8_t file_system_data_type        = 0;
-#endif
-
-	if( file_system_btree == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file system B-tree.",
-		 function );
-
-		return( -1 );
-	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                node,
-	                error );
-
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree node is a leaf node.",
-		 function );
-
-		goto on_error;
-	}
-	else if( is_leaf_node == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid node - not a leaf node.",
-		 function );
-
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: retrieving file extents of: %" PRIu64 "\n",
-		 function,
-		 identifier );
-	}
-#endif
-	if( libfsapfs_btree_node_get_number_of_entries(
-	     node,
-	     &number_of_entries,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from B-tree node.",
-		 function );
-
-		goto on_error;
-	}
-	lookup_identifier = ( (uint64_t) LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT << 60 ) | identifier;
-
-	for( btree_entry_index = 0;
-	     btree_entry_index < number_of_entries;
-	     btree_entry_index++ )
-	{
-		if( libfsapfs_btree_node_get_entry_by_index(
-		     node,
-		     btree_entry_index,
-		     &btree_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from B-tree node.",
-			 function );
-
-			goto on_error;
-		}
-		if( btree_entry == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d.",
-			 function,
-			 btree_entry_index );
-
-			goto on_error;
-		}
-		if( btree_entry->key_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d - missing key data.",
-			 function,
-			 btree_entry_index );
-
-			goto on_error;
-		}
-		byte_stream_copy_to_uint64_little_endian(
-		 ( (fsapfs_file_system_btree_key_common_t *) btree_entry->key_data )->file_system_identifier,
-		 file_system_identifier );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			file_system_data_type = (uint8_t) ( file_system_identifier >> 60 );
-
-			libcnotify_printf(
-			 "%s: B-tree entry: %d, identifier: %" PRIu64 ", data type: 0x%" PRIx8 " %s\n",
-			 function,
-			 btree_entry_index,
-			 file_system_identifier & 0x0fffffffffffffffUL,
-			 file_system_data_type,
-			 libfsapfs_debug_print_file_system_data_type(
-			  file_system_data_type ) );
-		}
-#endif
-		if( ( file_system_identifier & 0x0fffffffffffffffUL ) > identifier )
-		{
-			break;
-		}
-		if( file_system_identifier != lookup_identifier )
-		{
-			continue;
-		}
-		if( libfsapfs_file_extent_initialize(
-		     &file_extent,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create file extent.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsapfs_file_extent_read_key_data(
-		     file_extent,
-		     btree_entry->key_data,
-		     (size_t) btree_entry->key_data_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read file extent key data.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsapfs_file_extent_read_value_data(
-		     file_extent,
-		     btree_entry->value_data,
-		     (size_t) btree_entry->value_data_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read file extent value data.",
-			 function );
-
-			goto on_error;
-		}
-		if( libcdata_array_append_entry(
-		     file_extents,
-		     &entry_index,
-		     (intptr_t *) file_extent,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append file extent to array.",
-			 function );
-
-			goto on_error;
-		}
-		file_extent = NULL;
-
-		found_file_extent = 1;
-	}
-	return( found_file_extent );
-
-on_error:
-	if( file_extent != NULL )
-	{
-		libfsapfs_file_extent_free(
-		 &file_extent,
-		 NULL );
-	}
-	libcdata_array_empty(
-	 file_extents,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
-	 NULL );
-
-	return( -1 );
-}
-
-/* Retrieves file extents for a specific identifier from the file system B-tree branch node
- * Returns 1 if successful, 0 if not found or -1 on error
- */
-int libfsapfs_file_system_btree_get_file_extents_from_branch_node(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libbfio_handle_t *file_io_handle,
-     libfsapfs_btree_node_t *node,
-     uint64_t identifier,
-     libcdata_array_t *file_extents,
-     int recursion_depth,
-     libcerror_error_t **error )
-{
-	libfsapfs_btree_entry_t *entry          = NULL;
-	libfsapfs_btree_entry_t *previous_entry = NULL;
-	libfsapfs_btree_node_t *sub_node        = NULL;
-	static char *function                   = "libfsapfs_file_system_btree_get_file_extents_from_branch_node";
-	uint64_t file_extent_logical_address    = 0;
-	uint64_t file_system_identifier         = 0;
-	uint64_t sub_node_block_number          = 0;
-	uint8_t file_system_data_type           = 0;
-	int entry_index                         = 0;
-	int found_file_extent                   = 0;
-	int is_leaf_node                        = 0;
-	int number_of_entries                   = 0;
-	int result                              = 0;
-
-	if( file_system_btree == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file system B-tree.",
-		 function );
-
-		return( -1 );
-	}
-	if( node == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid node.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( recursion_depth < 0 )
-	 || ( recursion_depth > LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid recursion depth value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                node,
-	                error );
-
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree node is a leaf node.",
-		 function );
-
-		goto on_error;
-	}
-	else if( is_leaf_node != 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid node - not a branch node.",
-		 function );
-
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: retrieving file extents of: %" PRIu64 "\n",
-		 function,
-		 identifier );
-	}
-#endif
-	if( libfsapfs_btree_node_get_number_of_entries(
-	     node,
-	     &number_of_entries,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from B-tree node.",
-		 function );
-
-		goto on_error;
-	}
-	for( entry_index = 0;
-	     entry_index < number_of_entries;
-	     entry_index++ )
-	{
-		if( libfsapfs_btree_node_get_entry_by_index(
-		     node,
-		     entry_index,
-		     &entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from B-tree node.",
-			 function );
-
-			goto on_error;
-		}
-		if( entry == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d.",
-			 function,
-			 entry_index );
-
-			goto on_error;
-		}
-		if( entry->key_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry: %d - missing key data.",
-			 function,
-			 entry_index );
-
-			goto on_error;
-		}
-		byte_stream_copy_to_uint64_little_endian(
-		 ( (fsapfs_file_system_btree_key_common_t *) entry->key_data )->file_system_identifier,
-		 file_system_identifier );
-
-		file_system_data_type = (uint8_t) ( file_system_identifier >> 60 );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: B-tree entry: %d, identifier: %" PRIu64 ", data type: 0x%" PRIx8 " %s\n",
-			 function,
-			 entry_index,
-			 file_system_identifier & 0x0fffffffffffffffUL,
-			 file_system_data_type,
-			 libfsapfs_debug_print_file_system_data_type(
-			  file_system_data_type ) );
-		}
-#endif
-		file_system_identifier &= 0x0fffffffffffffffUL;
-
-		if( ( file_system_identifier > identifier )
-		 || ( ( file_system_identifier == identifier )
-		  &&  ( file_system_data_type > LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT ) ) )
-		{
-			break;
-		}
-		if( ( file_system_identifier == identifier )
-		 && ( file_system_data_type == LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT ) )
-		{
-			byte_stream_copy_to_uint64_little_endian(
-			 ( (fsapfs_file_system_btree_key_file_extent_t *) entry->key_data )->logical_address,
-			 file_extent_logical_address );
-		}
-		else
-		{
-			file_extent_logical_address = 0;
-		}
-		if( ( file_system_identifier == identifier )
-		 && ( file_system_data_type == LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT )
-		 && ( file_extent_logical_address > 0 )
-		 && ( previous_entry != NULL ) )
-		{
-			if( libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
-			     file_system_btree,
-			     file_io_handle,
-			     previous_entry,
-			     &sub_node_block_number,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine sub node block number.",
-				 function );
-
-				goto on_error;
-			}
-			if( libfsapfs_file_system_btree_get_sub_node(
-			     file_system_btree,
-			     file_io_handle,
-			     sub_node_block_number,
-			     &sub_node,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve B-tree sub node from block: %" PRIu64 ".",
-				 function,
-				 sub_node_block_number );
-
-				goto on_error;
-			}
-			is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-			                sub_node,
-			                error );
-
-			if( is_leaf_node == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if B-tree sub node is a leaf node.",
-				 function );
-
-				goto on_error;
-			}
-			if( is_leaf_node != 0 )
-			{
-				result = libfsapfs_file_system_btree_get_file_extents_from_leaf_node(
-				          file_system_btree,
-				          sub_node,
-				          identifier,
-				          file_extents,
-				          error );
-			}
-			else
-			{
-				result = libfsapfs_file_system_btree_get_file_extents_from_branch_node(
-				          file_system_btree,
-				          file_io_handle,
-				          sub_node,
-				          identifier,
-				          file_extents,
-				          recursion_depth + 1,
-				          error );
-			}
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve file extents: %" PRIu64 " from file system B-tree sub node.",
-				 function,
-				 identifier );
-
-				goto on_error;
-			}
-			else if( result != 0 )
-			{
-				found_file_extent = 1;
-			}
-			sub_node = NULL;
-		}
-		previous_entry = entry;
-	}
-	/* Fall-through for the last B-Tree entry
-	 */
-	if( libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
-	     file_system_btree,
-	     file_io_handle,
-	     previous_entry,
-	     &sub_node_block_number,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine sub node block number.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsapfs_file_system_btree_get_sub_node(
-	     file_system_btree,
-	     file_io_handle,
-	     sub_node_block_number,
-	     &sub_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve B-tree sub node from block: %" PRIu64 ".",
-		 function,
-		 sub_node_block_number );
-
-		goto on_error;
-	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                sub_node,
-	                error );
-
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree sub node is a leaf node.",
-		 function );
-
-		goto on_error;
-	}
-	if( is_leaf_node != 0 )
-	{
-		result = libfsapfs_file_system_btree_get_file_extents_from_leaf_node(
-		          file_system_btree,
-		          sub_node,
-		          identifier,
-		          file_extents,
-		          error );
-	}
-	else
-	{
-		result = libfsapfs_file_system_btree_get_file_extents_from_branch_node(
-		          file_system_btree,
-		          file_io_handle,
-		          sub_node,
-		          identifier,
-		          file_extents,
-		          recursion_depth + 1,
-		          error );
-	}
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file extents: %" PRIu64 " from file system B-tree sub node.",
-		 function,
-		 identifier );
-
-		goto on_error;
-	}
-	else if( result != 0 )
-	{
-		found_file_extent = 1;
-	}
-	return( found_file_extent );
-
-on_error:
-	libcdata_array_empty(
-	 file_extents,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
-	 NULL );
-
-	return( -1 );
-}
-
-/* Retrieves file extents for a specific identifier from the file system B-tree
- * Returns 1 if successful, 0 if not found or -1 on error
- */
-int libfsapfs_file_system_btree_get_file_extents(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libbfio_handle_t *file_io_handle,
-     uint64_t identifier,
-     libcdata_array_t *file_extents,
-     libcerror_error_t **error )
-{
-	libfsapfs_btree_node_t *root_node = NULL;
-	static char *function             = "libfsapfs_file_system_btree_get_file_extents";
-	int is_leaf_node                  = 0;
-	int result                        = 0;
-
-	if( file_system_btree == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file system B-tree.",
-		 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
 
-		return( -1 );
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: retrieving file extents of: %" PRIu64 "\n",
-		 function,
-		 identifier );
+			goto on_error;
+		}
 	}
-#endif
-	if( libfsapfs_file_system_btree_get_root_node(
-	     file_system_btree,
-	     file_io_handle,
-	     file_system_btree->root_node_block_number,
-	     &root_node,
-	     error ) != 1 )
+#if defined( HAVE_PROFILER )
+	if( file_system_btree->io_handle->profiler != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve B-tree root node.",
-		 function );
+		if( libfsapfs_profiler_stop_timing(
+		     file_system_btree->io_handle->profiler,
+		     profiler_start_timestamp,
+		     function,
+		     0,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to stop timing.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
-	                root_node,
-	                error );
+#endif /* defined( HAVE_PROFILER ) */
 
-	if( is_leaf_node == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if B-tree root node is a leaf node.",
-		 function );
+	return( result );
 
-		goto on_error;
-	}
-	if( is_leaf_node != 0 )
-	{
-		result = libfsapfs_file_system_btree_get_file_extents_from_leaf_node(
-		          file_system_btree,
-		          root_node,
-		          identifier,
-		          file_extents,
-		          error );
-	}
-	else
+on_error:
+	if( btree_node != NULL )
 	{
-		result = libfsapfs_file_system_btree_get_file_extents_from_branch_node(
-		          file_system_btree,
-		          file_io_handle,
-		          root_node,
-		          identifier,
-		          file_extents,
-		          0,
-		          error );
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &btree_node,
+		 NULL );
 	}
-	if( result == -1 )
+	if( *inode != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file extents: %" PRIu64 " from file system B-tree root node.",
-		 function,
-		 identifier );
-
-		goto on_error;
+		libfsapfs_inode_free(
+		 inode,
+		 NULL );
 	}
-	return( result );
-
-on_error:
-	libcdata_array_empty(
-	 file_extents,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
-	 NULL );
-
 	return( -1 );
 }
 
-/* Retrieves an inode for a specific identifier from the file system B-tree
- * Returns 1 if successful, 0 if not found or -1 on error
+/* Retrieves the inodes for specific identifiers from the file system B-tree
+ * The identifiers must be sorted in ascending order, which allows them to be resolved
+ * with a single forward walk of the B-tree that shares the node visits between lookups
+ * The inodes array must contain number of identifiers entries, an entry is set to NULL if the inode was not found
+ * Returns 1 if successful or -1 on error
  */
-int libfsapfs_file_system_btree_get_inode_by_identifier(
+int libfsapfs_file_system_btree_get_inodes_by_identifiers(
      libfsapfs_file_system_btree_t *file_system_btree,
      libbfio_handle_t *file_io_handle,
-     uint64_t identifier,
-     libfsapfs_inode_t **inode,
+     const uint64_t *identifiers,
+     int number_of_identifiers,
+     libfsapfs_inode_t **inodes,
      libcerror_error_t **error )
 {
-	libfsapfs_btree_entry_t *btree_entry = NULL;
-	libfsapfs_btree_node_t *btree_node   = NULL;
-	static char *function                = "libfsapfs_file_system_btree_get_inode_by_identifier";
-	int result                           = 0;
+	libfsapfs_btree_entry_t *btree_entry                           = NULL;
+	libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor = NULL;
+	static char *function                                          = "libfsapfs_file_system_btree_get_inodes_by_identifiers";
+	int compare_result                                             = 0;
+	int identifier_index                                           = 0;
+	int result                                                     = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp                               = 0;
 #endif
 
 	if( file_system_btree == NULL )
@@ -4938,28 +3777,68 @@ int libfsapfs_file_system_btree_get_inode_by_identifier(
 
 		return( -1 );
 	}
-	if( inode == NULL )
+	if( identifiers == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid inode.",
+		 "%s: invalid identifiers.",
 		 function );
 
 		return( -1 );
 	}
-	if( *inode != NULL )
+	if( number_of_identifiers < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid inode value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of identifiers value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( inodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid inodes.",
 		 function );
 
 		return( -1 );
 	}
+	for( identifier_index = 0;
+	     identifier_index < number_of_identifiers;
+	     identifier_index++ )
+	{
+		if( inodes[ identifier_index ] != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid inode: %d value already set.",
+			 function,
+			 identifier_index );
+
+			return( -1 );
+		}
+		if( ( identifier_index > 0 )
+		 && ( identifiers[ identifier_index ] < identifiers[ identifier_index - 1 ] ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: invalid identifiers - not sorted in ascending order.",
+			 function );
+
+			return( -1 );
+		}
+	}
 #if defined( HAVE_PROFILER )
 	if( file_system_btree->io_handle->profiler != NULL )
 	{
@@ -4980,74 +3859,114 @@ int libfsapfs_file_system_btree_get_inode_by_identifier(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: retrieving inode of: %" PRIu64 "\n",
-		 function,
-		 identifier );
-	}
-#endif
-	result = libfsapfs_file_system_btree_get_entry_by_identifier(
-	          file_system_btree,
-	          file_io_handle,
-	          identifier,
-	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
-	          &btree_node,
-	          &btree_entry,
-	          error );
-
-	if( result == -1 )
+	if( libfsapfs_file_system_btree_cursor_initialize(
+	     &file_system_btree_cursor,
+	     file_system_btree,
+	     file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve entry from B-tree node.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system B-tree cursor.",
 		 function );
 
 		goto on_error;
 	}
-	else if( result != 0 )
+	for( identifier_index = 0;
+	     identifier_index < number_of_identifiers;
+	     identifier_index++ )
 	{
-		if( btree_node == NULL )
+		if( ( identifier_index > 0 )
+		 && ( identifiers[ identifier_index ] == identifiers[ identifier_index - 1 ] ) )
+		{
+			continue;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: retrieving inode of: %" PRIu64 "\n",
+			 function,
+			 identifiers[ identifier_index ] );
+		}
+#endif
+		if( libfsapfs_file_system_btree_cursor_seek_forward(
+		     file_system_btree_cursor,
+		     identifiers[ identifier_index ],
+		     LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree node.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to seek inode: %" PRIu64 " in file system B-tree.",
+			 function,
+			 identifiers[ identifier_index ] );
+
+			goto on_error;
+		}
+		result = libfsapfs_file_system_btree_cursor_get_next_entry(
+		          file_system_btree_cursor,
+		          &btree_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next B-tree entry.",
 			 function );
 
 			goto on_error;
 		}
-		if( btree_entry == NULL )
+		else if( result == 0 )
+		{
+			/* There are no more entries and thus no more inodes
+			 */
+			break;
+		}
+		compare_result = libfsapfs_file_system_btree_cursor_compare_entry_key(
+		                  btree_entry,
+		                  identifiers[ identifier_index ],
+		                  LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+		                  error );
+
+		if( compare_result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid B-tree entry.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare key of B-tree entry.",
 			 function );
 
 			goto on_error;
 		}
+		else if( compare_result != LIBCDATA_COMPARE_EQUAL )
+		{
+			continue;
+		}
 		if( libfsapfs_inode_initialize(
-		     inode,
+		     &( inodes[ identifier_index ] ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create inode.",
-			 function );
+			 "%s: unable to create inode: %d.",
+			 function,
+			 identifier_index );
 
 			goto on_error;
 		}
 		if( libfsapfs_inode_read_key_data(
-		     *inode,
+		     inodes[ identifier_index ],
 		     btree_entry->key_data,
 		     (size_t) btree_entry->key_data_size,
 		     error ) != 1 )
@@ -5056,13 +3975,14 @@ int libfsapfs_file_system_btree_get_inode_by_identifier(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read inode key data.",
-			 function );
+			 "%s: unable to read inode: %d key data.",
+			 function,
+			 identifier_index );
 
 			goto on_error;
 		}
 		if( libfsapfs_inode_read_value_data(
-		     *inode,
+		     inodes[ identifier_index ],
 		     btree_entry->value_data,
 		     (size_t) btree_entry->value_data_size,
 		     error ) != 1 )
@@ -5071,12 +3991,25 @@ int libfsapfs_file_system_btree_get_inode_by_identifier(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read inode value data.",
-			 function );
+			 "%s: unable to read inode: %d value data.",
+			 function,
+			 identifier_index );
 
 			goto on_error;
 		}
-		btree_node = NULL;
+	}
+	if( libfsapfs_file_system_btree_cursor_free(
+	     &file_system_btree_cursor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file system B-tree cursor.",
+		 function );
+
+		goto on_error;
 	}
 #if defined( HAVE_PROFILER )
 	if( file_system_btree->io_handle->profiler != NULL )
@@ -5101,15 +4034,26 @@ int libfsapfs_file_system_btree_get_inode_by_identifier(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	return( result );
+	return( 1 );
 
 on_error:
-	if( *inode != NULL )
+	if( file_system_btree_cursor != NULL )
 	{
-		libfsapfs_inode_free(
-		 inode,
+		libfsapfs_file_system_btree_cursor_free(
+		 &file_system_btree_cursor,
 		 NULL );
 	}
+	for( identifier_index = 0;
+	     identifier_index < number_of_identifiers;
+	     identifier_index++ )
+	{
+		if( inodes[ identifier_index ] != NULL )
+		{
+			libfsapfs_inode_free(
+			 &( inodes[ identifier_index ] ),
+			 NULL );
+		}
+	}
 	return( -1 );
 }
 
@@ -5313,8 +4257,20 @@ int libfsapfs_file_system_btree_get_inode_by_utf8_name(
 			goto on_error;
 		}
 	}
-	root_node = NULL;
+	if( libfsapfs_file_system_btree_release_node(
+	     file_system_btree,
+	     &root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
 
+		goto on_error;
+	}
 	if( result != 0 )
 	{
 		result = libfsapfs_file_system_btree_get_entry_by_identifier(
@@ -5395,18 +4351,45 @@ int libfsapfs_file_system_btree_get_inode_by_utf8_name(
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read inode value data.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read inode value data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_file_system_btree_release_node(
+		     file_system_btree,
+		     &btree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
 			 function );
 
 			goto on_error;
 		}
-		btree_node = NULL;
 	}
 	return( result );
 
 on_error:
+	if( root_node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &root_node,
+		 NULL );
+	}
+	if( btree_node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &btree_node,
+		 NULL );
+	}
 	if( *directory_record != NULL )
 	{
 		libfsapfs_directory_record_free(
@@ -5701,8 +4684,20 @@ int libfsapfs_file_system_btree_get_inode_by_utf8_path(
 			goto on_error;
 		}
 	}
-	root_node = NULL;
+	if( libfsapfs_file_system_btree_release_node(
+	     file_system_btree,
+	     &root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
 
+		goto on_error;
+	}
 	if( result != 0 )
 	{
 		result = libfsapfs_file_system_btree_get_entry_by_identifier(
@@ -5790,13 +4785,40 @@ int libfsapfs_file_system_btree_get_inode_by_utf8_path(
 
 			goto on_error;
 		}
-		btree_node = NULL;
+		if( libfsapfs_file_system_btree_release_node(
+		     file_system_btree,
+		     &btree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
+
+			goto on_error;
+		}
 
 		*directory_record = safe_directory_record;
 	}
 	return( result );
 
 on_error:
+	if( root_node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &root_node,
+		 NULL );
+	}
+	if( btree_node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &btree_node,
+		 NULL );
+	}
 	if( safe_directory_record != NULL )
 	{
 		libfsapfs_directory_record_free(
@@ -6012,8 +5034,20 @@ int libfsapfs_file_system_btree_get_inode_by_utf16_name(
 			goto on_error;
 		}
 	}
-	root_node = NULL;
+	if( libfsapfs_file_system_btree_release_node(
+	     file_system_btree,
+	     &root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
 
+		goto on_error;
+	}
 	if( result != 0 )
 	{
 		result = libfsapfs_file_system_btree_get_entry_by_identifier(
@@ -6101,11 +5135,38 @@ int libfsapfs_file_system_btree_get_inode_by_utf16_name(
 
 			goto on_error;
 		}
-		btree_node = NULL;
+		if( libfsapfs_file_system_btree_release_node(
+		     file_system_btree,
+		     &btree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	return( result );
 
 on_error:
+	if( root_node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &root_node,
+		 NULL );
+	}
+	if( btree_node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &btree_node,
+		 NULL );
+	}
 	if( *directory_record != NULL )
 	{
 		libfsapfs_directory_record_free(
@@ -6400,8 +5461,20 @@ int libfsapfs_file_system_btree_get_inode_by_utf16_path(
 			goto on_error;
 		}
 	}
-	root_node = NULL;
+	if( libfsapfs_file_system_btree_release_node(
+	     file_system_btree,
+	     &root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
 
+		goto on_error;
+	}
 	if( result != 0 )
 	{
 		result = libfsapfs_file_system_btree_get_entry_by_identifier(
@@ -6489,13 +5562,40 @@ int libfsapfs_file_system_btree_get_inode_by_utf16_path(
 
 			goto on_error;
 		}
-		btree_node = NULL;
+		if( libfsapfs_file_system_btree_release_node(
+		     file_system_btree,
+		     &btree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
+
+			goto on_error;
+		}
 
 		*directory_record = safe_directory_record;
 	}
 	return( result );
 
 on_error:
+	if( root_node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &root_node,
+		 NULL );
+	}
+	if( btree_node != NULL )
+	{
+		libfsapfs_file_system_btree_release_node(
+		 file_system_btree,
+		 &btree_node,
+		 NULL );
+	}
 	if( safe_directory_record != NULL )
 	{
 		libfsapfs_directory_record_free(
@@ -6511,3 +5611,225 @@ on_error:
 	return( -1 );
 }
 
+/* Scans the file system B-tree
+ * The leaf nodes are walked once in key order and every record is passed to the callback function
+ * The key and value data passed to the callback function are only valid while the callback function runs
+ * The callback function should return 1 to continue, 0 to stop the scan or -1 on error
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_scan(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libbfio_handle_t *file_io_handle,
+     int (*callback_function)(
+            uint8_t record_type,
+            uint64_t identifier,
+            const uint8_t *key_data,
+            size_t key_data_size,
+            const uint8_t *value_data,
+            size_t value_data_size,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *btree_entry                           = NULL;
+	libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor = NULL;
+	static char *function                                          = "libfsapfs_file_system_btree_scan";
+	uint64_t file_system_identifier                                = 0;
+	uint8_t file_system_data_type                                  = 0;
+	int result                                                     = 0;
+
+#if defined( HAVE_PROFILER )
+	int64_t profiler_start_timestamp                               = 0;
+#endif
+
+	if( file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_PROFILER )
+	if( file_system_btree->io_handle->profiler != NULL )
+	{
+		if( libfsapfs_profiler_start_timing(
+		     file_system_btree->io_handle->profiler,
+		     &profiler_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start timing.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_PROFILER ) */
+
+	if( libfsapfs_file_system_btree_cursor_initialize(
+	     &file_system_btree_cursor,
+	     file_system_btree,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system B-tree cursor.",
+		 function );
+
+		goto on_error;
+	}
+	/* No key is less than identifier 0 and data type 0 hence this positions the cursor
+	 * at the first entry of the left-most leaf node
+	 */
+	if( libfsapfs_file_system_btree_cursor_seek(
+	     file_system_btree_cursor,
+	     0,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to seek first entry in file system B-tree.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		result = libfsapfs_file_system_btree_cursor_get_next_entry(
+		          file_system_btree_cursor,
+		          &btree_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next B-tree entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( ( btree_entry->key_data == NULL )
+		 || ( btree_entry->key_data_size < sizeof( fsapfs_file_system_btree_key_common_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree entry - missing key data.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsapfs_file_system_btree_key_common_t *) btree_entry->key_data )->file_system_identifier,
+		 file_system_identifier );
+
+		file_system_data_type   = (uint8_t) ( file_system_identifier >> 60 );
+		file_system_identifier &= 0x0fffffffffffffffUL;
+
+		result = callback_function(
+		          file_system_data_type,
+		          file_system_identifier,
+		          btree_entry->key_data,
+		          btree_entry->key_data_size,
+		          btree_entry->value_data,
+		          btree_entry->value_data_size,
+		          callback_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to process record: %" PRIu64 " of type: %" PRIu8 ".",
+			 function,
+			 file_system_identifier,
+			 file_system_data_type );
+
+			goto on_error;
+		}
+	}
+	while( result != 0 );
+
+	if( libfsapfs_file_system_btree_cursor_free(
+	     &file_system_btree_cursor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file system B-tree cursor.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_PROFILER )
+	if( file_system_btree->io_handle->profiler != NULL )
+	{
+		if( libfsapfs_profiler_stop_timing(
+		     file_system_btree->io_handle->profiler,
+		     profiler_start_timestamp,
+		     function,
+		     0,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to stop timing.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_PROFILER ) */
+
+	return( 1 );
+
+on_error:
+	if( file_system_btree_cursor != NULL )
+	{
+		libfsapfs_file_system_btree_cursor_free(
+		 &file_system_btree_cursor,
+		 NULL );
+	}
+	return( -1 );
+}
+
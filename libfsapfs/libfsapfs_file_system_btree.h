@@ -33,8 +33,8 @@
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
-#include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
+#include "libfsapfs_node_cache.h"
 #include "libfsapfs_object_map_btree.h"
 
 #if defined( __cplusplus )
@@ -57,13 +57,13 @@ struct libfsapfs_file_system_btree
 	 */
 	libfdata_vector_t *data_block_vector;
 
-	/* The data block cache
+	/* The node cache
 	 */
-	libfcache_cache_t *data_block_cache;
+	libfsapfs_node_cache_t *node_cache;
 
-	/* The node cache
+	/* The maximum number of cached nodes
 	 */
-	libfcache_cache_t *node_cache;
+	int maximum_number_of_cached_nodes;
 
 	/* The volume object map B-tree
 	 */
@@ -73,6 +73,11 @@ struct libfsapfs_file_system_btree
 	 */
 	uint64_t root_node_block_number;
 
+	/* The root node, which is read and validated once
+	 * and kept for the lifetime of the B-tree
+	 */
+	libfsapfs_btree_node_t *root_node;
+
 	/* Flag to indicate case folding should be used
 	 */
 	uint8_t use_case_folding;
@@ -92,6 +97,11 @@ int libfsapfs_file_system_btree_free(
      libfsapfs_file_system_btree_t **file_system_btree,
      libcerror_error_t **error );
 
+int libfsapfs_file_system_btree_set_cache_limits(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     size64_t maximum_btree_nodes_cache_size,
+     libcerror_error_t **error );
+
 int libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
      libfsapfs_file_system_btree_t *file_system_btree,
      libbfio_handle_t *file_io_handle,
@@ -113,6 +123,11 @@ int libfsapfs_file_system_btree_get_sub_node(
      libfsapfs_btree_node_t **sub_node,
      libcerror_error_t **error );
 
+int libfsapfs_file_system_btree_release_node(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
 int libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
      libfsapfs_file_system_btree_t *file_system_btree,
      libfsapfs_btree_node_t *node,
@@ -174,22 +189,6 @@ int libfsapfs_file_system_btree_get_directory_record_from_branch_node_by_utf16_n
      int recursion_depth,
      libcerror_error_t **error );
 
-int libfsapfs_file_system_btree_get_directory_entries_from_leaf_node(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libfsapfs_btree_node_t *node,
-     uint64_t parent_identifier,
-     libcdata_array_t *directory_entries,
-     libcerror_error_t **error );
-
-int libfsapfs_file_system_btree_get_directory_entries_from_branch_node(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libbfio_handle_t *file_io_handle,
-     libfsapfs_btree_node_t *node,
-     uint64_t parent_identifier,
-     libcdata_array_t *directory_entries,
-     int recursion_depth,
-     libcerror_error_t **error );
-
 int libfsapfs_file_system_btree_get_directory_entries(
      libfsapfs_file_system_btree_t *file_system_btree,
      libbfio_handle_t *file_io_handle,
@@ -197,23 +196,6 @@ int libfsapfs_file_system_btree_get_directory_entries(
      libcdata_array_t *directory_entries,
      libcerror_error_t **error );
 
-int libfsapfs_file_system_btree_get_extended_attributes_from_leaf_node(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libbfio_handle_t *file_io_handle,
-     libfsapfs_btree_node_t *node,
-     uint64_t identifier,
-     libcdata_array_t *extended_attributes,
-     libcerror_error_t **error );
-
-int libfsapfs_file_system_btree_get_extended_attributes_from_branch_node(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libbfio_handle_t *file_io_handle,
-     libfsapfs_btree_node_t *node,
-     uint64_t identifier,
-     libcdata_array_t *extended_attributes,
-     int recursion_depth,
-     libcerror_error_t **error );
-
 int libfsapfs_file_system_btree_get_extended_attributes(
      libfsapfs_file_system_btree_t *file_system_btree,
      libbfio_handle_t *file_io_handle,
@@ -221,34 +203,26 @@ int libfsapfs_file_system_btree_get_extended_attributes(
      libcdata_array_t *extended_attributes,
      libcerror_error_t **error );
 
-int libfsapfs_file_system_btree_get_file_extents_from_leaf_node(
-     libfsapfs_file_system_btree_t *file_system_btree,
-     libfsapfs_btree_node_t *node,
-     uint64_t identifier,
-     libcdata_array_t *file_extents,
-     libcerror_error_t **error );
-
-int libfsapfs_file_system_btree_get_file_extents_from_branch_node(
+int libfsapfs_file_system_btree_get_file_extents(
      libfsapfs_file_system_btree_t *file_system_btree,
      libbfio_handle_t *file_io_handle,
-     libfsapfs_btree_node_t *node,
      uint64_t identifier,
      libcdata_array_t *file_extents,
-     int recursion_depth,
      libcerror_error_t **error );
 
-int libfsapfs_file_system_btree_get_file_extents(
+int libfsapfs_file_system_btree_get_inode_by_identifier(
      libfsapfs_file_system_btree_t *file_system_btree,
      libbfio_handle_t *file_io_handle,
      uint64_t identifier,
-     libcdata_array_t *file_extents,
+     libfsapfs_inode_t **inode,
      libcerror_error_t **error );
 
-int libfsapfs_file_system_btree_get_inode_by_identifier(
+int libfsapfs_file_system_btree_get_inodes_by_identifiers(
      libfsapfs_file_system_btree_t *file_system_btree,
      libbfio_handle_t *file_io_handle,
-     uint64_t identifier,
-     libfsapfs_inode_t **inode,
+     const uint64_t *identifiers,
+     int number_of_identifiers,
+     libfsapfs_inode_t **inodes,
      libcerror_error_t **error );
 
 int libfsapfs_file_system_btree_get_inode_by_utf8_name(
@@ -291,6 +265,21 @@ int libfsapfs_file_system_btree_get_inode_by_utf16_path(
      libfsapfs_directory_record_t **directory_record,
      libcerror_error_t **error );
 
+int libfsapfs_file_system_btree_scan(
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libbfio_handle_t *file_io_handle,
+     int (*callback_function)(
+            uint8_t record_type,
+            uint64_t identifier,
+            const uint8_t *key_data,
+            size_t key_data_size,
+            const uint8_t *value_data,
+            size_t value_data_size,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
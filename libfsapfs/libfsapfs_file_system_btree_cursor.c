@@ -0,0 +1,1331 @@
+/*
+ * The file system B-tree cursor functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_btree_entry.h"
+#include "libfsapfs_btree_node.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_directory_record.h"
+#include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_file_system_btree_cursor.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcdata.h"
+#include "libfsapfs_libcerror.h"
+
+#include "fsapfs_file_system.h"
+
+/* Creates a file system B-tree cursor
+ * Make sure the value file_system_btree_cursor is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_initialize(
+     libfsapfs_file_system_btree_cursor_t **file_system_btree_cursor,
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_cursor_initialize";
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_system_btree_cursor != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file system B-tree cursor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	*file_system_btree_cursor = memory_allocate_structure(
+	                             libfsapfs_file_system_btree_cursor_t );
+
+	if( *file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file system B-tree cursor.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_system_btree_cursor,
+	     0,
+	     sizeof( libfsapfs_file_system_btree_cursor_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file system B-tree cursor.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_system_btree_cursor )->file_system_btree = file_system_btree;
+	( *file_system_btree_cursor )->file_io_handle    = file_io_handle;
+
+	return( 1 );
+
+on_error:
+	if( *file_system_btree_cursor != NULL )
+	{
+		memory_free(
+		 *file_system_btree_cursor );
+
+		*file_system_btree_cursor = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file system B-tree cursor
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_free(
+     libfsapfs_file_system_btree_cursor_t **file_system_btree_cursor,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_cursor_free";
+	int result            = 1;
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_system_btree_cursor != NULL )
+	{
+		if( libfsapfs_file_system_btree_cursor_release_nodes(
+		     *file_system_btree_cursor,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release nodes.",
+			 function );
+
+			result = -1;
+		}
+		/* The file_system_btree and file_io_handle references are freed elsewhere
+		 */
+		memory_free(
+		 *file_system_btree_cursor );
+
+		*file_system_btree_cursor = NULL;
+	}
+	return( result );
+}
+
+/* Releases the nodes on the path of the cursor from a specific depth
+ * The path of the cursor is shortened to the depth
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_release_nodes(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     int depth,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_cursor_release_nodes";
+	int result            = 1;
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( depth < 0 )
+	 || ( depth > file_system_btree_cursor->depth ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( file_system_btree_cursor->depth > depth )
+	{
+		file_system_btree_cursor->depth -= 1;
+
+		if( libfsapfs_file_system_btree_release_node(
+		     file_system_btree_cursor->file_system_btree,
+		     &( file_system_btree_cursor->nodes[ file_system_btree_cursor->depth ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node: %d.",
+			 function,
+			 file_system_btree_cursor->depth );
+
+			file_system_btree_cursor->nodes[ file_system_btree_cursor->depth ] = NULL;
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Compares the key of a file system B-tree entry with an identifier and data type
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_compare_entry_key(
+     libfsapfs_btree_entry_t *btree_entry,
+     uint64_t identifier,
+     uint8_t data_type,
+     libcerror_error_t **error )
+{
+	static char *function           = "libfsapfs_file_system_btree_cursor_compare_entry_key";
+	uint64_t file_system_identifier = 0;
+	uint8_t file_system_data_type   = 0;
+
+	if( btree_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( btree_entry->key_data == NULL )
+	 || ( btree_entry->key_data_size < sizeof( fsapfs_file_system_btree_key_common_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree entry - missing key data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsapfs_file_system_btree_key_common_t *) btree_entry->key_data )->file_system_identifier,
+	 file_system_identifier );
+
+	file_system_data_type   = (uint8_t) ( file_system_identifier >> 60 );
+	file_system_identifier &= 0x0fffffffffffffffUL;
+
+	if( file_system_identifier < identifier )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	else if( file_system_identifier > identifier )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	if( file_system_data_type < data_type )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	else if( file_system_data_type > data_type )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	return( LIBCDATA_COMPARE_EQUAL );
+}
+
+/* Retrieves the index of the first entry in a B-tree node with a key equal to or greater than the identifier and data type
+ * The entry index is set to the number of entries if all keys are less
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_get_lower_bound_entry_index(
+     libfsapfs_btree_node_t *node,
+     uint64_t identifier,
+     uint8_t data_type,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *btree_entry = NULL;
+	static char *function                = "libfsapfs_file_system_btree_cursor_get_lower_bound_entry_index";
+	int lower_entry_index                = 0;
+	int middle_entry_index               = 0;
+	int number_of_entries                = 0;
+	int result                           = 0;
+	int upper_entry_index                = 0;
+
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_btree_node_get_number_of_entries(
+	     node,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from B-tree node.",
+		 function );
+
+		return( -1 );
+	}
+	upper_entry_index = number_of_entries;
+
+	while( lower_entry_index < upper_entry_index )
+	{
+		middle_entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
+		if( libfsapfs_btree_node_get_entry_by_index(
+		     node,
+		     middle_entry_index,
+		     &btree_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree entry: %d.",
+			 function,
+			 middle_entry_index );
+
+			return( -1 );
+		}
+		result = libfsapfs_file_system_btree_cursor_compare_entry_key(
+		          btree_entry,
+		          identifier,
+		          data_type,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare key of B-tree entry: %d.",
+			 function,
+			 middle_entry_index );
+
+			return( -1 );
+		}
+		else if( result == LIBCDATA_COMPARE_LESS )
+		{
+			lower_entry_index = middle_entry_index + 1;
+		}
+		else
+		{
+			upper_entry_index = middle_entry_index;
+		}
+	}
+	*entry_index = lower_entry_index;
+
+	return( 1 );
+}
+
+/* Retrieves the node at a specific depth of the path of the cursor
+ * The node is referenced by the cursor and remains valid while it is on the path of the cursor
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_get_node_by_depth(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     int depth,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_cursor_get_node_by_depth";
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( depth < 0 )
+	 || ( depth >= file_system_btree_cursor->depth ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree_cursor->nodes[ depth ] == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system B-tree cursor - missing node: %d.",
+		 function,
+		 depth );
+
+		return( -1 );
+	}
+	*node = file_system_btree_cursor->nodes[ depth ];
+
+	return( 1 );
+}
+
+/* Retrieves the sub node referenced by a specific entry of a branch node and adds it to the path of the cursor
+ * The sub node is referenced by the cursor and remains valid while it is on the path of the cursor
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_push_sub_node(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libfsapfs_btree_node_t *node,
+     int entry_index,
+     libfsapfs_btree_node_t **sub_node,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *btree_entry = NULL;
+	static char *function                = "libfsapfs_file_system_btree_cursor_push_sub_node";
+	uint64_t sub_node_block_number       = 0;
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_system_btree_cursor->depth < 0 )
+	 || ( file_system_btree_cursor->depth >= LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file system B-tree cursor - depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_btree_node_get_entry_by_index(
+	     node,
+	     entry_index,
+	     &btree_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_system_btree_get_sub_node_block_number_from_entry(
+	     file_system_btree_cursor->file_system_btree,
+	     file_system_btree_cursor->file_io_handle,
+	     btree_entry,
+	     &sub_node_block_number,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine sub node block number.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_system_btree_get_sub_node(
+	     file_system_btree_cursor->file_system_btree,
+	     file_system_btree_cursor->file_io_handle,
+	     sub_node_block_number,
+	     &( file_system_btree_cursor->nodes[ file_system_btree_cursor->depth ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree sub node from block: %" PRIu64 ".",
+		 function,
+		 sub_node_block_number );
+
+		return( -1 );
+	}
+	*sub_node = file_system_btree_cursor->nodes[ file_system_btree_cursor->depth ];
+
+	file_system_btree_cursor->entry_indexes[ file_system_btree_cursor->depth ] = 0;
+
+	file_system_btree_cursor->depth += 1;
+
+	return( 1 );
+}
+
+/* Descends from the node at the end of the path of the cursor to the leaf node
+ * In a branch node the path follows the last entry with a key less than the identifier and data type,
+ * since the records of a single identifier and data type can span multiple sub nodes
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_descend(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libfsapfs_btree_node_t *node,
+     uint64_t identifier,
+     uint8_t data_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_btree_cursor_descend";
+	int entry_index       = 0;
+	int is_leaf_node      = 0;
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree_cursor->depth <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file system B-tree cursor - depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		is_leaf_node = libfsapfs_btree_node_is_leaf_node(
+		                node,
+		                error );
+
+		if( is_leaf_node == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if B-tree node is a leaf node.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfsapfs_file_system_btree_cursor_get_lower_bound_entry_index(
+		     node,
+		     identifier,
+		     data_type,
+		     &entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve lower bound entry index.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( is_leaf_node == 0 )
+		 && ( entry_index > 0 ) )
+		{
+			entry_index -= 1;
+		}
+		file_system_btree_cursor->entry_indexes[ file_system_btree_cursor->depth - 1 ] = entry_index;
+
+		if( is_leaf_node == 0 )
+		{
+			if( libfsapfs_file_system_btree_cursor_push_sub_node(
+			     file_system_btree_cursor,
+			     node,
+			     entry_index,
+			     &node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve B-tree sub node.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	while( is_leaf_node == 0 );
+
+	return( 1 );
+}
+
+/* Positions the cursor on the first leaf entry with a key equal to or greater than the identifier and data type
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_seek(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     uint64_t identifier,
+     uint8_t data_type,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_t *node = NULL;
+	static char *function        = "libfsapfs_file_system_btree_cursor_seek";
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree_cursor->file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system B-tree cursor - missing file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_system_btree_cursor_release_nodes(
+	     file_system_btree_cursor,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_system_btree_get_root_node(
+	     file_system_btree_cursor->file_system_btree,
+	     file_system_btree_cursor->file_io_handle,
+	     file_system_btree_cursor->file_system_btree->root_node_block_number,
+	     &( file_system_btree_cursor->nodes[ 0 ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree root node.",
+		 function );
+
+		return( -1 );
+	}
+	node = file_system_btree_cursor->nodes[ 0 ];
+
+	file_system_btree_cursor->entry_indexes[ 0 ] = 0;
+	file_system_btree_cursor->depth              = 1;
+
+	if( libfsapfs_file_system_btree_cursor_descend(
+	     file_system_btree_cursor,
+	     node,
+	     identifier,
+	     data_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to descend to B-tree leaf node.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libfsapfs_file_system_btree_cursor_release_nodes(
+	 file_system_btree_cursor,
+	 0,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Positions the cursor on the first leaf entry with a key equal to or greater than the identifier and data type
+ * The identifier and data type must not be less than those of a previous seek, this allows the nodes already
+ * on the path of the cursor to be reused: the path is only ascended up to the first node that contains a key
+ * equal to or greater than the identifier and data type, instead of descending from the root node
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_seek_forward(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     uint64_t identifier,
+     uint8_t data_type,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_t *node = NULL;
+	static char *function        = "libfsapfs_file_system_btree_cursor_seek_forward";
+	int depth                    = 0;
+	int entry_index              = 0;
+	int number_of_entries        = 0;
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	/* The root node is not checked since the path is always reusable from the root node
+	 */
+	for( depth = file_system_btree_cursor->depth - 1;
+	     depth > 0;
+	     depth-- )
+	{
+		if( libfsapfs_file_system_btree_cursor_get_node_by_depth(
+		     file_system_btree_cursor,
+		     depth,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree node: %d.",
+			 function,
+			 depth );
+
+			goto on_error;
+		}
+		if( libfsapfs_btree_node_get_number_of_entries(
+		     node,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries from B-tree node.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_file_system_btree_cursor_get_lower_bound_entry_index(
+		     node,
+		     identifier,
+		     data_type,
+		     &entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve lower bound entry index.",
+			 function );
+
+			goto on_error;
+		}
+		/* If the node contains a key equal to or greater than the identifier and data type
+		 * the first leaf entry with such a key is in the sub tree of this node
+		 */
+		if( entry_index < number_of_entries )
+		{
+			break;
+		}
+	}
+	if( depth <= 0 )
+	{
+		return( libfsapfs_file_system_btree_cursor_seek(
+		         file_system_btree_cursor,
+		         identifier,
+		         data_type,
+		         error ) );
+	}
+	if( libfsapfs_file_system_btree_cursor_release_nodes(
+	     file_system_btree_cursor,
+	     depth + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_system_btree_cursor_descend(
+	     file_system_btree_cursor,
+	     node,
+	     identifier,
+	     data_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to descend to B-tree leaf node.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libfsapfs_file_system_btree_cursor_release_nodes(
+	 file_system_btree_cursor,
+	 0,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Moves the cursor to the first entry of the next leaf node
+ * Returns 1 if successful, 0 if there are no more leaf nodes or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_move_to_next_leaf_node(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_t *node = NULL;
+	static char *function        = "libfsapfs_file_system_btree_cursor_move_to_next_leaf_node";
+	int depth                    = 0;
+	int is_leaf_node             = 0;
+	int number_of_entries        = 0;
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	while( file_system_btree_cursor->depth > 0 )
+	{
+		/* Remove the exhausted leaf node and every branch node of which
+		 * the last sub node has been visited from the path
+		 */
+		if( libfsapfs_file_system_btree_cursor_release_nodes(
+		     file_system_btree_cursor,
+		     file_system_btree_cursor->depth - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release leaf node.",
+			 function );
+
+			goto on_error;
+		}
+		while( file_system_btree_cursor->depth > 0 )
+		{
+			depth = file_system_btree_cursor->depth - 1;
+
+			if( libfsapfs_file_system_btree_cursor_get_node_by_depth(
+			     file_system_btree_cursor,
+			     depth,
+			     &node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve B-tree node: %d.",
+				 function,
+				 depth );
+
+				goto on_error;
+			}
+			if( libfsapfs_btree_node_get_number_of_entries(
+			     node,
+			     &number_of_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of entries from B-tree node.",
+				 function );
+
+				goto on_error;
+			}
+			file_system_btree_cursor->entry_indexes[ depth ] += 1;
+
+			if( file_system_btree_cursor->entry_indexes[ depth ] < number_of_entries )
+			{
+				break;
+			}
+			if( libfsapfs_file_system_btree_cursor_release_nodes(
+			     file_system_btree_cursor,
+			     depth,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release branch node: %d.",
+				 function,
+				 depth );
+
+				goto on_error;
+			}
+		}
+		if( file_system_btree_cursor->depth == 0 )
+		{
+			break;
+		}
+		/* Descend into the first entry of each sub node down to the leaf node
+		 */
+		do
+		{
+			depth = file_system_btree_cursor->depth - 1;
+
+			if( libfsapfs_file_system_btree_cursor_push_sub_node(
+			     file_system_btree_cursor,
+			     node,
+			     file_system_btree_cursor->entry_indexes[ depth ],
+			     &node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve B-tree sub node.",
+				 function );
+
+				goto on_error;
+			}
+			is_leaf_node = libfsapfs_btree_node_is_leaf_node(
+			                node,
+			                error );
+
+			if( is_leaf_node == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if B-tree node is a leaf node.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		while( is_leaf_node == 0 );
+
+		if( libfsapfs_btree_node_get_number_of_entries(
+		     node,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries from B-tree node.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_entries > 0 )
+		{
+			return( 1 );
+		}
+	}
+	return( 0 );
+
+on_error:
+	libfsapfs_file_system_btree_cursor_release_nodes(
+	 file_system_btree_cursor,
+	 0,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves the entry the cursor is positioned on and moves the cursor to the next entry
+ * The B-tree entry is owned by the B-tree node and only valid until the cursor moves to the next leaf node
+ * Returns 1 if successful, 0 if there are no more entries or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_get_next_entry(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libfsapfs_btree_entry_t **btree_entry,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_t *node = NULL;
+	static char *function        = "libfsapfs_file_system_btree_cursor_get_next_entry";
+	int depth                    = 0;
+	int number_of_entries        = 0;
+	int result                   = 0;
+
+	if( file_system_btree_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree_cursor->depth <= 0 )
+	{
+		return( 0 );
+	}
+	depth = file_system_btree_cursor->depth - 1;
+
+	if( libfsapfs_file_system_btree_cursor_get_node_by_depth(
+	     file_system_btree_cursor,
+	     depth,
+	     &node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree leaf node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_btree_node_get_number_of_entries(
+	     node,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from B-tree node.",
+		 function );
+
+		return( -1 );
+	}
+	/* The next leaf node is only read when an entry of it is requested
+	 */
+	if( file_system_btree_cursor->entry_indexes[ depth ] >= number_of_entries )
+	{
+		result = libfsapfs_file_system_btree_cursor_move_to_next_leaf_node(
+		          file_system_btree_cursor,
+		          error );
+
+		if( result != 1 )
+		{
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to move to next B-tree leaf node.",
+				 function );
+			}
+			return( result );
+		}
+		depth = file_system_btree_cursor->depth - 1;
+
+		if( libfsapfs_file_system_btree_cursor_get_node_by_depth(
+		     file_system_btree_cursor,
+		     depth,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree leaf node.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfsapfs_btree_node_get_entry_by_index(
+	     node,
+	     file_system_btree_cursor->entry_indexes[ depth ],
+	     btree_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree entry: %d.",
+		 function,
+		 file_system_btree_cursor->entry_indexes[ depth ] );
+
+		return( -1 );
+	}
+	file_system_btree_cursor->entry_indexes[ depth ] += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the directory record the cursor is positioned on and moves the cursor to the next entry
+ * The cursor should be positioned using libfsapfs_file_system_btree_cursor_seek with the parent identifier
+ * Returns 1 if successful, 0 if there are no more directory records of the parent identifier or -1 on error
+ */
+int libfsapfs_file_system_btree_cursor_get_next_directory_record(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     uint64_t parent_identifier,
+     libfsapfs_directory_record_t **directory_record,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *btree_entry = NULL;
+	static char *function                = "libfsapfs_file_system_btree_cursor_get_next_directory_record";
+	int compare_result                   = 0;
+	int result                           = 0;
+
+	if( directory_record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory record.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_record != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory record value already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsapfs_file_system_btree_cursor_get_next_entry(
+	          file_system_btree_cursor,
+	          &btree_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next B-tree entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	compare_result = libfsapfs_file_system_btree_cursor_compare_entry_key(
+	                  btree_entry,
+	                  parent_identifier,
+	                  LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_DIRECTORY_RECORD,
+	                  error );
+
+	if( compare_result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare key of B-tree entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( compare_result != LIBCDATA_COMPARE_EQUAL )
+	{
+		return( 0 );
+	}
+	/* The B-tree entry is only valid until the cursor moves to the next leaf node
+	 * hence the directory record is read before it is returned
+	 */
+	if( libfsapfs_directory_record_initialize(
+	     directory_record,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory record.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_directory_record_read_key_data(
+	     *directory_record,
+	     btree_entry->key_data,
+	     (size_t) btree_entry->key_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory record key data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_directory_record_read_value_data(
+	     *directory_record,
+	     btree_entry->value_data,
+	     (size_t) btree_entry->value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory record value data.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *directory_record != NULL )
+	{
+		libfsapfs_directory_record_free(
+		 directory_record,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,146 @@
+/*
+ * The file system B-tree cursor functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_FILE_SYSTEM_BTREE_CURSOR_H )
+#define _LIBFSAPFS_FILE_SYSTEM_BTREE_CURSOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_btree_entry.h"
+#include "libfsapfs_btree_node.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_directory_record.h"
+#include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_file_system_btree_cursor libfsapfs_file_system_btree_cursor_t;
+
+struct libfsapfs_file_system_btree_cursor
+{
+	/* The file system B-tree
+	 */
+	libfsapfs_file_system_btree_t *file_system_btree;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The number of nodes on the path
+	 */
+	int depth;
+
+	/* The nodes on the path from the root node to the current leaf node
+	 * The cursor holds a reference to each node so that they cannot be freed by an eviction from the node cache
+	 */
+	libfsapfs_btree_node_t *nodes[ LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH ];
+
+	/* The entry indexes of the nodes on the path from the root node to the current leaf node
+	 */
+	int entry_indexes[ LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH ];
+};
+
+int libfsapfs_file_system_btree_cursor_initialize(
+     libfsapfs_file_system_btree_cursor_t **file_system_btree_cursor,
+     libfsapfs_file_system_btree_t *file_system_btree,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_free(
+     libfsapfs_file_system_btree_cursor_t **file_system_btree_cursor,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_release_nodes(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     int depth,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_compare_entry_key(
+     libfsapfs_btree_entry_t *btree_entry,
+     uint64_t identifier,
+     uint8_t data_type,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_get_lower_bound_entry_index(
+     libfsapfs_btree_node_t *node,
+     uint64_t identifier,
+     uint8_t data_type,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_get_node_by_depth(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     int depth,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_push_sub_node(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libfsapfs_btree_node_t *node,
+     int entry_index,
+     libfsapfs_btree_node_t **sub_node,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_descend(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libfsapfs_btree_node_t *node,
+     uint64_t identifier,
+     uint8_t data_type,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_seek(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     uint64_t identifier,
+     uint8_t data_type,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_seek_forward(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     uint64_t identifier,
+     uint8_t data_type,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_move_to_next_leaf_node(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_get_next_entry(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     libfsapfs_btree_entry_t **btree_entry,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_btree_cursor_get_next_directory_record(
+     libfsapfs_file_system_btree_cursor_t *file_system_btree_cursor,
+     uint64_t parent_identifier,
+     libfsapfs_directory_record_t **directory_record,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_FILE_SYSTEM_BTREE_CURSOR_H ) */
+
@@ -0,0 +1,1259 @@
+/*
+ * The file system scanner functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_directory_record.h"
+#include "libfsapfs_encryption_context.h"
+#include "libfsapfs_extended_attribute.h"
+#include "libfsapfs_file_entry.h"
+#include "libfsapfs_file_extent.h"
+#include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_file_system_scanner.h"
+#include "libfsapfs_inode.h"
+#include "libfsapfs_io_handle.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcdata.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_types.h"
+
+#include "fsapfs_file_system.h"
+
+/* Creates a file system scanner
+ * Make sure the value file_system_scanner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_scanner_initialize(
+     libfsapfs_file_system_scanner_t **file_system_scanner,
+     libfsapfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_encryption_context_t *encryption_context,
+     libfsapfs_file_system_btree_t *file_system_btree,
+     int (*callback_function)(
+            const libfsapfs_scan_record_t *scan_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_scanner_initialize";
+
+	if( file_system_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_system_scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file system scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	*file_system_scanner = memory_allocate_structure(
+	                        libfsapfs_file_system_scanner_t );
+
+	if( *file_system_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file system scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_system_scanner,
+	     0,
+	     sizeof( libfsapfs_file_system_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file system scanner.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_system_scanner )->io_handle          = io_handle;
+	( *file_system_scanner )->file_io_handle     = file_io_handle;
+	( *file_system_scanner )->encryption_context = encryption_context;
+	( *file_system_scanner )->file_system_btree  = file_system_btree;
+	( *file_system_scanner )->callback_function  = callback_function;
+	( *file_system_scanner )->callback_data      = callback_data;
+
+	return( 1 );
+
+on_error:
+	if( *file_system_scanner != NULL )
+	{
+		memory_free(
+		 *file_system_scanner );
+
+		*file_system_scanner = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file system scanner
+ * A pending file entry is discarded, use libfsapfs_file_system_scanner_flush_file_entry to pass it to the callback function
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_file_system_scanner_free(
+     libfsapfs_file_system_scanner_t **file_system_scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_scanner_free";
+	int result            = 1;
+
+	if( file_system_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_system_scanner != NULL )
+	{
+		if( ( *file_system_scanner )->inode != NULL )
+		{
+			if( libfsapfs_inode_free(
+			     &( ( *file_system_scanner )->inode ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free inode.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file_system_scanner )->extended_attributes != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *file_system_scanner )->extended_attributes ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_internal_extended_attribute_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free extended attributes array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The io_handle, file_io_handle, encryption_context and file_system_btree references are freed elsewhere
+		 */
+		memory_free(
+		 *file_system_scanner );
+
+		*file_system_scanner = NULL;
+	}
+	return( result );
+}
+
+/* Reads a file system record and passes it to the callback function
+ * This function is used as the callback function of libfsapfs_file_system_btree_scan
+ * The extended attribute records of an inode directly follow its inode record hence
+ * the file entry of an inode is kept pending until a record of another kind or inode is read
+ * Returns 1 to continue, 0 if the callback function stopped the scan or -1 on error
+ */
+int libfsapfs_file_system_scanner_read_record(
+     uint8_t record_type,
+     uint64_t identifier,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_file_system_scanner_read_record";
+	int result            = 0;
+
+	if( file_system_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_system_scanner->inode != NULL )
+	 && ( ( record_type != LIBFSAPFS_RECORD_TYPE_EXTENDED_ATTRIBUTE )
+	  || ( identifier != file_system_scanner->inode_identifier ) ) )
+	{
+		result = libfsapfs_file_system_scanner_flush_file_entry(
+		          file_system_scanner,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to flush file entry.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	switch( record_type )
+	{
+		case LIBFSAPFS_RECORD_TYPE_INODE:
+			if( libfsapfs_inode_initialize(
+			     &( file_system_scanner->inode ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create inode.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfsapfs_inode_read_key_data(
+			     file_system_scanner->inode,
+			     key_data,
+			     key_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read inode: %" PRIu64 " key data.",
+				 function,
+				 identifier );
+
+				goto on_error;
+			}
+			if( libfsapfs_inode_read_value_data(
+			     file_system_scanner->inode,
+			     value_data,
+			     value_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read inode: %" PRIu64 " value data.",
+				 function,
+				 identifier );
+
+				goto on_error;
+			}
+			if( libcdata_array_initialize(
+			     &( file_system_scanner->extended_attributes ),
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create extended attributes array.",
+				 function );
+
+				goto on_error;
+			}
+			file_system_scanner->inode_identifier = identifier;
+
+			result = 1;
+
+			break;
+
+		case LIBFSAPFS_RECORD_TYPE_EXTENDED_ATTRIBUTE:
+			result = libfsapfs_file_system_scanner_read_extended_attribute(
+			          file_system_scanner,
+			          identifier,
+			          key_data,
+			          key_data_size,
+			          value_data,
+			          value_data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read extended attribute record: %" PRIu64 ".",
+				 function,
+				 identifier );
+
+				goto on_error;
+			}
+			break;
+
+		case LIBFSAPFS_RECORD_TYPE_DIRECTORY_RECORD:
+			result = libfsapfs_file_system_scanner_read_directory_record(
+			          file_system_scanner,
+			          identifier,
+			          key_data,
+			          key_data_size,
+			          value_data,
+			          value_data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read directory record: %" PRIu64 ".",
+				 function,
+				 identifier );
+
+				goto on_error;
+			}
+			break;
+
+		case LIBFSAPFS_RECORD_TYPE_FILE_EXTENT:
+			result = libfsapfs_file_system_scanner_read_file_extent(
+			          file_system_scanner,
+			          identifier,
+			          key_data,
+			          key_data_size,
+			          value_data,
+			          value_data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read file extent record: %" PRIu64 ".",
+				 function,
+				 identifier );
+
+				goto on_error;
+			}
+			break;
+
+		case LIBFSAPFS_RECORD_TYPE_SIBLING_LINK:
+			result = libfsapfs_file_system_scanner_read_sibling_link(
+			          file_system_scanner,
+			          identifier,
+			          key_data,
+			          key_data_size,
+			          value_data,
+			          value_data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sibling link record: %" PRIu64 ".",
+				 function,
+				 identifier );
+
+				goto on_error;
+			}
+			break;
+
+		default:
+			result = 1;
+
+			break;
+	}
+	return( result );
+
+on_error:
+	if( file_system_scanner->extended_attributes != NULL )
+	{
+		libcdata_array_free(
+		 &( file_system_scanner->extended_attributes ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_internal_extended_attribute_free,
+		 NULL );
+	}
+	if( file_system_scanner->inode != NULL )
+	{
+		libfsapfs_inode_free(
+		 &( file_system_scanner->inode ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Passes the pending file entry and its extended attributes to the callback function
+ * Returns 1 if successful, 0 if the callback function stopped the scan or -1 on error
+ */
+int libfsapfs_file_system_scanner_flush_file_entry(
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_entry_t *file_entry                   = NULL;
+	libfsapfs_internal_file_entry_t *internal_file_entry = NULL;
+	libfsapfs_scan_record_t scan_record;
+
+	static char *function                                = "libfsapfs_file_system_scanner_flush_file_entry";
+	int entry_index                                      = 0;
+	int number_of_extended_attributes                    = 0;
+	int result                                           = 1;
+
+	if( file_system_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system_scanner->inode == NULL )
+	{
+		return( 1 );
+	}
+	if( libfsapfs_file_entry_initialize(
+	     &file_entry,
+	     file_system_scanner->io_handle,
+	     file_system_scanner->file_io_handle,
+	     file_system_scanner->encryption_context,
+	     file_system_scanner->file_system_btree,
+	     file_system_scanner->inode,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry: %" PRIu64 ".",
+		 function,
+		 file_system_scanner->inode_identifier );
+
+		goto on_error;
+	}
+	/* The file entry takes over management of the inode
+	 */
+	file_system_scanner->inode = NULL;
+
+	internal_file_entry = (libfsapfs_internal_file_entry_t *) file_entry;
+
+	if( libfsapfs_internal_file_entry_set_extended_attributes(
+	     internal_file_entry,
+	     &( file_system_scanner->extended_attributes ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set extended attributes of file entry: %" PRIu64 ".",
+		 function,
+		 file_system_scanner->inode_identifier );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &scan_record,
+	     0,
+	     sizeof( libfsapfs_scan_record_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan record.",
+		 function );
+
+		goto on_error;
+	}
+	scan_record.record_type = LIBFSAPFS_RECORD_TYPE_INODE;
+	scan_record.identifier  = file_system_scanner->inode_identifier;
+	scan_record.file_entry  = file_entry;
+
+	result = file_system_scanner->callback_function(
+	          &scan_record,
+	          file_system_scanner->callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process file entry: %" PRIu64 ".",
+		 function,
+		 file_system_scanner->inode_identifier );
+
+		goto on_error;
+	}
+	/* The extended attributes are passed after the file entry to retain the key order of the records
+	 */
+	if( ( result == 1 )
+	 && ( internal_file_entry->extended_attributes != NULL ) )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     internal_file_entry->extended_attributes,
+		     &number_of_extended_attributes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of extended attributes.",
+			 function );
+
+			goto on_error;
+		}
+		scan_record.record_type = LIBFSAPFS_RECORD_TYPE_EXTENDED_ATTRIBUTE;
+		scan_record.file_entry  = NULL;
+
+		for( entry_index = 0;
+		     entry_index < number_of_extended_attributes;
+		     entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_file_entry->extended_attributes,
+			     entry_index,
+			     (intptr_t **) &( scan_record.extended_attribute ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extended attribute: %d.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			result = file_system_scanner->callback_function(
+			          &scan_record,
+			          file_system_scanner->callback_data,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to process extended attribute: %d of file entry: %" PRIu64 ".",
+				 function,
+				 entry_index,
+				 file_system_scanner->inode_identifier );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+		}
+	}
+	if( libfsapfs_file_entry_free(
+	     &file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file entry: %" PRIu64 ".",
+		 function,
+		 file_system_scanner->inode_identifier );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libfsapfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	if( file_system_scanner->extended_attributes != NULL )
+	{
+		libcdata_array_free(
+		 &( file_system_scanner->extended_attributes ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_internal_extended_attribute_free,
+		 NULL );
+	}
+	if( file_system_scanner->inode != NULL )
+	{
+		libfsapfs_inode_free(
+		 &( file_system_scanner->inode ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads an extended attribute record
+ * The extended attribute is added to the pending file entry if it belongs to its inode
+ * otherwise it is passed to the callback function directly
+ * Returns 1 to continue, 0 if the callback function stopped the scan or -1 on error
+ */
+int libfsapfs_file_system_scanner_read_extended_attribute(
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     uint64_t identifier,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_extended_attribute_t *extended_attribute = NULL;
+	libfsapfs_scan_record_t scan_record;
+
+	static char *function                              = "libfsapfs_file_system_scanner_read_extended_attribute";
+	int entry_index                                    = 0;
+	int result                                         = 1;
+
+	if( file_system_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_extended_attribute_initialize(
+	     &extended_attribute,
+	     file_system_scanner->io_handle,
+	     file_system_scanner->file_io_handle,
+	     file_system_scanner->encryption_context,
+	     file_system_scanner->file_system_btree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extended attribute.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_extended_attribute_read_key_data(
+	     extended_attribute,
+	     key_data,
+	     key_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read extended attribute key data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_extended_attribute_read_value_data(
+	     extended_attribute,
+	     value_data,
+	     value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read extended attribute value data.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_system_scanner->extended_attributes != NULL )
+	 && ( identifier == file_system_scanner->inode_identifier ) )
+	{
+		if( libcdata_array_append_entry(
+		     file_system_scanner->extended_attributes,
+		     &entry_index,
+		     (intptr_t *) extended_attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extended attribute to array.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	if( memory_set(
+	     &scan_record,
+	     0,
+	     sizeof( libfsapfs_scan_record_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan record.",
+		 function );
+
+		goto on_error;
+	}
+	scan_record.record_type        = LIBFSAPFS_RECORD_TYPE_EXTENDED_ATTRIBUTE;
+	scan_record.identifier         = identifier;
+	scan_record.extended_attribute = extended_attribute;
+
+	result = file_system_scanner->callback_function(
+	          &scan_record,
+	          file_system_scanner->callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process extended attribute.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_internal_extended_attribute_free(
+	     (libfsapfs_internal_extended_attribute_t **) &extended_attribute,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free extended attribute.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( extended_attribute != NULL )
+	{
+		libfsapfs_internal_extended_attribute_free(
+		 (libfsapfs_internal_extended_attribute_t **) &extended_attribute,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a directory record
+ * Returns 1 to continue, 0 if the callback function stopped the scan or -1 on error
+ */
+int libfsapfs_file_system_scanner_read_directory_record(
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     uint64_t identifier,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_directory_record_t *directory_record = NULL;
+	libfsapfs_directory_record_values_t directory_record_values;
+	libfsapfs_scan_record_t scan_record;
+
+	static char *function                          = "libfsapfs_file_system_scanner_read_directory_record";
+	int result                                     = 1;
+
+	if( file_system_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_directory_record_initialize(
+	     &directory_record,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory record.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_directory_record_read_key_data(
+	     directory_record,
+	     key_data,
+	     key_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory record key data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_directory_record_read_value_data(
+	     directory_record,
+	     value_data,
+	     value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory record value data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &scan_record,
+	     0,
+	     sizeof( libfsapfs_scan_record_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan record.",
+		 function );
+
+		goto on_error;
+	}
+	directory_record_values.parent_identifier = identifier;
+	directory_record_values.identifier        = directory_record->identifier;
+	directory_record_values.added_time        = (int64_t) directory_record->added_time;
+	directory_record_values.utf8_name         = directory_record->name;
+	directory_record_values.utf8_name_size    = (size_t) directory_record->name_size;
+
+	scan_record.record_type      = LIBFSAPFS_RECORD_TYPE_DIRECTORY_RECORD;
+	scan_record.identifier       = identifier;
+	scan_record.directory_record = &directory_record_values;
+
+	result = file_system_scanner->callback_function(
+	          &scan_record,
+	          file_system_scanner->callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process directory record.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_directory_record_free(
+	     &directory_record,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free directory record.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( directory_record != NULL )
+	{
+		libfsapfs_directory_record_free(
+		 &directory_record,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a file extent record
+ * Returns 1 to continue, 0 if the callback function stopped the scan or -1 on error
+ */
+int libfsapfs_file_system_scanner_read_file_extent(
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     uint64_t identifier,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_extent_t *file_extent = NULL;
+	libfsapfs_file_extent_values_t file_extent_values;
+	libfsapfs_scan_record_t scan_record;
+
+	static char *function                = "libfsapfs_file_system_scanner_read_file_extent";
+	int result                           = 1;
+
+	if( file_system_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_extent_initialize(
+	     &file_extent,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file extent.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_extent_read_key_data(
+	     file_extent,
+	     key_data,
+	     key_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file extent key data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_extent_read_value_data(
+	     file_extent,
+	     value_data,
+	     value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file extent value data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &scan_record,
+	     0,
+	     sizeof( libfsapfs_scan_record_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan record.",
+		 function );
+
+		goto on_error;
+	}
+	file_extent_values.identifier            = identifier;
+	file_extent_values.logical_offset        = file_extent->logical_offset;
+	file_extent_values.physical_block_number = file_extent->physical_block_number;
+	file_extent_values.data_size             = file_extent->data_size;
+	file_extent_values.encryption_identifier = file_extent->encryption_identifier;
+
+	scan_record.record_type = LIBFSAPFS_RECORD_TYPE_FILE_EXTENT;
+	scan_record.identifier  = identifier;
+	scan_record.file_extent = &file_extent_values;
+
+	result = file_system_scanner->callback_function(
+	          &scan_record,
+	          file_system_scanner->callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process file extent.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_extent_free(
+	     &file_extent,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file extent.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_extent != NULL )
+	{
+		libfsapfs_file_extent_free(
+		 &file_extent,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a sibling link record
+ * Returns 1 to continue, 0 if the callback function stopped the scan or -1 on error
+ */
+int libfsapfs_file_system_scanner_read_sibling_link(
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     uint64_t identifier,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_scan_record_t scan_record;
+	libfsapfs_sibling_link_values_t sibling_link_values;
+
+	static char *function = "libfsapfs_file_system_scanner_read_sibling_link";
+	uint16_t name_size    = 0;
+	int result            = 1;
+
+	if( file_system_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key data.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_data_size < sizeof( fsapfs_file_system_btree_key_sibling_link_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_data_size < sizeof( fsapfs_file_system_btree_value_sibling_link_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid value data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fsapfs_file_system_btree_value_sibling_link_t *) value_data )->name_size,
+	 name_size );
+
+	if( (size_t) name_size > ( value_data_size - sizeof( fsapfs_file_system_btree_value_sibling_link_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &scan_record,
+	     0,
+	     sizeof( libfsapfs_scan_record_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan record.",
+		 function );
+
+		return( -1 );
+	}
+	sibling_link_values.identifier = identifier;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsapfs_file_system_btree_key_sibling_link_t *) key_data )->sibling_identifier,
+	 sibling_link_values.sibling_identifier );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsapfs_file_system_btree_value_sibling_link_t *) value_data )->parent_identifier,
+	 sibling_link_values.parent_identifier );
+
+	sibling_link_values.utf8_name      = &( value_data[ sizeof( fsapfs_file_system_btree_value_sibling_link_t ) ] );
+	sibling_link_values.utf8_name_size = (size_t) name_size;
+
+	scan_record.record_type  = LIBFSAPFS_RECORD_TYPE_SIBLING_LINK;
+	scan_record.identifier   = identifier;
+	scan_record.sibling_link = &sibling_link_values;
+
+	result = file_system_scanner->callback_function(
+	          &scan_record,
+	          file_system_scanner->callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process sibling link.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
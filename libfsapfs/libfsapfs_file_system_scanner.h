@@ -0,0 +1,157 @@
+/*
+ * The file system scanner functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_FILE_SYSTEM_SCANNER_H )
+#define _LIBFSAPFS_FILE_SYSTEM_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_encryption_context.h"
+#include "libfsapfs_file_system_btree.h"
+#include "libfsapfs_inode.h"
+#include "libfsapfs_io_handle.h"
+#include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcdata.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_file_system_scanner libfsapfs_file_system_scanner_t;
+
+struct libfsapfs_file_system_scanner
+{
+	/* The IO handle
+	 */
+	libfsapfs_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The encryption context
+	 */
+	libfsapfs_encryption_context_t *encryption_context;
+
+	/* The file system B-tree
+	 */
+	libfsapfs_file_system_btree_t *file_system_btree;
+
+	/* The callback function
+	 */
+	int (*callback_function)(
+	       const libfsapfs_scan_record_t *scan_record,
+	       void *callback_data,
+	       libcerror_error_t **error );
+
+	/* The callback data
+	 */
+	void *callback_data;
+
+	/* The inode of the pending file entry
+	 */
+	libfsapfs_inode_t *inode;
+
+	/* The identifier of the pending file entry
+	 */
+	uint64_t inode_identifier;
+
+	/* The extended attributes of the pending file entry
+	 */
+	libcdata_array_t *extended_attributes;
+};
+
+int libfsapfs_file_system_scanner_initialize(
+     libfsapfs_file_system_scanner_t **file_system_scanner,
+     libfsapfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_encryption_context_t *encryption_context,
+     libfsapfs_file_system_btree_t *file_system_btree,
+     int (*callback_function)(
+            const libfsapfs_scan_record_t *scan_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_scanner_free(
+     libfsapfs_file_system_scanner_t **file_system_scanner,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_scanner_read_record(
+     uint8_t record_type,
+     uint64_t identifier,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_scanner_flush_file_entry(
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_scanner_read_extended_attribute(
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     uint64_t identifier,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_scanner_read_directory_record(
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     uint64_t identifier,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_scanner_read_file_extent(
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     uint64_t identifier,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libcerror_error_t **error );
+
+int libfsapfs_file_system_scanner_read_sibling_link(
+     libfsapfs_file_system_scanner_t *file_system_scanner,
+     uint64_t identifier,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_FILE_SYSTEM_SCANNER_H ) */
+
@@ -23,8 +23,11 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_definitions.h"
 #include "libfsapfs_io_handle.h"
+#include "libfsapfs_job_pool.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
 #include "libfsapfs_profiler.h"
 
 const char fsapfs_container_signature[ 4 ] = "NXSB";
@@ -125,6 +128,47 @@ int libfsapfs_io_handle_initialize(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *io_handle )->cache_size_read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize cache size read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *io_handle )->decryption_pool_read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize decryption pool read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *io_handle )->decompression_pool_read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize decompression pool read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *io_handle )->bytes_per_sector = 512;
 	( *io_handle )->block_size       = 4096;
 
@@ -133,6 +177,20 @@ int libfsapfs_io_handle_initialize(
 on_error:
 	if( *io_handle != NULL )
 	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( ( *io_handle )->decryption_pool_read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( ( *io_handle )->decryption_pool_read_write_lock ),
+			 NULL );
+		}
+		if( ( *io_handle )->cache_size_read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( ( *io_handle )->cache_size_read_write_lock ),
+			 NULL );
+		}
+#endif
 #if defined( HAVE_PROFILER )
 		if( ( *io_handle )->profiler != NULL )
 		{
@@ -201,6 +259,79 @@ int libfsapfs_io_handle_free(
 		}
 #endif /* defined( HAVE_PROFILER ) */
 
+		if( ( *io_handle )->decryption_pool != NULL )
+		{
+			if( libfsapfs_job_pool_free(
+			     &( ( *io_handle )->decryption_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free decryption pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *io_handle )->decompression_pool != NULL )
+		{
+			if( libfsapfs_job_pool_free(
+			     &( ( *io_handle )->decompression_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free decompression pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *io_handle )->cache_size_read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache size read/write lock.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_read_write_lock_free(
+		     &( ( *io_handle )->decryption_pool_read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free decryption pool read/write lock.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_read_write_lock_free(
+		     &( ( *io_handle )->decompression_pool_read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free decompression pool read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -216,10 +347,22 @@ int libfsapfs_io_handle_clear(
      libfsapfs_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function          = "libfsapfs_io_handle_clear";
+	libfsapfs_block_cache_t *block_cache                              = NULL;
+	libfsapfs_job_pool_t *decompression_pool                          = NULL;
+	libfsapfs_job_pool_t *decryption_pool                             = NULL;
+	static char *function                                             = "libfsapfs_io_handle_clear";
+	size64_t cache_size                                               = 0;
+	size64_t maximum_btree_nodes_cache_size                           = 0;
+	size64_t maximum_cache_size                                       = 0;
+	size64_t maximum_data_blocks_cache_size                           = 0;
 
 #if defined( HAVE_PROFILER )
-	libfsapfs_profiler_t *profiler = NULL;
+	libfsapfs_profiler_t *profiler                                    = NULL;
+#endif
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_t *cache_size_read_write_lock         = NULL;
+	libcthreads_read_write_lock_t *decompression_pool_read_write_lock = NULL;
+	libcthreads_read_write_lock_t *decryption_pool_read_write_lock    = NULL;
 #endif
 
 	if( io_handle == NULL )
@@ -236,6 +379,23 @@ int libfsapfs_io_handle_clear(
 #if defined( HAVE_PROFILER )
 	profiler = io_handle->profiler;
 #endif
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	cache_size_read_write_lock         = io_handle->cache_size_read_write_lock;
+	decryption_pool_read_write_lock    = io_handle->decryption_pool_read_write_lock;
+	decompression_pool_read_write_lock = io_handle->decompression_pool_read_write_lock;
+#endif
+	/* The cache limits, the size of the caches that are still in use
+	 * the block cache and the job pools are retained when the IO handle
+	 * is cleared
+	 */
+	block_cache                    = io_handle->block_cache;
+	decryption_pool                = io_handle->decryption_pool;
+	decompression_pool             = io_handle->decompression_pool;
+	maximum_btree_nodes_cache_size = io_handle->maximum_btree_nodes_cache_size;
+	maximum_data_blocks_cache_size = io_handle->maximum_data_blocks_cache_size;
+	maximum_cache_size             = io_handle->maximum_cache_size;
+	cache_size                     = io_handle->cache_size;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -250,11 +410,704 @@ int libfsapfs_io_handle_clear(
 
 		return( -1 );
 	}
-	io_handle->bytes_per_sector = 512;
-	io_handle->block_size       = 4096;
+	io_handle->bytes_per_sector               = 512;
+	io_handle->block_size                     = 4096;
+	io_handle->maximum_btree_nodes_cache_size = maximum_btree_nodes_cache_size;
+	io_handle->maximum_data_blocks_cache_size = maximum_data_blocks_cache_size;
+	io_handle->maximum_cache_size             = maximum_cache_size;
+	io_handle->cache_size                     = cache_size;
+	io_handle->block_cache                    = block_cache;
+	io_handle->decryption_pool                = decryption_pool;
+	io_handle->decompression_pool             = decompression_pool;
 
 #if defined( HAVE_PROFILER )
 	io_handle->profiler = profiler;
+#endif
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	io_handle->cache_size_read_write_lock         = cache_size_read_write_lock;
+	io_handle->decryption_pool_read_write_lock    = decryption_pool_read_write_lock;
+	io_handle->decompression_pool_read_write_lock = decompression_pool_read_write_lock;
+#endif
+	return( 1 );
+}
+
+/* Sets the cache limits
+ * The maximum B-tree nodes and data blocks cache sizes apply to every individual cache of that type,
+ * where 0 represents the default. The maximum cache size applies to all the caches of the container combined,
+ * where 0 represents no maximum. The limits apply to caches that are created after they have been set
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_set_cache_limits(
+     libfsapfs_io_handle_t *io_handle,
+     size64_t maximum_btree_nodes_cache_size,
+     size64_t maximum_data_blocks_cache_size,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_handle_set_cache_limits";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     io_handle->cache_size_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	io_handle->maximum_btree_nodes_cache_size = maximum_btree_nodes_cache_size;
+	io_handle->maximum_data_blocks_cache_size = maximum_data_blocks_cache_size;
+	io_handle->maximum_cache_size             = maximum_cache_size;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     io_handle->cache_size_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reserves the entries of a cache, where each entry has the specified size
+ * The number of cache entries is determined by the maximum cache size, where 0 represents
+ * the maximum size set in the IO handle for the cache type. If the maximum size of all the caches
+ * of the container combined is set, the number of cache entries is reduced to fit the remaining size,
+ * with a minimum of 1 entry
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_reserve_cache_entries_of_size(
+     libfsapfs_io_handle_t *io_handle,
+     int cache_type,
+     size_t entry_size,
+     size64_t maximum_cache_size,
+     int *number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	static char *function           = "libfsapfs_io_handle_reserve_cache_entries_of_size";
+	size64_t remaining_cache_size   = 0;
+	uint64_t safe_number_of_entries = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_size == 0 )
+	 || ( entry_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( cache_type != LIBFSAPFS_CACHE_TYPE_BTREE_NODES )
+	 && ( cache_type != LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cache type.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     io_handle->cache_size_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( maximum_cache_size == 0 )
+	{
+		if( cache_type == LIBFSAPFS_CACHE_TYPE_BTREE_NODES )
+		{
+			maximum_cache_size = io_handle->maximum_btree_nodes_cache_size;
+		}
+		else
+		{
+			maximum_cache_size = io_handle->maximum_data_blocks_cache_size;
+		}
+	}
+	if( maximum_cache_size != 0 )
+	{
+		safe_number_of_entries = maximum_cache_size / entry_size;
+	}
+	else if( cache_type == LIBFSAPFS_CACHE_TYPE_BTREE_NODES )
+	{
+		safe_number_of_entries = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES;
+	}
+	else
+	{
+		safe_number_of_entries = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DATA_BLOCKS;
+	}
+	if( io_handle->maximum_cache_size != 0 )
+	{
+		if( io_handle->cache_size < io_handle->maximum_cache_size )
+		{
+			remaining_cache_size = io_handle->maximum_cache_size - io_handle->cache_size;
+		}
+		if( safe_number_of_entries > ( remaining_cache_size / entry_size ) )
+		{
+			safe_number_of_entries = remaining_cache_size / entry_size;
+		}
+	}
+	if( safe_number_of_entries == 0 )
+	{
+		safe_number_of_entries = 1;
+	}
+	else if( safe_number_of_entries > (uint64_t) INT_MAX )
+	{
+		safe_number_of_entries = (uint64_t) INT_MAX;
+	}
+	io_handle->cache_size += safe_number_of_entries * entry_size;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     io_handle->cache_size_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_cache_entries = (int) safe_number_of_entries;
+
+	return( 1 );
+}
+
+/* Reserves the entries of a cache, where each entry has the size of a block
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_reserve_cache_entries(
+     libfsapfs_io_handle_t *io_handle,
+     int cache_type,
+     size64_t maximum_cache_size,
+     int *number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_handle_reserve_cache_entries";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_io_handle_reserve_cache_entries_of_size(
+	     io_handle,
+	     cache_type,
+	     (size_t) io_handle->block_size,
+	     maximum_cache_size,
+	     number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reserve cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases the entries of a cache previously reserved with libfsapfs_io_handle_reserve_cache_entries_of_size
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_release_cache_entries_of_size(
+     libfsapfs_io_handle_t *io_handle,
+     size_t entry_size,
+     int number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_handle_release_cache_entries_of_size";
+	size64_t cache_size   = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of cache entries value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     io_handle->cache_size_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	cache_size = (size64_t) number_of_cache_entries * entry_size;
+
+	if( cache_size > io_handle->cache_size )
+	{
+		io_handle->cache_size = 0;
+	}
+	else
+	{
+		io_handle->cache_size -= cache_size;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     io_handle->cache_size_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Releases the entries of a cache previously reserved with libfsapfs_io_handle_reserve_cache_entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_release_cache_entries(
+     libfsapfs_io_handle_t *io_handle,
+     int number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_handle_release_cache_entries";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_io_handle_release_cache_entries_of_size(
+	     io_handle,
+	     (size_t) io_handle->block_size,
+	     number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the number of threads of a job pool
+ * A number of threads of 0 frees the job pool. The job pool is replaced while holding
+ * its read/write lock for writing, hence not while it is in use by a reader
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_set_number_of_job_threads(
+     libfsapfs_io_handle_t *io_handle,
+     int job_pool_type,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libfsapfs_job_pool_t **job_pool = NULL;
+	static char *function           = "libfsapfs_io_handle_set_number_of_job_threads";
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_t *read_write_lock = NULL;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	switch( job_pool_type )
+	{
+		case LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION:
+			job_pool = &( io_handle->decryption_pool );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+			read_write_lock = io_handle->decryption_pool_read_write_lock;
+#endif
+			break;
+
+		case LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION:
+			job_pool = &( io_handle->decompression_pool );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+			read_write_lock = io_handle->decompression_pool_read_write_lock;
+#endif
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported job pool type.",
+			 function );
+
+			return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( libcthreads_read_write_lock_grab_for_write(
+	     read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( *job_pool != NULL )
+	{
+		if( libfsapfs_job_pool_free(
+		     job_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free job pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( number_of_threads > 0 )
+	{
+		if( libfsapfs_job_pool_initialize(
+		     job_pool,
+		     number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create job pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves a job pool and grabs it for reading
+ * The job pool is NULL if it has not been set. The job pool cannot be freed or replaced
+ * until it has been released with libfsapfs_io_handle_release_job_pool, which must be
+ * called, even if the job pool is NULL, once all the jobs pushed to it have been waited for
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_grab_job_pool(
+     libfsapfs_io_handle_t *io_handle,
+     int job_pool_type,
+     libfsapfs_job_pool_t **job_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_handle_grab_job_pool";
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_t *read_write_lock = NULL;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( job_pool_type != LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION )
+	 && ( job_pool_type != LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported job pool type.",
+		 function );
+
+		return( -1 );
+	}
+	if( job_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( job_pool_type == LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION )
+	{
+		read_write_lock = io_handle->decryption_pool_read_write_lock;
+	}
+	else
+	{
+		read_write_lock = io_handle->decompression_pool_read_write_lock;
+	}
+	if( libcthreads_read_write_lock_grab_for_read(
+	     read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( job_pool_type == LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION )
+	{
+		*job_pool = io_handle->decryption_pool;
+	}
+	else
+	{
+		*job_pool = io_handle->decompression_pool;
+	}
+	return( 1 );
+}
+
+/* Releases a job pool previously grabbed with libfsapfs_io_handle_grab_job_pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_io_handle_release_job_pool(
+     libfsapfs_io_handle_t *io_handle,
+     int job_pool_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_io_handle_release_job_pool";
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_t *read_write_lock = NULL;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( job_pool_type != LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION )
+	 && ( job_pool_type != LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported job pool type.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( job_pool_type == LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION )
+	{
+		read_write_lock = io_handle->decryption_pool_read_write_lock;
+	}
+	else
+	{
+		read_write_lock = io_handle->decompression_pool_read_write_lock;
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
 #endif
 	return( 1 );
 }
@@ -25,7 +25,11 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsapfs_block_cache.h"
+#include "libfsapfs_file_io_handle_pool.h"
+#include "libfsapfs_job_pool.h"
 #include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
 #include "libfsapfs_profiler.h"
 
 #if defined( __cplusplus )
@@ -51,6 +55,56 @@ struct libfsapfs_io_handle
 	 */
 	size64_t container_size;
 
+	/* The maximum size of a B-tree nodes cache in bytes, where 0 represents the default
+	 */
+	size64_t maximum_btree_nodes_cache_size;
+
+	/* The maximum size of a data blocks cache in bytes, where 0 represents the default
+	 */
+	size64_t maximum_data_blocks_cache_size;
+
+	/* The maximum size of all the caches of the container combined in bytes, where 0 represents no maximum
+	 */
+	size64_t maximum_cache_size;
+
+	/* The size of all the caches of the container combined in bytes
+	 */
+	size64_t cache_size;
+
+	/* The block cache, which is shared by the container and its volumes
+	 */
+	libfsapfs_block_cache_t *block_cache;
+
+	/* The decryption pool, which is shared by the container and its volumes
+	 */
+	libfsapfs_job_pool_t *decryption_pool;
+
+	/* The decompression pool, which is shared by the container and its volumes
+	 */
+	libfsapfs_job_pool_t *decompression_pool;
+
+	/* The file IO handle pool, which is shared by the container and its volumes
+	 */
+	libfsapfs_file_io_handle_pool_t *file_io_handle_pool;
+
+	/* Value to indicate if the object maps should be preloaded
+	 */
+	uint8_t preload_object_maps;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The cache size read/write lock
+	 */
+	libcthreads_read_write_lock_t *cache_size_read_write_lock;
+
+	/* The decryption pool read/write lock
+	 */
+	libcthreads_read_write_lock_t *decryption_pool_read_write_lock;
+
+	/* The decompression pool read/write lock
+	 */
+	libcthreads_read_write_lock_t *decompression_pool_read_write_lock;
+#endif
+
 #if defined( HAVE_PROFILER )
 	/* The profiler
 	 */
@@ -74,6 +128,56 @@ int libfsapfs_io_handle_clear(
      libfsapfs_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libfsapfs_io_handle_set_cache_limits(
+     libfsapfs_io_handle_t *io_handle,
+     size64_t maximum_btree_nodes_cache_size,
+     size64_t maximum_data_blocks_cache_size,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libfsapfs_io_handle_reserve_cache_entries_of_size(
+     libfsapfs_io_handle_t *io_handle,
+     int cache_type,
+     size_t entry_size,
+     size64_t maximum_cache_size,
+     int *number_of_cache_entries,
+     libcerror_error_t **error );
+
+int libfsapfs_io_handle_reserve_cache_entries(
+     libfsapfs_io_handle_t *io_handle,
+     int cache_type,
+     size64_t maximum_cache_size,
+     int *number_of_cache_entries,
+     libcerror_error_t **error );
+
+int libfsapfs_io_handle_release_cache_entries_of_size(
+     libfsapfs_io_handle_t *io_handle,
+     size_t entry_size,
+     int number_of_cache_entries,
+     libcerror_error_t **error );
+
+int libfsapfs_io_handle_release_cache_entries(
+     libfsapfs_io_handle_t *io_handle,
+     int number_of_cache_entries,
+     libcerror_error_t **error );
+
+int libfsapfs_io_handle_set_number_of_job_threads(
+     libfsapfs_io_handle_t *io_handle,
+     int job_pool_type,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libfsapfs_io_handle_grab_job_pool(
+     libfsapfs_io_handle_t *io_handle,
+     int job_pool_type,
+     libfsapfs_job_pool_t **job_pool,
+     libcerror_error_t **error );
+
+int libfsapfs_io_handle_release_job_pool(
+     libfsapfs_io_handle_t *io_handle,
+     int job_pool_type,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,690 @@
+/*
+ * Job pool functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_job_pool.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_unused.h"
+
+/* Creates a job pool
+ * Make sure the value job_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_job_pool_initialize(
+     libfsapfs_job_pool_t **job_pool,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_job_pool_initialize";
+
+	if( job_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *job_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid job pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: multi-threading not supported.",
+	 function );
+
+	return( -1 );
+#else
+	*job_pool = memory_allocate_structure(
+	             libfsapfs_job_pool_t );
+
+	if( *job_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create job pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *job_pool,
+	     0,
+	     sizeof( libfsapfs_job_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear job pool.",
+		 function );
+
+		memory_free(
+		 *job_pool );
+
+		*job_pool = NULL;
+
+		return( -1 );
+	}
+	/* The queue is bounded to keep the number of jobs in flight,
+	 * and with that the memory used, predictable
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *job_pool )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_JOBS,
+	     (int (*)(intptr_t *, void *)) &libfsapfs_job_pool_run_job,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *job_pool )->number_of_threads = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( *job_pool != NULL )
+	{
+		memory_free(
+		 *job_pool );
+
+		*job_pool = NULL;
+	}
+	return( -1 );
+#endif /* !defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+}
+
+/* Frees a job pool
+ * This waits for the pending jobs to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_job_pool_free(
+     libfsapfs_job_pool_t **job_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_job_pool_free";
+	int result            = 1;
+
+	if( job_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *job_pool != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( ( *job_pool )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *job_pool )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *job_pool );
+
+		*job_pool = NULL;
+	}
+	return( result );
+}
+
+/* Runs a job by calling the job function of its request
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_job_pool_run_job(
+     libfsapfs_job_t *job,
+     void *arguments LIBFSAPFS_ATTRIBUTE_UNUSED )
+{
+	libfsapfs_job_request_t *job_request = NULL;
+	int result                           = 1;
+
+	LIBFSAPFS_UNREFERENCED_PARAMETER( arguments )
+
+	if( job == NULL )
+	{
+		return( -1 );
+	}
+	job_request = job->request;
+
+	if( ( job_request == NULL )
+	 || ( job_request->job_function == NULL ) )
+	{
+		return( -1 );
+	}
+	/* There is no caller to report the error to, hence the error is
+	 * stored in the request as a result value
+	 */
+	if( job_request->job_function(
+	     job->value,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     job_request->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		job_request->result = -1;
+	}
+	job_request->number_of_pending_jobs -= 1;
+
+	if( job_request->number_of_pending_jobs == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     job_request->condition,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     job_request->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Pushes a job onto the job pool, which calls the job function of the request with the job value
+ * The job value must remain available until the request has been waited for
+ * This blocks if the queue of the job pool is full
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_job_pool_push_job(
+     libfsapfs_job_pool_t *job_pool,
+     libfsapfs_job_request_t *job_request,
+     intptr_t *job_value,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libfsapfs_job_t *job  = NULL;
+#endif
+	static char *function = "libfsapfs_job_pool_push_job";
+
+	if( job_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( job_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job request.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( job_request->number_of_jobs < 0 )
+	 || ( job_request->number_of_jobs >= LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_JOBS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid job request - number of jobs value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( job_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job value.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: multi-threading not supported.",
+	 function );
+
+	return( -1 );
+#else
+	job = &( job_request->jobs[ job_request->number_of_jobs ] );
+
+	job->request = job_request;
+	job->value   = job_value;
+
+	if( libcthreads_mutex_grab(
+	     job_request->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	job_request->number_of_jobs         += 1;
+	job_request->number_of_pending_jobs += 1;
+
+	if( libcthreads_mutex_release(
+	     job_request->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_push(
+	     job_pool->thread_pool,
+	     (intptr_t *) job,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push job onto thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	/* The job was not queued hence it will never complete
+	 */
+	if( libcthreads_mutex_grab(
+	     job_request->mutex,
+	     NULL ) == 1 )
+	{
+		job_request->number_of_jobs         -= 1;
+		job_request->number_of_pending_jobs -= 1;
+
+		libcthreads_mutex_release(
+		 job_request->mutex,
+		 NULL );
+	}
+	return( -1 );
+#endif /* !defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT ) */
+}
+
+/* Creates a job request
+ * The job function is called with the value of every job of the request
+ * Make sure the value job_request is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_job_request_initialize(
+     libfsapfs_job_request_t **job_request,
+     int (*job_function)(
+            intptr_t *value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_job_request_initialize";
+
+	if( job_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *job_request != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid job request value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( job_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job function.",
+		 function );
+
+		return( -1 );
+	}
+	*job_request = memory_allocate_structure(
+	                libfsapfs_job_request_t );
+
+	if( *job_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create job request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *job_request,
+	     0,
+	     sizeof( libfsapfs_job_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear job request.",
+		 function );
+
+		memory_free(
+		 *job_request );
+
+		*job_request = NULL;
+
+		return( -1 );
+	}
+	( *job_request )->job_function = job_function;
+	( *job_request )->result       = 1;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *job_request )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *job_request )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *job_request != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( ( *job_request )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *job_request )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *job_request );
+
+		*job_request = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a job request
+ * The request must have been waited for if jobs were pushed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_job_request_free(
+     libfsapfs_job_request_t **job_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_job_request_free";
+	int result            = 1;
+
+	if( job_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *job_request != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *job_request )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *job_request )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *job_request );
+
+		*job_request = NULL;
+	}
+	return( result );
+}
+
+/* Waits for the jobs of a job request to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_job_request_wait(
+     libfsapfs_job_request_t *job_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_job_request_wait";
+	int result            = 0;
+
+	if( job_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job request.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     job_request->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( job_request->number_of_pending_jobs > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     job_request->condition,
+		     job_request->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 job_request->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	result = job_request->result;
+
+	if( libcthreads_mutex_release(
+	     job_request->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	result = job_request->result;
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to complete jobs.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,140 @@
+/*
+ * Job pool functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_JOB_POOL_H )
+#define _LIBFSAPFS_JOB_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_job_request libfsapfs_job_request_t;
+
+typedef struct libfsapfs_job libfsapfs_job_t;
+
+struct libfsapfs_job
+{
+	/* The request the job is part of
+	 */
+	libfsapfs_job_request_t *request;
+
+	/* The job value
+	 */
+	intptr_t *value;
+};
+
+struct libfsapfs_job_request
+{
+	/* The job callback function
+	 */
+	int (*job_function)(
+	       intptr_t *value,
+	       libcerror_error_t **error );
+
+	/* The jobs
+	 */
+	libfsapfs_job_t jobs[ LIBFSAPFS_JOB_POOL_MAXIMUM_NUMBER_OF_JOBS ];
+
+	/* The number of jobs
+	 */
+	int number_of_jobs;
+
+	/* The number of jobs that have not been completed
+	 */
+	int number_of_pending_jobs;
+
+	/* The result, which is -1 if one of the jobs failed
+	 */
+	int result;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when all jobs have been completed
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+typedef struct libfsapfs_job_pool libfsapfs_job_pool_t;
+
+struct libfsapfs_job_pool
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+#endif
+};
+
+int libfsapfs_job_pool_initialize(
+     libfsapfs_job_pool_t **job_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libfsapfs_job_pool_free(
+     libfsapfs_job_pool_t **job_pool,
+     libcerror_error_t **error );
+
+int libfsapfs_job_pool_run_job(
+     libfsapfs_job_t *job,
+     void *arguments );
+
+int libfsapfs_job_pool_push_job(
+     libfsapfs_job_pool_t *job_pool,
+     libfsapfs_job_request_t *job_request,
+     intptr_t *job_value,
+     libcerror_error_t **error );
+
+int libfsapfs_job_request_initialize(
+     libfsapfs_job_request_t **job_request,
+     int (*job_function)(
+            intptr_t *value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libfsapfs_job_request_free(
+     libfsapfs_job_request_t **job_request,
+     libcerror_error_t **error );
+
+int libfsapfs_job_request_wait(
+     libfsapfs_job_request_t *job_request,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_JOB_POOL_H ) */
+
@@ -0,0 +1,1563 @@
+/*
+ * B-tree node cache functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_btree_node.h"
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_node_cache.h"
+
+/* The node cache uses a 2Q replacement policy to prevent a single pass over
+ * all the leaf nodes, such as a full file system walk, from evicting the nodes
+ * used by other lookups.
+ *
+ * Leaf nodes that are read for the first time are stored in the recent queue,
+ * which is a FIFO. When a node is evicted from the recent queue only its block
+ * number is retained in the ghost queue. Nodes that are read again while in
+ * the ghost queue are stored in the frequent queue, which is a LRU. Root and
+ * branch nodes are stored in the frequent queue directly and are pinned, they
+ * are only evicted when the frequent queue contains no unpinned nodes.
+ *
+ * The nodes handed out by the node cache are reference counted so that they
+ * remain valid while another thread evicts them. A node that is evicted while
+ * referenced is detached from the node cache and freed when its last
+ * reference is released.
+ */
+
+/* Creates a node cache
+ * Make sure the value node_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_initialize(
+     libfsapfs_node_cache_t **node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_node_cache_initialize";
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid node cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_nodes <= 0 )
+	 || ( maximum_number_of_nodes > ( INT_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*node_cache = memory_allocate_structure(
+	               libfsapfs_node_cache_t );
+
+	if( *node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create node cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *node_cache,
+	     0,
+	     sizeof( libfsapfs_node_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear node cache.",
+		 function );
+
+		memory_free(
+		 *node_cache );
+
+		*node_cache = NULL;
+
+		return( -1 );
+	}
+	if( libfsapfs_node_cache_allocate_entries(
+	     *node_cache,
+	     maximum_number_of_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to allocate entries.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *node_cache )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *node_cache != NULL )
+	{
+		libfsapfs_node_cache_free_entries(
+		 *node_cache,
+		 NULL );
+
+		memory_free(
+		 *node_cache );
+
+		*node_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a node cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_free(
+     libfsapfs_node_cache_t **node_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_node_cache_free";
+	int result            = 1;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node_cache != NULL )
+	{
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *node_cache )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libfsapfs_node_cache_free_entries(
+		     *node_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entries.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *node_cache );
+
+		*node_cache = NULL;
+	}
+	return( result );
+}
+
+/* Allocates the entries and the hash table of a node cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_allocate_entries(
+     libfsapfs_node_cache_t *node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfsapfs_node_cache_allocate_entries";
+	int entry_index             = 0;
+	int hash_bucket_index       = 0;
+	int number_of_entries       = 0;
+	int number_of_ghost_entries = 0;
+	int number_of_hash_buckets  = 0;
+	int queue                   = 0;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( node_cache->entries != NULL )
+	 || ( node_cache->hash_table != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid node cache - entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_nodes <= 0 )
+	 || ( maximum_number_of_nodes > ( INT_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_ghost_entries = maximum_number_of_nodes / 2;
+
+	if( number_of_ghost_entries == 0 )
+	{
+		number_of_ghost_entries = 1;
+	}
+	number_of_entries = maximum_number_of_nodes + number_of_ghost_entries;
+
+	number_of_hash_buckets = 1;
+
+	while( number_of_hash_buckets < number_of_entries )
+	{
+		number_of_hash_buckets <<= 1;
+	}
+	if( ( (size_t) number_of_entries > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsapfs_node_cache_entry_t ) ) )
+	 || ( (size_t) number_of_hash_buckets > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( int ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of entries value exceeds maximum allocation size.",
+		 function );
+
+		return( -1 );
+	}
+	node_cache->entries = (libfsapfs_node_cache_entry_t *) memory_allocate(
+	                                                        sizeof( libfsapfs_node_cache_entry_t ) * number_of_entries );
+
+	if( node_cache->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	node_cache->hash_table = (int *) memory_allocate(
+	                                  sizeof( int ) * number_of_hash_buckets );
+
+	if( node_cache->hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash table.",
+		 function );
+
+		goto on_error;
+	}
+	for( hash_bucket_index = 0;
+	     hash_bucket_index < number_of_hash_buckets;
+	     hash_bucket_index++ )
+	{
+		node_cache->hash_table[ hash_bucket_index ] = -1;
+	}
+	/* All entries start out in the free queue
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		node_cache->entries[ entry_index ].block_number    = 0;
+		node_cache->entries[ entry_index ].node            = NULL;
+		node_cache->entries[ entry_index ].previous_index  = entry_index - 1;
+		node_cache->entries[ entry_index ].next_index      = entry_index + 1;
+		node_cache->entries[ entry_index ].next_hash_index = -1;
+		node_cache->entries[ entry_index ].queue           = LIBFSAPFS_NODE_CACHE_QUEUE_FREE;
+		node_cache->entries[ entry_index ].is_pinned       = 0;
+	}
+	node_cache->entries[ number_of_entries - 1 ].next_index = -1;
+
+	for( queue = 0;
+	     queue < 4;
+	     queue++ )
+	{
+		node_cache->first_index[ queue ]             = -1;
+		node_cache->last_index[ queue ]              = -1;
+		node_cache->number_of_queue_entries[ queue ] = 0;
+	}
+	node_cache->first_index[ LIBFSAPFS_NODE_CACHE_QUEUE_FREE ]             = 0;
+	node_cache->last_index[ LIBFSAPFS_NODE_CACHE_QUEUE_FREE ]              = number_of_entries - 1;
+	node_cache->number_of_queue_entries[ LIBFSAPFS_NODE_CACHE_QUEUE_FREE ] = number_of_entries;
+
+	node_cache->maximum_number_of_nodes         = maximum_number_of_nodes;
+	node_cache->maximum_number_of_recent_nodes  = maximum_number_of_nodes / 4;
+	node_cache->maximum_number_of_ghost_entries = number_of_ghost_entries;
+	node_cache->number_of_entries               = number_of_entries;
+	node_cache->number_of_hash_buckets          = number_of_hash_buckets;
+
+	if( node_cache->maximum_number_of_recent_nodes == 0 )
+	{
+		node_cache->maximum_number_of_recent_nodes = 1;
+	}
+	return( 1 );
+
+on_error:
+	if( node_cache->hash_table != NULL )
+	{
+		memory_free(
+		 node_cache->hash_table );
+
+		node_cache->hash_table = NULL;
+	}
+	if( node_cache->entries != NULL )
+	{
+		memory_free(
+		 node_cache->entries );
+
+		node_cache->entries = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees the entries and the hash table of a node cache including the cached nodes
+ * Nodes that are still referenced are detached instead of freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_free_entries(
+     libfsapfs_node_cache_t *node_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_node_cache_free_entries";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_cache->entries != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < node_cache->number_of_entries;
+		     entry_index++ )
+		{
+			if( node_cache->entries[ entry_index ].node != NULL )
+			{
+				if( libfsapfs_node_cache_detach_node(
+				     &( node_cache->entries[ entry_index ].node ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to detach node: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 node_cache->entries );
+
+		node_cache->entries = NULL;
+	}
+	if( node_cache->hash_table != NULL )
+	{
+		memory_free(
+		 node_cache->hash_table );
+
+		node_cache->hash_table = NULL;
+	}
+	node_cache->number_of_entries      = 0;
+	node_cache->number_of_hash_buckets = 0;
+
+	return( result );
+}
+
+/* Empties a node cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_empty(
+     libfsapfs_node_cache_t *node_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_node_cache_empty";
+	int result            = 1;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsapfs_node_cache_resize(
+	          node_cache,
+	          node_cache->maximum_number_of_nodes,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize node cache.",
+		 function );
+	}
+	return( result );
+}
+
+/* Resizes a node cache
+ * The cached nodes are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_resize(
+     libfsapfs_node_cache_t *node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_node_cache_resize";
+	int result            = 1;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_nodes <= 0 )
+	 || ( maximum_number_of_nodes > ( INT_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     node_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_node_cache_free_entries(
+	     node_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free entries.",
+		 function );
+
+		result = -1;
+	}
+	/* Allocate the entries even if freeing failed so that the node cache remains usable
+	 */
+	if( libfsapfs_node_cache_allocate_entries(
+	     node_cache,
+	     maximum_number_of_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to allocate entries.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     node_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the index of the entry of a specific block number
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libfsapfs_node_cache_get_entry_index(
+     libfsapfs_node_cache_t *node_cache,
+     uint64_t block_number,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_node_cache_get_entry_index";
+	int hash_bucket_index = 0;
+	int safe_entry_index  = 0;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( node_cache->entries == NULL )
+	 || ( node_cache->hash_table == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node cache - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	hash_bucket_index = (int) ( ( block_number ^ ( block_number >> 16 ) ) & (uint64_t) ( node_cache->number_of_hash_buckets - 1 ) );
+
+	safe_entry_index = node_cache->hash_table[ hash_bucket_index ];
+
+	while( safe_entry_index != -1 )
+	{
+		if( node_cache->entries[ safe_entry_index ].block_number == block_number )
+		{
+			*entry_index = safe_entry_index;
+
+			return( 1 );
+		}
+		safe_entry_index = node_cache->entries[ safe_entry_index ].next_hash_index;
+	}
+	return( 0 );
+}
+
+/* Moves an entry to the front of a specific queue
+ * Entries moved out of the free queue are added to the hash table
+ * and entries moved into the free queue are removed from the hash table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_move_entry(
+     libfsapfs_node_cache_t *node_cache,
+     int entry_index,
+     uint8_t queue,
+     libcerror_error_t **error )
+{
+	libfsapfs_node_cache_entry_t *entry = NULL;
+	static char *function               = "libfsapfs_node_cache_move_entry";
+	int hash_bucket_index               = 0;
+	int *hash_entry_index               = NULL;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( node_cache->entries == NULL )
+	 || ( node_cache->hash_table == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node cache - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= node_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( queue > LIBFSAPFS_NODE_CACHE_QUEUE_FREQUENT )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported queue.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( node_cache->entries[ entry_index ] );
+
+	if( entry->previous_index != -1 )
+	{
+		node_cache->entries[ entry->previous_index ].next_index = entry->next_index;
+	}
+	else
+	{
+		node_cache->first_index[ entry->queue ] = entry->next_index;
+	}
+	if( entry->next_index != -1 )
+	{
+		node_cache->entries[ entry->next_index ].previous_index = entry->previous_index;
+	}
+	else
+	{
+		node_cache->last_index[ entry->queue ] = entry->previous_index;
+	}
+	node_cache->number_of_queue_entries[ entry->queue ] -= 1;
+
+	hash_bucket_index = (int) ( ( entry->block_number ^ ( entry->block_number >> 16 ) ) & (uint64_t) ( node_cache->number_of_hash_buckets - 1 ) );
+
+	if( ( entry->queue == LIBFSAPFS_NODE_CACHE_QUEUE_FREE )
+	 && ( queue != LIBFSAPFS_NODE_CACHE_QUEUE_FREE ) )
+	{
+		entry->next_hash_index = node_cache->hash_table[ hash_bucket_index ];
+
+		node_cache->hash_table[ hash_bucket_index ] = entry_index;
+	}
+	else if( ( entry->queue != LIBFSAPFS_NODE_CACHE_QUEUE_FREE )
+	      && ( queue == LIBFSAPFS_NODE_CACHE_QUEUE_FREE ) )
+	{
+		hash_entry_index = &( node_cache->hash_table[ hash_bucket_index ] );
+
+		while( *hash_entry_index != -1 )
+		{
+			if( *hash_entry_index == entry_index )
+			{
+				*hash_entry_index = entry->next_hash_index;
+
+				break;
+			}
+			hash_entry_index = &( node_cache->entries[ *hash_entry_index ].next_hash_index );
+		}
+		entry->next_hash_index = -1;
+	}
+	entry->previous_index = -1;
+	entry->next_index     = node_cache->first_index[ queue ];
+
+	if( entry->next_index != -1 )
+	{
+		node_cache->entries[ entry->next_index ].previous_index = entry_index;
+	}
+	else
+	{
+		node_cache->last_index[ queue ] = entry_index;
+	}
+	node_cache->first_index[ queue ]              = entry_index;
+	node_cache->number_of_queue_entries[ queue ] += 1;
+
+	entry->queue = queue;
+
+	return( 1 );
+}
+
+/* Detaches a node from the node cache
+ * The node is freed if it is not referenced, otherwise it is freed when its last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_detach_node(
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_node_cache_detach_node";
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node == NULL )
+	{
+		return( 1 );
+	}
+	if( ( *node )->number_of_references > 0 )
+	{
+		( *node )->is_evicted = 1;
+
+		*node = NULL;
+	}
+	else if( libfsapfs_btree_node_free(
+	          node,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free node.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Evicts a node from the node cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_evict_node(
+     libfsapfs_node_cache_t *node_cache,
+     libcerror_error_t **error )
+{
+	libfsapfs_node_cache_entry_t *entry = NULL;
+	static char *function               = "libfsapfs_node_cache_evict_node";
+	int entry_index                     = 0;
+	int number_of_frequent_nodes        = 0;
+	int number_of_recent_nodes          = 0;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_cache->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node cache - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_recent_nodes   = node_cache->number_of_queue_entries[ LIBFSAPFS_NODE_CACHE_QUEUE_RECENT ];
+	number_of_frequent_nodes = node_cache->number_of_queue_entries[ LIBFSAPFS_NODE_CACHE_QUEUE_FREQUENT ];
+
+	if( ( number_of_recent_nodes == 0 )
+	 && ( number_of_frequent_nodes == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node cache - missing nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_recent_nodes > 0 )
+	 && ( ( number_of_recent_nodes >= node_cache->maximum_number_of_recent_nodes )
+	  ||  ( number_of_frequent_nodes == 0 ) ) )
+	{
+		/* Evict the oldest node of the recent queue but remember its block number
+		 * in the ghost queue so that a subsequent read promotes it to the frequent queue
+		 */
+		if( node_cache->number_of_queue_entries[ LIBFSAPFS_NODE_CACHE_QUEUE_GHOST ] >= node_cache->maximum_number_of_ghost_entries )
+		{
+			if( libfsapfs_node_cache_move_entry(
+			     node_cache,
+			     node_cache->last_index[ LIBFSAPFS_NODE_CACHE_QUEUE_GHOST ],
+			     LIBFSAPFS_NODE_CACHE_QUEUE_FREE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to free ghost entry.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		entry_index = node_cache->last_index[ LIBFSAPFS_NODE_CACHE_QUEUE_RECENT ];
+		entry       = &( node_cache->entries[ entry_index ] );
+
+		if( libfsapfs_node_cache_detach_node(
+		     &( entry->node ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to detach node.",
+			 function );
+
+			return( -1 );
+		}
+		entry->is_pinned = 0;
+
+		if( libfsapfs_node_cache_move_entry(
+		     node_cache,
+		     entry_index,
+		     LIBFSAPFS_NODE_CACHE_QUEUE_GHOST,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to move entry to ghost queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		/* Evict the least recently used unpinned node of the frequent queue
+		 * or the least recently used node if all the nodes are pinned
+		 */
+		entry_index = node_cache->last_index[ LIBFSAPFS_NODE_CACHE_QUEUE_FREQUENT ];
+
+		while( ( entry_index != -1 )
+		    && ( node_cache->entries[ entry_index ].is_pinned != 0 ) )
+		{
+			entry_index = node_cache->entries[ entry_index ].previous_index;
+		}
+		if( entry_index == -1 )
+		{
+			entry_index = node_cache->last_index[ LIBFSAPFS_NODE_CACHE_QUEUE_FREQUENT ];
+		}
+		entry = &( node_cache->entries[ entry_index ] );
+
+		if( libfsapfs_node_cache_detach_node(
+		     &( entry->node ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to detach node.",
+			 function );
+
+			return( -1 );
+		}
+		entry->is_pinned = 0;
+
+		if( libfsapfs_node_cache_move_entry(
+		     node_cache,
+		     entry_index,
+		     LIBFSAPFS_NODE_CACHE_QUEUE_FREE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to move entry to free queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	node_cache->number_of_evictions += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the node of a specific block number
+ * The node is referenced and must be released with libfsapfs_node_cache_release_node
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsapfs_node_cache_get_node_by_block_number(
+     libfsapfs_node_cache_t *node_cache,
+     uint64_t block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	libfsapfs_node_cache_entry_t *entry = NULL;
+	static char *function               = "libfsapfs_node_cache_get_node_by_block_number";
+	int entry_index                     = 0;
+	int result                          = 0;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     node_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsapfs_node_cache_get_entry_index(
+	          node_cache,
+	          block_number,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		entry = &( node_cache->entries[ entry_index ] );
+
+		if( entry->queue == LIBFSAPFS_NODE_CACHE_QUEUE_GHOST )
+		{
+			result = 0;
+		}
+	}
+	if( result == 0 )
+	{
+		node_cache->number_of_misses += 1;
+	}
+	else
+	{
+		/* The recent queue is a FIFO, only the frequent queue is kept in LRU order
+		 */
+		if( entry->queue == LIBFSAPFS_NODE_CACHE_QUEUE_FREQUENT )
+		{
+			if( libfsapfs_node_cache_move_entry(
+			     node_cache,
+			     entry_index,
+			     LIBFSAPFS_NODE_CACHE_QUEUE_FREQUENT,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to move entry to front of frequent queue.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		node_cache->number_of_hits += 1;
+
+		entry->node->number_of_references += 1;
+
+		*node = entry->node;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     node_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 node_cache->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets the node of a specific block number
+ * The node cache takes over management of the node if successful and the node is
+ * referenced, it must be released with libfsapfs_node_cache_release_node
+ * If another thread has set the node of the block number in the meantime the node
+ * is freed and replaced by the cached node
+ * Root and branch nodes are pinned
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_set_node_by_block_number(
+     libfsapfs_node_cache_t *node_cache,
+     uint64_t block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	libfsapfs_node_cache_entry_t *entry = NULL;
+	static char *function               = "libfsapfs_node_cache_set_node_by_block_number";
+	uint8_t is_pinned                   = 0;
+	uint8_t queue                       = 0;
+	int entry_index                     = 0;
+	int result                          = 0;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( node == NULL )
+	 || ( *node == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( *node )->node_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node - missing node header.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( ( *node )->node_header->flags & 0x0001 ) != 0 )
+	 || ( ( *node )->node_header->level > 0 ) )
+	{
+		is_pinned = 1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     node_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsapfs_node_cache_get_entry_index(
+	          node_cache,
+	          block_number,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index.",
+		 function );
+
+		goto on_error;
+	}
+	queue = LIBFSAPFS_NODE_CACHE_QUEUE_RECENT;
+
+	if( result != 0 )
+	{
+		entry = &( node_cache->entries[ entry_index ] );
+
+		if( entry->queue != LIBFSAPFS_NODE_CACHE_QUEUE_GHOST )
+		{
+			/* Another thread read and set the same node
+			 */
+			if( libfsapfs_btree_node_free(
+			     node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free node.",
+				 function );
+
+				goto on_error;
+			}
+			entry->node->number_of_references += 1;
+
+			*node = entry->node;
+
+			goto on_exit;
+		}
+		/* The node was evicted from the recent queue recently
+		 */
+		if( libfsapfs_node_cache_move_entry(
+		     node_cache,
+		     entry_index,
+		     LIBFSAPFS_NODE_CACHE_QUEUE_FREE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to free ghost entry.",
+			 function );
+
+			goto on_error;
+		}
+		queue = LIBFSAPFS_NODE_CACHE_QUEUE_FREQUENT;
+	}
+	if( is_pinned != 0 )
+	{
+		queue = LIBFSAPFS_NODE_CACHE_QUEUE_FREQUENT;
+	}
+	while( ( node_cache->number_of_queue_entries[ LIBFSAPFS_NODE_CACHE_QUEUE_RECENT ]
+	       + node_cache->number_of_queue_entries[ LIBFSAPFS_NODE_CACHE_QUEUE_FREQUENT ] ) >= node_cache->maximum_number_of_nodes )
+	{
+		if( libfsapfs_node_cache_evict_node(
+		     node_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to evict node.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	entry_index = node_cache->first_index[ LIBFSAPFS_NODE_CACHE_QUEUE_FREE ];
+
+	if( entry_index == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node cache - missing free entry.",
+		 function );
+
+		goto on_error;
+	}
+	entry = &( node_cache->entries[ entry_index ] );
+
+	entry->block_number = block_number;
+
+	if( libfsapfs_node_cache_move_entry(
+	     node_cache,
+	     entry_index,
+	     queue,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to move entry to queue: %" PRIu8 ".",
+		 function,
+		 queue );
+
+		goto on_error;
+	}
+	( *node )->number_of_references = 1;
+	( *node )->is_evicted           = 0;
+
+	entry->node      = *node;
+	entry->is_pinned = is_pinned;
+
+on_exit:
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     node_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 node_cache->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Releases a reference to a node retrieved from the node cache
+ * The node is freed if it was evicted from the node cache and this was its last reference
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_release_node(
+     libfsapfs_node_cache_t *node_cache,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_node_cache_release_node";
+	int result            = 1;
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     node_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( *node )->number_of_references <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid node - number of references value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		( *node )->number_of_references -= 1;
+
+		if( ( ( *node )->number_of_references == 0 )
+		 && ( ( *node )->is_evicted != 0 ) )
+		{
+			if( libfsapfs_btree_node_free(
+			     node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free node.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     node_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*node = NULL;
+
+	return( result );
+}
+
+/* Retrieves the node cache statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_node_cache_get_statistics(
+     libfsapfs_node_cache_t *node_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_node_cache_get_statistics";
+
+	if( node_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_evictions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of evictions.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     node_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_hits      = node_cache->number_of_hits;
+	*number_of_misses    = node_cache->number_of_misses;
+	*number_of_evictions = node_cache->number_of_evictions;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     node_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,212 @@
+/*
+ * B-tree node cache functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_NODE_CACHE_H )
+#define _LIBFSAPFS_NODE_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_btree_node.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_node_cache_entry libfsapfs_node_cache_entry_t;
+
+struct libfsapfs_node_cache_entry
+{
+	/* The block number
+	 */
+	uint64_t block_number;
+
+	/* The node, NULL for a ghost entry
+	 */
+	libfsapfs_btree_node_t *node;
+
+	/* The index of the previous entry in the queue
+	 */
+	int previous_index;
+
+	/* The index of the next entry in the queue
+	 */
+	int next_index;
+
+	/* The index of the next entry in the hash bucket
+	 */
+	int next_hash_index;
+
+	/* The queue
+	 */
+	uint8_t queue;
+
+	/* Value to indicate the node should preferably be kept in the cache
+	 */
+	uint8_t is_pinned;
+};
+
+typedef struct libfsapfs_node_cache libfsapfs_node_cache_t;
+
+struct libfsapfs_node_cache
+{
+	/* The maximum number of cached nodes
+	 */
+	int maximum_number_of_nodes;
+
+	/* The maximum number of nodes in the recent queue
+	 */
+	int maximum_number_of_recent_nodes;
+
+	/* The maximum number of entries in the ghost queue
+	 */
+	int maximum_number_of_ghost_entries;
+
+	/* The entries
+	 */
+	libfsapfs_node_cache_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The hash table
+	 */
+	int *hash_table;
+
+	/* The number of hash table buckets
+	 */
+	int number_of_hash_buckets;
+
+	/* The index of the first free entry
+	 */
+	int free_index;
+
+	/* The index of the first entry of each queue
+	 */
+	int first_index[ 4 ];
+
+	/* The index of the last entry of each queue
+	 */
+	int last_index[ 4 ];
+
+	/* The number of entries of each queue
+	 */
+	int number_of_queue_entries[ 4 ];
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+	/* The number of evicted nodes
+	 */
+	uint64_t number_of_evictions;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libfsapfs_node_cache_initialize(
+     libfsapfs_node_cache_t **node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_free(
+     libfsapfs_node_cache_t **node_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_allocate_entries(
+     libfsapfs_node_cache_t *node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_free_entries(
+     libfsapfs_node_cache_t *node_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_empty(
+     libfsapfs_node_cache_t *node_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_resize(
+     libfsapfs_node_cache_t *node_cache,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_get_entry_index(
+     libfsapfs_node_cache_t *node_cache,
+     uint64_t block_number,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_move_entry(
+     libfsapfs_node_cache_t *node_cache,
+     int entry_index,
+     uint8_t queue,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_detach_node(
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_evict_node(
+     libfsapfs_node_cache_t *node_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_get_node_by_block_number(
+     libfsapfs_node_cache_t *node_cache,
+     uint64_t block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_set_node_by_block_number(
+     libfsapfs_node_cache_t *node_cache,
+     uint64_t block_number,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_release_node(
+     libfsapfs_node_cache_t *node_cache,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
+int libfsapfs_node_cache_get_statistics(
+     libfsapfs_node_cache_t *node_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_NODE_CACHE_H ) */
+
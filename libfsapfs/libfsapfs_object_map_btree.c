@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_block_cache.h"
 #include "libfsapfs_btree_entry.h"
 #include "libfsapfs_btree_node.h"
 #include "libfsapfs_data_block.h"
@@ -32,10 +33,12 @@
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
-#include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
+#include "libfsapfs_node_cache.h"
 #include "libfsapfs_object_map_btree.h"
+#include "libfsapfs_object_map_cache.h"
 #include "libfsapfs_object_map_descriptor.h"
+#include "libfsapfs_object_map_index.h"
 
 #include "fsapfs_object.h"
 #include "fsapfs_object_map.h"
@@ -108,30 +111,53 @@ int libfsapfs_object_map_btree_initialize(
 
 		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &( ( *object_map_btree )->data_block_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DATA_BLOCKS,
+	if( io_handle == NULL )
+	{
+		( *object_map_btree )->maximum_number_of_cached_nodes = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES;
+	}
+	else
+	{
+		if( libfsapfs_io_handle_reserve_cache_entries(
+		     io_handle,
+		     LIBFSAPFS_CACHE_TYPE_BTREE_NODES,
+		     0,
+		     &( ( *object_map_btree )->maximum_number_of_cached_nodes ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to reserve node cache entries.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfsapfs_node_cache_initialize(
+	     &( ( *object_map_btree )->node_cache ),
+	     ( *object_map_btree )->maximum_number_of_cached_nodes,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data block cache.",
+		 "%s: unable to create node cache.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( ( *object_map_btree )->node_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES,
+	if( libfsapfs_object_map_cache_initialize(
+	     &( ( *object_map_btree )->object_map_cache ),
+	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_OBJECT_MAP,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create node cache.",
+		 "%s: unable to create object map cache.",
 		 function );
 
 		goto on_error;
@@ -145,6 +171,25 @@ int libfsapfs_object_map_btree_initialize(
 on_error:
 	if( *object_map_btree != NULL )
 	{
+		if( ( *object_map_btree )->object_map_cache != NULL )
+		{
+			libfsapfs_object_map_cache_free(
+			 &( ( *object_map_btree )->object_map_cache ),
+			 NULL );
+		}
+		if( ( *object_map_btree )->node_cache != NULL )
+		{
+			libfsapfs_node_cache_free(
+			 &( ( *object_map_btree )->node_cache ),
+			 NULL );
+		}
+		if( io_handle != NULL )
+		{
+			libfsapfs_io_handle_release_cache_entries(
+			 io_handle,
+			 ( *object_map_btree )->maximum_number_of_cached_nodes,
+			 NULL );
+		}
 		memory_free(
 		 *object_map_btree );
 
@@ -178,7 +223,7 @@ int libfsapfs_object_map_btree_free(
 	{
 		/* The data_block_vector is referenced and freed elsewhere
 		 */
-		if( libfcache_cache_free(
+		if( libfsapfs_node_cache_free(
 		     &( ( *object_map_btree )->node_cache ),
 		     error ) != 1 )
 		{
@@ -191,19 +236,52 @@ int libfsapfs_object_map_btree_free(
 
 			result = -1;
 		}
-		if( libfcache_cache_free(
-		     &( ( *object_map_btree )->data_block_cache ),
+		if( libfsapfs_object_map_cache_free(
+		     &( ( *object_map_btree )->object_map_cache ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free data block cache.",
+			 "%s: unable to free object map cache.",
 			 function );
 
 			result = -1;
 		}
+		if( ( *object_map_btree )->object_map_index != NULL )
+		{
+			if( libfsapfs_object_map_index_free(
+			     &( ( *object_map_btree )->object_map_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free object map index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *object_map_btree )->io_handle != NULL )
+		{
+			if( libfsapfs_io_handle_release_cache_entries(
+			     ( *object_map_btree )->io_handle,
+			     ( *object_map_btree )->maximum_number_of_cached_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release node cache entries.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *object_map_btree );
 
@@ -212,7 +290,130 @@ int libfsapfs_object_map_btree_free(
 	return( result );
 }
 
+/* Sets the cache limits
+ * The maximum cache size is in bytes, where 0 represents the limit set in the IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_btree_set_cache_limits(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     size64_t maximum_btree_nodes_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_object_map_btree_set_cache_limits";
+
+	if( object_map_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( object_map_btree->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid object map B-tree - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_io_handle_release_cache_entries(
+	     object_map_btree->io_handle,
+	     object_map_btree->maximum_number_of_cached_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release node cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	object_map_btree->maximum_number_of_cached_nodes = 0;
+
+	if( libfsapfs_io_handle_reserve_cache_entries(
+	     object_map_btree->io_handle,
+	     LIBFSAPFS_CACHE_TYPE_BTREE_NODES,
+	     maximum_btree_nodes_cache_size,
+	     &( object_map_btree->maximum_number_of_cached_nodes ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to reserve node cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_node_cache_resize(
+	     object_map_btree->node_cache,
+	     object_map_btree->maximum_number_of_cached_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize node cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the object map cache statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_btree_get_cache_statistics(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_object_map_btree_get_cache_statistics";
+
+	if( object_map_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_object_map_cache_get_statistics(
+	     object_map_btree->object_map_cache,
+	     number_of_hits,
+	     number_of_misses,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve object map cache statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the object map B-tree root node
+ * The node must be released with libfsapfs_object_map_btree_release_node
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_object_map_btree_get_root_node(
@@ -222,14 +423,13 @@ int libfsapfs_object_map_btree_get_root_node(
      libfsapfs_btree_node_t **root_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	libfsapfs_btree_node_t *node         = NULL;
-	libfsapfs_data_block_t *data_block   = NULL;
-	static char *function                = "libfsapfs_object_map_btree_get_root_node";
-	int result                           = 0;
+	libfsapfs_btree_node_t *node       = NULL;
+	libfsapfs_data_block_t *data_block = NULL;
+	static char *function              = "libfsapfs_object_map_btree_get_root_node";
+	int result                         = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp   = 0;
 #endif
 
 	if( object_map_btree == NULL )
@@ -243,6 +443,17 @@ int libfsapfs_object_map_btree_get_root_node(
 
 		return( -1 );
 	}
+	if( object_map_btree->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid object map B-tree - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( root_node_block_number > (uint64_t) INT_MAX )
 	{
 		libcerror_error_set(
@@ -285,12 +496,10 @@ int libfsapfs_object_map_btree_get_root_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	result = libfcache_cache_get_value_by_identifier(
+	result = libfsapfs_node_cache_get_node_by_block_number(
 	          object_map_btree->node_cache,
-	          0,
-	          (off64_t) root_node_block_number,
-	          0,
-	          &cache_value,
+	          root_node_block_number,
+	          root_node,
 	          error );
 
 	if( result == -1 )
@@ -306,13 +515,26 @@ int libfsapfs_object_map_btree_get_root_node(
 	}
 	else if( result == 0 )
 	{
-		if( libfdata_vector_get_element_value_by_index(
+		if( libfsapfs_btree_node_initialize(
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create B-tree node.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_block_cache_get_element_value_by_index(
+		     object_map_btree->io_handle->block_cache,
 		     object_map_btree->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) object_map_btree->data_block_cache,
+		     file_io_handle,
 		     (int) root_node_block_number,
+		     root_node_block_number,
 		     (intptr_t **) &data_block,
-		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -335,34 +557,40 @@ int libfsapfs_object_map_btree_get_root_node(
 			 function,
 			 root_node_block_number );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_initialize(
-		     &node,
-		     error ) != 1 )
+		else if( libfsapfs_btree_node_read_data(
+		          node,
+		          data_block->data,
+		          data_block->data_size,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree node.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read B-tree node.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_read_data(
-		     node,
-		     data_block->data,
-		     data_block->data_size,
+		if( libfsapfs_block_cache_release_element_value_by_block_number(
+		     object_map_btree->io_handle->block_cache,
+		     root_node_block_number,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read B-tree node.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release data block: %" PRIu64 ".",
+			 function,
+			 root_node_block_number );
 
+			result = -1;
+		}
+		if( result == -1 )
+		{
 			goto on_error;
 		}
 		if( node->object_type != 0x40000002UL )
@@ -435,44 +663,23 @@ int libfsapfs_object_map_btree_get_root_node(
 
 			goto on_error;
 		}
-		if( libfcache_cache_set_value_by_identifier(
+		if( libfsapfs_node_cache_set_node_by_block_number(
 		     object_map_btree->node_cache,
-		     0,
-		     (off64_t) root_node_block_number,
-		     0,
-		     (intptr_t *) node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     root_node_block_number,
+		     &node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value in cache.",
-			 function );
-
-			goto on_error;
-		}
-		node = NULL;
-
-		if( libfcache_cache_get_value_by_identifier(
-		     object_map_btree->node_cache,
-		     0,
-		     (off64_t) root_node_block_number,
-		     0,
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
+		*root_node = node;
+		node       = NULL;
 	}
 #if defined( HAVE_PROFILER )
 	if( object_map_btree->io_handle->profiler != NULL )
@@ -497,20 +704,6 @@ int libfsapfs_object_map_btree_get_root_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     (intptr_t **) root_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve root node.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -524,6 +717,7 @@ on_error:
 }
 
 /* Retrieves a object map B-tree sub node
+ * The node must be released with libfsapfs_object_map_btree_release_node
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_object_map_btree_get_sub_node(
@@ -533,14 +727,13 @@ int libfsapfs_object_map_btree_get_sub_node(
      libfsapfs_btree_node_t **sub_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	libfsapfs_btree_node_t *node         = NULL;
-	libfsapfs_data_block_t *data_block   = NULL;
-	static char *function                = "libfsapfs_object_map_btree_get_sub_node";
-	int result                           = 0;
+	libfsapfs_btree_node_t *node       = NULL;
+	libfsapfs_data_block_t *data_block = NULL;
+	static char *function              = "libfsapfs_object_map_btree_get_sub_node";
+	int result                         = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp   = 0;
 #endif
 
 	if( object_map_btree == NULL )
@@ -554,6 +747,17 @@ int libfsapfs_object_map_btree_get_sub_node(
 
 		return( -1 );
 	}
+	if( object_map_btree->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid object map B-tree - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( sub_node_block_number > (uint64_t) INT_MAX )
 	{
 		libcerror_error_set(
@@ -596,12 +800,10 @@ int libfsapfs_object_map_btree_get_sub_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	result = libfcache_cache_get_value_by_identifier(
+	result = libfsapfs_node_cache_get_node_by_block_number(
 	          object_map_btree->node_cache,
-	          0,
-	          (off64_t) sub_node_block_number,
-	          0,
-	          &cache_value,
+	          sub_node_block_number,
+	          sub_node,
 	          error );
 
 	if( result == -1 )
@@ -617,13 +819,26 @@ int libfsapfs_object_map_btree_get_sub_node(
 	}
 	else if( result == 0 )
 	{
-		if( libfdata_vector_get_element_value_by_index(
+		if( libfsapfs_btree_node_initialize(
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create B-tree node.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_block_cache_get_element_value_by_index(
+		     object_map_btree->io_handle->block_cache,
 		     object_map_btree->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) object_map_btree->data_block_cache,
+		     file_io_handle,
 		     (int) sub_node_block_number,
+		     sub_node_block_number,
 		     (intptr_t **) &data_block,
-		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -646,34 +861,40 @@ int libfsapfs_object_map_btree_get_sub_node(
 			 function,
 			 sub_node_block_number );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_initialize(
-		     &node,
-		     error ) != 1 )
+		else if( libfsapfs_btree_node_read_data(
+		          node,
+		          data_block->data,
+		          data_block->data_size,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree node.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read B-tree node.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_read_data(
-		     node,
-		     data_block->data,
-		     data_block->data_size,
+		if( libfsapfs_block_cache_release_element_value_by_block_number(
+		     object_map_btree->io_handle->block_cache,
+		     sub_node_block_number,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read B-tree node.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release data block: %" PRIu64 ".",
+			 function,
+			 sub_node_block_number );
 
+			result = -1;
+		}
+		if( result == -1 )
+		{
 			goto on_error;
 		}
 		if( node->object_type != 0x40000003UL )
@@ -713,44 +934,23 @@ int libfsapfs_object_map_btree_get_sub_node(
 
 			goto on_error;
 		}
-		if( libfcache_cache_set_value_by_identifier(
+		if( libfsapfs_node_cache_set_node_by_block_number(
 		     object_map_btree->node_cache,
-		     0,
-		     (off64_t) sub_node_block_number,
-		     0,
-		     (intptr_t *) node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     sub_node_block_number,
+		     &node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value in cache.",
-			 function );
-
-			goto on_error;
-		}
-		node = NULL;
-
-		if( libfcache_cache_get_value_by_identifier(
-		     object_map_btree->node_cache,
-		     0,
-		     (off64_t) sub_node_block_number,
-		     0,
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
+		*sub_node = node;
+		node       = NULL;
 	}
 #if defined( HAVE_PROFILER )
 	if( object_map_btree->io_handle->profiler != NULL )
@@ -775,20 +975,6 @@ int libfsapfs_object_map_btree_get_sub_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     (intptr_t **) sub_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve sub node.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -801,7 +987,61 @@ on_error:
 	return( -1 );
 }
 
+/* Releases a node retrieved from the object map B-tree
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_btree_release_node(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_object_map_btree_release_node";
+
+	if( object_map_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node == NULL )
+	{
+		return( 1 );
+	}
+	if( libfsapfs_node_cache_release_node(
+	     object_map_btree->node_cache,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release node in cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves an entry for a specific identifier from the object map B-tree node
+ * The node entries are sorted by object identifier, hence a binary search is used
  * Returns 1 if successful, 0 if not found or -1 on error
  */
 int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
@@ -811,13 +1051,16 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
      libfsapfs_btree_entry_t **btree_entry,
      libcerror_error_t **error )
 {
-	libfsapfs_btree_entry_t *entry          = NULL;
-	libfsapfs_btree_entry_t *previous_entry = NULL;
-	static char *function                   = "libfsapfs_object_map_btree_get_entry_from_node_by_identifier";
-	uint64_t object_map_identifier          = 0;
-	int btree_entry_index                   = 0;
-	int is_leaf_node                        = 0;
-	int number_of_entries                   = 0;
+	libfsapfs_btree_entry_t *entry       = NULL;
+	libfsapfs_btree_entry_t *upper_entry = NULL;
+	static char *function                = "libfsapfs_object_map_btree_get_entry_from_node_by_identifier";
+	uint64_t object_map_identifier       = 0;
+	uint8_t upper_entry_is_match         = 0;
+	int btree_entry_index                = 0;
+	int is_leaf_node                     = 0;
+	int lower_entry_index                = 0;
+	int number_of_entries                = 0;
+	int upper_entry_index                = 0;
 
 	if( object_map_btree == NULL )
 	{
@@ -830,6 +1073,17 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
 
 		return( -1 );
 	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
 	if( btree_entry == NULL )
 	{
 		libcerror_error_set(
@@ -879,10 +1133,15 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
 
 		return( -1 );
 	}
-	for( btree_entry_index = 0;
-	     btree_entry_index < number_of_entries;
-	     btree_entry_index++ )
+	/* Search for the first entry with a key equal to or greater than the lookup key
+	 */
+	lower_entry_index = 0;
+	upper_entry_index = number_of_entries;
+
+	while( lower_entry_index < upper_entry_index )
 	{
+		btree_entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
 		if( libfsapfs_btree_node_get_entry_by_index(
 		     node,
 		     btree_entry_index,
@@ -893,8 +1152,9 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from B-tree node.",
-			 function );
+			 "%s: unable to retrieve B-tree entry: %d.",
+			 function,
+			 btree_entry_index );
 
 			return( -1 );
 		}
@@ -910,7 +1170,8 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
 
 			return( -1 );
 		}
-		if( entry->key_data == NULL )
+		if( ( entry->key_data == NULL )
+		 || ( entry->key_data_size < 8 ) )
 		{
 			libcerror_error_set(
 			 error,
@@ -936,45 +1197,58 @@ int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
 			 object_map_identifier );
 		}
 #endif
-		if( object_map_identifier > object_identifier )
+		if( object_map_identifier < object_identifier )
 		{
-			break;
-		}
-		if( is_leaf_node != 0 )
-		{
-			if( object_map_identifier == object_identifier )
-			{
-				*btree_entry = entry;
-
-				return( 1 );
-			}
+			lower_entry_index = btree_entry_index + 1;
 		}
 		else
 		{
-			if( object_map_identifier >= object_identifier )
-			{
-				if( ( previous_entry == NULL )
-				 || ( object_map_identifier == object_identifier ) )
-				{
-					previous_entry = entry;
-				}
-				*btree_entry = previous_entry;
-
-				return( 1 );
-			}
-			previous_entry = entry;
+			upper_entry_index    = btree_entry_index;
+			upper_entry          = entry;
+			upper_entry_is_match = (uint8_t) ( object_map_identifier == object_identifier );
 		}
 	}
-	if( is_leaf_node == 0 )
+	if( ( lower_entry_index < number_of_entries )
+	 && ( upper_entry_is_match != 0 ) )
 	{
-		*btree_entry = previous_entry;
+		*btree_entry = upper_entry;
 
 		return( 1 );
 	}
-	return( 0 );
+	if( is_leaf_node != 0 )
+	{
+		return( 0 );
+	}
+	/* In a branch node the sub node that can contain the key is referenced
+	 * by the last entry with a key less than the lookup key
+	 */
+	if( lower_entry_index == 0 )
+	{
+		*btree_entry = NULL;
+
+		return( 1 );
+	}
+	if( libfsapfs_btree_node_get_entry_by_index(
+	     node,
+	     lower_entry_index - 1,
+	     btree_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree entry: %d.",
+		 function,
+		 lower_entry_index - 1 );
+
+		return( -1 );
+	}
+	return( 1 );
 }
 
 /* Retrieves an entry for a specific identifier from the object map B-tree
+ * The B-tree node is referenced and must be released with libfsapfs_object_map_btree_release_node
  * Returns 1 if successful, 0 if not found or -1 on error
  */
 int libfsapfs_object_map_btree_get_entry_by_identifier(
@@ -1054,7 +1328,7 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
 			 "%s: invalid recursion depth value out of bounds.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		is_leaf_node = libfsapfs_btree_node_is_leaf_node(
 		                node,
@@ -1069,7 +1343,7 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
 			 "%s: unable to determine if B-tree node is a leaf node.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		result = libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
 		          object_map_btree,
@@ -1087,7 +1361,7 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
 			 "%s: unable to retrieve entry from B-tree node.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		else if( result == 0 )
 		{
@@ -1109,7 +1383,7 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
 			 "%s: invalid B-tree entry.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		if( entry->value_data == NULL )
 		{
@@ -1120,7 +1394,7 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
 			 "%s: invalid B-tree entry - missing value data.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		if( entry->value_data_size != 8 )
 		{
@@ -1131,7 +1405,7 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
 			 "%s: invalid B-tree entry - unsupported value data size.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		byte_stream_copy_to_uint64_little_endian(
 		 entry->value_data,
@@ -1146,8 +1420,20 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
 			 sub_node_block_number );
 		}
 #endif
-		node = NULL;
+		if( libfsapfs_object_map_btree_release_node(
+		     object_map_btree,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
 
+			goto on_error;
+		}
 		if( libfsapfs_object_map_btree_get_sub_node(
 		     object_map_btree,
 		     file_io_handle,
@@ -1163,13 +1449,37 @@ int libfsapfs_object_map_btree_get_entry_by_identifier(
 			 function,
 			 sub_node_block_number );
 
-			return( -1 );
+			goto on_error;
 		}
 		recursion_depth++;
 	}
 	while( is_leaf_node == 0 );
 
+	if( libfsapfs_object_map_btree_release_node(
+	     object_map_btree,
+	     &node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
+
+		goto on_error;
+	}
 	return( 0 );
+
+on_error:
+	if( node != NULL )
+	{
+		libfsapfs_object_map_btree_release_node(
+		 object_map_btree,
+		 &node,
+		 NULL );
+	}
+	return( -1 );
 }
 
 /* Retrieves the object map descriptor of a specific object identifier
@@ -1182,10 +1492,11 @@ int libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
      libfsapfs_object_map_descriptor_t **descriptor,
      libcerror_error_t **error )
 {
-	libfsapfs_btree_entry_t *entry = NULL;
-	libfsapfs_btree_node_t *node   = NULL;
-	static char *function          = "libfsapfs_object_map_btree_get_descriptor_by_object_identifier";
-	int result                     = 0;
+	libfsapfs_btree_entry_t *entry                        = NULL;
+	libfsapfs_btree_node_t *node                          = NULL;
+	libfsapfs_object_map_descriptor_t *indexed_descriptor = NULL;
+	static char *function                                 = "libfsapfs_object_map_btree_get_descriptor_by_object_identifier";
+	int result                                            = 0;
 
 	if( object_map_btree == NULL )
 	{
@@ -1220,6 +1531,57 @@ int libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
 
 		return( -1 );
 	}
+	if( object_map_btree->object_map_index != NULL )
+	{
+		result = libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+		          object_map_btree->object_map_index,
+		          object_identifier,
+		          &indexed_descriptor,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve descriptor from object map index.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libfsapfs_object_map_descriptor_initialize(
+			     descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create object map descriptor.",
+				 function );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     *descriptor,
+			     indexed_descriptor,
+			     sizeof( libfsapfs_object_map_descriptor_t ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy object map descriptor.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		return( result );
+	}
 	result = libfsapfs_object_map_btree_get_entry_by_identifier(
 	          object_map_btree,
 	          file_io_handle,
@@ -1306,11 +1668,31 @@ int libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
 
 			goto on_error;
 		}
-		node = NULL;
+		if( libfsapfs_object_map_btree_release_node(
+		     object_map_btree,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	return( result );
 
 on_error:
+	if( node != NULL )
+	{
+		libfsapfs_object_map_btree_release_node(
+		 object_map_btree,
+		 &node,
+		 NULL );
+	}
 	if( *descriptor != NULL )
 	{
 		libfsapfs_object_map_descriptor_free(
@@ -1320,3 +1702,658 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the physical address and flags of a specific object identifier
+ * If the object map was preloaded only the object map index is searched,
+ * otherwise the object map cache is consulted before the object map B-tree is searched
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libfsapfs_object_map_btree_get_physical_address_by_object_identifier(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libbfio_handle_t *file_io_handle,
+     uint64_t object_identifier,
+     uint64_t *physical_address,
+     uint32_t *flags,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *entry                        = NULL;
+	libfsapfs_btree_node_t *node                          = NULL;
+	libfsapfs_object_map_descriptor_t *indexed_descriptor = NULL;
+	static char *function                                 = "libfsapfs_object_map_btree_get_physical_address_by_object_identifier";
+	uint64_t safe_physical_address                        = 0;
+	uint32_t safe_flags                                   = 0;
+	int result                                            = 0;
+
+	if( object_map_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_address == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical address.",
+		 function );
+
+		return( -1 );
+	}
+	if( flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( object_identifier == 0 )
+	{
+		return( 0 );
+	}
+	if( object_map_btree->object_map_index != NULL )
+	{
+		result = libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+		          object_map_btree->object_map_index,
+		          object_identifier,
+		          &indexed_descriptor,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve descriptor of object identifier: %" PRIu64 " from object map index.",
+			 function,
+			 object_identifier );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*physical_address = indexed_descriptor->physical_address;
+			*flags            = indexed_descriptor->flags;
+		}
+		return( result );
+	}
+	result = libfsapfs_object_map_cache_get_physical_address_by_object_identifier(
+	          object_map_btree->object_map_cache,
+	          object_identifier,
+	          physical_address,
+	          flags,
+	          error );
+
+	if( result != 0 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve physical address of object identifier: %" PRIu64 " from object map cache.",
+			 function,
+			 object_identifier );
+		}
+		return( result );
+	}
+	result = libfsapfs_object_map_btree_get_entry_by_identifier(
+	          object_map_btree,
+	          file_io_handle,
+	          object_identifier,
+	          &node,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry from B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( entry->value_data == NULL )
+		 || ( entry->value_data_size < sizeof( fsapfs_object_map_btree_value_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid B-tree entry - value data size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fsapfs_object_map_btree_value_t *) entry->value_data )->object_flags,
+		 safe_flags );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fsapfs_object_map_btree_value_t *) entry->value_data )->object_physical_address,
+		 safe_physical_address );
+
+		if( libfsapfs_object_map_cache_set_physical_address_by_object_identifier(
+		     object_map_btree->object_map_cache,
+		     object_identifier,
+		     safe_physical_address,
+		     safe_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set physical address of object identifier: %" PRIu64 " in object map cache.",
+			 function,
+			 object_identifier );
+
+			goto on_error;
+		}
+		if( libfsapfs_object_map_btree_release_node(
+		     object_map_btree,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
+
+			goto on_error;
+		}
+		*physical_address = safe_physical_address;
+		*flags            = safe_flags;
+	}
+	return( result );
+
+on_error:
+	if( node != NULL )
+	{
+		libfsapfs_object_map_btree_release_node(
+		 object_map_btree,
+		 &node,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the object map index
+ * This reads all the descriptors of the object map B-tree into memory,
+ * after which the B-tree nodes are no longer needed for lookups
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_btree_read_index(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_node_t *root_node              = NULL;
+	libfsapfs_object_map_index_t *object_map_index = NULL;
+	static char *function                          = "libfsapfs_object_map_btree_read_index";
+	uint64_t total_number_of_keys                  = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	size64_t object_map_index_size                 = 0;
+#endif
+
+	if( object_map_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( object_map_btree->object_map_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid object map B-tree - object map index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_object_map_btree_get_root_node(
+	     object_map_btree,
+	     file_io_handle,
+	     object_map_btree->root_node_block_number,
+	     &root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( root_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( root_node->footer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree root node - missing footer.",
+		 function );
+
+		goto on_error;
+	}
+	/* The total number of keys in the footer of the root node is used to size
+	 * the index so that it is allocated once
+	 */
+	total_number_of_keys = root_node->footer->total_number_of_keys;
+
+	if( ( total_number_of_keys == 0 )
+	 || ( total_number_of_keys > (uint64_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid total number of keys value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_object_map_btree_release_node(
+	     object_map_btree,
+	     &root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_object_map_index_initialize(
+	     &object_map_index,
+	     (int) total_number_of_keys,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create object map index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_object_map_btree_read_index_from_node(
+	     object_map_btree,
+	     file_io_handle,
+	     object_map_index,
+	     object_map_btree->root_node_block_number,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read object map index.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( libfsapfs_object_map_index_get_size(
+		     object_map_index,
+		     &object_map_index_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve object map index size.",
+			 function );
+
+			goto on_error;
+		}
+		libcnotify_printf(
+		 "%s: object map index contains: %d descriptors in: %" PRIu64 " bytes.\n",
+		 function,
+		 object_map_index->number_of_descriptors,
+		 object_map_index_size );
+	}
+#endif
+	object_map_btree->object_map_index = object_map_index;
+
+	return( 1 );
+
+on_error:
+	if( root_node != NULL )
+	{
+		libfsapfs_object_map_btree_release_node(
+		 object_map_btree,
+		 &root_node,
+		 NULL );
+	}
+	if( object_map_index != NULL )
+	{
+		libfsapfs_object_map_index_free(
+		 &object_map_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the object map index from a B-tree node
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_btree_read_index_from_node(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_object_map_index_t *object_map_index,
+     uint64_t node_block_number,
+     int recursion_depth,
+     libcerror_error_t **error )
+{
+	libfsapfs_btree_entry_t *entry = NULL;
+	libfsapfs_btree_node_t *node   = NULL;
+	static char *function          = "libfsapfs_object_map_btree_read_index_from_node";
+	uint64_t sub_node_block_number = 0;
+	int entry_index                = 0;
+	int is_leaf_node               = 0;
+	int number_of_entries          = 0;
+	int result                     = 0;
+
+	if( object_map_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( recursion_depth < 0 )
+	 || ( recursion_depth > LIBFSAPFS_MAXIMUM_BTREE_NODE_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid recursion depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( recursion_depth == 0 )
+	{
+		result = libfsapfs_object_map_btree_get_root_node(
+		          object_map_btree,
+		          file_io_handle,
+		          node_block_number,
+		          &node,
+		          error );
+	}
+	else
+	{
+		result = libfsapfs_object_map_btree_get_sub_node(
+		          object_map_btree,
+		          file_io_handle,
+		          node_block_number,
+		          &node,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree node from block: %" PRIu64 ".",
+		 function,
+		 node_block_number );
+
+		goto on_error;
+	}
+	/* The node is referenced and hence remains valid while its sub nodes are read
+	 */
+	is_leaf_node = libfsapfs_btree_node_is_leaf_node(
+	                node,
+	                error );
+
+	if( is_leaf_node == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if B-tree node is a leaf node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_btree_node_get_number_of_entries(
+	     node,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from B-tree node.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libfsapfs_btree_node_get_entry_by_index(
+		     node,
+		     entry_index,
+		     &entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( is_leaf_node != 0 )
+		{
+			if( libfsapfs_object_map_index_append_entry(
+			     object_map_index,
+			     entry->key_data,
+			     (size_t) entry->key_data_size,
+			     entry->value_data,
+			     (size_t) entry->value_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append B-tree entry: %d to object map index.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( ( entry->value_data == NULL )
+			 || ( entry->value_data_size != 8 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: invalid B-tree entry: %d - unsupported value data size.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint64_little_endian(
+			 entry->value_data,
+			 sub_node_block_number );
+
+			if( libfsapfs_object_map_btree_read_index_from_node(
+			     object_map_btree,
+			     file_io_handle,
+			     object_map_index,
+			     sub_node_block_number,
+			     recursion_depth + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read object map index from B-tree sub node in block: %" PRIu64 ".",
+				 function,
+				 sub_node_block_number );
+
+				goto on_error;
+			}
+		}
+	}
+	if( libfsapfs_object_map_btree_release_node(
+	     object_map_btree,
+	     &node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( node != NULL )
+	{
+		libfsapfs_object_map_btree_release_node(
+		 object_map_btree,
+		 &node,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the size of the memory used by the object map index
+ * Returns 1 if successful, 0 if the object map index was not read or -1 on error
+ */
+int libfsapfs_object_map_btree_get_index_size(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_object_map_btree_get_index_size";
+
+	if( object_map_btree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map B-tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( object_map_btree->object_map_index == NULL )
+	{
+		return( 0 );
+	}
+	if( libfsapfs_object_map_index_get_size(
+	     object_map_btree->object_map_index,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve object map index size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
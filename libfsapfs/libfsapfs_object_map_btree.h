@@ -30,9 +30,11 @@
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
-#include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
+#include "libfsapfs_node_cache.h"
+#include "libfsapfs_object_map_cache.h"
 #include "libfsapfs_object_map_descriptor.h"
+#include "libfsapfs_object_map_index.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -50,13 +52,21 @@ struct libfsapfs_object_map_btree
 	 */
 	libfdata_vector_t *data_block_vector;
 
-	/* Data block cache
+	/* The node cache
 	 */
-	libfcache_cache_t *data_block_cache;
+	libfsapfs_node_cache_t *node_cache;
 
-	/* The node cache
+	/* The maximum number of cached nodes
+	 */
+	int maximum_number_of_cached_nodes;
+
+	/* The object map cache
 	 */
-	libfcache_cache_t *node_cache;
+	libfsapfs_object_map_cache_t *object_map_cache;
+
+	/* The object map index, which is only set when the object map was preloaded
+	 */
+	libfsapfs_object_map_index_t *object_map_index;
 
 	/* Block number of B-tree root node
 	 */
@@ -74,6 +84,17 @@ int libfsapfs_object_map_btree_free(
      libfsapfs_object_map_btree_t **object_map_btree,
      libcerror_error_t **error );
 
+int libfsapfs_object_map_btree_set_cache_limits(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     size64_t maximum_btree_nodes_cache_size,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_btree_get_cache_statistics(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
 int libfsapfs_object_map_btree_get_root_node(
      libfsapfs_object_map_btree_t *object_map_btree,
      libbfio_handle_t *file_io_handle,
@@ -88,6 +109,11 @@ int libfsapfs_object_map_btree_get_sub_node(
      libfsapfs_btree_node_t **sub_node,
      libcerror_error_t **error );
 
+int libfsapfs_object_map_btree_release_node(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
 int libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
      libfsapfs_object_map_btree_t *object_map_btree,
      libfsapfs_btree_node_t *node,
@@ -110,6 +136,32 @@ int libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
      libfsapfs_object_map_descriptor_t **descriptor,
      libcerror_error_t **error );
 
+int libfsapfs_object_map_btree_get_physical_address_by_object_identifier(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libbfio_handle_t *file_io_handle,
+     uint64_t object_identifier,
+     uint64_t *physical_address,
+     uint32_t *flags,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_btree_read_index(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_btree_read_index_from_node(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     libbfio_handle_t *file_io_handle,
+     libfsapfs_object_map_index_t *object_map_index,
+     uint64_t node_block_number,
+     int recursion_depth,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_btree_get_index_size(
+     libfsapfs_object_map_btree_t *object_map_btree,
+     size64_t *size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,726 @@
+/*
+ * Object map cache functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_definitions.h"
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+#include "libfsapfs_object_map_cache.h"
+
+/* The object map cache maps object identifiers to the physical address and
+ * flags of the corresponding object map descriptor, so that following a
+ * virtual object identifier does not require a walk of the object map B-tree.
+ * The cache is a set associative hash table that is distributed over a number
+ * of shards, where every shard has its own lock. Within a set the entries are
+ * replaced round-robin.
+ */
+
+/* Creates an object map cache
+ * Make sure the value object_map_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_cache_initialize(
+     libfsapfs_object_map_cache_t **object_map_cache,
+     int maximum_number_of_cache_entries,
+     libcerror_error_t **error )
+{
+	libfsapfs_object_map_cache_shard_t *shard = NULL;
+	static char *function                     = "libfsapfs_object_map_cache_initialize";
+	size_t entries_size                       = 0;
+	size_t shards_size                        = 0;
+	int number_of_sets                        = 1;
+	int shard_index                           = 0;
+
+	if( object_map_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *object_map_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid object map cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of cache entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	/* The number of sets per shard is a power of 2
+	 */
+	while( ( number_of_sets * 2 ) <= ( maximum_number_of_cache_entries / ( LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_SHARDS * LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_WAYS ) ) )
+	{
+		number_of_sets *= 2;
+	}
+	*object_map_cache = memory_allocate_structure(
+	                     libfsapfs_object_map_cache_t );
+
+	if( *object_map_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create object map cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *object_map_cache,
+	     0,
+	     sizeof( libfsapfs_object_map_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear object map cache.",
+		 function );
+
+		memory_free(
+		 *object_map_cache );
+
+		*object_map_cache = NULL;
+
+		return( -1 );
+	}
+	shards_size = sizeof( libfsapfs_object_map_cache_shard_t ) * LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_SHARDS;
+
+	( *object_map_cache )->shards = (libfsapfs_object_map_cache_shard_t *) memory_allocate(
+	                                                                        shards_size );
+
+	if( ( *object_map_cache )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *object_map_cache )->shards,
+	     0,
+	     shards_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		memory_free(
+		 ( *object_map_cache )->shards );
+
+		( *object_map_cache )->shards = NULL;
+
+		goto on_error;
+	}
+	entries_size = sizeof( libfsapfs_object_map_cache_entry_t ) * number_of_sets * LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_WAYS;
+
+	for( shard_index = 0;
+	     shard_index < LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		shard = &( ( *object_map_cache )->shards[ shard_index ] );
+
+		shard->entries = (libfsapfs_object_map_cache_entry_t *) memory_allocate(
+		                                                         entries_size );
+
+		if( shard->entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d entries.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     shard->entries,
+		     0,
+		     entries_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear shard: %d entries.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->replacement_ways = (uint8_t *) memory_allocate(
+		                                       sizeof( uint8_t ) * number_of_sets );
+
+		if( shard->replacement_ways == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d replacement ways.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     shard->replacement_ways,
+		     0,
+		     sizeof( uint8_t ) * number_of_sets ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear shard: %d replacement ways.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_initialize(
+		     &( shard->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize shard: %d read/write lock.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+		( *object_map_cache )->number_of_shards += 1;
+	}
+	( *object_map_cache )->number_of_sets = number_of_sets;
+
+	return( 1 );
+
+on_error:
+	if( *object_map_cache != NULL )
+	{
+		libfsapfs_object_map_cache_free(
+		 object_map_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees an object map cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_cache_free(
+     libfsapfs_object_map_cache_t **object_map_cache,
+     libcerror_error_t **error )
+{
+	libfsapfs_object_map_cache_shard_t *shard = NULL;
+	static char *function                     = "libfsapfs_object_map_cache_free";
+	int result                                = 1;
+	int shard_index                           = 0;
+
+	if( object_map_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *object_map_cache != NULL )
+	{
+		if( ( *object_map_cache )->shards != NULL )
+		{
+			/* The shards are cleared on initialization so that
+			 * partially initialized shards are freed as well
+			 */
+			for( shard_index = 0;
+			     shard_index < LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_SHARDS;
+			     shard_index++ )
+			{
+				shard = &( ( *object_map_cache )->shards[ shard_index ] );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+				if( shard->read_write_lock != NULL )
+				{
+					if( libcthreads_read_write_lock_free(
+					     &( shard->read_write_lock ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d read/write lock.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+#endif
+				if( shard->replacement_ways != NULL )
+				{
+					memory_free(
+					 shard->replacement_ways );
+				}
+				if( shard->entries != NULL )
+				{
+					memory_free(
+					 shard->entries );
+				}
+			}
+			memory_free(
+			 ( *object_map_cache )->shards );
+		}
+		memory_free(
+		 *object_map_cache );
+
+		*object_map_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the shard and set of a specific object identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_cache_get_set_by_object_identifier(
+     libfsapfs_object_map_cache_t *object_map_cache,
+     uint64_t object_identifier,
+     libfsapfs_object_map_cache_shard_t **shard,
+     int *set_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_object_map_cache_get_set_by_object_identifier";
+	uint64_t hash         = 0;
+
+	if( object_map_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( object_map_cache->number_of_shards <= 0 )
+	 || ( object_map_cache->number_of_sets <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid object map cache - number of shards or sets value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( object_identifier == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported object identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid set index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Object identifiers are mostly allocated sequentially, hence they are
+	 * scrambled with a multiplicative hash to spread them over the shards
+	 */
+	hash  = object_identifier * 0x9e3779b97f4a7c15UL;
+	hash ^= hash >> 32;
+
+	*shard     = &( object_map_cache->shards[ hash % object_map_cache->number_of_shards ] );
+	*set_index = (int) ( ( hash / object_map_cache->number_of_shards ) & ( object_map_cache->number_of_sets - 1 ) );
+
+	return( 1 );
+}
+
+/* Retrieves the physical address and flags of a specific object identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfsapfs_object_map_cache_get_physical_address_by_object_identifier(
+     libfsapfs_object_map_cache_t *object_map_cache,
+     uint64_t object_identifier,
+     uint64_t *physical_address,
+     uint32_t *flags,
+     libcerror_error_t **error )
+{
+	libfsapfs_object_map_cache_entry_t *entry = NULL;
+	libfsapfs_object_map_cache_shard_t *shard = NULL;
+	static char *function                     = "libfsapfs_object_map_cache_get_physical_address_by_object_identifier";
+	int result                                = 0;
+	int set_index                             = 0;
+	int way_index                             = 0;
+
+	if( physical_address == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical address.",
+		 function );
+
+		return( -1 );
+	}
+	if( flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_object_map_cache_get_set_by_object_identifier(
+	     object_map_cache,
+	     object_identifier,
+	     &shard,
+	     &set_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve set of object identifier: %" PRIu64 ".",
+		 function,
+		 object_identifier );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry = &( shard->entries[ set_index * LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_WAYS ] );
+
+	for( way_index = 0;
+	     way_index < LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_WAYS;
+	     way_index++ )
+	{
+		if( entry->object_identifier == object_identifier )
+		{
+			*physical_address = entry->physical_address;
+			*flags            = entry->flags;
+
+			result = 1;
+
+			break;
+		}
+		entry++;
+	}
+	if( result != 0 )
+	{
+		shard->number_of_hits += 1;
+	}
+	else
+	{
+		shard->number_of_misses += 1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the physical address and flags of a specific object identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_cache_set_physical_address_by_object_identifier(
+     libfsapfs_object_map_cache_t *object_map_cache,
+     uint64_t object_identifier,
+     uint64_t physical_address,
+     uint32_t flags,
+     libcerror_error_t **error )
+{
+	libfsapfs_object_map_cache_entry_t *entry = NULL;
+	libfsapfs_object_map_cache_entry_t *set   = NULL;
+	libfsapfs_object_map_cache_shard_t *shard = NULL;
+	static char *function                     = "libfsapfs_object_map_cache_set_physical_address_by_object_identifier";
+	int set_index                             = 0;
+	int way_index                             = 0;
+
+	if( libfsapfs_object_map_cache_get_set_by_object_identifier(
+	     object_map_cache,
+	     object_identifier,
+	     &shard,
+	     &set_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve set of object identifier: %" PRIu64 ".",
+		 function,
+		 object_identifier );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	set = &( shard->entries[ set_index * LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_WAYS ] );
+
+	/* Reuse the entry of the object identifier or an unused entry
+	 * before replacing the entry of another object identifier
+	 */
+	for( way_index = 0;
+	     way_index < LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_WAYS;
+	     way_index++ )
+	{
+		if( ( set[ way_index ].object_identifier == object_identifier )
+		 || ( set[ way_index ].object_identifier == 0 ) )
+		{
+			entry = &( set[ way_index ] );
+
+			break;
+		}
+	}
+	if( entry == NULL )
+	{
+		way_index = shard->replacement_ways[ set_index ];
+
+		entry = &( set[ way_index ] );
+
+		shard->replacement_ways[ set_index ] = (uint8_t) ( ( way_index + 1 ) % LIBFSAPFS_OBJECT_MAP_CACHE_NUMBER_OF_WAYS );
+	}
+	entry->object_identifier = object_identifier;
+	entry->physical_address  = physical_address;
+	entry->flags             = flags;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the cache statistics
+ * The number of hits is the number of object map B-tree lookups that were not needed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_cache_get_statistics(
+     libfsapfs_object_map_cache_t *object_map_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libfsapfs_object_map_cache_shard_t *shard = NULL;
+	static char *function                     = "libfsapfs_object_map_cache_get_statistics";
+	uint64_t safe_number_of_hits              = 0;
+	uint64_t safe_number_of_misses            = 0;
+	int shard_index                           = 0;
+
+	if( object_map_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < object_map_cache->number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( object_map_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d read/write lock for reading.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_number_of_hits   += shard->number_of_hits;
+		safe_number_of_misses += shard->number_of_misses;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d read/write lock for reading.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*number_of_hits   = safe_number_of_hits;
+	*number_of_misses = safe_number_of_misses;
+
+	return( 1 );
+}
+
@@ -0,0 +1,137 @@
+/*
+ * Object map cache functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_OBJECT_MAP_CACHE_H )
+#define _LIBFSAPFS_OBJECT_MAP_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_object_map_cache_entry libfsapfs_object_map_cache_entry_t;
+
+struct libfsapfs_object_map_cache_entry
+{
+	/* The object identifier, where 0 represents an unused entry
+	 */
+	uint64_t object_identifier;
+
+	/* The physical address
+	 */
+	uint64_t physical_address;
+
+	/* The flags
+	 */
+	uint32_t flags;
+};
+
+typedef struct libfsapfs_object_map_cache_shard libfsapfs_object_map_cache_shard_t;
+
+struct libfsapfs_object_map_cache_shard
+{
+	/* The entries
+	 */
+	libfsapfs_object_map_cache_entry_t *entries;
+
+	/* The way to replace next per set
+	 */
+	uint8_t *replacement_ways;
+
+	/* The number of hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of misses
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+typedef struct libfsapfs_object_map_cache libfsapfs_object_map_cache_t;
+
+struct libfsapfs_object_map_cache
+{
+	/* The number of sets per shard
+	 */
+	int number_of_sets;
+
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The shards
+	 */
+	libfsapfs_object_map_cache_shard_t *shards;
+};
+
+int libfsapfs_object_map_cache_initialize(
+     libfsapfs_object_map_cache_t **object_map_cache,
+     int maximum_number_of_cache_entries,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_cache_free(
+     libfsapfs_object_map_cache_t **object_map_cache,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_cache_get_set_by_object_identifier(
+     libfsapfs_object_map_cache_t *object_map_cache,
+     uint64_t object_identifier,
+     libfsapfs_object_map_cache_shard_t **shard,
+     int *set_index,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_cache_get_physical_address_by_object_identifier(
+     libfsapfs_object_map_cache_t *object_map_cache,
+     uint64_t object_identifier,
+     uint64_t *physical_address,
+     uint32_t *flags,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_cache_set_physical_address_by_object_identifier(
+     libfsapfs_object_map_cache_t *object_map_cache,
+     uint64_t object_identifier,
+     uint64_t physical_address,
+     uint32_t flags,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_cache_get_statistics(
+     libfsapfs_object_map_cache_t *object_map_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_OBJECT_MAP_CACHE_H ) */
+
@@ -0,0 +1,410 @@
+/*
+ * Object map index functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_object_map_descriptor.h"
+#include "libfsapfs_object_map_index.h"
+
+/* The object map index is a flat array of all the object map descriptors of
+ * an object map B-tree, read in a single pass over its leaf nodes. Since
+ * the leaf nodes are visited in key order the array is sorted by identifier
+ * and transaction identifier, so that a lookup is a binary search without
+ * any B-tree node access.
+ */
+
+/* Creates an object map index
+ * Make sure the value object_map_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_index_initialize(
+     libfsapfs_object_map_index_t **object_map_index,
+     int maximum_number_of_descriptors,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfsapfs_object_map_index_initialize";
+	size_t descriptors_size = 0;
+
+	if( object_map_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *object_map_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid object map index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_descriptors <= 0 )
+	 || ( (size_t) maximum_number_of_descriptors > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libfsapfs_object_map_descriptor_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of descriptors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*object_map_index = memory_allocate_structure(
+	                     libfsapfs_object_map_index_t );
+
+	if( *object_map_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create object map index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *object_map_index,
+	     0,
+	     sizeof( libfsapfs_object_map_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear object map index.",
+		 function );
+
+		memory_free(
+		 *object_map_index );
+
+		*object_map_index = NULL;
+
+		return( -1 );
+	}
+	descriptors_size = sizeof( libfsapfs_object_map_descriptor_t ) * maximum_number_of_descriptors;
+
+	( *object_map_index )->descriptors = (libfsapfs_object_map_descriptor_t *) memory_allocate(
+	                                                                             descriptors_size );
+
+	if( ( *object_map_index )->descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	( *object_map_index )->maximum_number_of_descriptors = maximum_number_of_descriptors;
+
+	return( 1 );
+
+on_error:
+	if( *object_map_index != NULL )
+	{
+		memory_free(
+		 *object_map_index );
+
+		*object_map_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an object map index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_index_free(
+     libfsapfs_object_map_index_t **object_map_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_object_map_index_free";
+
+	if( object_map_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *object_map_index != NULL )
+	{
+		if( ( *object_map_index )->descriptors != NULL )
+		{
+			memory_free(
+			 ( *object_map_index )->descriptors );
+		}
+		memory_free(
+		 *object_map_index );
+
+		*object_map_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends an object map B-tree leaf node entry
+ * The entries must be appended in key order
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_index_append_entry(
+     libfsapfs_object_map_index_t *object_map_index,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_object_map_descriptor_t *descriptor          = NULL;
+	libfsapfs_object_map_descriptor_t *previous_descriptor = NULL;
+	static char *function                                  = "libfsapfs_object_map_index_append_entry";
+
+	if( object_map_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map index.",
+		 function );
+
+		return( -1 );
+	}
+	if( object_map_index->descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid object map index - missing descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( object_map_index->number_of_descriptors < 0 )
+	 || ( object_map_index->number_of_descriptors >= object_map_index->maximum_number_of_descriptors ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid object map index - number of descriptors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	descriptor = &( object_map_index->descriptors[ object_map_index->number_of_descriptors ] );
+
+	if( memory_set(
+	     descriptor,
+	     0,
+	     sizeof( libfsapfs_object_map_descriptor_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_object_map_descriptor_read_key_data(
+	     descriptor,
+	     key_data,
+	     key_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read object map descriptor key data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_object_map_descriptor_read_value_data(
+	     descriptor,
+	     value_data,
+	     value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read object map descriptor value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( object_map_index->number_of_descriptors > 0 )
+	{
+		previous_descriptor = &( object_map_index->descriptors[ object_map_index->number_of_descriptors - 1 ] );
+
+		if( ( descriptor->identifier < previous_descriptor->identifier )
+		 || ( ( descriptor->identifier == previous_descriptor->identifier )
+		  &&  ( descriptor->transaction_identifier <= previous_descriptor->transaction_identifier ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported object map entry: %" PRIu64 " - entries not in key order.",
+			 function,
+			 descriptor->identifier );
+
+			return( -1 );
+		}
+	}
+	object_map_index->number_of_descriptors += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the descriptor of a specific object identifier
+ * If the object identifier has multiple descriptors the one with the lowest transaction identifier is returned,
+ * which corresponds with the descriptor returned by the object map B-tree
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+     libfsapfs_object_map_index_t *object_map_index,
+     uint64_t object_identifier,
+     libfsapfs_object_map_descriptor_t **descriptor,
+     libcerror_error_t **error )
+{
+	libfsapfs_object_map_descriptor_t *descriptors = NULL;
+	static char *function                          = "libfsapfs_object_map_index_get_descriptor_by_object_identifier";
+	int descriptor_index                           = 0;
+	int half_number_of_descriptors                 = 0;
+	int number_of_descriptors                      = 0;
+
+	if( object_map_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map index.",
+		 function );
+
+		return( -1 );
+	}
+	if( descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_descriptors = object_map_index->number_of_descriptors;
+
+	if( number_of_descriptors <= 0 )
+	{
+		return( 0 );
+	}
+	descriptors = object_map_index->descriptors;
+
+	/* Search for the first descriptor with an identifier equal to or greater than
+	 * the object identifier. The search range is halved without a data dependent
+	 * branch, so that the comparison can be compiled into a conditional move.
+	 */
+	while( number_of_descriptors > 1 )
+	{
+		half_number_of_descriptors = number_of_descriptors / 2;
+
+		descriptor_index = ( descriptors[ descriptor_index + half_number_of_descriptors ].identifier < object_identifier ) ? descriptor_index + half_number_of_descriptors : descriptor_index;
+
+		number_of_descriptors -= half_number_of_descriptors;
+	}
+	descriptor_index += ( descriptors[ descriptor_index ].identifier < object_identifier );
+
+	if( ( descriptor_index >= object_map_index->number_of_descriptors )
+	 || ( descriptors[ descriptor_index ].identifier != object_identifier ) )
+	{
+		return( 0 );
+	}
+	*descriptor = &( descriptors[ descriptor_index ] );
+
+	return( 1 );
+}
+
+/* Retrieves the size of the memory used by the object map index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_object_map_index_get_size(
+     libfsapfs_object_map_index_t *object_map_index,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_object_map_index_get_size";
+
+	if( object_map_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid object map index.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = (size64_t) sizeof( libfsapfs_object_map_index_t )
+	      + ( (size64_t) sizeof( libfsapfs_object_map_descriptor_t ) * object_map_index->maximum_number_of_descriptors );
+
+	return( 1 );
+}
+
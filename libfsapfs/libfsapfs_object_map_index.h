@@ -0,0 +1,85 @@
+/*
+ * Object map index functions
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSAPFS_OBJECT_MAP_INDEX_H )
+#define _LIBFSAPFS_OBJECT_MAP_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsapfs_libcerror.h"
+#include "libfsapfs_object_map_descriptor.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsapfs_object_map_index libfsapfs_object_map_index_t;
+
+struct libfsapfs_object_map_index
+{
+	/* The descriptors, sorted by identifier and transaction identifier
+	 */
+	libfsapfs_object_map_descriptor_t *descriptors;
+
+	/* The number of descriptors
+	 */
+	int number_of_descriptors;
+
+	/* The maximum number of descriptors
+	 */
+	int maximum_number_of_descriptors;
+};
+
+int libfsapfs_object_map_index_initialize(
+     libfsapfs_object_map_index_t **object_map_index,
+     int maximum_number_of_descriptors,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_index_free(
+     libfsapfs_object_map_index_t **object_map_index,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_index_append_entry(
+     libfsapfs_object_map_index_t *object_map_index,
+     const uint8_t *key_data,
+     size_t key_data_size,
+     const uint8_t *value_data,
+     size_t value_data_size,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+     libfsapfs_object_map_index_t *object_map_index,
+     uint64_t object_identifier,
+     libfsapfs_object_map_descriptor_t **descriptor,
+     libcerror_error_t **error );
+
+int libfsapfs_object_map_index_get_size(
+     libfsapfs_object_map_index_t *object_map_index,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSAPFS_OBJECT_MAP_INDEX_H ) */
+
@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsapfs_block_cache.h"
 #include "libfsapfs_btree_entry.h"
 #include "libfsapfs_btree_node.h"
 #include "libfsapfs_data_block.h"
@@ -33,10 +34,9 @@
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
-#include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
+#include "libfsapfs_node_cache.h"
 #include "libfsapfs_object_map_btree.h"
-#include "libfsapfs_object_map_descriptor.h"
 #include "libfsapfs_snapshot_metadata.h"
 #include "libfsapfs_snapshot_metadata_tree.h"
 
@@ -112,23 +112,32 @@ int libfsapfs_snapshot_metadata_tree_initialize(
 
 		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &( ( *snapshot_metadata_tree )->data_block_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_DATA_BLOCKS,
-	     error ) != 1 )
+	if( io_handle == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data block cache.",
-		 function );
+		( *snapshot_metadata_tree )->maximum_number_of_cached_nodes = LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES;
+	}
+	else
+	{
+		if( libfsapfs_io_handle_reserve_cache_entries(
+		     io_handle,
+		     LIBFSAPFS_CACHE_TYPE_BTREE_NODES,
+		     0,
+		     &( ( *snapshot_metadata_tree )->maximum_number_of_cached_nodes ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to reserve node cache entries.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	if( libfcache_cache_initialize(
+	if( libfsapfs_node_cache_initialize(
 	     &( ( *snapshot_metadata_tree )->node_cache ),
-	     LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES,
+	     ( *snapshot_metadata_tree )->maximum_number_of_cached_nodes,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -150,6 +159,19 @@ int libfsapfs_snapshot_metadata_tree_initialize(
 on_error:
 	if( *snapshot_metadata_tree != NULL )
 	{
+		if( ( *snapshot_metadata_tree )->node_cache != NULL )
+		{
+			libfsapfs_node_cache_free(
+			 &( ( *snapshot_metadata_tree )->node_cache ),
+			 NULL );
+		}
+		if( io_handle != NULL )
+		{
+			libfsapfs_io_handle_release_cache_entries(
+			 io_handle,
+			 ( *snapshot_metadata_tree )->maximum_number_of_cached_nodes,
+			 NULL );
+		}
 		memory_free(
 		 *snapshot_metadata_tree );
 
@@ -183,7 +205,7 @@ int libfsapfs_snapshot_metadata_tree_free(
 	{
 		/* The data_block_vector is referenced and freed elsewhere
 		 */
-		if( libfcache_cache_free(
+		if( libfsapfs_node_cache_free(
 		     &( ( *snapshot_metadata_tree )->node_cache ),
 		     error ) != 1 )
 		{
@@ -196,18 +218,22 @@ int libfsapfs_snapshot_metadata_tree_free(
 
 			result = -1;
 		}
-		if( libfcache_cache_free(
-		     &( ( *snapshot_metadata_tree )->data_block_cache ),
-		     error ) != 1 )
+		if( ( *snapshot_metadata_tree )->io_handle != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free data block cache.",
-			 function );
-
-			result = -1;
+			if( libfsapfs_io_handle_release_cache_entries(
+			     ( *snapshot_metadata_tree )->io_handle,
+			     ( *snapshot_metadata_tree )->maximum_number_of_cached_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release node cache entries.",
+				 function );
+
+				result = -1;
+			}
 		}
 		memory_free(
 		 *snapshot_metadata_tree );
@@ -217,6 +243,88 @@ int libfsapfs_snapshot_metadata_tree_free(
 	return( result );
 }
 
+/* Sets the cache limits
+ * The maximum cache size is in bytes, where 0 represents the limit set in the IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_snapshot_metadata_tree_set_cache_limits(
+     libfsapfs_snapshot_metadata_tree_t *snapshot_metadata_tree,
+     size64_t maximum_btree_nodes_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_snapshot_metadata_tree_set_cache_limits";
+
+	if( snapshot_metadata_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot metadata tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( snapshot_metadata_tree->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid snapshot metadata tree - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_io_handle_release_cache_entries(
+	     snapshot_metadata_tree->io_handle,
+	     snapshot_metadata_tree->maximum_number_of_cached_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release node cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	snapshot_metadata_tree->maximum_number_of_cached_nodes = 0;
+
+	if( libfsapfs_io_handle_reserve_cache_entries(
+	     snapshot_metadata_tree->io_handle,
+	     LIBFSAPFS_CACHE_TYPE_BTREE_NODES,
+	     maximum_btree_nodes_cache_size,
+	     &( snapshot_metadata_tree->maximum_number_of_cached_nodes ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to reserve node cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_node_cache_resize(
+	     snapshot_metadata_tree->node_cache,
+	     snapshot_metadata_tree->maximum_number_of_cached_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize node cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the sub node block number from a B-tree entry
  * Returns 1 if successful, 0 if not found or -1 on error
  */
@@ -227,10 +335,11 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node_block_number_from_entry(
      uint64_t *sub_node_block_number,
      libcerror_error_t **error )
 {
-	libfsapfs_object_map_descriptor_t *object_map_descriptor = NULL;
-	static char *function                                    = "libfsapfs_snapshot_metadata_tree_get_sub_node_block_number_from_entry";
-	uint64_t sub_node_object_identifier                      = 0;
-	int result                                               = 0;
+	static char *function               = "libfsapfs_snapshot_metadata_tree_get_sub_node_block_number_from_entry";
+	uint64_t physical_address           = 0;
+	uint64_t sub_node_object_identifier = 0;
+	uint32_t object_flags               = 0;
+	int result                          = 0;
 
 	if( snapshot_metadata_tree == NULL )
 	{
@@ -300,11 +409,12 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node_block_number_from_entry(
 		 sub_node_object_identifier );
 	}
 #endif
-	result = libfsapfs_object_map_btree_get_descriptor_by_object_identifier(
+	result = libfsapfs_object_map_btree_get_physical_address_by_object_identifier(
 	          snapshot_metadata_tree->object_map_btree,
 	          file_io_handle,
 	          sub_node_object_identifier,
-	          &object_map_descriptor,
+	          &physical_address,
+	          &object_flags,
 	          error );
 
 	if( result == -1 )
@@ -313,63 +423,30 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node_block_number_from_entry(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve object map descriptor for sub node object identifier: %" PRIu64 ".",
+		 "%s: unable to retrieve physical address for sub node object identifier: %" PRIu64 ".",
 		 function,
 		 sub_node_object_identifier );
 
-		goto on_error;
+		return( -1 );
 	}
 	else if( result != 0 )
 	{
-		if( object_map_descriptor == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid object map descriptor.",
-			 function );
-
-			goto on_error;
-		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
 			libcnotify_printf(
 			 "%s: sub node block number: %" PRIu64 "\n",
 			 function,
-			 object_map_descriptor->physical_address );
+			 physical_address );
 		}
 #endif
-		*sub_node_block_number = object_map_descriptor->physical_address;
-
-		if( libfsapfs_object_map_descriptor_free(
-		     &object_map_descriptor,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free object map descriptor.",
-			 function );
-
-			goto on_error;
-		}
+		*sub_node_block_number = physical_address;
 	}
 	return( result );
-
-on_error:
-	if( object_map_descriptor != NULL )
-	{
-		libfsapfs_object_map_descriptor_free(
-		 &object_map_descriptor,
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Retrieves the snapshot metadata tree root node
+ * The node must be released with libfsapfs_snapshot_metadata_tree_release_node
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_snapshot_metadata_tree_get_root_node(
@@ -379,14 +456,13 @@ int libfsapfs_snapshot_metadata_tree_get_root_node(
      libfsapfs_btree_node_t **root_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	libfsapfs_btree_node_t *node         = NULL;
-	libfsapfs_data_block_t *data_block   = NULL;
-	static char *function                = "libfsapfs_snapshot_metadata_tree_get_root_node";
-	int result                           = 0;
+	libfsapfs_btree_node_t *node       = NULL;
+	libfsapfs_data_block_t *data_block = NULL;
+	static char *function              = "libfsapfs_snapshot_metadata_tree_get_root_node";
+	int result                         = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp   = 0;
 #endif
 
 	if( snapshot_metadata_tree == NULL )
@@ -400,6 +476,17 @@ int libfsapfs_snapshot_metadata_tree_get_root_node(
 
 		return( -1 );
 	}
+	if( snapshot_metadata_tree->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid snapshot metadata tree - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( root_node_block_number > (uint64_t) INT_MAX )
 	{
 		libcerror_error_set(
@@ -442,12 +529,10 @@ int libfsapfs_snapshot_metadata_tree_get_root_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	result = libfcache_cache_get_value_by_identifier(
+	result = libfsapfs_node_cache_get_node_by_block_number(
 	          snapshot_metadata_tree->node_cache,
-	          0,
-	          (off64_t) root_node_block_number,
-	          0,
-	          &cache_value,
+	          root_node_block_number,
+	          root_node,
 	          error );
 
 	if( result == -1 )
@@ -463,13 +548,26 @@ int libfsapfs_snapshot_metadata_tree_get_root_node(
 	}
 	else if( result == 0 )
 	{
-		if( libfdata_vector_get_element_value_by_index(
+		if( libfsapfs_btree_node_initialize(
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create B-tree node.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_block_cache_get_element_value_by_index(
+		     snapshot_metadata_tree->io_handle->block_cache,
 		     snapshot_metadata_tree->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) snapshot_metadata_tree->data_block_cache,
+		     file_io_handle,
 		     (int) root_node_block_number,
+		     root_node_block_number,
 		     (intptr_t **) &data_block,
-		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -492,34 +590,40 @@ int libfsapfs_snapshot_metadata_tree_get_root_node(
 			 function,
 			 root_node_block_number );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_initialize(
-		     &node,
-		     error ) != 1 )
+		else if( libfsapfs_btree_node_read_data(
+		          node,
+		          data_block->data,
+		          data_block->data_size,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree node.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read B-tree node.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_read_data(
-		     node,
-		     data_block->data,
-		     data_block->data_size,
+		if( libfsapfs_block_cache_release_element_value_by_block_number(
+		     snapshot_metadata_tree->io_handle->block_cache,
+		     root_node_block_number,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read B-tree node.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release data block: %" PRIu64 ".",
+			 function,
+			 root_node_block_number );
 
+			result = -1;
+		}
+		if( result == -1 )
+		{
 			goto on_error;
 		}
 		if( node->object_type != 0x40000002UL )
@@ -591,44 +695,23 @@ int libfsapfs_snapshot_metadata_tree_get_root_node(
 
 			goto on_error;
 		}
-		if( libfcache_cache_set_value_by_identifier(
+		if( libfsapfs_node_cache_set_node_by_block_number(
 		     snapshot_metadata_tree->node_cache,
-		     0,
-		     (off64_t) root_node_block_number,
-		     0,
-		     (intptr_t *) node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     root_node_block_number,
+		     &node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value in cache.",
-			 function );
-
-			goto on_error;
-		}
-		node = NULL;
-
-		if( libfcache_cache_get_value_by_identifier(
-		     snapshot_metadata_tree->node_cache,
-		     0,
-		     (off64_t) root_node_block_number,
-		     0,
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
+		*root_node = node;
+		node       = NULL;
 	}
 #if defined( HAVE_PROFILER )
 	if( snapshot_metadata_tree->io_handle->profiler != NULL )
@@ -653,20 +736,6 @@ int libfsapfs_snapshot_metadata_tree_get_root_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     (intptr_t **) root_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve root node.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -680,6 +749,7 @@ on_error:
 }
 
 /* Retrieves a snapshot metadata tree sub node
+ * The node must be released with libfsapfs_snapshot_metadata_tree_release_node
  * Returns 1 if successful or -1 on error
  */
 int libfsapfs_snapshot_metadata_tree_get_sub_node(
@@ -689,14 +759,13 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node(
      libfsapfs_btree_node_t **sub_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value = NULL;
-	libfsapfs_btree_node_t *node         = NULL;
-	libfsapfs_data_block_t *data_block   = NULL;
-	static char *function                = "libfsapfs_snapshot_metadata_tree_get_sub_node";
-	int result                           = 0;
+	libfsapfs_btree_node_t *node       = NULL;
+	libfsapfs_data_block_t *data_block = NULL;
+	static char *function              = "libfsapfs_snapshot_metadata_tree_get_sub_node";
+	int result                         = 0;
 
 #if defined( HAVE_PROFILER )
-	int64_t profiler_start_timestamp     = 0;
+	int64_t profiler_start_timestamp   = 0;
 #endif
 
 	if( snapshot_metadata_tree == NULL )
@@ -710,6 +779,17 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node(
 
 		return( -1 );
 	}
+	if( snapshot_metadata_tree->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid snapshot metadata tree - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( sub_node_block_number > (uint64_t) INT_MAX )
 	{
 		libcerror_error_set(
@@ -752,12 +832,10 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	result = libfcache_cache_get_value_by_identifier(
+	result = libfsapfs_node_cache_get_node_by_block_number(
 	          snapshot_metadata_tree->node_cache,
-	          0,
-	          (off64_t) sub_node_block_number,
-	          0,
-	          &cache_value,
+	          sub_node_block_number,
+	          sub_node,
 	          error );
 
 	if( result == -1 )
@@ -773,13 +851,26 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node(
 	}
 	else if( result == 0 )
 	{
-		if( libfdata_vector_get_element_value_by_index(
+		if( libfsapfs_btree_node_initialize(
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create B-tree node.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsapfs_block_cache_get_element_value_by_index(
+		     snapshot_metadata_tree->io_handle->block_cache,
 		     snapshot_metadata_tree->data_block_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) snapshot_metadata_tree->data_block_cache,
+		     file_io_handle,
 		     (int) sub_node_block_number,
+		     sub_node_block_number,
 		     (intptr_t **) &data_block,
-		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -802,34 +893,40 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node(
 			 function,
 			 sub_node_block_number );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_initialize(
-		     &node,
-		     error ) != 1 )
+		else if( libfsapfs_btree_node_read_data(
+		          node,
+		          data_block->data,
+		          data_block->data_size,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create B-tree node.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read B-tree node.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfsapfs_btree_node_read_data(
-		     node,
-		     data_block->data,
-		     data_block->data_size,
+		if( libfsapfs_block_cache_release_element_value_by_block_number(
+		     snapshot_metadata_tree->io_handle->block_cache,
+		     sub_node_block_number,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read B-tree node.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release data block: %" PRIu64 ".",
+			 function,
+			 sub_node_block_number );
 
+			result = -1;
+		}
+		if( result == -1 )
+		{
 			goto on_error;
 		}
 		if( node->object_type != 0x40000003UL )
@@ -868,44 +965,23 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node(
 
 			goto on_error;
 		}
-		if( libfcache_cache_set_value_by_identifier(
+		if( libfsapfs_node_cache_set_node_by_block_number(
 		     snapshot_metadata_tree->node_cache,
-		     0,
-		     (off64_t) sub_node_block_number,
-		     0,
-		     (intptr_t *) node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_btree_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     sub_node_block_number,
+		     &node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set value in cache.",
-			 function );
-
-			goto on_error;
-		}
-		node = NULL;
-
-		if( libfcache_cache_get_value_by_identifier(
-		     snapshot_metadata_tree->node_cache,
-		     0,
-		     (off64_t) sub_node_block_number,
-		     0,
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from cache.",
+			 "%s: unable to set node in cache.",
 			 function );
 
 			goto on_error;
 		}
+		*sub_node = node;
+		node       = NULL;
 	}
 #if defined( HAVE_PROFILER )
 	if( snapshot_metadata_tree->io_handle->profiler != NULL )
@@ -930,20 +1006,6 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node(
 	}
 #endif /* defined( HAVE_PROFILER ) */
 
-	if( libfcache_cache_value_get_value(
-	     cache_value,
-	     (intptr_t **) sub_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve sub node.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -956,7 +1018,61 @@ on_error:
 	return( -1 );
 }
 
+/* Releases a node retrieved from the snapshot metadata tree
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_snapshot_metadata_tree_release_node(
+     libfsapfs_snapshot_metadata_tree_t *snapshot_metadata_tree,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsapfs_snapshot_metadata_tree_release_node";
+
+	if( snapshot_metadata_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot metadata tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *node == NULL )
+	{
+		return( 1 );
+	}
+	if( libfsapfs_node_cache_release_node(
+	     snapshot_metadata_tree->node_cache,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release node in cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves an entry for a specific identifier from the snapshot metadata tree node
+ * The node entries are sorted by object identifier, hence a binary search is used
  * Returns 1 if successful, 0 if not found or -1 on error
  */
 int libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier(
@@ -966,14 +1082,17 @@ int libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier(
      libfsapfs_btree_entry_t **btree_entry,
      libcerror_error_t **error )
 {
-	libfsapfs_btree_entry_t *entry          = NULL;
-	libfsapfs_btree_entry_t *previous_entry = NULL;
-	static char *function                   = "libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier";
-	uint64_t snapshot_metadata_identifier   = 0;
-	uint8_t snapshot_metadata_data_type     = 0;
-	int btree_entry_index                   = 0;
-	int is_leaf_node                        = 0;
-	int number_of_entries                   = 0;
+	libfsapfs_btree_entry_t *entry        = NULL;
+	libfsapfs_btree_entry_t *upper_entry  = NULL;
+	static char *function                 = "libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier";
+	uint64_t snapshot_metadata_identifier = 0;
+	uint8_t snapshot_metadata_data_type   = 0;
+	uint8_t upper_entry_is_match          = 0;
+	int btree_entry_index                 = 0;
+	int is_leaf_node                      = 0;
+	int lower_entry_index                 = 0;
+	int number_of_entries                 = 0;
+	int upper_entry_index                 = 0;
 
 	if( snapshot_metadata_tree == NULL )
 	{
@@ -986,6 +1105,17 @@ int libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier(
 
 		return( -1 );
 	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
 	if( btree_entry == NULL )
 	{
 		libcerror_error_set(
@@ -1035,10 +1165,15 @@ int libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier(
 
 		return( -1 );
 	}
-	for( btree_entry_index = 0;
-	     btree_entry_index < number_of_entries;
-	     btree_entry_index++ )
+	/* Search for the first entry with a key equal to or greater than the lookup key
+	 */
+	lower_entry_index = 0;
+	upper_entry_index = number_of_entries;
+
+	while( lower_entry_index < upper_entry_index )
 	{
+		btree_entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
 		if( libfsapfs_btree_node_get_entry_by_index(
 		     node,
 		     btree_entry_index,
@@ -1049,8 +1184,9 @@ int libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of entries from B-tree node.",
-			 function );
+			 "%s: unable to retrieve B-tree entry: %d.",
+			 function,
+			 btree_entry_index );
 
 			return( -1 );
 		}
@@ -1066,7 +1202,8 @@ int libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier(
 
 			return( -1 );
 		}
-		if( entry->key_data == NULL )
+		if( ( entry->key_data == NULL )
+		 || ( entry->key_data_size < 8 ) )
 		{
 			libcerror_error_set(
 			 error,
@@ -1082,7 +1219,8 @@ int libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier(
 		 entry->key_data,
 		 snapshot_metadata_identifier );
 
-		snapshot_metadata_data_type = (uint8_t) ( snapshot_metadata_identifier >> 60 );
+		snapshot_metadata_data_type   = (uint8_t) ( snapshot_metadata_identifier >> 60 );
+		snapshot_metadata_identifier &= 0x0fffffffffffffffUL;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
@@ -1091,49 +1229,64 @@ int libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier(
 			 "%s: B-tree entry: %d, identifier: %" PRIu64 ", data type: 0x%" PRIx8 " %s\n",
 			 function,
 			 btree_entry_index,
-			 snapshot_metadata_identifier & 0x0fffffffffffffffUL,
+			 snapshot_metadata_identifier,
 			 snapshot_metadata_data_type,
 			 libfsapfs_debug_print_file_system_data_type(
 			  snapshot_metadata_data_type ) );
 		}
 #endif
-		snapshot_metadata_identifier &= 0x0fffffffffffffffUL;
-
-		if( is_leaf_node != 0 )
+		if( snapshot_metadata_identifier < object_identifier )
 		{
-			if( snapshot_metadata_identifier == object_identifier )
-			{
-				*btree_entry = entry;
-
-				return( 1 );
-			}
+			lower_entry_index = btree_entry_index + 1;
 		}
 		else
 		{
-			if( snapshot_metadata_identifier >= object_identifier )
-			{
-				if( ( previous_entry == NULL )
-				 || ( snapshot_metadata_identifier == object_identifier ) )
-				{
-					previous_entry = entry;
-				}
-				*btree_entry = previous_entry;
-
-				return( 1 );
-			}
-			previous_entry = entry;
+			upper_entry_index    = btree_entry_index;
+			upper_entry          = entry;
+			upper_entry_is_match = (uint8_t) ( snapshot_metadata_identifier == object_identifier );
 		}
 	}
-	if( is_leaf_node == 0 )
+	if( ( lower_entry_index < number_of_entries )
+	 && ( upper_entry_is_match != 0 ) )
 	{
-		*btree_entry = previous_entry;
+		*btree_entry = upper_entry;
 
 		return( 1 );
 	}
-	return( 0 );
+	if( is_leaf_node != 0 )
+	{
+		return( 0 );
+	}
+	/* In a branch node the sub node that can contain the key is referenced
+	 * by the last entry with a key less than the lookup key
+	 */
+	if( lower_entry_index == 0 )
+	{
+		*btree_entry = upper_entry;
+
+		return( 1 );
+	}
+	if( libfsapfs_btree_node_get_entry_by_index(
+	     node,
+	     lower_entry_index - 1,
+	     btree_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree entry: %d.",
+		 function,
+		 lower_entry_index - 1 );
+
+		return( -1 );
+	}
+	return( 1 );
 }
 
 /* Retrieves an entry for a specific identifier from the snapshot metadata tree
+ * The B-tree node is referenced and must be released with libfsapfs_snapshot_metadata_tree_release_node
  * Returns 1 if successful, 0 if not found or -1 on error
  */
 int libfsapfs_snapshot_metadata_tree_get_entry_by_identifier(
@@ -1213,7 +1366,7 @@ int libfsapfs_snapshot_metadata_tree_get_entry_by_identifier(
 			 "%s: invalid recursion depth value out of bounds.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		is_leaf_node = libfsapfs_btree_node_is_leaf_node(
 		                node,
@@ -1228,7 +1381,7 @@ int libfsapfs_snapshot_metadata_tree_get_entry_by_identifier(
 			 "%s: unable to determine if B-tree node is a leaf node.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		result = libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier(
 		          snapshot_metadata_tree,
@@ -1246,7 +1399,7 @@ int libfsapfs_snapshot_metadata_tree_get_entry_by_identifier(
 			 "%s: unable to retrieve entry from B-tree node.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		else if( result == 0 )
 		{
@@ -1268,7 +1421,7 @@ int libfsapfs_snapshot_metadata_tree_get_entry_by_identifier(
 			 "%s: invalid B-tree entry.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		if( entry->value_data == NULL )
 		{
@@ -1279,7 +1432,7 @@ int libfsapfs_snapshot_metadata_tree_get_entry_by_identifier(
 			 "%s: invalid B-tree entry - missing value data.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		if( entry->value_data_size != 8 )
 		{
@@ -1290,7 +1443,7 @@ int libfsapfs_snapshot_metadata_tree_get_entry_by_identifier(
 			 "%s: invalid B-tree entry - unsupported value data size.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		byte_stream_copy_to_uint64_little_endian(
 		 entry->value_data,
@@ -1305,8 +1458,20 @@ int libfsapfs_snapshot_metadata_tree_get_entry_by_identifier(
 			 sub_node_block_number );
 		}
 #endif
-		node = NULL;
+		if( libfsapfs_snapshot_metadata_tree_release_node(
+		     snapshot_metadata_tree,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
 
+			goto on_error;
+		}
 		if( libfsapfs_snapshot_metadata_tree_get_sub_node(
 		     snapshot_metadata_tree,
 		     file_io_handle,
@@ -1322,13 +1487,37 @@ int libfsapfs_snapshot_metadata_tree_get_entry_by_identifier(
 			 function,
 			 sub_node_block_number );
 
-			return( -1 );
+			goto on_error;
 		}
 		recursion_depth++;
 	}
 	while( is_leaf_node == 0 );
 
+	if( libfsapfs_snapshot_metadata_tree_release_node(
+	     snapshot_metadata_tree,
+	     &node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
+
+		goto on_error;
+	}
 	return( 0 );
+
+on_error:
+	if( node != NULL )
+	{
+		libfsapfs_snapshot_metadata_tree_release_node(
+		 snapshot_metadata_tree,
+		 &node,
+		 NULL );
+	}
+	return( -1 );
 }
 
 /* Retrieves the snapshot metadata of a specific object identifier
@@ -1465,11 +1654,31 @@ int libfsapfs_snapshot_metadata_tree_get_metadata_by_object_identifier(
 
 			goto on_error;
 		}
-		node = NULL;
+		if( libfsapfs_snapshot_metadata_tree_release_node(
+		     snapshot_metadata_tree,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	return( result );
 
 on_error:
+	if( node != NULL )
+	{
+		libfsapfs_snapshot_metadata_tree_release_node(
+		 snapshot_metadata_tree,
+		 &node,
+		 NULL );
+	}
 	if( *metadata != NULL )
 	{
 		libfsapfs_snapshot_metadata_free(
@@ -1950,11 +2159,31 @@ int libfsapfs_snapshot_metadata_tree_get_snapshots_from_branch_node(
 		{
 			found_snapshot_metadata = 1;
 		}
-		sub_node = NULL;
+		if( libfsapfs_snapshot_metadata_tree_release_node(
+		     snapshot_metadata_tree,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release B-tree node.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	return( found_snapshot_metadata );
 
 on_error:
+	if( sub_node != NULL )
+	{
+		libfsapfs_snapshot_metadata_tree_release_node(
+		 snapshot_metadata_tree,
+		 &sub_node,
+		 NULL );
+	}
 	libcdata_array_empty(
 	 snapshots,
 	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_snapshot_metadata_free,
@@ -2083,6 +2312,20 @@ int libfsapfs_snapshot_metadata_tree_get_snapshots(
 
 		goto on_error;
 	}
+	if( libfsapfs_snapshot_metadata_tree_release_node(
+	     snapshot_metadata_tree,
+	     &root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release B-tree node.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_PROFILER )
 	if( snapshot_metadata_tree->io_handle->profiler != NULL )
 	{
@@ -2109,6 +2352,13 @@ int libfsapfs_snapshot_metadata_tree_get_snapshots(
 	return( result );
 
 on_error:
+	if( root_node != NULL )
+	{
+		libfsapfs_snapshot_metadata_tree_release_node(
+		 snapshot_metadata_tree,
+		 &root_node,
+		 NULL );
+	}
 	libcdata_array_empty(
 	 snapshots,
 	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_snapshot_metadata_free,
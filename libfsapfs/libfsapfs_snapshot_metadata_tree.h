@@ -30,8 +30,8 @@
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
 #include "libfsapfs_libcerror.h"
-#include "libfsapfs_libfcache.h"
 #include "libfsapfs_libfdata.h"
+#include "libfsapfs_node_cache.h"
 #include "libfsapfs_object_map_btree.h"
 #include "libfsapfs_snapshot_metadata.h"
 
@@ -51,13 +51,13 @@ struct libfsapfs_snapshot_metadata_tree
 	 */
 	libfdata_vector_t *data_block_vector;
 
-	/* Data block cache
+	/* The node cache
 	 */
-	libfcache_cache_t *data_block_cache;
+	libfsapfs_node_cache_t *node_cache;
 
-	/* The node cache
+	/* The maximum number of cached nodes
 	 */
-	libfcache_cache_t *node_cache;
+	int maximum_number_of_cached_nodes;
 
 	/* The volume object map B-tree
 	 */
@@ -80,6 +80,11 @@ int libfsapfs_snapshot_metadata_tree_free(
      libfsapfs_snapshot_metadata_tree_t **snapshot_metadata_tree,
      libcerror_error_t **error );
 
+int libfsapfs_snapshot_metadata_tree_set_cache_limits(
+     libfsapfs_snapshot_metadata_tree_t *snapshot_metadata_tree,
+     size64_t maximum_btree_nodes_cache_size,
+     libcerror_error_t **error );
+
 int libfsapfs_snapshot_metadata_tree_get_sub_node_block_number_from_entry(
      libfsapfs_snapshot_metadata_tree_t *snapshot_metadata_tree,
      libbfio_handle_t *file_io_handle,
@@ -101,6 +106,11 @@ int libfsapfs_snapshot_metadata_tree_get_sub_node(
      libfsapfs_btree_node_t **sub_node,
      libcerror_error_t **error );
 
+int libfsapfs_snapshot_metadata_tree_release_node(
+     libfsapfs_snapshot_metadata_tree_t *snapshot_metadata_tree,
+     libfsapfs_btree_node_t **node,
+     libcerror_error_t **error );
+
 int libfsapfs_snapshot_metadata_tree_get_entry_from_node_by_identifier(
      libfsapfs_snapshot_metadata_tree_t *snapshot_metadata_tree,
      libfsapfs_btree_node_t *node,
@@ -49,6 +49,124 @@ typedef intptr_t libfsapfs_volume_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
 
+/* The directory record values
+ */
+typedef struct libfsapfs_directory_record_values libfsapfs_directory_record_values_t;
+
+struct libfsapfs_directory_record_values
+{
+	/* The parent identifier
+	 */
+	uint64_t parent_identifier;
+
+	/* The identifier
+	 */
+	uint64_t identifier;
+
+	/* The added date and time, as a POSIX timestamp in number of nano seconds
+	 */
+	int64_t added_time;
+
+	/* The UTF-8 encoded name as stored in the record, which is typically
+	 * terminated by an end-of-string character
+	 */
+	const uint8_t *utf8_name;
+
+	/* The size of the UTF-8 encoded name
+	 */
+	size_t utf8_name_size;
+};
+
+/* The file extent values
+ */
+typedef struct libfsapfs_file_extent_values libfsapfs_file_extent_values_t;
+
+struct libfsapfs_file_extent_values
+{
+	/* The data stream identifier
+	 */
+	uint64_t identifier;
+
+	/* The logical offset
+	 */
+	uint64_t logical_offset;
+
+	/* The physical block number
+	 */
+	uint64_t physical_block_number;
+
+	/* The data size
+	 */
+	uint64_t data_size;
+
+	/* The encryption identifier
+	 */
+	uint64_t encryption_identifier;
+};
+
+/* The sibling link values
+ */
+typedef struct libfsapfs_sibling_link_values libfsapfs_sibling_link_values_t;
+
+struct libfsapfs_sibling_link_values
+{
+	/* The identifier of the inode
+	 */
+	uint64_t identifier;
+
+	/* The sibling identifier
+	 */
+	uint64_t sibling_identifier;
+
+	/* The parent identifier
+	 */
+	uint64_t parent_identifier;
+
+	/* The UTF-8 encoded name as stored in the record, which is typically
+	 * terminated by an end-of-string character
+	 */
+	const uint8_t *utf8_name;
+
+	/* The size of the UTF-8 encoded name
+	 */
+	size_t utf8_name_size;
+};
+
+/* The scan record, only the value that corresponds to the record type is set
+ */
+typedef struct libfsapfs_scan_record libfsapfs_scan_record_t;
+
+struct libfsapfs_scan_record
+{
+	/* The record type (LIBFSAPFS_RECORD_TYPE_*)
+	 */
+	uint8_t record_type;
+
+	/* The file system identifier
+	 */
+	uint64_t identifier;
+
+	/* The file entry of an inode record
+	 */
+	libfsapfs_file_entry_t *file_entry;
+
+	/* The extended attribute of an extended attribute record
+	 */
+	libfsapfs_extended_attribute_t *extended_attribute;
+
+	/* The values of a directory record
+	 */
+	const libfsapfs_directory_record_values_t *directory_record;
+
+	/* The values of a file extent record
+	 */
+	const libfsapfs_file_extent_values_t *file_extent;
+
+	/* The values of a sibling link record
+	 */
+	const libfsapfs_sibling_link_values_t *sibling_link;
+};
+
 #endif /* defined( HAVE_LOCAL_LIBFSAPFS ) */
 
 #endif /* !defined( _LIBFSAPFS_INTERNAL_TYPES_H ) */
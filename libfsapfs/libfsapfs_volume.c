@@ -25,6 +25,7 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libfsapfs_btree_node.h"
 #include "libfsapfs_container_data_handle.h"
 #include "libfsapfs_container_key_bag.h"
 #include "libfsapfs_debug.h"
@@ -34,9 +35,11 @@
 #include "libfsapfs_file_entry.h"
 #include "libfsapfs_file_system_btree.h"
 #include "libfsapfs_file_system_data_handle.h"
+#include "libfsapfs_file_system_scanner.h"
 #include "libfsapfs_inode.h"
 #include "libfsapfs_io_handle.h"
 #include "libfsapfs_libbfio.h"
+#include "libfsapfs_libcdata.h"
 #include "libfsapfs_libcerror.h"
 #include "libfsapfs_libcnotify.h"
 #include "libfsapfs_libcthreads.h"
@@ -534,6 +537,23 @@ int libfsapfs_internal_volume_open_read(
 
 		goto on_error;
 	}
+	if( internal_volume->io_handle->preload_object_maps != 0 )
+	{
+		if( libfsapfs_object_map_btree_read_index(
+		     internal_volume->object_map_btree,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to preload object map.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libfsapfs_object_map_free(
 	     &object_map,
 	     error ) != 1 )
@@ -1840,6 +1860,268 @@ int libfsapfs_volume_is_locked(
 	return( is_locked );
 }
 
+/* Sets the cache limits
+ * The maximum cache size is in bytes and applies to every individual B-tree node cache
+ * of the metadata B-trees of the volume, where 0 represents the limit set for the container
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_volume_set_cache_limits(
+     libfsapfs_volume_t *volume,
+     size64_t maximum_btree_nodes_cache_size,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsapfs_volume_set_cache_limits";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->maximum_btree_nodes_cache_size = maximum_btree_nodes_cache_size;
+
+	if( internal_volume->object_map_btree != NULL )
+	{
+		if( libfsapfs_object_map_btree_set_cache_limits(
+		     internal_volume->object_map_btree,
+		     maximum_btree_nodes_cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache limits of object map B-tree.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_volume->snapshot_metadata_tree != NULL ) )
+	{
+		if( libfsapfs_snapshot_metadata_tree_set_cache_limits(
+		     internal_volume->snapshot_metadata_tree,
+		     maximum_btree_nodes_cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache limits of snapshot metadata tree.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_volume->file_system_btree != NULL ) )
+	{
+		if( libfsapfs_file_system_btree_set_cache_limits(
+		     internal_volume->file_system_btree,
+		     maximum_btree_nodes_cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache limits of file system B-tree.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the object map cache statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_volume_get_object_map_cache_statistics(
+     libfsapfs_volume_t *volume,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsapfs_volume_get_object_map_cache_statistics";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_object_map_btree_get_cache_statistics(
+	     internal_volume->object_map_btree,
+	     number_of_cache_hits,
+	     number_of_cache_misses,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve object map cache statistics.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the memory used by the preloaded object map
+ * The object map is preloaded when the container is opened with LIBFSAPFS_ACCESS_FLAG_PRELOAD_OBJECT_MAP
+ * Returns 1 if successful, 0 if the object map was not preloaded or -1 on error
+ */
+int libfsapfs_volume_get_preloaded_object_map_size(
+     libfsapfs_volume_t *volume,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libfsapfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsapfs_volume_get_preloaded_object_map_size";
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsapfs_object_map_btree_get_index_size(
+	          internal_volume->object_map_btree,
+	          size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve object map index size.",
+		 function );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Sets an UTF-8 formatted password
  * This function needs to be used before one of the open or unlock functions
  * Returns 1 if successful, 0 if password is invalid or -1 on error
@@ -2588,6 +2870,7 @@ int libfsapfs_internal_volume_get_file_system_btree(
      libfsapfs_internal_volume_t *internal_volume,
      libcerror_error_t **error )
 {
+	libfsapfs_btree_node_t *root_node                        = NULL;
 	libfsapfs_object_map_descriptor_t *object_map_descriptor = NULL;
 	static char *function                                    = "libfsapfs_internal_volume_get_file_system_btree";
 	uint8_t use_case_folding                                 = 0;
@@ -2681,6 +2964,56 @@ int libfsapfs_internal_volume_get_file_system_btree(
 
 		goto on_error;
 	}
+	if( internal_volume->maximum_btree_nodes_cache_size != 0 )
+	{
+		if( libfsapfs_file_system_btree_set_cache_limits(
+		     internal_volume->file_system_btree,
+		     internal_volume->maximum_btree_nodes_cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache limits of file system B-tree.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Read the root node once so that lookups do not need to retrieve
+	 * and validate it again
+	 */
+	if( libfsapfs_file_system_btree_get_root_node(
+	     internal_volume->file_system_btree,
+	     internal_volume->file_io_handle,
+	     internal_volume->file_system_btree->root_node_block_number,
+	     &root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file system B-tree root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_system_btree_release_node(
+	     internal_volume->file_system_btree,
+	     &root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file system B-tree root node.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfsapfs_object_map_descriptor_free(
 	     &object_map_descriptor,
 	     error ) != 1 )
@@ -3009,6 +3342,194 @@ on_error:
 	return( -1 );
 }
 
+/* Scans the file system records
+ * The file system B-tree leaf nodes are walked once in key order and every record is parsed and passed to the callback function
+ * An inode record is passed as a file entry, followed by its extended attributes
+ * The file entries are not created from directory records hence their names and parent identifiers
+ * are those stored in the inodes
+ * The objects and values of a scan record are only valid while the callback function runs and must not be freed
+ * The volume is not locked while the callback function runs
+ * The callback function should return 1 to continue, 0 to stop the scan or -1 on error
+ * Returns 1 if successful or -1 on error
+ */
+int libfsapfs_volume_scan(
+     libfsapfs_volume_t *volume,
+     int (*callback_function)(
+            const libfsapfs_scan_record_t *scan_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle                     = NULL;
+	libfsapfs_encryption_context_t *encryption_context   = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree     = NULL;
+	libfsapfs_file_system_scanner_t *file_system_scanner = NULL;
+	libfsapfs_internal_volume_t *internal_volume         = NULL;
+	libfsapfs_io_handle_t *io_handle                     = NULL;
+	static char *function                                = "libfsapfs_volume_scan";
+	int result                                           = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsapfs_internal_volume_t *) volume;
+
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_system_btree == NULL )
+	{
+		if( libfsapfs_internal_volume_get_file_system_btree(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine file system B-tree.",
+			 function );
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_volume->read_write_lock,
+			 NULL );
+#endif
+			return( -1 );
+		}
+	}
+	io_handle          = internal_volume->io_handle;
+	file_io_handle     = internal_volume->file_io_handle;
+	encryption_context = internal_volume->encryption_context;
+	file_system_btree  = internal_volume->file_system_btree;
+
+#if defined( HAVE_LIBFSAPFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsapfs_file_system_scanner_initialize(
+	     &file_system_scanner,
+	     io_handle,
+	     file_io_handle,
+	     encryption_context,
+	     file_system_btree,
+	     callback_function,
+	     callback_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file system scanner.",
+		 function );
+
+		goto on_error;
+	}
+	/* The lock is not held during the scan so that the callback function
+	 * can use the volume, the file system B-tree is kept until the volume is closed
+	 */
+	if( libfsapfs_file_system_btree_scan(
+	     file_system_btree,
+	     file_io_handle,
+	     (int (*)(uint8_t, uint64_t, const uint8_t *, size_t, const uint8_t *, size_t, void *, libcerror_error_t **)) &libfsapfs_file_system_scanner_read_record,
+	     (void *) file_system_scanner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to scan file system B-tree.",
+		 function );
+
+		goto on_error;
+	}
+	/* The file entry of the last inode is still pending when the scan reaches the end of the B-tree
+	 */
+	result = libfsapfs_file_system_scanner_flush_file_entry(
+	          file_system_scanner,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to flush file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsapfs_file_system_scanner_free(
+	     &file_system_scanner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file system scanner.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_system_scanner != NULL )
+	{
+		libfsapfs_file_system_scanner_free(
+		 &file_system_scanner,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Retrieves the file entry for an UTF-8 encoded path
  * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
@@ -99,6 +99,10 @@ struct libfsapfs_internal_volume
 	 */
 	libfsapfs_file_system_btree_t *file_system_btree;
 
+	/* The maximum size of the B-tree nodes caches of the volume in bytes, where 0 represents the container limit
+	 */
+	size64_t maximum_btree_nodes_cache_size;
+
 	/* The IO handle
 	 */
 	libfsapfs_io_handle_t *io_handle;
@@ -217,6 +221,25 @@ int libfsapfs_volume_is_locked(
      libfsapfs_volume_t *volume,
      libcerror_error_t **error );
 
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_set_cache_limits(
+     libfsapfs_volume_t *volume,
+     size64_t maximum_btree_nodes_cache_size,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_get_object_map_cache_statistics(
+     libfsapfs_volume_t *volume,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_get_preloaded_object_map_size(
+     libfsapfs_volume_t *volume,
+     size64_t *size,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_volume_set_utf8_password(
      libfsapfs_volume_t *volume,
@@ -268,6 +291,16 @@ int libfsapfs_volume_get_root_directory(
      libfsapfs_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+LIBFSAPFS_EXTERN \
+int libfsapfs_volume_scan(
+     libfsapfs_volume_t *volume,
+     int (*callback_function)(
+            const libfsapfs_scan_record_t *scan_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
 LIBFSAPFS_EXTERN \
 int libfsapfs_volume_get_file_entry_by_utf8_path(
      libfsapfs_volume_t *volume,
@@ -0,0 +1,956 @@
+/*
+ * Library hardware accelerated AES functions test program
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_aes_ni.h"
+#include "../libfsapfs/libfsapfs_definitions.h"
+#include "../libfsapfs/libfsapfs_encryption_context.h"
+
+#define FSAPFS_TEST_AES_NI_BENCHMARK_DATA_SIZE	( 16 * 1024 * 1024 )
+
+uint8_t fsapfs_test_aes_ni_key[ 16 ] = {
+	0x27, 0x18, 0x28, 0x18, 0x28, 0x45, 0x90, 0x45, 0x23, 0x53, 0x60, 0x28, 0x74, 0x71, 0x35, 0x26 };
+
+uint8_t fsapfs_test_aes_ni_tweak_key[ 16 ] = {
+	0x31, 0x41, 0x59, 0x26, 0x53, 0x58, 0x97, 0x93, 0x23, 0x84, 0x62, 0x64, 0x33, 0x83, 0x27, 0x95 };
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Retrieves a timestamp in microseconds
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_aes_ni_get_timestamp(
+     int64_t *timestamp )
+{
+#if !defined( WINAPI )
+	struct timespec current_time;
+#endif
+
+	if( timestamp == NULL )
+	{
+		return( -1 );
+	}
+#if defined( WINAPI )
+	*timestamp = (int64_t) GetTickCount() * 1000;
+#else
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &current_time ) != 0 )
+	{
+		return( -1 );
+	}
+	*timestamp = ( (int64_t) current_time.tv_sec * 1000000 ) + ( current_time.tv_nsec / 1000 );
+#endif
+	return( 1 );
+}
+
+/* Tests the libfsapfs_aes_ni_get_support_flags function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_aes_ni_get_support_flags(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t support_flags    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_aes_ni_get_support_flags(
+	          &support_flags,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* VAES is only used in combination with AES-NI
+	 */
+	if( ( support_flags & LIBFSAPFS_AES_NI_SUPPORT_FLAG_VAES ) != 0 )
+	{
+		FSAPFS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "support_flags & LIBFSAPFS_AES_NI_SUPPORT_FLAG_AES_NI",
+		 (int) ( support_flags & LIBFSAPFS_AES_NI_SUPPORT_FLAG_AES_NI ),
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libfsapfs_aes_ni_get_support_flags(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_aes_ni_set_key function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_aes_ni_set_key(
+     void )
+{
+	uint8_t round_keys[ LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	uint8_t support_flags    = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_aes_ni_get_support_flags(
+	          &support_flags,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( ( support_flags & LIBFSAPFS_AES_NI_SUPPORT_FLAG_AES_NI ) == 0 )
+	{
+		return( 1 );
+	}
+	/* Test regular cases
+	 */
+	result = libfsapfs_aes_ni_set_key(
+	          round_keys,
+	          LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE,
+	          LIBCAES_CRYPT_MODE_ENCRYPT,
+	          fsapfs_test_aes_ni_key,
+	          128,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The first encryption round key is the key itself
+	 */
+	result = memory_compare(
+	          round_keys,
+	          fsapfs_test_aes_ni_key,
+	          16 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfsapfs_aes_ni_set_key(
+	          round_keys,
+	          LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE,
+	          LIBCAES_CRYPT_MODE_DECRYPT,
+	          fsapfs_test_aes_ni_key,
+	          128,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The last decryption round key is the key itself
+	 */
+	result = memory_compare(
+	          &( round_keys[ 160 ] ),
+	          fsapfs_test_aes_ni_key,
+	          16 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_aes_ni_set_key(
+	          NULL,
+	          LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE,
+	          LIBCAES_CRYPT_MODE_DECRYPT,
+	          fsapfs_test_aes_ni_key,
+	          128,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_ni_set_key(
+	          round_keys,
+	          16,
+	          LIBCAES_CRYPT_MODE_DECRYPT,
+	          fsapfs_test_aes_ni_key,
+	          128,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_ni_set_key(
+	          round_keys,
+	          LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE,
+	          LIBCAES_CRYPT_MODE_DECRYPT,
+	          NULL,
+	          128,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_ni_set_key(
+	          round_keys,
+	          LIBFSAPFS_AES_NI_ROUND_KEYS_SIZE,
+	          LIBCAES_CRYPT_MODE_DECRYPT,
+	          fsapfs_test_aes_ni_key,
+	          256,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_aes_ni_decrypt_xts function
+ * The output of every supported hardware AES path is compared with that of libcaes
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_aes_ni_decrypt_xts(
+     void )
+{
+	uint16_t bytes_per_sector_values[ 5 ] = { 16, 48, 512, 1040, 4096 };
+
+	libcerror_error_t *error                = NULL;
+	libfsapfs_encryption_context_t *context = NULL;
+	uint8_t *decrypted_data                 = NULL;
+	uint8_t *encrypted_data                 = NULL;
+	uint8_t *expected_data                  = NULL;
+	size_t data_offset                      = 0;
+	size_t data_size                        = 0;
+	uint16_t bytes_per_sector               = 0;
+	uint8_t support_flags                   = 0;
+	uint8_t support_flags_index             = 0;
+	uint8_t supported_flags                 = 0;
+	int result                              = 0;
+	int value_index                         = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_encryption_context_initialize(
+	          &context,
+	          LIBFSAPFS_ENCRYPTION_METHOD_AES_128_XTS,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_encryption_context_set_keys(
+	          context,
+	          fsapfs_test_aes_ni_key,
+	          16,
+	          fsapfs_test_aes_ni_tweak_key,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	supported_flags = context->aes_ni_support_flags;
+
+	if( ( supported_flags & LIBFSAPFS_AES_NI_SUPPORT_FLAG_AES_NI ) == 0 )
+	{
+		libfsapfs_encryption_context_free(
+		 &context,
+		 NULL );
+
+		return( 1 );
+	}
+	encrypted_data = (uint8_t *) memory_allocate(
+	                              4 * 4096 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "encrypted_data",
+	 encrypted_data );
+
+	expected_data = (uint8_t *) memory_allocate(
+	                             4 * 4096 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_data",
+	 expected_data );
+
+	decrypted_data = (uint8_t *) memory_allocate(
+	                              4 * 4096 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "decrypted_data",
+	 decrypted_data );
+
+	for( data_offset = 0;
+	     data_offset < ( 4 * 4096 );
+	     data_offset++ )
+	{
+		encrypted_data[ data_offset ] = (uint8_t) ( ( data_offset * 7 ) + ( data_offset >> 8 ) );
+	}
+	/* Test regular cases
+	 */
+	for( value_index = 0;
+	     value_index < 5;
+	     value_index++ )
+	{
+		bytes_per_sector = bytes_per_sector_values[ value_index ];
+		data_size        = 4 * (size_t) bytes_per_sector;
+
+		context->aes_ni_support_flags = 0;
+
+		result = libfsapfs_encryption_context_crypt(
+		          context,
+		          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		          encrypted_data,
+		          data_size,
+		          expected_data,
+		          data_size,
+		          0xfffffffffffffffeUL,
+		          bytes_per_sector,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( support_flags_index = 0;
+		     support_flags_index < 2;
+		     support_flags_index++ )
+		{
+			if( support_flags_index == 0 )
+			{
+				support_flags = LIBFSAPFS_AES_NI_SUPPORT_FLAG_AES_NI;
+			}
+			else if( ( supported_flags & LIBFSAPFS_AES_NI_SUPPORT_FLAG_VAES ) != 0 )
+			{
+				support_flags = supported_flags;
+			}
+			else
+			{
+				break;
+			}
+			context->aes_ni_support_flags = support_flags;
+
+			result = libfsapfs_encryption_context_crypt(
+			          context,
+			          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+			          encrypted_data,
+			          data_size,
+			          decrypted_data,
+			          data_size,
+			          0xfffffffffffffffeUL,
+			          bytes_per_sector,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          decrypted_data,
+			          expected_data,
+			          data_size );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			/* Test decrypting in place
+			 */
+			result = memory_copy(
+			          decrypted_data,
+			          encrypted_data,
+			          data_size ) != NULL;
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			result = libfsapfs_aes_ni_decrypt_xts(
+			          support_flags,
+			          context->aes_ni_data_round_keys,
+			          context->aes_ni_tweak_round_keys,
+			          decrypted_data,
+			          decrypted_data,
+			          data_size,
+			          0xfffffffffffffffeUL,
+			          bytes_per_sector,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          decrypted_data,
+			          expected_data,
+			          data_size );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	context->aes_ni_support_flags = supported_flags;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_aes_ni_decrypt_xts(
+	          0,
+	          context->aes_ni_data_round_keys,
+	          context->aes_ni_tweak_round_keys,
+	          encrypted_data,
+	          decrypted_data,
+	          512,
+	          0,
+	          512,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_ni_decrypt_xts(
+	          supported_flags,
+	          NULL,
+	          context->aes_ni_tweak_round_keys,
+	          encrypted_data,
+	          decrypted_data,
+	          512,
+	          0,
+	          512,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_ni_decrypt_xts(
+	          supported_flags,
+	          context->aes_ni_data_round_keys,
+	          context->aes_ni_tweak_round_keys,
+	          NULL,
+	          decrypted_data,
+	          512,
+	          0,
+	          512,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_ni_decrypt_xts(
+	          supported_flags,
+	          context->aes_ni_data_round_keys,
+	          context->aes_ni_tweak_round_keys,
+	          encrypted_data,
+	          decrypted_data,
+	          512,
+	          0,
+	          24,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_aes_ni_decrypt_xts(
+	          supported_flags,
+	          context->aes_ni_data_round_keys,
+	          context->aes_ni_tweak_round_keys,
+	          encrypted_data,
+	          decrypted_data,
+	          500,
+	          0,
+	          512,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 decrypted_data );
+
+	decrypted_data = NULL;
+
+	memory_free(
+	 expected_data );
+
+	expected_data = NULL;
+
+	memory_free(
+	 encrypted_data );
+
+	encrypted_data = NULL;
+
+	result = libfsapfs_encryption_context_free(
+	          &context,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( decrypted_data != NULL )
+	{
+		memory_free(
+		 decrypted_data );
+	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	if( encrypted_data != NULL )
+	{
+		memory_free(
+		 encrypted_data );
+	}
+	if( context != NULL )
+	{
+		libfsapfs_encryption_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Benchmarks the AES-XTS decryption paths
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_aes_ni_benchmark(
+     void )
+{
+	const char *path_names[ 3 ]             = { "libcaes", "AES-NI", "VAES" };
+	uint8_t path_support_flags[ 3 ]         = { 0, LIBFSAPFS_AES_NI_SUPPORT_FLAG_AES_NI, LIBFSAPFS_AES_NI_SUPPORT_FLAG_AES_NI | LIBFSAPFS_AES_NI_SUPPORT_FLAG_VAES };
+
+	libcerror_error_t *error                = NULL;
+	libfsapfs_encryption_context_t *context = NULL;
+	uint8_t *data                           = NULL;
+	int64_t duration                        = 0;
+	int64_t start_timestamp                 = 0;
+	int64_t stop_timestamp                  = 0;
+	uint64_t throughput                     = 0;
+	uint8_t supported_flags                 = 0;
+	int path_index                          = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_encryption_context_initialize(
+	          &context,
+	          LIBFSAPFS_ENCRYPTION_METHOD_AES_128_XTS,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_encryption_context_set_keys(
+	          context,
+	          fsapfs_test_aes_ni_key,
+	          16,
+	          fsapfs_test_aes_ni_tweak_key,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	supported_flags = context->aes_ni_support_flags;
+
+	data = (uint8_t *) memory_allocate(
+	                    FSAPFS_TEST_AES_NI_BENCHMARK_DATA_SIZE );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	result = memory_set(
+	          data,
+	          0xa5,
+	          FSAPFS_TEST_AES_NI_BENCHMARK_DATA_SIZE ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	for( path_index = 0;
+	     path_index < 3;
+	     path_index++ )
+	{
+		if( ( path_support_flags[ path_index ] & supported_flags ) != path_support_flags[ path_index ] )
+		{
+			continue;
+		}
+		context->aes_ni_support_flags = path_support_flags[ path_index ];
+
+		result = fsapfs_test_aes_ni_get_timestamp(
+		          &start_timestamp );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libfsapfs_encryption_context_crypt(
+		          context,
+		          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		          data,
+		          FSAPFS_TEST_AES_NI_BENCHMARK_DATA_SIZE,
+		          data,
+		          FSAPFS_TEST_AES_NI_BENCHMARK_DATA_SIZE,
+		          0,
+		          512,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = fsapfs_test_aes_ni_get_timestamp(
+		          &stop_timestamp );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		duration = stop_timestamp - start_timestamp;
+
+		if( duration <= 0 )
+		{
+			duration = 1;
+		}
+		/* Throughput in MB/s, which is printed as GB/s
+		 */
+		throughput = (uint64_t) FSAPFS_TEST_AES_NI_BENCHMARK_DATA_SIZE / (uint64_t) duration;
+
+		fprintf(
+		 stdout,
+		 "AES-XTS decryption using %s: %d bytes in %" PRIi64 " us (%" PRIu64 ".%03" PRIu64 " GB/s)\n",
+		 path_names[ path_index ],
+		 FSAPFS_TEST_AES_NI_BENCHMARK_DATA_SIZE,
+		 duration,
+		 throughput / 1000,
+		 throughput % 1000 );
+	}
+	context->aes_ni_support_flags = supported_flags;
+
+	/* Clean up
+	 */
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	result = libfsapfs_encryption_context_free(
+	          &context,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( context != NULL )
+	{
+		libfsapfs_encryption_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_aes_ni_get_support_flags",
+	 fsapfs_test_aes_ni_get_support_flags );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_aes_ni_set_key",
+	 fsapfs_test_aes_ni_set_key );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_aes_ni_decrypt_xts",
+	 fsapfs_test_aes_ni_decrypt_xts );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_aes_ni_benchmark",
+	 fsapfs_test_aes_ni_benchmark );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
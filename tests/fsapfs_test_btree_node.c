@@ -309,7 +309,7 @@ int fsapfs_test_btree_node_initialize(
 	int result                         = 0;
 
 #if defined( HAVE_FSAPFS_TEST_MEMORY )
-	int number_of_malloc_fail_tests    = 2;
+	int number_of_malloc_fail_tests    = 1;
 	int number_of_memset_fail_tests    = 1;
 	int test_number                    = 0;
 #endif
@@ -775,7 +775,7 @@ int fsapfs_test_btree_node_read_data(
 
 #if defined( HAVE_FSAPFS_TEST_MEMORY )
 
-	/* Test libfsapfs_btree_node_read_data with malloc failing in libfsapfs_btree_entry_initialize
+	/* Test libfsapfs_btree_node_read_data with malloc failing when creating the data
 	 */
 	fsapfs_test_malloc_attempts_before_fail = 2;
 
@@ -805,6 +805,38 @@ int fsapfs_test_btree_node_read_data(
 	}
 #endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
 
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	/* Test libfsapfs_btree_node_read_data with malloc failing when creating the entries
+	 */
+	fsapfs_test_malloc_attempts_before_fail = 3;
+
+	result = libfsapfs_btree_node_read_data(
+	          btree_node,
+	          fsapfs_test_btree_node_data1,
+	          4096,
+	          &error );
+
+	if( fsapfs_test_malloc_attempts_before_fail != -1 )
+	{
+		fsapfs_test_malloc_attempts_before_fail = -1;
+	}
+	else
+	{
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
 	/* Clean up
 	 */
 	result = libfsapfs_btree_node_free(
@@ -1201,6 +1233,14 @@ int fsapfs_test_btree_node_get_entry_by_index(
 	 result,
 	 1 );
 
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_entry",
+	 btree_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_entry->key_data",
+	 btree_entry->key_data );
+
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
@@ -1225,6 +1265,42 @@ int fsapfs_test_btree_node_get_entry_by_index(
 	libcerror_error_free(
 	 &error );
 
+	result = libfsapfs_btree_node_get_entry_by_index(
+	          btree_node,
+	          -1,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_btree_node_get_entry_by_index(
+	          btree_node,
+	          6,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
 	result = libfsapfs_btree_node_get_entry_by_index(
 	          btree_node,
 	          0,
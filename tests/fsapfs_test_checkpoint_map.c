@@ -29,6 +29,7 @@
 #endif
 
 #include "fsapfs_test_functions.h"
+#include "fsapfs_test_libcdata.h"
 #include "fsapfs_test_libcerror.h"
 #include "fsapfs_test_libfsapfs.h"
 #include "fsapfs_test_macros.h"
@@ -36,6 +37,7 @@
 #include "fsapfs_test_unused.h"
 
 #include "../libfsapfs/libfsapfs_checkpoint_map.h"
+#include "../libfsapfs/libfsapfs_checkpoint_map_entry.h"
 
 uint8_t fsapfs_test_checkpoint_map_data1[ 4096 ] = {
 	0x96, 0xb2, 0x61, 0x3f, 0x2d, 0x25, 0x9e, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -1033,6 +1035,407 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_checkpoint_map_build_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_checkpoint_map_build_index(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libfsapfs_checkpoint_map_t *checkpoint_map  = NULL;
+	libfsapfs_checkpoint_map_entry_t *map_entry = NULL;
+	uint64_t physical_address                   = 0;
+	int entry_index                             = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_checkpoint_map_initialize(
+	          &checkpoint_map,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "checkpoint_map",
+	 checkpoint_map );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Add the entries in descending object identifier order
+	 */
+	for( entry_index = 0;
+	     entry_index < 7;
+	     entry_index++ )
+	{
+		result = libfsapfs_checkpoint_map_entry_initialize(
+		          &map_entry,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "map_entry",
+		 map_entry );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		map_entry->object_identifier = (uint64_t) ( 1030 - entry_index );
+		map_entry->physical_address  = (uint64_t) ( 15 - entry_index );
+
+		result = libcdata_array_append_entry(
+		          checkpoint_map->entries_array,
+		          &result,
+		          (intptr_t *) map_entry,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		map_entry = NULL;
+	}
+	/* Test regular cases
+	 */
+	result = libfsapfs_checkpoint_map_build_index(
+	          checkpoint_map,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "checkpoint_map->number_of_index_entries",
+	 checkpoint_map->number_of_index_entries,
+	 7 );
+
+	/* The root of the implicit tree is the median entry
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "checkpoint_map->index_entries[ 1 ].object_identifier",
+	 checkpoint_map->index_entries[ 1 ].object_identifier,
+	 (uint64_t) 1027 );
+
+	for( entry_index = 0;
+	     entry_index < 7;
+	     entry_index++ )
+	{
+		result = libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
+		          checkpoint_map,
+		          (uint64_t) ( 1024 + entry_index ),
+		          &physical_address,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+		 "physical_address",
+		 physical_address,
+		 (uint64_t) ( 9 + entry_index ) );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Add the entries of a second block, which interleave with those of the first block
+	 */
+	for( entry_index = 0;
+	     entry_index < 5;
+	     entry_index++ )
+	{
+		result = libfsapfs_checkpoint_map_entry_initialize(
+		          &map_entry,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "map_entry",
+		 map_entry );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		map_entry->object_identifier = (uint64_t) ( 2048 + ( ( entry_index * 3 ) % 5 ) );
+		map_entry->physical_address  = (uint64_t) ( 32 + ( ( entry_index * 3 ) % 5 ) );
+
+		result = libcdata_array_append_entry(
+		          checkpoint_map->entries_array,
+		          &result,
+		          (intptr_t *) map_entry,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		map_entry = NULL;
+	}
+	result = libfsapfs_checkpoint_map_entry_initialize(
+	          &map_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "map_entry",
+	 map_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	map_entry->object_identifier = 16;
+	map_entry->physical_address  = 8;
+
+	result = libcdata_array_append_entry(
+	          checkpoint_map->entries_array,
+	          &result,
+	          (intptr_t *) map_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	map_entry = NULL;
+
+	result = libfsapfs_checkpoint_map_build_index(
+	          checkpoint_map,
+	          7,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "checkpoint_map->number_of_index_entries",
+	 checkpoint_map->number_of_index_entries,
+	 13 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "checkpoint_map->number_of_sorted_entries",
+	 checkpoint_map->number_of_sorted_entries,
+	 13 );
+
+	for( entry_index = 1;
+	     entry_index < 13;
+	     entry_index++ )
+	{
+		FSAPFS_TEST_ASSERT_LESS_THAN_UINT64(
+		 "checkpoint_map->sorted_entries[ entry_index - 1 ].object_identifier",
+		 checkpoint_map->sorted_entries[ entry_index - 1 ].object_identifier,
+		 checkpoint_map->sorted_entries[ entry_index ].object_identifier );
+	}
+	for( entry_index = 0;
+	     entry_index < 7;
+	     entry_index++ )
+	{
+		result = libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
+		          checkpoint_map,
+		          (uint64_t) ( 1024 + entry_index ),
+		          &physical_address,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+		 "physical_address",
+		 physical_address,
+		 (uint64_t) ( 9 + entry_index ) );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( entry_index = 0;
+	     entry_index < 5;
+	     entry_index++ )
+	{
+		result = libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
+		          checkpoint_map,
+		          (uint64_t) ( 2048 + entry_index ),
+		          &physical_address,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+		 "physical_address",
+		 physical_address,
+		 (uint64_t) ( 32 + entry_index ) );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
+	          checkpoint_map,
+	          16,
+	          &physical_address,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "physical_address",
+	 physical_address,
+	 (uint64_t) 8 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
+	          checkpoint_map,
+	          1031,
+	          &physical_address,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_checkpoint_map_build_index(
+	          NULL,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_checkpoint_map_build_index(
+	          checkpoint_map,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_checkpoint_map_free(
+	          &checkpoint_map,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "checkpoint_map",
+	 checkpoint_map );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( map_entry != NULL )
+	{
+		libfsapfs_checkpoint_map_entry_free(
+		 &map_entry,
+		 NULL );
+	}
+	if( checkpoint_map != NULL )
+	{
+		libfsapfs_checkpoint_map_free(
+		 &checkpoint_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libfsapfs_checkpoint_map_get_physical_address_by_object_identifier function
  * Returns 1 if successful or 0 if not
  */
@@ -1080,6 +1483,41 @@ int fsapfs_checkpoint_map_get_physical_address_by_object_identifier(
 	 "error",
 	 error );
 
+	result = libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
+	          checkpoint_map,
+	          1025,
+	          &physical_address,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "physical_address",
+	 physical_address,
+	 (uint64_t) 10 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
+	          checkpoint_map,
+	          1026,
+	          &physical_address,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test error cases
 	 */
 	result = libfsapfs_checkpoint_map_get_physical_address_by_object_identifier(
@@ -1171,6 +1609,12 @@ int main(
 	 "libfsapfs_checkpoint_map_read_data",
 	 fsapfs_test_checkpoint_map_read_data );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_checkpoint_map_build_index",
+	 fsapfs_test_checkpoint_map_build_index );
+
+	/* TODO: add tests for libfsapfs_checkpoint_map_fill_index */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 
 	/* Initialize test
@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -36,7 +38,14 @@
 
 #include "../libfsapfs/libfsapfs_compressed_data_handle.h"
 #include "../libfsapfs/libfsapfs_data_stream.h"
+#include "../libfsapfs/libfsapfs_decompressed_block_cache.h"
 #include "../libfsapfs/libfsapfs_definitions.h"
+#include "../libfsapfs/libfsapfs_io_handle.h"
+
+#define FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE			65536
+#define FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_BLOCKS		4
+#define FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_INTERLEAVED_READS	64
+#define FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_LARGE_READ_BLOCKS	40
 
 uint8_t fsapfs_test_compressed_data_handle_lzvn_compressed_data1[ 35 ] = {
 	0x66, 0x70, 0x6d, 0x63, 0x07, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -87,6 +96,7 @@ int fsapfs_test_compressed_data_handle_initialize(
 	 */
 	result = libfsapfs_compressed_data_handle_initialize(
 	          &compressed_data_handle,
+	          NULL,
 	          compressed_data_stream,
 	          16,
 	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
@@ -125,6 +135,7 @@ int fsapfs_test_compressed_data_handle_initialize(
 	/* Test error cases
 	 */
 	result = libfsapfs_compressed_data_handle_initialize(
+	          NULL,
 	          NULL,
 	          compressed_data_stream,
 	          16,
@@ -147,6 +158,7 @@ int fsapfs_test_compressed_data_handle_initialize(
 
 	result = libfsapfs_compressed_data_handle_initialize(
 	          &compressed_data_handle,
+	          NULL,
 	          compressed_data_stream,
 	          16,
 	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
@@ -169,6 +181,7 @@ int fsapfs_test_compressed_data_handle_initialize(
 	result = libfsapfs_compressed_data_handle_initialize(
 	          &compressed_data_handle,
 	          NULL,
+	          NULL,
 	          16,
 	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
 	          &error );
@@ -187,6 +200,7 @@ int fsapfs_test_compressed_data_handle_initialize(
 
 	result = libfsapfs_compressed_data_handle_initialize(
 	          &compressed_data_handle,
+	          NULL,
 	          compressed_data_stream,
 	          16,
 	          -1,
@@ -216,6 +230,7 @@ int fsapfs_test_compressed_data_handle_initialize(
 
 		result = libfsapfs_compressed_data_handle_initialize(
 		          &compressed_data_handle,
+		          NULL,
 		          compressed_data_stream,
 		          16,
 		          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
@@ -261,6 +276,7 @@ int fsapfs_test_compressed_data_handle_initialize(
 
 		result = libfsapfs_compressed_data_handle_initialize(
 		          &compressed_data_handle,
+		          NULL,
 		          compressed_data_stream,
 		          16,
 		          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
@@ -429,6 +445,7 @@ int fsapfs_test_compressed_data_handle_get_compressed_block_offsets(
 
 	result = libfsapfs_compressed_data_handle_initialize(
 	          &compressed_data_handle,
+	          NULL,
 	          compressed_data_stream,
 	          16,
 	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
@@ -578,6 +595,7 @@ int fsapfs_test_compressed_data_handle_read_segment_data(
 
 	result = libfsapfs_compressed_data_handle_initialize(
 	          &compressed_data_handle,
+	          NULL,
 	          compressed_data_stream,
 	          16,
 	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
@@ -752,24 +770,162 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libfsapfs_compressed_data_handle_seek_segment_offset function
+/* Creates DEFLATE compressed data with uncompressed (stored) blocks
+ * Every block is filled with its own byte value, the last block only contains 4096 bytes
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_compressed_data_handle_create_deflate_compressed_data(
+     uint32_t number_of_blocks,
+     uint8_t **compressed_data,
+     size_t *compressed_data_size,
+     size64_t *uncompressed_data_size )
+{
+	uint8_t *safe_compressed_data = NULL;
+	size_t block_size             = 0;
+	size_t data_offset            = 0;
+	size_t safe_data_size         = 0;
+	uint32_t block_index          = 0;
+	uint32_t block_offset         = 0;
+
+	if( ( number_of_blocks == 0 )
+	 || ( number_of_blocks > 64 )
+	 || ( compressed_data == NULL )
+	 || ( compressed_data_size == NULL )
+	 || ( uncompressed_data_size == NULL ) )
+	{
+		return( -1 );
+	}
+	/* The header, the number of blocks, the block descriptors, the blocks and a 16-byte footer
+	 */
+	safe_data_size = 264 + ( number_of_blocks * 8 )
+	               + ( ( number_of_blocks - 1 ) * ( FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1 ) )
+	               + ( 4096 + 1 ) + 16;
+
+	safe_compressed_data = (uint8_t *) memory_allocate(
+	                                    sizeof( uint8_t ) * safe_data_size );
+
+	if( safe_compressed_data == NULL )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     safe_compressed_data,
+	     0,
+	     safe_data_size ) == NULL )
+	{
+		memory_free(
+		 safe_compressed_data );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( safe_compressed_data[ 0 ] ),
+	 0x00000100UL );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( safe_compressed_data[ 4 ] ),
+	 (uint32_t) ( safe_data_size - 16 ) );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( safe_compressed_data[ 12 ] ),
+	 16 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( safe_compressed_data[ 260 ] ),
+	 number_of_blocks );
+
+	/* The block offsets are relative to the number of blocks
+	 */
+	block_offset = 4 + ( number_of_blocks * 8 );
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( block_index == ( number_of_blocks - 1 ) )
+		{
+			block_size = 4096 + 1;
+		}
+		else
+		{
+			block_size = FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 &( safe_compressed_data[ 264 + ( block_index * 8 ) ] ),
+		 block_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( safe_compressed_data[ 264 + ( block_index * 8 ) + 4 ] ),
+		 (uint32_t) block_size );
+
+		data_offset = 260 + block_offset;
+
+		/* A block that starts with 0xff is stored uncompressed
+		 */
+		safe_compressed_data[ data_offset ] = 0xff;
+
+		if( memory_set(
+		     &( safe_compressed_data[ data_offset + 1 ] ),
+		     (int) ( 'A' + block_index ),
+		     block_size - 1 ) == NULL )
+		{
+			memory_free(
+			 safe_compressed_data );
+
+			return( -1 );
+		}
+		block_offset += (uint32_t) block_size;
+	}
+	*compressed_data        = safe_compressed_data;
+	*compressed_data_size   = safe_data_size;
+	*uncompressed_data_size = ( ( number_of_blocks - 1 ) * FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ) + 4096;
+
+	return( 1 );
+}
+
+/* Tests interleaved reads of the libfsapfs_compressed_data_handle_read_segment_data function
+ * The decompressed blocks are expected to be cached so that every block is decompressed once
  * Returns 1 if successful or 0 if not
  */
-int fsapfs_test_compressed_data_handle_seek_segment_offset(
+int fsapfs_test_compressed_data_handle_read_segment_data_interleaved(
      void )
 {
+	uint8_t segment_data[ 512 ];
+
+	uint32_t block_order[ FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_BLOCKS ] = { 0, 2, 1, 3 };
+
 	libcerror_error_t *error                                   = NULL;
 	libfdata_stream_t *compressed_data_stream                  = NULL;
 	libfsapfs_compressed_data_handle_t *compressed_data_handle = NULL;
+	uint8_t *compressed_data                                   = NULL;
+	size64_t uncompressed_data_size                            = 0;
+	size_t compressed_data_size                                = 0;
+	ssize_t read_count                                         = 0;
 	off64_t offset                                             = 0;
+	off64_t segment_offset                                     = 0;
+	uint64_t number_of_hits                                    = 0;
+	uint64_t number_of_misses                                  = 0;
+	uint32_t block_index                                       = 0;
+	int read_index                                             = 0;
 	int result                                                 = 0;
 
 	/* Initialize test
 	 */
+	result = fsapfs_test_compressed_data_handle_create_deflate_compressed_data(
+	          FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_BLOCKS,
+	          &compressed_data,
+	          &compressed_data_size,
+	          &uncompressed_data_size );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
 	result = libfsapfs_data_stream_initialize_from_data(
 	          &compressed_data_stream,
-	          fsapfs_test_compressed_data_handle_lzvn_compressed_data1,
-	          35,
+	          compressed_data,
+	          compressed_data_size,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -787,9 +943,10 @@ int fsapfs_test_compressed_data_handle_seek_segment_offset(
 
 	result = libfsapfs_compressed_data_handle_initialize(
 	          &compressed_data_handle,
+	          NULL,
 	          compressed_data_stream,
-	          16,
-	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
+	          uncompressed_data_size,
+	          LIBFSAPFS_COMPRESSION_METHOD_DEFLATE,
 	          &error );
 
 	FSAPFS_TEST_ASSERT_EQUAL_INT(
@@ -807,84 +964,935 @@ int fsapfs_test_compressed_data_handle_seek_segment_offset(
 
 	/* Test regular cases
 	 */
-	offset = libfsapfs_compressed_data_handle_seek_segment_offset(
-	          compressed_data_handle,
-	          NULL,
-	          0,
-	          0,
-	          0,
+	for( read_index = 0;
+	     read_index < FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_INTERLEAVED_READS;
+	     read_index++ )
+	{
+		block_index = block_order[ read_index % FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_BLOCKS ];
+		offset      = ( ( read_index / FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_BLOCKS ) * 512 ) % 4096;
+
+		segment_offset = libfsapfs_compressed_data_handle_seek_segment_offset(
+		                  compressed_data_handle,
+		                  NULL,
+		                  0,
+		                  0,
+		                  ( (off64_t) block_index * FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ) + offset,
+		                  &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT64(
+		 "segment_offset",
+		 (int64_t) segment_offset,
+		 (int64_t) ( ( (off64_t) block_index * FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE ) + offset ) );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libfsapfs_compressed_data_handle_read_segment_data(
+		              compressed_data_handle,
+		              NULL,
+		              0,
+		              0,
+		              segment_data,
+		              512,
+		              0,
+		              0,
+		              &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 512 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+		 "segment_data[ 0 ]",
+		 segment_data[ 0 ],
+		 (uint8_t) ( 'A' + block_index ) );
+
+		FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+		 "segment_data[ 511 ]",
+		 segment_data[ 511 ],
+		 (uint8_t) ( 'A' + block_index ) );
+	}
+	result = libfsapfs_decompressed_block_cache_get_statistics(
+	          compressed_data_handle->block_cache,
+	          &number_of_hits,
+	          &number_of_misses,
 	          &error );
 
-	FSAPFS_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
+	fprintf(
+	 stdout,
+	 "Interleaved reads: %d reads of %d blocks required %" PRIu64 " decompressions\n",
+	 FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_INTERLEAVED_READS,
+	 FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_BLOCKS,
+	 number_of_misses );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_BLOCKS );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) ( FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_INTERLEAVED_READS - FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_BLOCKS ) );
+
+	/* Clean up
 	 */
-	offset = libfsapfs_compressed_data_handle_seek_segment_offset(
-	          NULL,
-	          NULL,
-	          0,
-	          0,
-	          0,
+	result = libfsapfs_compressed_data_handle_free(
+	          &compressed_data_handle,
 	          &error );
 
-	FSAPFS_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_data_handle",
+	 compressed_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = libfdata_stream_free(
+	          &compressed_data_stream,
+	          &error );
 
-	offset = libfsapfs_compressed_data_handle_seek_segment_offset(
-	          compressed_data_handle,
-	          NULL,
-	          -1,
-	          0,
-	          0,
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_data_stream",
+	 compressed_data_stream );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 compressed_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_data_handle != NULL )
+	{
+		libfsapfs_compressed_data_handle_free(
+		 &compressed_data_handle,
+		 NULL );
+	}
+	if( compressed_data_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &compressed_data_stream,
+		 NULL );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( 0 );
+}
+
+/* Tests reads of the libfsapfs_compressed_data_handle_read_segment_data function
+ * that span multiple compressed blocks
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_data_handle_read_segment_data_multiple_blocks(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfdata_stream_t *compressed_data_stream                  = NULL;
+	libfsapfs_compressed_data_handle_t *compressed_data_handle = NULL;
+	uint8_t *compressed_data                                   = NULL;
+	uint8_t *uncompressed_data                                 = NULL;
+	size64_t uncompressed_data_size                            = 0;
+	size_t compressed_data_size                                = 0;
+	size_t data_offset                                         = 0;
+	ssize_t read_count                                         = 0;
+	uint64_t number_of_hits                                    = 0;
+	uint64_t number_of_misses                                  = 0;
+	uint32_t block_index                                       = 0;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = fsapfs_test_compressed_data_handle_create_deflate_compressed_data(
+	          FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_LARGE_READ_BLOCKS,
+	          &compressed_data,
+	          &compressed_data_size,
+	          &uncompressed_data_size );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * (size_t) uncompressed_data_size );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	result = libfsapfs_data_stream_initialize_from_data(
+	          &compressed_data_stream,
+	          compressed_data,
+	          compressed_data_size,
 	          &error );
 
-	FSAPFS_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_stream",
+	 compressed_data_stream );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	offset = libfsapfs_compressed_data_handle_seek_segment_offset(
-	          compressed_data_handle,
+	result = libfsapfs_compressed_data_handle_initialize(
+	          &compressed_data_handle,
 	          NULL,
-	          0,
-	          0,
-	          -1,
+	          compressed_data_stream,
+	          uncompressed_data_size,
+	          LIBFSAPFS_COMPRESSION_METHOD_DEFLATE,
 	          &error );
 
-	FSAPFS_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_handle",
+	 compressed_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	/* Test regular cases
+	 */
+	read_count = libfsapfs_compressed_data_handle_read_segment_data(
+	              compressed_data_handle,
+	              NULL,
+	              0,
+	              0,
+	              uncompressed_data,
+	              (size_t) uncompressed_data_size,
+	              0,
+	              0,
+	              &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) uncompressed_data_size );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_index = 0;
+	     block_index < FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_LARGE_READ_BLOCKS;
+	     block_index++ )
+	{
+		data_offset = (size_t) block_index * FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+
+		FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+		 "uncompressed_data[ data_offset ]",
+		 uncompressed_data[ data_offset ],
+		 (uint8_t) ( 'A' + block_index ) );
+
+		if( block_index < ( FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_LARGE_READ_BLOCKS - 1 ) )
+		{
+			data_offset += FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE - 1;
+		}
+		else
+		{
+			data_offset += 4096 - 1;
+		}
+		FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+		 "uncompressed_data[ data_offset ]",
+		 uncompressed_data[ data_offset ],
+		 (uint8_t) ( 'A' + block_index ) );
+	}
+	/* Every block is decompressed once
+	 */
+	result = libfsapfs_decompressed_block_cache_get_statistics(
+	          compressed_data_handle->block_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_LARGE_READ_BLOCKS );
+
+	/* Clean up
+	 */
+	result = libfsapfs_compressed_data_handle_free(
+	          &compressed_data_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_data_handle",
+	 compressed_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_stream_free(
+	          &compressed_data_stream,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_data_stream",
+	 compressed_data_stream );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 uncompressed_data );
+
+	memory_free(
+	 compressed_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_data_handle != NULL )
+	{
+		libfsapfs_compressed_data_handle_free(
+		 &compressed_data_handle,
+		 NULL );
+	}
+	if( compressed_data_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &compressed_data_stream,
+		 NULL );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Tests reads of the libfsapfs_compressed_data_handle_read_segment_data function
+ * that are decompressed in parallel using a decompression pool
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_data_handle_read_segment_data_parallel(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfdata_stream_t *compressed_data_stream                  = NULL;
+	libfsapfs_compressed_data_handle_t *compressed_data_handle = NULL;
+	libfsapfs_io_handle_t *io_handle                           = NULL;
+	uint8_t *compressed_data                                   = NULL;
+	uint8_t *uncompressed_data                                 = NULL;
+	size64_t uncompressed_data_size                            = 0;
+	size_t compressed_data_size                                = 0;
+	size_t data_offset                                         = 0;
+	ssize_t read_count                                         = 0;
+	uint64_t number_of_hits                                    = 0;
+	uint64_t number_of_misses                                  = 0;
+	uint32_t block_index                                       = 0;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = fsapfs_test_compressed_data_handle_create_deflate_compressed_data(
+	          FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_LARGE_READ_BLOCKS,
+	          &compressed_data,
+	          &compressed_data_size,
+	          &uncompressed_data_size );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * (size_t) uncompressed_data_size );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_set_number_of_job_threads(
+	          io_handle,
+	          LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION,
+	          4,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_data_stream_initialize_from_data(
+	          &compressed_data_stream,
+	          compressed_data,
+	          compressed_data_size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_stream",
+	 compressed_data_stream );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_data_handle_initialize(
+	          &compressed_data_handle,
+	          io_handle,
+	          compressed_data_stream,
+	          uncompressed_data_size,
+	          LIBFSAPFS_COMPRESSION_METHOD_DEFLATE,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_handle",
+	 compressed_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The decompressed block cache and the compressed blocks data are counted against
+	 * the cache size budget of the IO handle
+	 */
+	FSAPFS_TEST_ASSERT_NOT_EQUAL_INT(
+	 "compressed_data_handle->number_of_reserved_block_cache_entries",
+	 compressed_data_handle->number_of_reserved_block_cache_entries,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_NOT_EQUAL_INT(
+	 "compressed_data_handle->number_of_reserved_read_blocks",
+	 compressed_data_handle->number_of_reserved_read_blocks,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->cache_size",
+	 io_handle->cache_size,
+	 ( (uint64_t) compressed_data_handle->number_of_reserved_block_cache_entries * FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE )
+	 + ( (uint64_t) compressed_data_handle->number_of_reserved_read_blocks * ( FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE + 1 ) ) );
+
+	/* Test regular cases
+	 */
+	read_count = libfsapfs_compressed_data_handle_read_segment_data(
+	              compressed_data_handle,
+	              NULL,
+	              0,
+	              0,
+	              uncompressed_data,
+	              (size_t) uncompressed_data_size,
+	              0,
+	              0,
+	              &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) uncompressed_data_size );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_index = 0;
+	     block_index < FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_LARGE_READ_BLOCKS;
+	     block_index++ )
+	{
+		data_offset = (size_t) block_index * FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+
+		FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+		 "uncompressed_data[ data_offset ]",
+		 uncompressed_data[ data_offset ],
+		 (uint8_t) ( 'A' + block_index ) );
+
+		if( block_index < ( FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_LARGE_READ_BLOCKS - 1 ) )
+		{
+			data_offset += FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE - 1;
+		}
+		else
+		{
+			data_offset += 4096 - 1;
+		}
+		FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+		 "uncompressed_data[ data_offset ]",
+		 uncompressed_data[ data_offset ],
+		 (uint8_t) ( 'A' + block_index ) );
+	}
+	/* Only the last block, which is not a full block, is read through the decompressed block cache
+	 */
+	result = libfsapfs_decompressed_block_cache_get_statistics(
+	          compressed_data_handle->block_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 1 );
+
+	/* Clean up
+	 */
+	result = libfsapfs_compressed_data_handle_free(
+	          &compressed_data_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_data_handle",
+	 compressed_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->cache_size",
+	 io_handle->cache_size,
+	 (uint64_t) 0 );
+
+	/* Test with the cache size budget of the IO handle exhausted
+	 */
+	result = libfsapfs_io_handle_set_cache_limits(
+	          io_handle,
+	          0,
+	          0,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_data_handle_initialize(
+	          &compressed_data_handle,
+	          io_handle,
+	          compressed_data_stream,
+	          uncompressed_data_size,
+	          LIBFSAPFS_COMPRESSION_METHOD_DEFLATE,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_handle",
+	 compressed_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A single decompressed block is reserved in full and no compressed blocks data is used
+	 */
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "compressed_data_handle->number_of_reserved_block_cache_entries",
+	 compressed_data_handle->number_of_reserved_block_cache_entries,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "compressed_data_handle->number_of_reserved_read_blocks",
+	 compressed_data_handle->number_of_reserved_read_blocks,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT32(
+	 "compressed_data_handle->maximum_number_of_read_blocks",
+	 compressed_data_handle->maximum_number_of_read_blocks,
+	 (uint32_t) 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->cache_size",
+	 io_handle->cache_size,
+	 (uint64_t) FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE );
+
+	read_count = libfsapfs_compressed_data_handle_read_segment_data(
+	              compressed_data_handle,
+	              NULL,
+	              0,
+	              0,
+	              uncompressed_data,
+	              (size_t) uncompressed_data_size,
+	              0,
+	              0,
+	              &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) uncompressed_data_size );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_index = 0;
+	     block_index < FSAPFS_TEST_COMPRESSED_DATA_HANDLE_NUMBER_OF_LARGE_READ_BLOCKS;
+	     block_index++ )
+	{
+		data_offset = (size_t) block_index * FSAPFS_TEST_COMPRESSED_DATA_HANDLE_BLOCK_SIZE;
+
+		FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+		 "uncompressed_data[ data_offset ]",
+		 uncompressed_data[ data_offset ],
+		 (uint8_t) ( 'A' + block_index ) );
+	}
+	result = libfsapfs_compressed_data_handle_free(
+	          &compressed_data_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->cache_size",
+	 io_handle->cache_size,
+	 (uint64_t) 0 );
+
+	result = libfdata_stream_free(
+	          &compressed_data_stream,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "compressed_data_stream",
+	 compressed_data_stream );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 uncompressed_data );
+
+	memory_free(
+	 compressed_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_data_handle != NULL )
+	{
+		libfsapfs_compressed_data_handle_free(
+		 &compressed_data_handle,
+		 NULL );
+	}
+	if( compressed_data_stream != NULL )
+	{
+		libfdata_stream_free(
+		 &compressed_data_stream,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Tests the libfsapfs_compressed_data_handle_seek_segment_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_compressed_data_handle_seek_segment_offset(
+     void )
+{
+	libcerror_error_t *error                                   = NULL;
+	libfdata_stream_t *compressed_data_stream                  = NULL;
+	libfsapfs_compressed_data_handle_t *compressed_data_handle = NULL;
+	off64_t offset                                             = 0;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_data_stream_initialize_from_data(
+	          &compressed_data_stream,
+	          fsapfs_test_compressed_data_handle_lzvn_compressed_data1,
+	          35,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_stream",
+	 compressed_data_stream );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_compressed_data_handle_initialize(
+	          &compressed_data_handle,
+	          NULL,
+	          compressed_data_stream,
+	          16,
+	          LIBFSAPFS_COMPRESSION_METHOD_LZVN,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data_handle",
+	 compressed_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	offset = libfsapfs_compressed_data_handle_seek_segment_offset(
+	          compressed_data_handle,
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libfsapfs_compressed_data_handle_seek_segment_offset(
+	          NULL,
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libfsapfs_compressed_data_handle_seek_segment_offset(
+	          compressed_data_handle,
+	          NULL,
+	          -1,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libfsapfs_compressed_data_handle_seek_segment_offset(
+	          compressed_data_handle,
+	          NULL,
+	          0,
+	          0,
+	          -1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
 	/* Clean up
 	 */
@@ -980,6 +1988,22 @@ int main(
 	 "libfsapfs_compressed_data_handle_read_segment_data",
 	 fsapfs_test_compressed_data_handle_read_segment_data );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_data_handle_read_segment_data_interleaved",
+	 fsapfs_test_compressed_data_handle_read_segment_data_interleaved );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_data_handle_read_segment_data_multiple_blocks",
+	 fsapfs_test_compressed_data_handle_read_segment_data_multiple_blocks );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_compressed_data_handle_read_segment_data_parallel",
+	 fsapfs_test_compressed_data_handle_read_segment_data_parallel );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	FSAPFS_TEST_RUN(
 	 "libfsapfs_compressed_data_handle_seek_segment_offset",
 	 fsapfs_test_compressed_data_handle_seek_segment_offset );
@@ -1123,6 +1123,180 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_container_set_cache_limits function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_container_set_cache_limits(
+     libfsapfs_container_t *container )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_container_set_cache_limits(
+	          container,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_container_set_cache_limits(
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests a libfsapfs_container_set_number_of_*_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_container_set_number_of_threads(
+     libfsapfs_container_t *container,
+     int (*set_number_of_threads_function)(
+            libfsapfs_container_t *container,
+            int number_of_threads,
+            libcerror_error_t **error ) )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = set_number_of_threads_function(
+	          container,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	result = set_number_of_threads_function(
+	          container,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = set_number_of_threads_function(
+	          NULL,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = set_number_of_threads_function(
+	          container,
+	          -1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_container_set_number_of_decryption_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_container_set_number_of_decryption_threads(
+     libfsapfs_container_t *container )
+{
+	return( fsapfs_test_container_set_number_of_threads(
+	         container,
+	         &libfsapfs_container_set_number_of_decryption_threads ) );
+}
+
+/* Tests the libfsapfs_container_set_number_of_decompression_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_container_set_number_of_decompression_threads(
+     libfsapfs_container_t *container )
+{
+	return( fsapfs_test_container_set_number_of_threads(
+	         container,
+	         &libfsapfs_container_set_number_of_decompression_threads ) );
+}
+
 /* Tests the libfsapfs_container_get_size function
  * Returns 1 if successful or 0 if not
  */
@@ -1487,6 +1661,21 @@ int main(
 		 fsapfs_test_container_signal_abort,
 		 container );
 
+		FSAPFS_TEST_RUN_WITH_ARGS(
+		 "libfsapfs_container_set_cache_limits",
+		 fsapfs_test_container_set_cache_limits,
+		 container );
+
+		FSAPFS_TEST_RUN_WITH_ARGS(
+		 "libfsapfs_container_set_number_of_decryption_threads",
+		 fsapfs_test_container_set_number_of_decryption_threads,
+		 container );
+
+		FSAPFS_TEST_RUN_WITH_ARGS(
+		 "libfsapfs_container_set_number_of_decompression_threads",
+		 fsapfs_test_container_set_number_of_decompression_threads,
+		 container );
+
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
 		/* TODO: add tests for libfsapfs_internal_container_open_read */
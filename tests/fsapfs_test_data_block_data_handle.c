@@ -37,6 +37,7 @@
 #include "fsapfs_test_memory.h"
 #include "fsapfs_test_unused.h"
 
+#include "../libfsapfs/libfsapfs_block_cache.h"
 #include "../libfsapfs/libfsapfs_data_block_data_handle.h"
 #include "../libfsapfs/libfsapfs_file_extent.h"
 #include "../libfsapfs/libfsapfs_io_handle.h"
@@ -518,6 +519,24 @@ int fsapfs_test_data_block_data_handle_read_segment_data(
 
 	io_handle->block_size = 4096;
 
+	result = libfsapfs_block_cache_initialize(
+	          &( io_handle->block_cache ),
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle->block_cache",
+	 io_handle->block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libcdata_array_initialize(
 	          &file_extents,
 	          0,
@@ -989,6 +1008,444 @@ int fsapfs_test_data_block_data_handle_read_segment_data(
 
 	data_block_data = NULL;
 
+	/* Clean up
+	 */
+	result = libfsapfs_data_block_data_handle_free(
+	          &data_block_data_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "data_block_data_handle",
+	 data_block_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_free(
+	          &file_extents,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_extents",
+	 file_extents );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_block_cache_free(
+	          &( io_handle->block_cache ),
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle->block_cache",
+	 io_handle->block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data_block_data != NULL )
+	{
+		memory_free(
+		 data_block_data );
+	}
+	if( data_block_data_handle != NULL )
+	{
+		libfsapfs_data_block_data_handle_free(
+		 &data_block_data_handle,
+		 NULL );
+	}
+	if( file_extent != NULL )
+	{
+		libfsapfs_file_extent_free(
+		 &file_extent,
+		 NULL );
+	}
+	if( file_extents != NULL )
+	{
+		libcdata_array_free(
+		 &file_extents,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsapfs_file_extent_free,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		if( io_handle->block_cache != NULL )
+		{
+			libfsapfs_block_cache_free(
+			 &( io_handle->block_cache ),
+			 NULL );
+		}
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_data_block_data_handle_read_extent_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_data_block_data_handle_read_extent_data(
+     void )
+{
+	uint8_t segment_data[ 8192 ];
+
+	libbfio_handle_t *file_io_handle                           = NULL;
+	libcdata_array_t *file_extents                             = NULL;
+	libcerror_error_t *error                                   = NULL;
+	libfsapfs_data_block_data_handle_t *data_block_data_handle = NULL;
+	libfsapfs_file_extent_t *file_extent                       = NULL;
+	libfsapfs_io_handle_t *io_handle                           = NULL;
+	uint8_t *data_block_data                                   = NULL;
+	size_t data_offset                                         = 0;
+	ssize_t read_count                                         = 0;
+	uint64_t physical_block_number                             = 0;
+	int entry_index                                            = 0;
+	int result                                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->block_size = 4096;
+
+	result = libcdata_array_initialize(
+	          &file_extents,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_extents",
+	 file_extents );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Add 2 file extents that are physically contiguous
+	 */
+	for( physical_block_number = 1;
+	     physical_block_number <= 2;
+	     physical_block_number++ )
+	{
+		result = libfsapfs_file_extent_initialize(
+		          &file_extent,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "file_extent",
+		 file_extent );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		file_extent->physical_block_number = physical_block_number;
+		file_extent->data_size             = 4096;
+
+		result = libcdata_array_append_entry(
+		          file_extents,
+		          &entry_index,
+		          (intptr_t *) file_extent,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		file_extent = NULL;
+	}
+	result = libfsapfs_data_block_data_handle_initialize(
+	          &data_block_data_handle,
+	          io_handle,
+	          NULL,
+	          file_extents,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block_data_handle",
+	 data_block_data_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize file IO handle
+	 */
+	data_block_data = (uint8_t *) memory_allocate(
+	                               12288 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block_data",
+	 data_block_data );
+
+	for( data_offset = 0;
+	     data_offset < 12288;
+	     data_offset++ )
+	{
+		data_block_data[ data_offset ] = (uint8_t) ( data_offset / 4096 );
+	}
+	result = fsapfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          data_block_data,
+	          12288,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libfsapfs_data_block_data_handle_read_extent_data(
+	              data_block_data_handle,
+	              file_io_handle,
+	              segment_data,
+	              8192,
+	              &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 8192 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          segment_data,
+	          &( data_block_data[ 4096 ] ),
+	          8192 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Read buffer beyond last file extent
+	 */
+	data_block_data_handle->current_offset = 8192;
+
+	read_count = libfsapfs_data_block_data_handle_read_extent_data(
+	              data_block_data_handle,
+	              file_io_handle,
+	              segment_data,
+	              4096,
+	              &error );
+
+	data_block_data_handle->current_offset = 0;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libfsapfs_data_block_data_handle_read_extent_data(
+	              NULL,
+	              file_io_handle,
+	              segment_data,
+	              4096,
+	              &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	data_block_data_handle->current_offset = 1;
+
+	read_count = libfsapfs_data_block_data_handle_read_extent_data(
+	              data_block_data_handle,
+	              file_io_handle,
+	              segment_data,
+	              4096,
+	              &error );
+
+	data_block_data_handle->current_offset = 0;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfsapfs_data_block_data_handle_read_extent_data(
+	              data_block_data_handle,
+	              file_io_handle,
+	              NULL,
+	              4096,
+	              &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libfsapfs_data_block_data_handle_read_extent_data(
+	              data_block_data_handle,
+	              file_io_handle,
+	              segment_data,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT64(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up file IO handle
+	 */
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 data_block_data );
+
+	data_block_data = NULL;
+
 	/* Clean up
 	 */
 	result = libfsapfs_data_block_data_handle_free(
@@ -1404,6 +1861,10 @@ int main(
 	 "libfsapfs_data_block_data_handle_read_segment_data",
 	 fsapfs_test_data_block_data_handle_read_segment_data );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_data_block_data_handle_read_extent_data",
+	 fsapfs_test_data_block_data_handle_read_extent_data );
+
 	FSAPFS_TEST_RUN(
 	 "libfsapfs_data_block_data_handle_seek_segment_offset",
 	 fsapfs_test_data_block_data_handle_seek_segment_offset );
@@ -0,0 +1,752 @@
+/*
+ * Library decompressed_block_cache type test program
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_decompressed_block_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Tests the libfsapfs_decompressed_block_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_decompressed_block_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                                       = NULL;
+	libfsapfs_decompressed_block_cache_t *decompressed_block_cache = NULL;
+	int result                                                     = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                                = 2;
+	int number_of_memset_fail_tests                                = 2;
+	int test_number                                                = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_decompressed_block_cache_initialize(
+	          &decompressed_block_cache,
+	          4,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "decompressed_block_cache",
+	 decompressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_decompressed_block_cache_free(
+	          &decompressed_block_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "decompressed_block_cache",
+	 decompressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_decompressed_block_cache_initialize(
+	          NULL,
+	          4,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	decompressed_block_cache = (libfsapfs_decompressed_block_cache_t *) 0x12345678UL;
+
+	result = libfsapfs_decompressed_block_cache_initialize(
+	          &decompressed_block_cache,
+	          4,
+	          16,
+	          &error );
+
+	decompressed_block_cache = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_decompressed_block_cache_initialize(
+	          &decompressed_block_cache,
+	          0,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "decompressed_block_cache",
+	 decompressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_decompressed_block_cache_initialize(
+	          &decompressed_block_cache,
+	          4,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "decompressed_block_cache",
+	 decompressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_decompressed_block_cache_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_decompressed_block_cache_initialize(
+		          &decompressed_block_cache,
+		          4,
+		          16,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( decompressed_block_cache != NULL )
+			{
+				libfsapfs_decompressed_block_cache_free(
+				 &decompressed_block_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "decompressed_block_cache",
+			 decompressed_block_cache );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_decompressed_block_cache_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_decompressed_block_cache_initialize(
+		          &decompressed_block_cache,
+		          4,
+		          16,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( decompressed_block_cache != NULL )
+			{
+				libfsapfs_decompressed_block_cache_free(
+				 &decompressed_block_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "decompressed_block_cache",
+			 decompressed_block_cache );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( decompressed_block_cache != NULL )
+	{
+		libfsapfs_decompressed_block_cache_free(
+		 &decompressed_block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_decompressed_block_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_decompressed_block_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_decompressed_block_cache_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_decompressed_block_cache_get_entry_by_block_index and libfsapfs_decompressed_block_cache_get_statistics functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_decompressed_block_cache_get_entry_by_block_index(
+     void )
+{
+	libcerror_error_t *error                                       = NULL;
+	libfsapfs_decompressed_block_cache_entry_t *cache_entry        = NULL;
+	libfsapfs_decompressed_block_cache_entry_t *first_cache_entry  = NULL;
+	libfsapfs_decompressed_block_cache_t *decompressed_block_cache = NULL;
+	uint64_t number_of_hits                                        = 0;
+	uint64_t number_of_misses                                      = 0;
+	int result                                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_decompressed_block_cache_initialize(
+	          &decompressed_block_cache,
+	          2,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          decompressed_block_cache,
+	          1,
+	          &cache_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_entry",
+	 cache_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_entry->data",
+	 cache_entry->data );
+
+	cache_entry->block_index = 1;
+	cache_entry->data_size   = 16;
+
+	first_cache_entry = cache_entry;
+
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          decompressed_block_cache,
+	          2,
+	          &cache_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_entry",
+	 cache_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	cache_entry->block_index = 2;
+	cache_entry->data_size   = 16;
+
+	/* Block 1 is cached and becomes the most recently used block
+	 */
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          decompressed_block_cache,
+	          1,
+	          &cache_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_entry",
+	 cache_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "cache_entry",
+	 (intptr_t) cache_entry,
+	 (intptr_t) first_cache_entry );
+
+	/* Block 3 replaces block 2, which is the least recently used block
+	 */
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          decompressed_block_cache,
+	          3,
+	          &cache_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_entry",
+	 cache_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_NOT_EQUAL_INTPTR(
+	 "cache_entry",
+	 (intptr_t) cache_entry,
+	 (intptr_t) first_cache_entry );
+
+	cache_entry->block_index = 3;
+	cache_entry->data_size   = 16;
+
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          decompressed_block_cache,
+	          1,
+	          &cache_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_entry",
+	 cache_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          decompressed_block_cache,
+	          3,
+	          &cache_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_entry",
+	 cache_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A block that was not marked as decompressed is not cached
+	 */
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          decompressed_block_cache,
+	          2,
+	          &cache_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_entry",
+	 cache_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          decompressed_block_cache,
+	          2,
+	          &cache_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_entry",
+	 cache_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_decompressed_block_cache_get_statistics(
+	          decompressed_block_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 3 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 5 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          NULL,
+	          1,
+	          &cache_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          decompressed_block_cache,
+	          (uint32_t) -1,
+	          &cache_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_decompressed_block_cache_get_entry_by_block_index(
+	          decompressed_block_cache,
+	          1,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_decompressed_block_cache_get_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_decompressed_block_cache_get_statistics(
+	          decompressed_block_cache,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_decompressed_block_cache_get_statistics(
+	          decompressed_block_cache,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_decompressed_block_cache_free(
+	          &decompressed_block_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "decompressed_block_cache",
+	 decompressed_block_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( decompressed_block_cache != NULL )
+	{
+		libfsapfs_decompressed_block_cache_free(
+		 &decompressed_block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_decompressed_block_cache_initialize",
+	 fsapfs_test_decompressed_block_cache_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_decompressed_block_cache_free",
+	 fsapfs_test_decompressed_block_cache_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_decompressed_block_cache_get_entry_by_block_index",
+	 fsapfs_test_decompressed_block_cache_get_entry_by_block_index );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
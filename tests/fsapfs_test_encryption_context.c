@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -33,7 +35,9 @@
 #include "fsapfs_test_memory.h"
 #include "fsapfs_test_unused.h"
 
+#include "../libfsapfs/libfsapfs_definitions.h"
 #include "../libfsapfs/libfsapfs_encryption_context.h"
+#include "../libfsapfs/libfsapfs_libcaes.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
@@ -75,6 +79,485 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_encryption_context_crypt function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_encryption_context_crypt(
+     void )
+{
+	uint8_t encrypted_data[ 64 ] = {
+		0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e, 0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+		0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4, 0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0,
+		0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e, 0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+		0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4, 0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0 };
+
+	uint8_t expected_data[ 32 ] = {
+		0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+		0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44 };
+
+	uint8_t key[ 16 ] = {
+		0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11 };
+
+	uint8_t tweak_key[ 16 ] = {
+		0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22 };
+
+	uint8_t decrypted_data[ 64 ];
+
+	libcerror_error_t *error                = NULL;
+	libfsapfs_encryption_context_t *context = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_encryption_context_initialize(
+	          &context,
+	          LIBFSAPFS_ENCRYPTION_METHOD_AES_128_XTS,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_encryption_context_set_keys(
+	          context,
+	          key,
+	          16,
+	          tweak_key,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases with the IEEE P1619 XTS-AES-128 test vector 2
+	 */
+	result = libfsapfs_encryption_context_crypt(
+	          context,
+	          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          encrypted_data,
+	          32,
+	          decrypted_data,
+	          32,
+	          0x3333333333UL,
+	          32,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          decrypted_data,
+	          expected_data,
+	          32 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_encryption_context_crypt(
+	          NULL,
+	          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          encrypted_data,
+	          32,
+	          decrypted_data,
+	          32,
+	          0,
+	          32,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_encryption_context_crypt(
+	          context,
+	          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          encrypted_data,
+	          32,
+	          decrypted_data,
+	          32,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test in place decryption of a partial sector
+	 */
+	result = libfsapfs_encryption_context_crypt(
+	          context,
+	          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          decrypted_data,
+	          48,
+	          decrypted_data,
+	          48,
+	          0,
+	          32,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_encryption_context_decrypt_xts_sectors(
+	          context,
+	          encrypted_data,
+	          decrypted_data,
+	          48,
+	          0,
+	          32,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_encryption_context_free(
+	          &context,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libfsapfs_encryption_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_encryption_context_decrypt_xts_sectors function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_encryption_context_decrypt_xts_sectors(
+     void )
+{
+	uint8_t decrypted_data[ 4096 ];
+	uint8_t encrypted_data[ 4096 ];
+	uint8_t expected_data[ 4096 ];
+	uint8_t tweak_value[ 16 ];
+
+	uint8_t key[ 16 ] = {
+		0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11 };
+
+	uint8_t tweak_key[ 16 ] = {
+		0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22 };
+
+	libcerror_error_t *error                = NULL;
+	libfsapfs_encryption_context_t *context = NULL;
+	size_t data_offset                      = 0;
+	uint64_t sector_number                  = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_encryption_context_initialize(
+	          &context,
+	          LIBFSAPFS_ENCRYPTION_METHOD_AES_128_XTS,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_encryption_context_set_keys(
+	          context,
+	          key,
+	          16,
+	          tweak_key,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		encrypted_data[ data_offset ] = (uint8_t) ( ( data_offset * 7 ) + 3 );
+	}
+	/* Decrypt every 512-byte sector separately with libcaes_crypt_xts as reference
+	 */
+	sector_number = 0x3333333333UL;
+
+	result = memory_set(
+	          tweak_value,
+	          0,
+	          16 ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset += 512 )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 tweak_value,
+		 sector_number );
+
+		result = libcaes_crypt_xts(
+		          context->decryption_context,
+		          LIBCAES_CRYPT_MODE_DECRYPT,
+		          tweak_value,
+		          16,
+		          &( encrypted_data[ data_offset ] ),
+		          512,
+		          &( expected_data[ data_offset ] ),
+		          512,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		sector_number += 1;
+	}
+	/* Test that all sectors decrypted at once match the reference, using hardware AES if supported
+	 */
+	result = libfsapfs_encryption_context_crypt(
+	          context,
+	          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          encrypted_data,
+	          4096,
+	          decrypted_data,
+	          4096,
+	          0x3333333333UL,
+	          512,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          decrypted_data,
+	          expected_data,
+	          4096 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test the libcaes_crypt_ecb multi-block path without hardware AES
+	 */
+	context->aes_ni_support_flags = 0;
+
+	result = libfsapfs_encryption_context_decrypt_xts_sectors(
+	          context,
+	          encrypted_data,
+	          decrypted_data,
+	          4096,
+	          0x3333333333UL,
+	          512,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          decrypted_data,
+	          expected_data,
+	          4096 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test decrypting in place without hardware AES
+	 */
+	result = memory_copy(
+	          decrypted_data,
+	          encrypted_data,
+	          4096 ) != NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfsapfs_encryption_context_crypt(
+	          context,
+	          LIBFSAPFS_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          decrypted_data,
+	          4096,
+	          decrypted_data,
+	          4096,
+	          0x3333333333UL,
+	          512,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          decrypted_data,
+	          expected_data,
+	          4096 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libfsapfs_encryption_context_free(
+	          &context,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libfsapfs_encryption_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -100,7 +583,13 @@ int main(
 
 	/* TODO: add tests for libfsapfs_encryption_context_set_keys */
 
-	/* TODO: add tests for libfsapfs_encryption_context_crypt */
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_encryption_context_crypt",
+	 fsapfs_test_encryption_context_crypt );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_encryption_context_decrypt_xts_sectors",
+	 fsapfs_test_encryption_context_decrypt_xts_sectors );
 
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
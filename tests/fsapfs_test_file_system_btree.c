@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
 #include <types.h>
 
@@ -34,7 +35,12 @@
 #include "fsapfs_test_memory.h"
 #include "fsapfs_test_unused.h"
 
+#include "../libfsapfs/libfsapfs_btree_entry.h"
+#include "../libfsapfs/libfsapfs_btree_node.h"
+#include "../libfsapfs/libfsapfs_definitions.h"
 #include "../libfsapfs/libfsapfs_file_system_btree.h"
+#include "../libfsapfs/libfsapfs_inode.h"
+#include "../libfsapfs/libfsapfs_io_handle.h"
 
 uint8_t fsapfs_test_file_system_btree_data1[ 4096 ] = {
 	0xf0, 0xac, 0xe4, 0x68, 0xe9, 0xb0, 0xe2, 0x5a, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -559,6 +565,1205 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_file_system_btree_get_root_node function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_get_root_node(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libfsapfs_btree_node_t *btree_node               = NULL;
+	libfsapfs_btree_node_t *root_node                = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree = NULL;
+	libfsapfs_io_handle_t *io_handle                 = NULL;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          NULL,
+	          5,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_initialize(
+	          &btree_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_node",
+	 btree_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_read_data(
+	          btree_node,
+	          fsapfs_test_file_system_btree_data1,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file system B-tree takes over management of the root node
+	 */
+	file_system_btree->root_node = btree_node;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_system_btree_get_root_node(
+	          file_system_btree,
+	          NULL,
+	          5,
+	          &root_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "root_node",
+	 (intptr_t) root_node,
+	 (intptr_t) btree_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	btree_node = NULL;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_get_root_node(
+	          NULL,
+	          NULL,
+	          5,
+	          &root_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_get_root_node(
+	          file_system_btree,
+	          NULL,
+	          5,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( btree_node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &btree_node,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_system_btree_get_entry_from_node_by_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_get_entry_from_node_by_identifier(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libfsapfs_btree_entry_t *btree_entry             = NULL;
+	libfsapfs_btree_node_t *btree_node               = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree = NULL;
+	uint64_t identifier                              = 0;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_initialize(
+	          &btree_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_node",
+	 btree_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_read_data(
+	          btree_node,
+	          fsapfs_test_file_system_btree_data1,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          16,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_entry",
+	 btree_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 btree_entry->key_data,
+	 identifier );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "identifier",
+	 identifier,
+	 (uint64_t) 0x3000000000000010UL );
+
+	btree_entry = NULL;
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          19,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_FILE_EXTENT,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_entry",
+	 btree_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 btree_entry->key_data,
+	 identifier );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "identifier",
+	 identifier,
+	 (uint64_t) 0x8000000000000013UL );
+
+	btree_entry = NULL;
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          4,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "btree_entry",
+	 btree_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          20,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "btree_entry",
+	 btree_entry );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          NULL,
+	          btree_node,
+	          16,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          NULL,
+	          16,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_get_entry_from_node_by_identifier(
+	          file_system_btree,
+	          btree_node,
+	          16,
+	          LIBFSAPFS_FILE_SYSTEM_DATA_TYPE_INODE,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_btree_node_free(
+	          &btree_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "btree_node",
+	 btree_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( btree_node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &btree_node,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_system_btree_get_inodes_by_identifiers function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_get_inodes_by_identifiers(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libfsapfs_btree_node_t *btree_node               = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree = NULL;
+	libfsapfs_inode_t *inodes[ 4 ]                   = { NULL, NULL, NULL, NULL };
+	libfsapfs_io_handle_t *io_handle                 = NULL;
+	uint64_t identifier                              = 0;
+	uint64_t identifiers[ 4 ]                        = { 16, 18, 19, 20 };
+	uint64_t unsorted_identifiers[ 2 ]               = { 18, 16 };
+	int identifier_index                             = 0;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          NULL,
+	          5,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_initialize(
+	          &btree_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_node",
+	 btree_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_read_data(
+	          btree_node,
+	          fsapfs_test_file_system_btree_data1,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file system B-tree takes over management of the root node
+	 */
+	file_system_btree->root_node = btree_node;
+
+	btree_node = NULL;
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_system_btree_get_inodes_by_identifiers(
+	          file_system_btree,
+	          NULL,
+	          identifiers,
+	          4,
+	          inodes,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( identifier_index = 0;
+	     identifier_index < 3;
+	     identifier_index++ )
+	{
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "inodes[ identifier_index ]",
+		 inodes[ identifier_index ] );
+
+		result = libfsapfs_inode_get_identifier(
+		          inodes[ identifier_index ],
+		          &identifier,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+		 "identifier",
+		 identifier,
+		 identifiers[ identifier_index ] );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libfsapfs_inode_free(
+		          &( inodes[ identifier_index ] ),
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* There is no inode with identifier 20
+	 */
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "inodes[ 3 ]",
+	 inodes[ 3 ] );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_get_inodes_by_identifiers(
+	          NULL,
+	          NULL,
+	          identifiers,
+	          4,
+	          inodes,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_get_inodes_by_identifiers(
+	          file_system_btree,
+	          NULL,
+	          NULL,
+	          4,
+	          inodes,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_get_inodes_by_identifiers(
+	          file_system_btree,
+	          NULL,
+	          identifiers,
+	          -1,
+	          inodes,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_get_inodes_by_identifiers(
+	          file_system_btree,
+	          NULL,
+	          identifiers,
+	          4,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_get_inodes_by_identifiers(
+	          file_system_btree,
+	          NULL,
+	          unsorted_identifiers,
+	          2,
+	          inodes,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( identifier_index = 0;
+	     identifier_index < 4;
+	     identifier_index++ )
+	{
+		if( inodes[ identifier_index ] != NULL )
+		{
+			libfsapfs_inode_free(
+			 &( inodes[ identifier_index ] ),
+			 NULL );
+		}
+	}
+	if( btree_node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &btree_node,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Counts the records passed by libfsapfs_file_system_btree_scan per record type
+ * Returns 1 to continue, 0 to stop or -1 on error
+ */
+int fsapfs_test_file_system_btree_scan_callback(
+     uint8_t record_type,
+     uint64_t identifier FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     const uint8_t *key_data,
+     size_t key_data_size FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     const uint8_t *value_data FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     size_t value_data_size FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     void *callback_data,
+     libcerror_error_t **error FSAPFS_TEST_ATTRIBUTE_UNUSED )
+{
+	int *number_of_records = NULL;
+
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( identifier )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( key_data_size )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( value_data )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( value_data_size )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( ( key_data == NULL )
+	 || ( callback_data == NULL )
+	 || ( record_type > 15 ) )
+	{
+		return( -1 );
+	}
+	number_of_records = (int *) callback_data;
+
+	number_of_records[ record_type ] += 1;
+
+	/* The last element contains the maximum number of records to scan
+	 */
+	number_of_records[ 16 ] -= 1;
+
+	if( number_of_records[ 16 ] <= 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests the libfsapfs_file_system_btree_scan function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_btree_scan(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libfsapfs_btree_node_t *btree_node               = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree = NULL;
+	libfsapfs_io_handle_t *io_handle                 = NULL;
+	int number_of_records[ 17 ];
+	int record_type                                  = 0;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          NULL,
+	          5,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_initialize(
+	          &btree_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_node",
+	 btree_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_read_data(
+	          btree_node,
+	          fsapfs_test_file_system_btree_data1,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file system B-tree takes over management of the root node
+	 */
+	file_system_btree->root_node = btree_node;
+
+	btree_node = NULL;
+
+	/* Test regular cases
+	 */
+	for( record_type = 0;
+	     record_type < 16;
+	     record_type++ )
+	{
+		number_of_records[ record_type ] = 0;
+	}
+	number_of_records[ 16 ] = 100;
+
+	result = libfsapfs_file_system_btree_scan(
+	          file_system_btree,
+	          NULL,
+	          &fsapfs_test_file_system_btree_scan_callback,
+	          (void *) number_of_records,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_records[ 16 ]",
+	 number_of_records[ 16 ],
+	 100 - 18 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_records[ LIBFSAPFS_RECORD_TYPE_INODE ]",
+	 number_of_records[ LIBFSAPFS_RECORD_TYPE_INODE ],
+	 6 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_records[ LIBFSAPFS_RECORD_TYPE_DIRECTORY_RECORD ]",
+	 number_of_records[ LIBFSAPFS_RECORD_TYPE_DIRECTORY_RECORD ],
+	 6 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_records[ LIBFSAPFS_RECORD_TYPE_FILE_EXTENT ]",
+	 number_of_records[ LIBFSAPFS_RECORD_TYPE_FILE_EXTENT ],
+	 3 );
+
+	/* Test stopping the scan from the callback function
+	 */
+	for( record_type = 0;
+	     record_type < 16;
+	     record_type++ )
+	{
+		number_of_records[ record_type ] = 0;
+	}
+	number_of_records[ 16 ] = 2;
+
+	result = libfsapfs_file_system_btree_scan(
+	          file_system_btree,
+	          NULL,
+	          &fsapfs_test_file_system_btree_scan_callback,
+	          (void *) number_of_records,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_records[ 16 ]",
+	 number_of_records[ 16 ],
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_btree_scan(
+	          NULL,
+	          NULL,
+	          &fsapfs_test_file_system_btree_scan_callback,
+	          (void *) number_of_records,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_btree_scan(
+	          file_system_btree,
+	          NULL,
+	          NULL,
+	          (void *) number_of_records,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test scan with callback function failing
+	 */
+	result = libfsapfs_file_system_btree_scan(
+	          file_system_btree,
+	          NULL,
+	          &fsapfs_test_file_system_btree_scan_callback,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( btree_node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &btree_node,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -586,11 +1791,15 @@ int main(
 	 "libfsapfs_file_system_btree_free",
 	 fsapfs_test_file_system_btree_free );
 
-/* TODO add tests for libfsapfs_file_system_btree_get_root_node */
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_get_root_node",
+	 fsapfs_test_file_system_btree_get_root_node );
 
 /* TODO add tests for libfsapfs_file_system_btree_get_sub_node */
 
-/* TODO add tests for libfsapfs_file_system_btree_get_entry_from_node_by_identifier */
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_get_entry_from_node_by_identifier",
+	 fsapfs_test_file_system_btree_get_entry_from_node_by_identifier );
 
 /* TODO add tests for libfsapfs_file_system_btree_get_directory_record_from_node_by_utf8_name */
 
@@ -598,18 +1807,22 @@ int main(
 
 /* TODO add tests for libfsapfs_file_system_btree_get_directory_entries */
 
-/* TODO add tests for libfsapfs_file_system_btree_get_directory_entries_from_node */
-
 /* TODO add tests for libfsapfs_file_system_btree_get_file_extents */
 
-/* TODO add tests for libfsapfs_file_system_btree_get_file_extents_from_node */
-
 /* TODO add tests for libfsapfs_file_system_btree_get_inode_by_identifier */
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_get_inodes_by_identifiers",
+	 fsapfs_test_file_system_btree_get_inodes_by_identifiers );
+
 /* TODO add tests for libfsapfs_file_system_btree_get_inode_by_utf8_path */
 
 /* TODO add tests for libfsapfs_file_system_btree_get_inode_by_utf16_path */
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_btree_scan",
+	 fsapfs_test_file_system_btree_scan );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,890 @@
+/*
+ * Library file_system_scanner type test program
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_definitions.h"
+#include "../libfsapfs/libfsapfs_file_system_btree.h"
+#include "../libfsapfs/libfsapfs_file_system_scanner.h"
+#include "../libfsapfs/libfsapfs_io_handle.h"
+
+uint8_t fsapfs_test_file_system_scanner_directory_record_key_data1[ 23 ] = {
+	0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x0b, 0x14, 0xbe, 0x9c, 0x2e, 0x66, 0x73, 0x65,
+	0x76, 0x65, 0x6e, 0x74, 0x73, 0x64, 0x00 };
+
+uint8_t fsapfs_test_file_system_scanner_directory_record_value_data1[ 18 ] = {
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x43, 0xe3, 0x85, 0x4a, 0x54, 0x55, 0x52, 0x15,
+	0x04, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+typedef struct fsapfs_test_file_system_scanner_values fsapfs_test_file_system_scanner_values_t;
+
+struct fsapfs_test_file_system_scanner_values
+{
+	/* The number of records
+	 */
+	int number_of_records;
+
+	/* The record type of the last record
+	 */
+	uint8_t record_type;
+
+	/* The identifier of the last directory record
+	 */
+	uint64_t directory_record_identifier;
+
+	/* The parent identifier of the last directory record
+	 */
+	uint64_t directory_record_parent_identifier;
+
+	/* The value the callback function returns
+	 */
+	int callback_result;
+};
+
+/* Callback function that collects the scan record values
+ * Returns the callback result of the test values
+ */
+int fsapfs_test_file_system_scanner_callback(
+     const libfsapfs_scan_record_t *scan_record,
+     fsapfs_test_file_system_scanner_values_t *test_values,
+     libcerror_error_t **error FSAPFS_TEST_ATTRIBUTE_UNUSED )
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( ( scan_record == NULL )
+	 || ( test_values == NULL ) )
+	{
+		return( -1 );
+	}
+	test_values->number_of_records += 1;
+	test_values->record_type        = scan_record->record_type;
+
+	if( scan_record->directory_record != NULL )
+	{
+		test_values->directory_record_identifier        = scan_record->directory_record->identifier;
+		test_values->directory_record_parent_identifier = scan_record->directory_record->parent_identifier;
+	}
+	return( test_values->callback_result );
+}
+
+/* Tests the libfsapfs_file_system_scanner_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_scanner_initialize(
+     void )
+{
+	libcerror_error_t *error                             = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree     = NULL;
+	libfsapfs_file_system_scanner_t *file_system_scanner = NULL;
+	libfsapfs_io_handle_t *io_handle                     = NULL;
+	int result                                           = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                      = 1;
+	int number_of_memset_fail_tests                      = 1;
+	int test_number                                      = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_system_scanner_initialize(
+	          &file_system_scanner,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          (int (*)(const libfsapfs_scan_record_t *, void *, libcerror_error_t **)) &fsapfs_test_file_system_scanner_callback,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_scanner",
+	 file_system_scanner );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_scanner_free(
+	          &file_system_scanner,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_scanner",
+	 file_system_scanner );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_scanner_initialize(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          (int (*)(const libfsapfs_scan_record_t *, void *, libcerror_error_t **)) &fsapfs_test_file_system_scanner_callback,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_system_scanner = (libfsapfs_file_system_scanner_t *) 0x12345678UL;
+
+	result = libfsapfs_file_system_scanner_initialize(
+	          &file_system_scanner,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          (int (*)(const libfsapfs_scan_record_t *, void *, libcerror_error_t **)) &fsapfs_test_file_system_scanner_callback,
+	          NULL,
+	          &error );
+
+	file_system_scanner = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_scanner_initialize(
+	          &file_system_scanner,
+	          NULL,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          (int (*)(const libfsapfs_scan_record_t *, void *, libcerror_error_t **)) &fsapfs_test_file_system_scanner_callback,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_scanner_initialize(
+	          &file_system_scanner,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          NULL,
+	          (int (*)(const libfsapfs_scan_record_t *, void *, libcerror_error_t **)) &fsapfs_test_file_system_scanner_callback,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_scanner_initialize(
+	          &file_system_scanner,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          NULL,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_file_system_scanner_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_file_system_scanner_initialize(
+		          &file_system_scanner,
+		          io_handle,
+		          NULL,
+		          NULL,
+		          file_system_btree,
+		          (int (*)(const libfsapfs_scan_record_t *, void *, libcerror_error_t **)) &fsapfs_test_file_system_scanner_callback,
+		          NULL,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( file_system_scanner != NULL )
+			{
+				libfsapfs_file_system_scanner_free(
+				 &file_system_scanner,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "file_system_scanner",
+			 file_system_scanner );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_file_system_scanner_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_file_system_scanner_initialize(
+		          &file_system_scanner,
+		          io_handle,
+		          NULL,
+		          NULL,
+		          file_system_btree,
+		          (int (*)(const libfsapfs_scan_record_t *, void *, libcerror_error_t **)) &fsapfs_test_file_system_scanner_callback,
+		          NULL,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( file_system_scanner != NULL )
+			{
+				libfsapfs_file_system_scanner_free(
+				 &file_system_scanner,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "file_system_scanner",
+			 file_system_scanner );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_system_scanner != NULL )
+	{
+		libfsapfs_file_system_scanner_free(
+		 &file_system_scanner,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_system_scanner_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_scanner_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_scanner_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_file_system_scanner_read_record function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_file_system_scanner_read_record(
+     void )
+{
+	fsapfs_test_file_system_scanner_values_t test_values;
+
+	libcerror_error_t *error                             = NULL;
+	libfsapfs_file_system_btree_t *file_system_btree     = NULL;
+	libfsapfs_file_system_scanner_t *file_system_scanner = NULL;
+	libfsapfs_io_handle_t *io_handle                     = NULL;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	test_values.number_of_records                  = 0;
+	test_values.record_type                        = 0;
+	test_values.directory_record_identifier        = 0;
+	test_values.directory_record_parent_identifier = 0;
+	test_values.callback_result                    = 1;
+
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_initialize(
+	          &file_system_btree,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_scanner_initialize(
+	          &file_system_scanner,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          file_system_btree,
+	          (int (*)(const libfsapfs_scan_record_t *, void *, libcerror_error_t **)) &fsapfs_test_file_system_scanner_callback,
+	          (void *) &test_values,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_system_scanner",
+	 file_system_scanner );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_file_system_scanner_read_record(
+	          LIBFSAPFS_RECORD_TYPE_DIRECTORY_RECORD,
+	          2,
+	          fsapfs_test_file_system_scanner_directory_record_key_data1,
+	          23,
+	          fsapfs_test_file_system_scanner_directory_record_value_data1,
+	          18,
+	          file_system_scanner,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "test_values.number_of_records",
+	 test_values.number_of_records,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT8(
+	 "test_values.record_type",
+	 test_values.record_type,
+	 LIBFSAPFS_RECORD_TYPE_DIRECTORY_RECORD );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "test_values.directory_record_identifier",
+	 test_values.directory_record_identifier,
+	 (uint64_t) 16 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "test_values.directory_record_parent_identifier",
+	 test_values.directory_record_parent_identifier,
+	 (uint64_t) 2 );
+
+	/* Test that records of other types are skipped
+	 */
+	result = libfsapfs_file_system_scanner_read_record(
+	          LIBFSAPFS_RECORD_TYPE_DIRECTORY_STATISTICS,
+	          2,
+	          fsapfs_test_file_system_scanner_directory_record_key_data1,
+	          23,
+	          fsapfs_test_file_system_scanner_directory_record_value_data1,
+	          18,
+	          file_system_scanner,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "test_values.number_of_records",
+	 test_values.number_of_records,
+	 1 );
+
+	/* Test that the callback function can stop the scan
+	 */
+	test_values.callback_result = 0;
+
+	result = libfsapfs_file_system_scanner_read_record(
+	          LIBFSAPFS_RECORD_TYPE_DIRECTORY_RECORD,
+	          2,
+	          fsapfs_test_file_system_scanner_directory_record_key_data1,
+	          23,
+	          fsapfs_test_file_system_scanner_directory_record_value_data1,
+	          18,
+	          file_system_scanner,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "test_values.number_of_records",
+	 test_values.number_of_records,
+	 2 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_file_system_scanner_read_record(
+	          LIBFSAPFS_RECORD_TYPE_DIRECTORY_RECORD,
+	          2,
+	          fsapfs_test_file_system_scanner_directory_record_key_data1,
+	          23,
+	          fsapfs_test_file_system_scanner_directory_record_value_data1,
+	          18,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_scanner_read_record(
+	          LIBFSAPFS_RECORD_TYPE_DIRECTORY_RECORD,
+	          2,
+	          NULL,
+	          23,
+	          fsapfs_test_file_system_scanner_directory_record_value_data1,
+	          18,
+	          file_system_scanner,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_file_system_scanner_read_record(
+	          LIBFSAPFS_RECORD_TYPE_SIBLING_LINK,
+	          2,
+	          fsapfs_test_file_system_scanner_directory_record_key_data1,
+	          8,
+	          fsapfs_test_file_system_scanner_directory_record_value_data1,
+	          18,
+	          file_system_scanner,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_file_system_scanner_free(
+	          &file_system_scanner,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_scanner",
+	 file_system_scanner );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_file_system_btree_free(
+	          &file_system_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "file_system_btree",
+	 file_system_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_system_scanner != NULL )
+	{
+		libfsapfs_file_system_scanner_free(
+		 &file_system_scanner,
+		 NULL );
+	}
+	if( file_system_btree != NULL )
+	{
+		libfsapfs_file_system_btree_free(
+		 &file_system_btree,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_scanner_initialize",
+	 fsapfs_test_file_system_scanner_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_scanner_free",
+	 fsapfs_test_file_system_scanner_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_file_system_scanner_read_record",
+	 fsapfs_test_file_system_scanner_read_record );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -33,7 +33,9 @@
 #include "fsapfs_test_memory.h"
 #include "fsapfs_test_unused.h"
 
+#include "../libfsapfs/libfsapfs_definitions.h"
 #include "../libfsapfs/libfsapfs_io_handle.h"
+#include "../libfsapfs/libfsapfs_job_pool.h"
 
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
@@ -398,6 +400,762 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_io_handle_set_cache_limits function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_io_handle_set_cache_limits(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libfsapfs_io_handle_t *io_handle = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_io_handle_set_cache_limits(
+	          io_handle,
+	          1048576,
+	          65536,
+	          4194304,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->maximum_btree_nodes_cache_size",
+	 (uint64_t) io_handle->maximum_btree_nodes_cache_size,
+	 (uint64_t) 1048576 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->maximum_data_blocks_cache_size",
+	 (uint64_t) io_handle->maximum_data_blocks_cache_size,
+	 (uint64_t) 65536 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->maximum_cache_size",
+	 (uint64_t) io_handle->maximum_cache_size,
+	 (uint64_t) 4194304 );
+
+	/* The cache limits are retained when the IO handle is cleared
+	 */
+	result = libfsapfs_io_handle_clear(
+	          io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->maximum_cache_size",
+	 (uint64_t) io_handle->maximum_cache_size,
+	 (uint64_t) 4194304 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_io_handle_set_cache_limits(
+	          NULL,
+	          1048576,
+	          65536,
+	          4194304,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_io_handle_reserve_cache_entries and libfsapfs_io_handle_release_cache_entries functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_io_handle_reserve_cache_entries(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libfsapfs_io_handle_t *io_handle = NULL;
+	int number_of_cache_entries      = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_io_handle_reserve_cache_entries(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_BTREE_NODES,
+	          0,
+	          &number_of_cache_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cache_entries",
+	 number_of_cache_entries,
+	 LIBFSAPFS_MAXIMUM_CACHE_ENTRIES_BTREE_NODES );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_release_cache_entries(
+	          io_handle,
+	          number_of_cache_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->cache_size",
+	 (uint64_t) io_handle->cache_size,
+	 (uint64_t) 0 );
+
+	/* Test with a maximum of 1 MiB per B-tree nodes cache and 260 blocks for all caches combined
+	 */
+	result = libfsapfs_io_handle_set_cache_limits(
+	          io_handle,
+	          1048576,
+	          0,
+	          260 * 4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_reserve_cache_entries(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_BTREE_NODES,
+	          0,
+	          &number_of_cache_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cache_entries",
+	 number_of_cache_entries,
+	 256 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_reserve_cache_entries(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          0,
+	          &number_of_cache_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cache_entries",
+	 number_of_cache_entries,
+	 4 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_reserve_cache_entries(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          8192,
+	          &number_of_cache_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cache_entries",
+	 number_of_cache_entries,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->cache_size",
+	 (uint64_t) io_handle->cache_size,
+	 (uint64_t) 261 * 4096 );
+
+	/* Test with entries larger than a block, where the budget is exhausted
+	 */
+	result = libfsapfs_io_handle_reserve_cache_entries_of_size(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          65536,
+	          4 * 65536,
+	          &number_of_cache_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cache_entries",
+	 number_of_cache_entries,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->cache_size",
+	 (uint64_t) io_handle->cache_size,
+	 ( (uint64_t) 261 * 4096 ) + 65536 );
+
+	result = libfsapfs_io_handle_release_cache_entries_of_size(
+	          io_handle,
+	          65536,
+	          number_of_cache_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "io_handle->cache_size",
+	 (uint64_t) io_handle->cache_size,
+	 (uint64_t) 261 * 4096 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_io_handle_reserve_cache_entries(
+	          NULL,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          0,
+	          &number_of_cache_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_reserve_cache_entries(
+	          io_handle,
+	          0,
+	          0,
+	          &number_of_cache_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_reserve_cache_entries(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          0,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_reserve_cache_entries_of_size(
+	          io_handle,
+	          LIBFSAPFS_CACHE_TYPE_DATA_BLOCKS,
+	          0,
+	          0,
+	          &number_of_cache_entries,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_release_cache_entries(
+	          NULL,
+	          1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_release_cache_entries(
+	          io_handle,
+	          -1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_io_handle_grab_job_pool and libfsapfs_io_handle_release_job_pool functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_io_handle_grab_job_pool(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libfsapfs_io_handle_t *io_handle = NULL;
+	libfsapfs_job_pool_t *job_pool   = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_io_handle_grab_job_pool(
+	          io_handle,
+	          LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION,
+	          &job_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "job_pool",
+	 job_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_release_job_pool(
+	          io_handle,
+	          LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = libfsapfs_io_handle_set_number_of_job_threads(
+	          io_handle,
+	          LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_grab_job_pool(
+	          io_handle,
+	          LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION,
+	          &job_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "job_pool",
+	 job_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_release_job_pool(
+	          io_handle,
+	          LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_io_handle_set_number_of_job_threads(
+	          io_handle,
+	          LIBFSAPFS_JOB_POOL_TYPE_DECOMPRESSION,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle->decompression_pool",
+	 io_handle->decompression_pool );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	/* Test error cases
+	 */
+	result = libfsapfs_io_handle_grab_job_pool(
+	          NULL,
+	          LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION,
+	          &job_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_grab_job_pool(
+	          io_handle,
+	          -1,
+	          &job_pool,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_grab_job_pool(
+	          io_handle,
+	          LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_release_job_pool(
+	          NULL,
+	          LIBFSAPFS_JOB_POOL_TYPE_DECRYPTION,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_io_handle_release_job_pool(
+	          io_handle,
+	          -1,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libfsapfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -429,6 +1187,18 @@ int main(
 	 "libfsapfs_io_handle_clear",
 	 fsapfs_test_io_handle_clear );
 
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_io_handle_set_cache_limits",
+	 fsapfs_test_io_handle_set_cache_limits );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_io_handle_reserve_cache_entries",
+	 fsapfs_test_io_handle_reserve_cache_entries );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_io_handle_grab_job_pool",
+	 fsapfs_test_io_handle_grab_job_pool );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
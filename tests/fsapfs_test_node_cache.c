@@ -0,0 +1,1342 @@
+/*
+ * Library node_cache type test program
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_btree_node.h"
+#include "../libfsapfs/libfsapfs_btree_node_header.h"
+#include "../libfsapfs/libfsapfs_node_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Creates a B-tree node for testing
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_node_cache_create_node(
+     libfsapfs_btree_node_t **node,
+     uint16_t flags,
+     uint16_t level,
+     libcerror_error_t **error )
+{
+	if( libfsapfs_btree_node_initialize(
+	     node,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libfsapfs_btree_node_header_initialize(
+	     &( ( *node )->node_header ),
+	     error ) != 1 )
+	{
+		libfsapfs_btree_node_free(
+		 node,
+		 NULL );
+
+		return( -1 );
+	}
+	( *node )->node_header->flags = flags;
+	( *node )->node_header->level = level;
+
+	return( 1 );
+}
+
+/* Tests the libfsapfs_node_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_node_cache_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libfsapfs_node_cache_t *node_cache   = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 3;
+	int number_of_memset_fail_tests       = 1;
+	int test_number                       = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_node_cache_initialize(
+	          &node_cache,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_node_cache_free(
+	          &node_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_node_cache_initialize(
+	          NULL,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	node_cache = (libfsapfs_node_cache_t *) 0x12345678UL;
+
+	result = libfsapfs_node_cache_initialize(
+	          &node_cache,
+	          16,
+	          &error );
+
+	node_cache = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_node_cache_initialize(
+	          &node_cache,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_node_cache_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_node_cache_initialize(
+		          &node_cache,
+		          16,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( node_cache != NULL )
+			{
+				libfsapfs_node_cache_free(
+				 &node_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "node_cache",
+			 node_cache );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_node_cache_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_node_cache_initialize(
+		          &node_cache,
+		          16,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( node_cache != NULL )
+			{
+				libfsapfs_node_cache_free(
+				 &node_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "node_cache",
+			 node_cache );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( node_cache != NULL )
+	{
+		libfsapfs_node_cache_free(
+		 &node_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_node_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_node_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_node_cache_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_node_cache_get_node_by_block_number and libfsapfs_node_cache_set_node_by_block_number functions
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_node_cache_get_and_set_node_by_block_number(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libfsapfs_btree_node_t *cached_node    = NULL;
+	libfsapfs_btree_node_t *duplicate_node = NULL;
+	libfsapfs_btree_node_t *node           = NULL;
+	libfsapfs_node_cache_t *node_cache     = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_node_cache_initialize(
+	          &node_cache,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_node_cache_create_node(
+	          &node,
+	          0x0002,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "node",
+	 node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_node_cache_get_node_by_block_number(
+	          node_cache,
+	          1234,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_node_cache_set_node_by_block_number(
+	          node_cache,
+	          1234,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_node_cache_get_node_by_block_number(
+	          node_cache,
+	          1234,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "cached_node",
+	 (intptr_t) cached_node,
+	 (intptr_t) node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "node->number_of_references",
+	 node->number_of_references,
+	 2 );
+
+	/* Setting a node that was set by another thread returns the cached node
+	 */
+	result = fsapfs_test_node_cache_create_node(
+	          &duplicate_node,
+	          0x0002,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_node_cache_set_node_by_block_number(
+	          node_cache,
+	          1234,
+	          &duplicate_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "duplicate_node",
+	 (intptr_t) duplicate_node,
+	 (intptr_t) node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "node->number_of_references",
+	 node->number_of_references,
+	 3 );
+
+	result = libfsapfs_node_cache_release_node(
+	          node_cache,
+	          &duplicate_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "duplicate_node",
+	 duplicate_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_node_cache_release_node(
+	          node_cache,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "cached_node",
+	 cached_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "node->number_of_references",
+	 node->number_of_references,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_node_cache_get_node_by_block_number(
+	          NULL,
+	          1234,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_node_cache_get_node_by_block_number(
+	          node_cache,
+	          1234,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_node_cache_set_node_by_block_number(
+	          NULL,
+	          5678,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_node_cache_set_node_by_block_number(
+	          node_cache,
+	          5678,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_node_cache_release_node(
+	          NULL,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_node_cache_release_node(
+	          node_cache,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_node_cache_release_node(
+	          node_cache,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Releasing a node that is not referenced fails
+	 */
+	result = libfsapfs_node_cache_get_node_by_block_number(
+	          node_cache,
+	          1234,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	cached_node->number_of_references = 0;
+
+	result = libfsapfs_node_cache_release_node(
+	          node_cache,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_node_cache_free(
+	          &node_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &node,
+		 NULL );
+	}
+	if( node_cache != NULL )
+	{
+		libfsapfs_node_cache_free(
+		 &node_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_node_cache_release_node function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_node_cache_release_node(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libfsapfs_btree_node_t *cached_node = NULL;
+	libfsapfs_btree_node_t *node        = NULL;
+	libfsapfs_btree_node_t *other_node  = NULL;
+	libfsapfs_node_cache_t *node_cache  = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_node_cache_initialize(
+	          &node_cache,
+	          2,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_node_cache_create_node(
+	          &node,
+	          0x0002,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_node_cache_set_node_by_block_number(
+	          node_cache,
+	          1234,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Setting other nodes evicts the referenced node, which remains valid
+	 */
+	result = fsapfs_test_node_cache_create_node(
+	          &other_node,
+	          0x0002,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_node_cache_set_node_by_block_number(
+	          node_cache,
+	          5678,
+	          &other_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_node_cache_release_node(
+	          node_cache,
+	          &other_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_node_cache_create_node(
+	          &other_node,
+	          0x0002,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_node_cache_set_node_by_block_number(
+	          node_cache,
+	          9012,
+	          &other_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_node_cache_release_node(
+	          node_cache,
+	          &other_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "node->number_of_references",
+	 node->number_of_references,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "node->is_evicted",
+	 node->is_evicted,
+	 1 );
+
+	result = libfsapfs_node_cache_get_node_by_block_number(
+	          node_cache,
+	          1234,
+	          &cached_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Releasing the last reference frees the evicted node
+	 */
+	result = libfsapfs_node_cache_release_node(
+	          node_cache,
+	          &node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node",
+	 node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_node_cache_free(
+	          &node_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( other_node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &other_node,
+		 NULL );
+	}
+	if( node_cache != NULL )
+	{
+		libfsapfs_node_cache_free(
+		 &node_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the replacement policy of the node cache with a scan over leaf nodes
+ * mixed with lookups of the root node, a branch node and a frequently used leaf node
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_node_cache_scan_resistance(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libfsapfs_btree_node_t *cached_node = NULL;
+	libfsapfs_btree_node_t *node        = NULL;
+	libfsapfs_node_cache_t *node_cache  = NULL;
+	uint64_t block_number               = 0;
+	uint64_t number_of_evictions        = 0;
+	uint64_t number_of_hits             = 0;
+	uint64_t number_of_misses           = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_node_cache_initialize(
+	          &node_cache,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Add a root node, a branch node and a leaf node
+	 * The leaf node is read twice to mark it as frequently used
+	 */
+	for( block_number = 1;
+	     block_number <= 3;
+	     block_number++ )
+	{
+		result = fsapfs_test_node_cache_create_node(
+		          &node,
+		          ( block_number == 1 ) ? 0x0001 : 0x0000,
+		          (uint16_t) ( 3 - block_number ),
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libfsapfs_node_cache_set_node_by_block_number(
+		          node_cache,
+		          block_number,
+		          &node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libfsapfs_node_cache_release_node(
+		          node_cache,
+		          &node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	for( block_number = 1000;
+	     block_number < 1032;
+	     block_number++ )
+	{
+		result = fsapfs_test_node_cache_create_node(
+		          &node,
+		          0x0002,
+		          0,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libfsapfs_node_cache_set_node_by_block_number(
+		          node_cache,
+		          block_number,
+		          &node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libfsapfs_node_cache_release_node(
+		          node_cache,
+		          &node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		if( block_number == 1016 )
+		{
+			/* The leaf node has been evicted from the recent queue by now
+			 */
+			result = libfsapfs_node_cache_get_node_by_block_number(
+			          node_cache,
+			          3,
+			          &cached_node,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+
+			result = fsapfs_test_node_cache_create_node(
+			          &node,
+			          0x0002,
+			          0,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			result = libfsapfs_node_cache_set_node_by_block_number(
+			          node_cache,
+			          3,
+			          &node,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			result = libfsapfs_node_cache_release_node(
+			          node_cache,
+			          &node,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+	}
+	/* Scan a large number of leaf nodes once
+	 */
+	for( block_number = 10000;
+	     block_number < 20000;
+	     block_number++ )
+	{
+		result = libfsapfs_node_cache_get_node_by_block_number(
+		          node_cache,
+		          block_number,
+		          &cached_node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = fsapfs_test_node_cache_create_node(
+		          &node,
+		          0x0002,
+		          0,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libfsapfs_node_cache_set_node_by_block_number(
+		          node_cache,
+		          block_number,
+		          &node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libfsapfs_node_cache_release_node(
+		          node_cache,
+		          &node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	/* The root node, branch node and frequently used leaf node should have survived the scan
+	 */
+	for( block_number = 1;
+	     block_number <= 3;
+	     block_number++ )
+	{
+		result = libfsapfs_node_cache_get_node_by_block_number(
+		          node_cache,
+		          block_number,
+		          &cached_node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "cached_node",
+		 cached_node );
+
+		result = libfsapfs_node_cache_release_node(
+		          node_cache,
+		          &cached_node,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	result = libfsapfs_node_cache_get_statistics(
+	          node_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &number_of_evictions,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 3 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 10001 );
+
+	FSAPFS_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "number_of_evictions",
+	 (int64_t) number_of_evictions,
+	 (int64_t) 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_node_cache_get_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &number_of_evictions,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_node_cache_free(
+	          &node_cache,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "node_cache",
+	 node_cache );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &node,
+		 NULL );
+	}
+	if( node_cache != NULL )
+	{
+		libfsapfs_node_cache_free(
+		 &node_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_node_cache_initialize",
+	 fsapfs_test_node_cache_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_node_cache_free",
+	 fsapfs_test_node_cache_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_node_cache_get_node_by_block_number",
+	 fsapfs_test_node_cache_get_and_set_node_by_block_number );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_node_cache_release_node",
+	 fsapfs_test_node_cache_release_node );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_node_cache_scan_resistance",
+	 fsapfs_test_node_cache_scan_resistance );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
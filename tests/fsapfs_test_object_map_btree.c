@@ -20,13 +20,24 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
 #include "fsapfs_test_functions.h"
 #include "fsapfs_test_libcerror.h"
 #include "fsapfs_test_libfsapfs.h"
@@ -34,8 +45,13 @@
 #include "fsapfs_test_memory.h"
 #include "fsapfs_test_unused.h"
 
+#include "../libfsapfs/libfsapfs_btree_entry.h"
+#include "../libfsapfs/libfsapfs_btree_node.h"
 #include "../libfsapfs/libfsapfs_object_map_btree.h"
 
+#define FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_KEYS	100
+#define FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_ROUNDS	2000
+
 uint8_t fsapfs_test_object_map_btree_data1[ 4096 ] = {
 	0xa7, 0xc1, 0x94, 0x52, 0xbe, 0x2d, 0xc9, 0x5d, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x40, 0x0b, 0x00, 0x00, 0x00,
@@ -296,6 +312,146 @@ uint8_t fsapfs_test_object_map_btree_data1[ 4096 ] = {
 
 #if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
 
+/* Retrieves a timestamp in microseconds
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_object_map_btree_get_timestamp(
+     int64_t *timestamp )
+{
+#if !defined( WINAPI )
+	struct timespec current_time;
+#endif
+
+	if( timestamp == NULL )
+	{
+		return( -1 );
+	}
+#if defined( WINAPI )
+	*timestamp = (int64_t) GetTickCount() * 1000;
+#else
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &current_time ) != 0 )
+	{
+		return( -1 );
+	}
+	*timestamp = ( (int64_t) current_time.tv_sec * 1000000 ) + ( current_time.tv_nsec / 1000 );
+#endif
+	return( 1 );
+}
+
+/* Creates the data of a full 4 KiB object map B-tree root and leaf node
+ * The keys contain the object identifiers 1024, 1026, 1028, etc.
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_object_map_btree_create_full_node_data(
+     uint8_t *data,
+     size_t data_size )
+{
+	uint8_t *entry_data      = NULL;
+	size_t key_data_offset   = 0;
+	size_t value_data_offset = 0;
+	uint16_t entries_size    = 0;
+	uint16_t entry_index     = 0;
+	uint16_t keys_size       = 0;
+
+	if( ( data == NULL )
+	 || ( data_size != 4096 ) )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     data_size ) == NULL )
+	{
+		return( -1 );
+	}
+	entries_size = (uint16_t) ( FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_KEYS * 4 );
+	keys_size    = (uint16_t) ( FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_KEYS * 16 );
+
+	/* The object header: physical B-tree root node of the object map
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 8 ] ),
+	 (uint64_t) 1025 );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 24 ] ),
+	 0x40000002UL );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 28 ] ),
+	 0x0000000bUL );
+
+	/* The node header: root, leaf and fixed-size entries
+	 */
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 32 ] ),
+	 0x0007 );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 36 ] ),
+	 FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_KEYS );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 42 ] ),
+	 entries_size );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 44 ] ),
+	 keys_size );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 46 ] ),
+	 (uint16_t) ( 4096 - 56 - 40 - entries_size - ( 2 * keys_size ) ) );
+
+	for( entry_index = 0;
+	     entry_index < FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_KEYS;
+	     entry_index++ )
+	{
+		entry_data = &( data[ 56 + ( entry_index * 4 ) ] );
+
+		byte_stream_copy_from_uint16_little_endian(
+		 &( entry_data[ 0 ] ),
+		 (uint16_t) ( entry_index * 16 ) );
+		byte_stream_copy_from_uint16_little_endian(
+		 &( entry_data[ 2 ] ),
+		 (uint16_t) ( ( entry_index + 1 ) * 16 ) );
+
+		key_data_offset = 56 + entries_size + ( entry_index * 16 );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( data[ key_data_offset ] ),
+		 (uint64_t) 1024 + ( 2 * entry_index ) );
+		byte_stream_copy_from_uint64_little_endian(
+		 &( data[ key_data_offset + 8 ] ),
+		 (uint64_t) 1 );
+
+		value_data_offset = 4096 - 40 - ( ( entry_index + 1 ) * 16 );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( data[ value_data_offset + 4 ] ),
+		 4096 );
+		byte_stream_copy_from_uint64_little_endian(
+		 &( data[ value_data_offset + 8 ] ),
+		 (uint64_t) 2048 + entry_index );
+	}
+	/* The footer
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 4096 - 40 + 4 ] ),
+	 4096 );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 4096 - 40 + 8 ] ),
+	 16 );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 4096 - 40 + 12 ] ),
+	 16 );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 4096 - 40 + 24 ] ),
+	 (uint64_t) FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_KEYS );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 4096 - 40 + 32 ] ),
+	 (uint64_t) 1 );
+
+	return( 1 );
+}
+
 /* Tests the libfsapfs_object_map_btree_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -544,6 +700,337 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfsapfs_object_map_btree_get_entry_from_node_by_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_map_btree_get_entry_from_node_by_identifier(
+     void )
+{
+	uint8_t node_data[ 4096 ];
+
+	libcerror_error_t *error                       = NULL;
+	libfsapfs_btree_entry_t *btree_entry           = NULL;
+	libfsapfs_btree_node_t *btree_node             = NULL;
+	libfsapfs_object_map_btree_t *object_map_btree = NULL;
+	int64_t duration                               = 0;
+	int64_t start_timestamp                        = 0;
+	int64_t stop_timestamp                         = 0;
+	uint64_t lookup_key                            = 0;
+	uint64_t number_of_lookups                     = 0;
+	uint64_t object_identifier                     = 0;
+	int key_index                                  = 0;
+	int result                                     = 0;
+	int round_index                                = 0;
+
+	/* Initialize test
+	 */
+	result = fsapfs_test_object_map_btree_create_full_node_data(
+	          node_data,
+	          4096 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfsapfs_object_map_btree_initialize(
+	          &object_map_btree,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "object_map_btree",
+	 object_map_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_initialize(
+	          &btree_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "btree_node",
+	 btree_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_btree_node_read_data(
+	          btree_node,
+	          node_data,
+	          4096,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( key_index = 0;
+	     key_index < FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_KEYS;
+	     key_index++ )
+	{
+		lookup_key = (uint64_t) 1024 + ( 2 * key_index );
+
+		btree_entry = NULL;
+
+		result = libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
+		          object_map_btree,
+		          btree_node,
+		          lookup_key,
+		          &btree_entry,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "btree_entry",
+		 btree_entry );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 btree_entry->key_data,
+		 object_identifier );
+
+		FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+		 "object_identifier",
+		 object_identifier,
+		 lookup_key );
+
+		/* The identifiers in between the keys are not stored in the leaf node
+		 */
+		result = libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
+		          object_map_btree,
+		          btree_node,
+		          lookup_key + 1,
+		          &btree_entry,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
+	          object_map_btree,
+	          btree_node,
+	          1023,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Measure the lookups of all the keys of a full node
+	 */
+	result = fsapfs_test_object_map_btree_get_timestamp(
+	          &start_timestamp );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( round_index = 0;
+	     round_index < FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_ROUNDS;
+	     round_index++ )
+	{
+		for( key_index = 0;
+		     key_index < FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_KEYS;
+		     key_index++ )
+		{
+			result = libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
+			          object_map_btree,
+			          btree_node,
+			          (uint64_t) 1024 + ( 2 * key_index ),
+			          &btree_entry,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+	}
+	result = fsapfs_test_object_map_btree_get_timestamp(
+	          &stop_timestamp );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	duration = stop_timestamp - start_timestamp;
+
+	if( duration <= 0 )
+	{
+		duration = 1;
+	}
+	number_of_lookups = (uint64_t) FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_ROUNDS * FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_KEYS;
+
+	fprintf(
+	 stdout,
+	 "Object map B-tree node lookup: %" PRIu64 " lookups in a node of %d keys in %" PRIi64 " us (%" PRIu64 " ns per lookup)\n",
+	 number_of_lookups,
+	 FSAPFS_TEST_OBJECT_MAP_BTREE_BENCHMARK_NUMBER_OF_KEYS,
+	 duration,
+	 ( (uint64_t) duration * 1000 ) / number_of_lookups );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
+	          NULL,
+	          btree_node,
+	          1024,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
+	          object_map_btree,
+	          NULL,
+	          1024,
+	          &btree_entry,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_btree_get_entry_from_node_by_identifier(
+	          object_map_btree,
+	          btree_node,
+	          1024,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_btree_node_free(
+	          &btree_node,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "btree_node",
+	 btree_node );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_object_map_btree_free(
+	          &object_map_btree,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "object_map_btree",
+	 object_map_btree );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( btree_node != NULL )
+	{
+		libfsapfs_btree_node_free(
+		 &btree_node,
+		 NULL );
+	}
+	if( object_map_btree != NULL )
+	{
+		libfsapfs_object_map_btree_free(
+		 &object_map_btree,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
 
 /* The main program
@@ -575,7 +1062,9 @@ int main(
 
 /* TODO add tests for libfsapfs_object_map_btree_get_sub_node */
 
-/* TODO add tests for libfsapfs_object_map_btree_get_entry_from_node_by_identifier */
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_map_btree_get_entry_from_node_by_identifier",
+	 fsapfs_test_object_map_btree_get_entry_from_node_by_identifier );
 
 /* TODO add tests for libfsapfs_object_map_btree_get_descriptor_by_object_identifier */
 
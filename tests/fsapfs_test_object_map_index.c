@@ -0,0 +1,927 @@
+/*
+ * Library object_map_index type test program
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+#include "fsapfs_test_unused.h"
+
+#include "../libfsapfs/libfsapfs_object_map_descriptor.h"
+#include "../libfsapfs/libfsapfs_object_map_index.h"
+
+uint8_t fsapfs_test_object_map_index_key_data1[ 48 ] = {
+	0x02, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x03, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x03, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+uint8_t fsapfs_test_object_map_index_value_data1[ 48 ] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x6e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x6f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+/* Tests the libfsapfs_object_map_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_map_index_initialize(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libfsapfs_object_map_index_t *object_map_index = NULL;
+	int result                                     = 0;
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests                = 2;
+	int number_of_memset_fail_tests                = 1;
+	int test_number                                = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_object_map_index_initialize(
+	          &object_map_index,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "object_map_index",
+	 object_map_index );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_object_map_index_free(
+	          &object_map_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "object_map_index",
+	 object_map_index );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_map_index_initialize(
+	          NULL,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	object_map_index = (libfsapfs_object_map_index_t *) 0x12345678UL;
+
+	result = libfsapfs_object_map_index_initialize(
+	          &object_map_index,
+	          16,
+	          &error );
+
+	object_map_index = NULL;
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_index_initialize(
+	          &object_map_index,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "object_map_index",
+	 object_map_index );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSAPFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_object_map_index_initialize with malloc failing
+		 */
+		fsapfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfsapfs_object_map_index_initialize(
+		          &object_map_index,
+		          16,
+		          &error );
+
+		if( fsapfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fsapfs_test_malloc_attempts_before_fail = -1;
+
+			if( object_map_index != NULL )
+			{
+				libfsapfs_object_map_index_free(
+				 &object_map_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "object_map_index",
+			 object_map_index );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfsapfs_object_map_index_initialize with memset failing
+		 */
+		fsapfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfsapfs_object_map_index_initialize(
+		          &object_map_index,
+		          16,
+		          &error );
+
+		if( fsapfs_test_memset_attempts_before_fail != -1 )
+		{
+			fsapfs_test_memset_attempts_before_fail = -1;
+
+			if( object_map_index != NULL )
+			{
+				libfsapfs_object_map_index_free(
+				 &object_map_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "object_map_index",
+			 object_map_index );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSAPFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( object_map_index != NULL )
+	{
+		libfsapfs_object_map_index_free(
+		 &object_map_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_object_map_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_map_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_map_index_free(
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_object_map_index_append_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_map_index_append_entry(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libfsapfs_object_map_index_t *object_map_index = NULL;
+	int result                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_object_map_index_initialize(
+	          &object_map_index,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "object_map_index",
+	 object_map_index );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_object_map_index_append_entry(
+	          object_map_index,
+	          &( fsapfs_test_object_map_index_key_data1[ 0 ] ),
+	          16,
+	          &( fsapfs_test_object_map_index_value_data1[ 0 ] ),
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfsapfs_object_map_index_append_entry(
+	          object_map_index,
+	          &( fsapfs_test_object_map_index_key_data1[ 16 ] ),
+	          16,
+	          &( fsapfs_test_object_map_index_value_data1[ 16 ] ),
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "object_map_index->number_of_descriptors",
+	 object_map_index->number_of_descriptors,
+	 2 );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_map_index_append_entry(
+	          NULL,
+	          fsapfs_test_object_map_index_key_data1,
+	          16,
+	          fsapfs_test_object_map_index_value_data1,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_index_append_entry(
+	          object_map_index,
+	          fsapfs_test_object_map_index_key_data1,
+	          8,
+	          fsapfs_test_object_map_index_value_data1,
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the entries are not in key order
+	 */
+	result = libfsapfs_object_map_index_append_entry(
+	          object_map_index,
+	          &( fsapfs_test_object_map_index_key_data1[ 0 ] ),
+	          16,
+	          &( fsapfs_test_object_map_index_value_data1[ 0 ] ),
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_index_append_entry(
+	          object_map_index,
+	          &( fsapfs_test_object_map_index_key_data1[ 32 ] ),
+	          16,
+	          &( fsapfs_test_object_map_index_value_data1[ 32 ] ),
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the maximum number of descriptors is exceeded
+	 */
+	result = libfsapfs_object_map_index_append_entry(
+	          object_map_index,
+	          &( fsapfs_test_object_map_index_key_data1[ 32 ] ),
+	          16,
+	          &( fsapfs_test_object_map_index_value_data1[ 32 ] ),
+	          16,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_object_map_index_free(
+	          &object_map_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "object_map_index",
+	 object_map_index );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( object_map_index != NULL )
+	{
+		libfsapfs_object_map_index_free(
+		 &object_map_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_object_map_index_get_descriptor_by_object_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_map_index_get_descriptor_by_object_identifier(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libfsapfs_object_map_descriptor_t *descriptor  = NULL;
+	libfsapfs_object_map_index_t *object_map_index = NULL;
+	int entry_index                                = 0;
+	int result                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_object_map_index_initialize(
+	          &object_map_index,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "object_map_index",
+	 object_map_index );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	descriptor = NULL;
+
+	result = libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+	          object_map_index,
+	          0x00000402UL,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( entry_index = 0;
+	     entry_index < 3;
+	     entry_index++ )
+	{
+		result = libfsapfs_object_map_index_append_entry(
+		          object_map_index,
+		          &( fsapfs_test_object_map_index_key_data1[ entry_index * 16 ] ),
+		          16,
+		          &( fsapfs_test_object_map_index_value_data1[ entry_index * 16 ] ),
+		          16,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	descriptor = NULL;
+
+	result = libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+	          object_map_index,
+	          0x00000402UL,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor",
+	 descriptor );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "descriptor->physical_address",
+	 descriptor->physical_address,
+	 (uint64_t) 0x0000006eUL );
+
+	descriptor = NULL;
+
+	result = libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+	          object_map_index,
+	          0x00000403UL,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor",
+	 descriptor );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "descriptor->transaction_identifier",
+	 descriptor->transaction_identifier,
+	 (uint64_t) 7 );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "descriptor->physical_address",
+	 descriptor->physical_address,
+	 (uint64_t) 0x0000006fUL );
+
+	descriptor = NULL;
+
+	result = libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+	          object_map_index,
+	          0x00000401UL,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	descriptor = NULL;
+
+	result = libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+	          object_map_index,
+	          0x00000404UL,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+	          NULL,
+	          0x00000402UL,
+	          &descriptor,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_index_get_descriptor_by_object_identifier(
+	          object_map_index,
+	          0x00000402UL,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_object_map_index_free(
+	          &object_map_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "object_map_index",
+	 object_map_index );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( object_map_index != NULL )
+	{
+		libfsapfs_object_map_index_free(
+		 &object_map_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfsapfs_object_map_index_get_size function
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_object_map_index_get_size(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libfsapfs_object_map_index_t *object_map_index = NULL;
+	size64_t size                                  = 0;
+	int result                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_object_map_index_initialize(
+	          &object_map_index,
+	          3,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "object_map_index",
+	 object_map_index );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfsapfs_object_map_index_get_size(
+	          object_map_index,
+	          &size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 size,
+	 (uint64_t) ( sizeof( libfsapfs_object_map_index_t ) + ( 3 * sizeof( libfsapfs_object_map_descriptor_t ) ) ) );
+
+	/* Test error cases
+	 */
+	result = libfsapfs_object_map_index_get_size(
+	          NULL,
+	          &size,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfsapfs_object_map_index_get_size(
+	          object_map_index,
+	          NULL,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfsapfs_object_map_index_free(
+	          &object_map_index,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "object_map_index",
+	 object_map_index );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( object_map_index != NULL )
+	{
+		libfsapfs_object_map_index_free(
+		 &object_map_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSAPFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSAPFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSAPFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT )
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_map_index_initialize",
+	 fsapfs_test_object_map_index_initialize );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_map_index_free",
+	 fsapfs_test_object_map_index_free );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_map_index_append_entry",
+	 fsapfs_test_object_map_index_append_entry );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_map_index_get_descriptor_by_object_identifier",
+	 fsapfs_test_object_map_index_get_descriptor_by_object_identifier );
+
+	FSAPFS_TEST_RUN(
+	 "libfsapfs_object_map_index_get_size",
+	 fsapfs_test_object_map_index_get_size );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSAPFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1155 @@
+/*
+ * Library multi-threaded read testing program
+ *
+ * Copyright (C) 2018-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "fsapfs_test_functions.h"
+#include "fsapfs_test_getopt.h"
+#include "fsapfs_test_libbfio.h"
+#include "fsapfs_test_libcerror.h"
+#include "fsapfs_test_libcthreads.h"
+#include "fsapfs_test_libfsapfs.h"
+#include "fsapfs_test_macros.h"
+#include "fsapfs_test_memory.h"
+
+#if !defined( LIBFSAPFS_HAVE_BFIO )
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_check_container_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBFSAPFS_EXTERN \
+int libfsapfs_container_open_file_io_handle(
+     libfsapfs_container_t *container,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libfsapfs_error_t **error );
+
+#endif /* !defined( LIBFSAPFS_HAVE_BFIO ) */
+
+/* The buffer is large enough for reads of encrypted data to be decrypted in parallel
+ */
+#define FSAPFS_TEST_READ_THREADS_BUFFER_SIZE			( 4 * 1024 * 1024 )
+#define FSAPFS_TEST_READ_THREADS_MAXIMUM_NUMBER_OF_FILE_ENTRIES	256
+#define FSAPFS_TEST_READ_THREADS_NUMBER_OF_DECRYPTION_THREADS	4
+#define FSAPFS_TEST_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS	8
+#define FSAPFS_TEST_READ_THREADS_MAXIMUM_RECURSION_DEPTH	16
+
+typedef struct fsapfs_test_read_threads_context fsapfs_test_read_threads_context_t;
+
+struct fsapfs_test_read_threads_context
+{
+	/* The file entries
+	 */
+	libfsapfs_file_entry_t **file_entries;
+
+	/* The number of file entries
+	 */
+	int number_of_file_entries;
+
+	/* The index of the first file entry read by the thread
+	 */
+	int first_file_entry_index;
+
+	/* The number of threads, which is used as the file entry index increment
+	 */
+	int number_of_threads;
+
+	/* The number of bytes read
+	 */
+	size64_t read_size;
+
+	/* The result of the thread
+	 */
+	int result;
+};
+
+/* Retrieves a timestamp in milliseconds
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_read_threads_get_timestamp(
+     int64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if !defined( WINAPI )
+	struct timespec current_time;
+#endif
+
+	static char *function = "fsapfs_test_read_threads_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	*timestamp = (int64_t) GetTickCount();
+#else
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &current_time ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (int64_t) current_time.tv_sec * 1000 ) + ( current_time.tv_nsec / 1000000 );
+#endif
+	return( 1 );
+}
+
+/* Collects the regular files with data in a directory and its sub directories
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_read_threads_collect_file_entries(
+     libfsapfs_file_entry_t *file_entry,
+     libfsapfs_file_entry_t **file_entries,
+     int *number_of_file_entries,
+     int recursion_depth,
+     libcerror_error_t **error )
+{
+	libfsapfs_file_entry_t *sub_file_entry = NULL;
+	static char *function                  = "fsapfs_test_read_threads_collect_file_entries";
+	size64_t size                          = 0;
+	uint16_t file_mode                     = 0;
+	int number_of_sub_file_entries         = 0;
+	int sub_file_entry_index               = 0;
+
+	if( file_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_file_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of file entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsapfs_file_entry_get_number_of_sub_file_entries(
+	     file_entry,
+	     &number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub file entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( sub_file_entry_index = 0;
+	     sub_file_entry_index < number_of_sub_file_entries;
+	     sub_file_entry_index++ )
+	{
+		if( *number_of_file_entries >= FSAPFS_TEST_READ_THREADS_MAXIMUM_NUMBER_OF_FILE_ENTRIES )
+		{
+			break;
+		}
+		if( libfsapfs_file_entry_get_sub_file_entry_by_index(
+		     file_entry,
+		     sub_file_entry_index,
+		     &sub_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		if( libfsapfs_file_entry_get_file_mode(
+		     sub_file_entry,
+		     &file_mode,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file mode.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( file_mode & 0xf000 ) == 0x4000 )
+		{
+			if( recursion_depth < FSAPFS_TEST_READ_THREADS_MAXIMUM_RECURSION_DEPTH )
+			{
+				if( fsapfs_test_read_threads_collect_file_entries(
+				     sub_file_entry,
+				     file_entries,
+				     number_of_file_entries,
+				     recursion_depth + 1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to collect file entries of sub file entry: %d.",
+					 function,
+					 sub_file_entry_index );
+
+					goto on_error;
+				}
+			}
+		}
+		else if( ( file_mode & 0xf000 ) == 0x8000 )
+		{
+			if( libfsapfs_file_entry_get_size(
+			     sub_file_entry,
+			     &size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size.",
+				 function );
+
+				goto on_error;
+			}
+			if( size > 0 )
+			{
+				file_entries[ *number_of_file_entries ] = sub_file_entry;
+
+				*number_of_file_entries += 1;
+
+				sub_file_entry = NULL;
+			}
+		}
+		if( sub_file_entry != NULL )
+		{
+			if( libfsapfs_file_entry_free(
+			     &sub_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub file entry: %d.",
+				 function,
+				 sub_file_entry_index );
+
+				goto on_error;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( sub_file_entry != NULL )
+	{
+		libfsapfs_file_entry_free(
+		 &sub_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the data of the file entries of a thread
+ * Callback for the read threads
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_read_threads_read_file_entries(
+     fsapfs_test_read_threads_context_t *context )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *buffer          = NULL;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int file_entry_index     = 0;
+
+	if( context == NULL )
+	{
+		return( -1 );
+	}
+	context->result = -1;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * FSAPFS_TEST_READ_THREADS_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		return( -1 );
+	}
+	for( file_entry_index = context->first_file_entry_index;
+	     file_entry_index < context->number_of_file_entries;
+	     file_entry_index += context->number_of_threads )
+	{
+		offset = 0;
+
+		do
+		{
+			read_count = libfsapfs_file_entry_read_buffer_at_offset(
+			              context->file_entries[ file_entry_index ],
+			              buffer,
+			              FSAPFS_TEST_READ_THREADS_BUFFER_SIZE,
+			              offset,
+			              &error );
+
+			if( read_count < 0 )
+			{
+				goto on_error;
+			}
+			offset             += read_count;
+			context->read_size += read_count;
+		}
+		while( read_count > 0 );
+	}
+	memory_free(
+	 buffer );
+
+	context->result = 1;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	memory_free(
+	 buffer );
+
+	return( -1 );
+}
+
+/* Reads the data of the file entries using a number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int fsapfs_test_read_threads_read(
+     libfsapfs_file_entry_t **file_entries,
+     int number_of_file_entries,
+     int number_of_threads,
+     size64_t *read_size,
+     libcerror_error_t **error )
+{
+	fsapfs_test_read_threads_context_t contexts[ FSAPFS_TEST_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS ];
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_t *threads[ FSAPFS_TEST_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS ];
+#endif
+
+	static char *function   = "fsapfs_test_read_threads_read";
+	size64_t safe_read_size = 0;
+	int result              = 1;
+	int thread_index        = 0;
+
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > FSAPFS_TEST_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
+		 function );
+
+		return( -1 );
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		contexts[ thread_index ].file_entries           = file_entries;
+		contexts[ thread_index ].number_of_file_entries = number_of_file_entries;
+		contexts[ thread_index ].first_file_entry_index = thread_index;
+		contexts[ thread_index ].number_of_threads      = number_of_threads;
+		contexts[ thread_index ].read_size              = 0;
+		contexts[ thread_index ].result                 = 0;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+
+		if( libcthreads_thread_create(
+		     &( threads[ thread_index ] ),
+		     NULL,
+		     (int (*)(void *)) &fsapfs_test_read_threads_read_file_entries,
+		     (void *) &( contexts[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread: %d.",
+			 function,
+			 thread_index );
+
+			number_of_threads = thread_index;
+			result            = -1;
+
+			break;
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( threads[ thread_index ] ),
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+#else
+	if( number_of_threads != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of threads without multi-threading support.",
+		 function );
+
+		return( -1 );
+	}
+	fsapfs_test_read_threads_read_file_entries(
+	 &( contexts[ 0 ] ) );
+#endif
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( contexts[ thread_index ].result != 1 )
+		{
+			result = -1;
+		}
+		safe_read_size += contexts[ thread_index ].read_size;
+	}
+	if( result != 1 )
+	{
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file entries with: %d threads.",
+			 function,
+			 number_of_threads );
+		}
+		return( -1 );
+	}
+	*read_size = safe_read_size;
+
+	return( 1 );
+}
+
+/* Tests reading the file entries of a volume concurrently
+ * The reads are repeated with parallel decryption enabled on the container
+ * Returns 1 if successful or 0 if not
+ */
+int fsapfs_test_read_threads(
+     libfsapfs_container_t *container,
+     libfsapfs_volume_t *volume )
+{
+	libfsapfs_file_entry_t *file_entries[ FSAPFS_TEST_READ_THREADS_MAXIMUM_NUMBER_OF_FILE_ENTRIES ];
+
+	libcerror_error_t *error                 = NULL;
+	libfsapfs_file_entry_t *root_directory   = NULL;
+	size64_t expected_read_size              = 0;
+	size64_t read_size                       = 0;
+	int64_t duration                         = 0;
+	int64_t start_timestamp                  = 0;
+	int64_t stop_timestamp                   = 0;
+	uint64_t throughput                      = 0;
+	int file_entry_index                     = 0;
+	int maximum_number_of_decryption_threads = 0;
+	int maximum_number_of_threads            = 1;
+	int number_of_decryption_threads         = 0;
+	int number_of_file_entries               = 0;
+	int number_of_threads                    = 0;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	result = libfsapfs_volume_get_root_directory(
+	          volume,
+	          &root_directory,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+	 "root_directory",
+	 root_directory );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fsapfs_test_read_threads_collect_file_entries(
+	          root_directory,
+	          file_entries,
+	          &number_of_file_entries,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	maximum_number_of_decryption_threads = FSAPFS_TEST_READ_THREADS_NUMBER_OF_DECRYPTION_THREADS;
+	maximum_number_of_threads            = FSAPFS_TEST_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS;
+#endif
+	for( number_of_decryption_threads = 0;
+	     number_of_decryption_threads <= maximum_number_of_decryption_threads;
+	     number_of_decryption_threads += FSAPFS_TEST_READ_THREADS_NUMBER_OF_DECRYPTION_THREADS )
+	{
+		result = libfsapfs_container_set_number_of_decryption_threads(
+		          container,
+		          number_of_decryption_threads,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( number_of_threads = 1;
+		     number_of_threads <= maximum_number_of_threads;
+		     number_of_threads *= 2 )
+		{
+			result = fsapfs_test_read_threads_get_timestamp(
+			          &start_timestamp,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = fsapfs_test_read_threads_read(
+			          file_entries,
+			          number_of_file_entries,
+			          number_of_threads,
+			          &read_size,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = fsapfs_test_read_threads_get_timestamp(
+			          &stop_timestamp,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* Every number of threads is expected to read the same data
+			 */
+			if( ( number_of_decryption_threads == 0 )
+			 && ( number_of_threads == 1 ) )
+			{
+				expected_read_size = read_size;
+			}
+			FSAPFS_TEST_ASSERT_EQUAL_UINT64(
+			 "read_size",
+			 (uint64_t) read_size,
+			 (uint64_t) expected_read_size );
+
+			duration = stop_timestamp - start_timestamp;
+
+			if( duration <= 0 )
+			{
+				duration = 1;
+			}
+			throughput = ( (uint64_t) read_size * 1000 ) / (uint64_t) duration;
+
+			fprintf(
+			 stdout,
+			 "Read %d file entries with %d thread(s) and %d decryption thread(s): %" PRIu64 " bytes in %" PRIi64 " ms (%" PRIu64 " KiB/s)\n",
+			 number_of_file_entries,
+			 number_of_threads,
+			 number_of_decryption_threads,
+			 (uint64_t) read_size,
+			 duration,
+			 throughput / 1024 );
+		}
+	}
+	result = libfsapfs_container_set_number_of_decryption_threads(
+	          container,
+	          0,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	for( file_entry_index = 0;
+	     file_entry_index < number_of_file_entries;
+	     file_entry_index++ )
+	{
+		result = libfsapfs_file_entry_free(
+		          &( file_entries[ file_entry_index ] ),
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	number_of_file_entries = 0;
+
+	result = libfsapfs_file_entry_free(
+	          &root_directory,
+	          &error );
+
+	FSAPFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "root_directory",
+	 root_directory );
+
+	FSAPFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( file_entry_index = 0;
+	     file_entry_index < number_of_file_entries;
+	     file_entry_index++ )
+	{
+		if( file_entries[ file_entry_index ] != NULL )
+		{
+			libfsapfs_file_entry_free(
+			 &( file_entries[ file_entry_index ] ),
+			 NULL );
+		}
+	}
+	if( root_directory != NULL )
+	{
+		libfsapfs_file_entry_free(
+		 &root_directory,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libbfio_handle_t *file_io_handle    = NULL;
+	libcerror_error_t *error            = NULL;
+	libfsapfs_container_t *container    = NULL;
+	libfsapfs_volume_t *volume          = NULL;
+	system_character_t *option_offset   = NULL;
+	system_character_t *option_password = NULL;
+	system_character_t *source          = NULL;
+	system_integer_t option             = 0;
+	size_t string_length                = 0;
+	off64_t volume_offset               = 0;
+	int number_of_volumes               = 0;
+	int result                          = 0;
+
+	while( ( option = fsapfs_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "o:p:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'o':
+				option_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'p':
+				option_password = optarg;
+
+				break;
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+	if( option_offset != NULL )
+	{
+		string_length = system_string_length(
+		                 option_offset );
+
+		result = fsapfs_test_system_string_copy_from_64_bit_in_decimal(
+		          option_offset,
+		          string_length + 1,
+		          (uint64_t *) &volume_offset,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+	if( source != NULL )
+	{
+		result = libbfio_file_range_initialize(
+		          &file_io_handle,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "file_io_handle",
+		 file_io_handle );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		string_length = system_string_length(
+		                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libbfio_file_range_set_name_wide(
+		          file_io_handle,
+		          source,
+		          string_length,
+		          &error );
+#else
+		result = libbfio_file_range_set_name(
+		          file_io_handle,
+		          source,
+		          string_length,
+		          &error );
+#endif
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbfio_file_range_set(
+		          file_io_handle,
+		          volume_offset,
+		          0,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libfsapfs_check_container_signature_file_io_handle(
+		          file_io_handle,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	if( result != 0 )
+	{
+		/* Initialize test
+		 */
+		result = libfsapfs_container_initialize(
+		          &container,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+		 "container",
+		 container );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libfsapfs_container_open_file_io_handle(
+		          container,
+		          file_io_handle,
+		          LIBFSAPFS_OPEN_READ | LIBFSAPFS_ACCESS_FLAG_CLONE_FILE_IO_HANDLE,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libfsapfs_container_get_number_of_volumes(
+		          container,
+		          &number_of_volumes,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( number_of_volumes > 0 )
+		{
+			result = libfsapfs_container_get_volume_by_index(
+			          container,
+			          0,
+			          &volume,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_IS_NOT_NULL(
+			 "volume",
+			 volume );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* Locked volumes cannot be read without a password
+			 */
+			result = libfsapfs_volume_is_locked(
+			          volume,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( ( result != 0 )
+			 && ( option_password != NULL ) )
+			{
+				string_length = system_string_length(
+				                 option_password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+				result = libfsapfs_volume_set_utf16_password(
+				          volume,
+				          (uint16_t *) option_password,
+				          string_length,
+				          &error );
+#else
+				result = libfsapfs_volume_set_utf8_password(
+				          volume,
+				          (uint8_t *) option_password,
+				          string_length,
+				          &error );
+#endif
+				FSAPFS_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				FSAPFS_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = libfsapfs_volume_unlock(
+				          volume,
+				          &error );
+
+				FSAPFS_TEST_ASSERT_NOT_EQUAL_INT(
+				 "result",
+				 result,
+				 -1 );
+
+				FSAPFS_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				/* The volume remains locked if the password is incorrect
+				 */
+				result = ( result == 1 ) ? 0 : 1;
+			}
+
+			if( result == 0 )
+			{
+				FSAPFS_TEST_RUN_WITH_ARGS(
+				 "fsapfs_test_read_threads",
+				 fsapfs_test_read_threads,
+				 container,
+				 volume );
+			}
+			/* Clean up
+			 */
+			result = libfsapfs_volume_free(
+			          &volume,
+			          &error );
+
+			FSAPFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "volume",
+			 volume );
+
+			FSAPFS_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = libfsapfs_container_close(
+		          container,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libfsapfs_container_free(
+		          &container,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "container",
+		 container );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	if( file_io_handle != NULL )
+	{
+		result = libbfio_handle_free(
+		          &file_io_handle,
+		          &error );
+
+		FSAPFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "file_io_handle",
+		 file_io_handle );
+
+		FSAPFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libfsapfs_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( container != NULL )
+	{
+		libfsapfs_container_free(
+		 &container,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -7,8 +7,8 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-PROFILES=("fsapfsinfo_bodyfile_fs");
-OPTIONS_PER_PROFILE=("-Bbodyfile -H");
+PROFILES=("fsapfsinfo_bodyfile_fs" "fsapfsinfo_bodyfile_scan_fs" "fsapfsinfo_bodyfile_md5_fs");
+OPTIONS_PER_PROFILE=("-Bbodyfile -H" "-Bbodyfile -H -S" "-Bbodyfile -dmd5 -H");
 OPTION_SETS="offset password";
 
 INPUT_GLOB="*";
@@ -6,8 +6,8 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "btree_entry btree_footer btree_node btree_node_header buffer_data_handle checkpoint_map checkpoint_map_entry checksum chunk_information_block container_data_handle container_key_bag container_reaper container_superblock compressed_data_handle compression data_block data_block_data_handle data_stream deflate directory_record encryption_context error extended_attribute extent_reference_tree file_extent file_system_btree file_system_data_handle fusion_middle_tree inode io_handle key_bag_entry key_bag_header key_encrypted_key name name_hash notify object object_map object_map_btree object_map_descriptor profiler snapshot snapshot_metadata snapshot_metadata_tree space_manager volume volume_key_bag"
-$LibraryTestsWithInput = "container support"
+$LibraryTests = "aes_ni block_cache btree_entry btree_footer btree_node btree_node_header buffer_data_handle checkpoint_map checkpoint_map_entry checksum chunk_information_block compressed_data_handle compression container_data_handle container_key_bag container_reaper container_superblock data_block data_block_data_handle data_stream decompressed_block_cache deflate directory_record encryption_context error extended_attribute extent_reference_tree file_extent file_io_handle_pool file_system_btree file_system_btree_cursor file_system_data_handle file_system_scanner fusion_middle_tree inode io_handle key_bag_entry key_bag_header key_encrypted_key name name_hash node_cache notify object object_map object_map_btree object_map_cache object_map_descriptor object_map_index profiler snapshot snapshot_metadata snapshot_metadata_tree space_manager volume volume_key_bag"
+$LibraryTestsWithInput = "container read_threads support"
 $OptionSets = "offset password"
 
 $InputGlob = "*"